@@ -130,7 +130,7 @@ static struct option dpaiop_destroy_options[] = {
 
 C_ASSERT(ARRAY_SIZE(dpaiop_destroy_options) <= MAX_NUM_CMD_LINE_OPTIONS + 1);
 
-static const struct flib_ops dpaiop_ops = {
+const struct flib_ops dpaiop_ops = {
 	.obj_open = dpaiop_open,
 	.obj_close = dpaiop_close,
 	.obj_get_irq_mask = dpaiop_get_irq_mask,
@@ -402,7 +402,7 @@ static int print_dpaiop_info(uint32_t dpaiop_id, int mc_fw_version)
 
 	if (restool.cmd_option_mask & ONE_BIT_MASK(INFO_OPT_VERBOSE)) {
 		restool.cmd_option_mask &= ~ONE_BIT_MASK(INFO_OPT_VERBOSE);
-		error = print_obj_verbose(&target_obj_desc, &dpaiop_ops);
+		error = print_obj_verbose(&target_obj_desc);
 	}
 
 out:
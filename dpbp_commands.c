@@ -121,7 +121,7 @@ static struct option dpbp_destroy_options[] = {
 
 C_ASSERT(ARRAY_SIZE(dpbp_destroy_options) <= MAX_NUM_CMD_LINE_OPTIONS + 1);
 
-static const struct flib_ops dpbp_ops = {
+const struct flib_ops dpbp_ops = {
 	.obj_open = dpbp_open,
 	.obj_close = dpbp_close,
 	.obj_get_irq_mask = dpbp_get_irq_mask,
@@ -304,7 +304,7 @@ static int print_dpbp_info(uint32_t dpbp_id, int mc_fw_version)
 
 	if (restool.cmd_option_mask & ONE_BIT_MASK(INFO_OPT_VERBOSE)) {
 		restool.cmd_option_mask &= ~ONE_BIT_MASK(INFO_OPT_VERBOSE);
-		error = print_obj_verbose(&target_obj_desc, &dpbp_ops);
+		error = print_obj_verbose(&target_obj_desc);
 	}
 
 out:
@@ -138,7 +138,7 @@ static struct option dpci_destroy_options[] = {
 
 C_ASSERT(ARRAY_SIZE(dpci_destroy_options) <= MAX_NUM_CMD_LINE_OPTIONS + 1);
 
-static const struct flib_ops dpci_ops = {
+const struct flib_ops dpci_ops = {
 	.obj_open = dpci_open,
 	.obj_close = dpci_close,
 	.obj_get_irq_mask = dpci_get_irq_mask,
@@ -390,7 +390,7 @@ static int print_dpci_info(uint32_t dpci_id, int mc_fw_version)
 
 	if (restool.cmd_option_mask & ONE_BIT_MASK(INFO_OPT_VERBOSE)) {
 		restool.cmd_option_mask &= ~ONE_BIT_MASK(INFO_OPT_VERBOSE);
-		error = print_obj_verbose(&target_obj_desc, &dpci_ops);
+		error = print_obj_verbose(&target_obj_desc);
 	}
 
 out:
@@ -130,7 +130,7 @@ static struct option dpcon_destroy_options[] = {
 
 C_ASSERT(ARRAY_SIZE(dpcon_destroy_options) <= MAX_NUM_CMD_LINE_OPTIONS + 1);
 
-static const struct flib_ops dpcon_ops = {
+const struct flib_ops dpcon_ops = {
 	.obj_open = dpcon_open,
 	.obj_close = dpcon_close,
 	.obj_get_irq_mask = dpcon_get_irq_mask,
@@ -322,7 +322,7 @@ static int print_dpcon_info(uint32_t dpcon_id, int mc_fw_version)
 
 	if (restool.cmd_option_mask & ONE_BIT_MASK(INFO_OPT_VERBOSE)) {
 		restool.cmd_option_mask &= ~ONE_BIT_MASK(INFO_OPT_VERBOSE);
-		error = print_obj_verbose(&target_obj_desc, &dpcon_ops);
+		error = print_obj_verbose(&target_obj_desc);
 	}
 
 out:
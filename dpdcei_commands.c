@@ -137,7 +137,7 @@ static struct option dpdcei_destroy_options[] = {
 
 C_ASSERT(ARRAY_SIZE(dpdcei_destroy_options) <= MAX_NUM_CMD_LINE_OPTIONS + 1);
 
-static const struct flib_ops dpdcei_ops = {
+const struct flib_ops dpdcei_ops = {
 	.obj_open = dpdcei_open,
 	.obj_close = dpdcei_close,
 	.obj_get_irq_mask = dpdcei_get_irq_mask,
@@ -339,7 +339,7 @@ static int print_dpdcei_info(uint32_t dpdcei_id, int mc_fw_version)
 
 	if (restool.cmd_option_mask & ONE_BIT_MASK(INFO_OPT_VERBOSE)) {
 		restool.cmd_option_mask &= ~ONE_BIT_MASK(INFO_OPT_VERBOSE);
-		error = print_obj_verbose(&target_obj_desc, &dpdcei_ops);
+		error = print_obj_verbose(&target_obj_desc);
 	}
 
 out:
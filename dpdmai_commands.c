@@ -128,7 +128,7 @@ static struct option dpdmai_destroy_options[] = {
 
 C_ASSERT(ARRAY_SIZE(dpdmai_destroy_options) <= MAX_NUM_CMD_LINE_OPTIONS + 1);
 
-static const struct flib_ops dpdmai_ops = {
+const struct flib_ops dpdmai_ops = {
 	.obj_open = dpdmai_open,
 	.obj_close = dpdmai_close,
 	.obj_get_irq_mask = dpdmai_get_irq_mask,
@@ -314,7 +314,7 @@ static int print_dpdmai_info(uint32_t dpdmai_id, int mc_fw_version)
 
 	if (restool.cmd_option_mask & ONE_BIT_MASK(INFO_OPT_VERBOSE)) {
 		restool.cmd_option_mask &= ~ONE_BIT_MASK(INFO_OPT_VERBOSE);
-		error = print_obj_verbose(&target_obj_desc, &dpdmai_ops);
+		error = print_obj_verbose(&target_obj_desc);
 	}
 
 out:
@@ -42,6 +42,7 @@
 #include "utils.h"
 #include "mc_v9/fsl_dpdmux.h"
 #include "mc_v10/fsl_dpdmux.h"
+#include "dpni_commands_classify.h"
 
 #define ALL_DPDMUX_OPTS (		\
 	DPDMUX_OPT_BRIDGE_EN |		\
@@ -250,13 +251,65 @@ static struct option dpdmux_destroy_options[] = {
 
 C_ASSERT(ARRAY_SIZE(dpdmux_destroy_options) <= MAX_NUM_CMD_LINE_OPTIONS + 1);
 
+/**
+ * dpdmux set-key, rule-add, rule-del and rule-load command options
+ */
+enum dpdmux_rule_options {
+	RULE_OPT_HELP = 0,
+	RULE_OPT_KEY,
+	RULE_OPT_RULE,
+	RULE_OPT_IF,
+	RULE_OPT_FILE,
+};
+
+static struct option dpdmux_rule_options[] = {
+	[RULE_OPT_HELP] = {
+		.name = "help",
+		.has_arg = 0,
+		.flag = NULL,
+		.val = 0,
+	},
+
+	[RULE_OPT_KEY] = {
+		.name = "key",
+		.has_arg = 1,
+		.flag = NULL,
+		.val = 0,
+	},
+
+	[RULE_OPT_RULE] = {
+		.name = "rule",
+		.has_arg = 1,
+		.flag = NULL,
+		.val = 0,
+	},
+
+	[RULE_OPT_IF] = {
+		.name = "if",
+		.has_arg = 1,
+		.flag = NULL,
+		.val = 0,
+	},
+
+	[RULE_OPT_FILE] = {
+		.name = "file",
+		.has_arg = 1,
+		.flag = NULL,
+		.val = 0,
+	},
+
+	{ 0 },
+};
+
+C_ASSERT(ARRAY_SIZE(dpdmux_rule_options) <= MAX_NUM_CMD_LINE_OPTIONS + 1);
+
 static struct option_entry options_map[] = {
 	OPTION_MAP_ENTRY(DPDMUX_OPT_BRIDGE_EN),
 	OPTION_MAP_ENTRY(DPDMUX_OPT_CLS_MASK_SUPPORT),
 };
 static unsigned options_num = ARRAY_SIZE(options_map);
 
-static const struct flib_ops dpdmux_ops_v9 = {
+const struct flib_ops dpdmux_ops_v9 = {
 	.obj_open = dpdmux_open,
 	.obj_close = dpdmux_close,
 	.obj_get_irq_mask = dpdmux_get_irq_mask,
@@ -272,6 +325,11 @@ static int cmd_dpdmux_help(void)
 		"   info - displays detailed information about a DPDMUX object.\n"
 		"   create - creates a new child DPDMUX under the root DPRC.\n"
 		"   destroy - destroys a child DPDMUX under the root DPRC.\n"
+		"   set-key - sets the classification key of a custom method DPDMUX.\n"
+		"   rule-add - adds a rule steering frames to a DPDMUX interface.\n"
+		"   rule-del - removes a rule from a DPDMUX.\n"
+		"   rule-load - adds the rules listed in a file to a DPDMUX.\n"
+		"   The set-key and rule-* commands need MC 10.x.\n"
 		"\n"
 		"For command-specific help, use the --help option of each command.\n"
 		"\n";
@@ -297,11 +355,7 @@ static int print_dpdmux_endpoint(uint32_t target_id, uint16_t num_ifs)
 		endpoint1.id = target_id;
 		endpoint1.if_id = k;
 
-		error = dprc_get_connection(&restool.mc_io, 0,
-					restool.root_dprc_handle,
-					&endpoint1,
-					&endpoint2,
-					&state);
+		error = get_connection(&endpoint1, &endpoint2, &state);
 		printf("interface %d:\n", k);
 		if (error == 0 && state == -1) {
 			printf("\tconnection: none\n");
@@ -567,7 +621,7 @@ static int print_dpdmux_info(uint32_t dpdmux_id, int mc_fw_version)
 
 	if (restool.cmd_option_mask & ONE_BIT_MASK(INFO_OPT_VERBOSE)) {
 		restool.cmd_option_mask &= ~ONE_BIT_MASK(INFO_OPT_VERBOSE);
-		error = print_obj_verbose(&target_obj_desc, &dpdmux_ops_v9);
+		error = print_obj_verbose(&target_obj_desc);
 	}
 
 out:
@@ -1185,6 +1239,535 @@ static int cmd_dpdmux_destroy_v10(void)
 	return destroy_dpdmux(MC_FW_VERSION_10);
 }
 
+/**
+ * Rules of the L2 methods are written like the custom ones, against
+ * the key the method classifies on
+ */
+static const struct {
+	enum dpdmux_method method;
+	const char *key;
+} dpdmux_l2_keys[] = {
+	{ DPDMUX_METHOD_MAC, "ethdst" },
+	{ DPDMUX_METHOD_C_VLAN_MAC, "ethdst,vlan" },
+	{ DPDMUX_METHOD_C_VLAN, "vlan" },
+	{ DPDMUX_METHOD_S_VLAN, "vlan" },
+};
+
+/**
+ * Entries to add to or remove from a DPDMUX table, all in one MC
+ * session
+ */
+struct dpdmux_rule_batch {
+	bool add;
+
+	/**
+	 * --key of a custom method DPDMUX, NULL for the L2 methods
+	 */
+	const char *key;
+
+	/**
+	 * either a single rule and its interface, or a file of rules
+	 */
+	const char *rule;
+	bool has_if;
+	uint16_t if_id;
+	const char *rule_file;
+};
+
+static int get_dpdmux_rule_key(uint32_t dpdmux_id,
+			       const struct dpdmux_attr_v10 *dpdmux_attr,
+			       const char *key, struct dpkg_profile_cfg *key_cfg)
+{
+	if (dpdmux_attr->method == DPDMUX_METHOD_CUSTOM) {
+		if (key == NULL) {
+			ERROR_PRINTF("dpdmux.%u uses the custom method, --key must be specified\n",
+				     dpdmux_id);
+			return -EINVAL;
+		}
+		return parse_dpni_key(key, key_cfg);
+	}
+
+	if (key != NULL) {
+		ERROR_PRINTF("--key is only for custom method DPDMUXes\n");
+		return -EINVAL;
+	}
+
+	for (unsigned int i = 0; i < ARRAY_SIZE(dpdmux_l2_keys); i++) {
+		if (dpdmux_l2_keys[i].method == dpdmux_attr->method)
+			return parse_dpni_key(dpdmux_l2_keys[i].key, key_cfg);
+	}
+
+	ERROR_PRINTF("dpdmux.%u has no classification method\n", dpdmux_id);
+	return -EINVAL;
+}
+
+/*
+ * Checks the rules against the DPDMUX: interfaces go from 0 (uplink) to
+ * num_ifs, only custom rules with mask support take masks
+ */
+static int check_dpdmux_rules(uint32_t dpdmux_id,
+			      const struct dpdmux_attr_v10 *dpdmux_attr,
+			      const struct dpdmux_rule_batch *batch,
+			      const struct dpni_rule *rules, int num_rules)
+{
+	bool mask_support = dpdmux_attr->method == DPDMUX_METHOD_CUSTOM &&
+		(dpdmux_attr->options & DPDMUX_OPT_CLS_MASK_SUPPORT);
+
+	for (int i = 0; i < num_rules; i++) {
+		if (rules[i].target > dpdmux_attr->num_ifs) {
+			ERROR_PRINTF("Interface %u is out of range, dpdmux.%u has %u downlinks\n",
+				     (uint32_t)rules[i].target, dpdmux_id,
+				     (uint32_t)dpdmux_attr->num_ifs);
+		} else if (rules[i].has_mask && !mask_support) {
+			ERROR_PRINTF("dpdmux.%u rules take no mask\n",
+				     dpdmux_id);
+		} else {
+			continue;
+		}
+
+		if (rules[i].line)
+			ERROR_PRINTF("%s:%d: invalid rule\n", batch->rule_file,
+				     rules[i].line);
+		return -EINVAL;
+	}
+
+	return 0;
+}
+
+static void get_dpdmux_l2_rule(const struct dpkg_profile_cfg *key_cfg,
+			       const struct dpni_rule *rule,
+			       struct dpdmux_l2_rule *l2_rule)
+{
+	const uint8_t *key = rule->key;
+
+	memset(l2_rule, 0, sizeof(*l2_rule));
+	for (int i = 0; i < key_cfg->num_extracts; i++) {
+		if (key_cfg->extracts[i].extract.from_hdr.prot ==
+		    NET_PROT_ETH) {
+			memcpy(l2_rule->mac_addr, key, 6);
+			key += 6;
+		} else {
+			l2_rule->vlan_id = (key[0] << 8 | key[1]) & 0xfff;
+			key += 2;
+		}
+	}
+}
+
+static int apply_dpdmux_rule(uint16_t dpdmux_handle,
+			     const struct dpdmux_attr_v10 *dpdmux_attr,
+			     const struct dpdmux_rule_batch *batch,
+			     const struct dpkg_profile_cfg *key_cfg,
+			     const struct dpni_rule *rule, void *key_buf,
+			     struct dpdmux_rule_cfg *rule_cfg,
+			     uint64_t mask_iova)
+{
+	struct dpdmux_cls_action action;
+	struct dpdmux_l2_rule l2_rule;
+	uint8_t *key = key_buf;
+
+	if (dpdmux_attr->method != DPDMUX_METHOD_CUSTOM) {
+		get_dpdmux_l2_rule(key_cfg, rule, &l2_rule);
+		if (batch->add)
+			return dpdmux_if_add_l2_rule_v10(&restool.mc_io, 0,
+							 dpdmux_handle,
+							 rule->target,
+							 &l2_rule);
+		return dpdmux_if_remove_l2_rule_v10(&restool.mc_io, 0,
+						    dpdmux_handle,
+						    rule->target, &l2_rule);
+	}
+
+	memcpy(key, rule->key, rule_cfg->key_size);
+	memcpy(key + DPNI_MAX_KEY_SIZE, rule->mask, rule_cfg->key_size);
+	rule_cfg->mask_iova = rule->has_mask ? mask_iova : 0;
+	if (!batch->add)
+		return dpdmux_remove_custom_cls_entry_v10(&restool.mc_io, 0,
+							  dpdmux_handle,
+							  rule_cfg);
+
+	action.dest_if = rule->target;
+	return dpdmux_add_custom_cls_entry_v10(&restool.mc_io, 0,
+					       dpdmux_handle, rule_cfg,
+					       &action);
+}
+
+/*
+ * The rules are parsed against the key of the DPDMUX method, checked,
+ * then issued in the session opened to read the DPDMUX attributes
+ */
+static int update_dpdmux_rules(uint32_t dpdmux_id,
+			       const struct dpdmux_rule_batch *batch)
+{
+	struct dpdmux_attr_v10 dpdmux_attr;
+	struct dpkg_profile_cfg key_cfg;
+	struct dpdmux_rule_cfg rule_cfg;
+	struct dpni_rule *rules = NULL;
+	struct dpni_rule rule;
+	uint16_t dpdmux_handle;
+	bool need_target;
+	int num_rules = 0;
+	uint64_t key_iova;
+	void *key_buf;
+	char *values;
+	int error, error2;
+	int done;
+
+	error = dpdmux_open_v10(&restool.mc_io, 0, dpdmux_id, &dpdmux_handle);
+	if (error < 0) {
+		mc_status = flib_error_to_mc_status(error);
+		ERROR_PRINTF("MC error: %s (status %#x)\n",
+			     mc_status_to_string(mc_status), mc_status);
+		return error;
+	}
+
+	memset(&dpdmux_attr, 0, sizeof(dpdmux_attr));
+	error = dpdmux_get_attributes_v10(&restool.mc_io, 0, dpdmux_handle,
+					  &dpdmux_attr);
+	if (error < 0) {
+		mc_status = flib_error_to_mc_status(error);
+		ERROR_PRINTF("MC error: %s (status %#x)\n",
+			     mc_status_to_string(mc_status), mc_status);
+		goto close;
+	}
+
+	error = get_dpdmux_rule_key(dpdmux_id, &dpdmux_attr, batch->key,
+				    &key_cfg);
+	if (error)
+		goto close;
+
+	/* custom rules are removed by key only, L2 ones per interface */
+	need_target = batch->add || dpdmux_attr.method != DPDMUX_METHOD_CUSTOM;
+	if (need_target && batch->rule != NULL && !batch->has_if) {
+		ERROR_PRINTF("--if option missing\n");
+		error = -EINVAL;
+		goto close;
+	}
+
+	if (batch->rule_file != NULL) {
+		error = read_dpni_rule_file(batch->rule_file, &key_cfg,
+					    need_target, &rules, &num_rules);
+		if (error)
+			goto close;
+	} else {
+		values = strdup(batch->rule);
+		if (values == NULL) {
+			ERROR_PRINTF("strdup() failed\n");
+			error = -ENOMEM;
+			goto close;
+		}
+		rule.line = 0;
+		rule.target = batch->if_id;
+		error = parse_dpni_rule_values(&key_cfg, values, &rule);
+		free(values);
+		if (error)
+			goto close;
+		rules = &rule;
+		num_rules = 1;
+	}
+
+	error = check_dpdmux_rules(dpdmux_id, &dpdmux_attr, batch, rules,
+				   num_rules);
+	if (error)
+		goto free_rules;
+
+	/* key and mask share one buffer for the whole batch */
+	error = alloc_dma_buf(2 * DPNI_MAX_KEY_SIZE, &key_buf, &key_iova);
+	if (error)
+		goto free_rules;
+
+	memset(&rule_cfg, 0, sizeof(rule_cfg));
+	rule_cfg.key_iova = key_iova;
+	rule_cfg.key_size = get_dpni_key_size(&key_cfg);
+	for (done = 0; done < num_rules; done++) {
+		error = apply_dpdmux_rule(dpdmux_handle, &dpdmux_attr, batch,
+					  &key_cfg, &rules[done], key_buf,
+					  &rule_cfg,
+					  key_iova + DPNI_MAX_KEY_SIZE);
+		if (error < 0) {
+			mc_status = flib_error_to_mc_status(error);
+			if (rules[done].line)
+				ERROR_PRINTF("%s:%d: MC error: %s (status %#x)\n",
+					     batch->rule_file,
+					     rules[done].line,
+					     mc_status_to_string(mc_status),
+					     mc_status);
+			else
+				ERROR_PRINTF("MC error: %s (status %#x)\n",
+					     mc_status_to_string(mc_status),
+					     mc_status);
+			break;
+		}
+	}
+
+	free_dma_buf(key_buf);
+	if (batch->rule_file != NULL)
+		printf("%d of %d rules %s\n", done, num_rules,
+		       batch->add ? "added" : "removed");
+
+free_rules:
+	if (batch->rule_file != NULL)
+		free(rules);
+close:
+	error2 = dpdmux_close_v10(&restool.mc_io, 0, dpdmux_handle);
+	if (error2 < 0) {
+		mc_status = flib_error_to_mc_status(error2);
+		ERROR_PRINTF("MC error: %s (status %#x)\n",
+			     mc_status_to_string(mc_status), mc_status);
+		if (error == 0)
+			error = error2;
+	}
+
+	return error;
+}
+
+static int set_dpdmux_key(uint32_t dpdmux_id,
+			  const struct dpkg_profile_cfg *key_cfg)
+{
+	uint16_t dpdmux_handle;
+	uint64_t key_cfg_iova;
+	void *key_cfg_buf;
+	int error, error2;
+
+	error = dpdmux_open_v10(&restool.mc_io, 0, dpdmux_id, &dpdmux_handle);
+	if (error < 0) {
+		mc_status = flib_error_to_mc_status(error);
+		ERROR_PRINTF("MC error: %s (status %#x)\n",
+			     mc_status_to_string(mc_status), mc_status);
+		return error;
+	}
+
+	error = alloc_dma_buf(DPNI_KEY_CFG_SIZE, &key_cfg_buf, &key_cfg_iova);
+	if (error)
+		goto out;
+
+	error = dpni_prepare_key_cfg(key_cfg, key_cfg_buf);
+	if (error == 0) {
+		error = dpdmux_set_custom_key_v10(&restool.mc_io, 0,
+						  dpdmux_handle, key_cfg_iova);
+		if (error < 0) {
+			mc_status = flib_error_to_mc_status(error);
+			ERROR_PRINTF("MC error: %s (status %#x)\n",
+				     mc_status_to_string(mc_status), mc_status);
+		}
+	}
+	free_dma_buf(key_cfg_buf);
+
+out:
+	error2 = dpdmux_close_v10(&restool.mc_io, 0, dpdmux_handle);
+	if (error2 < 0) {
+		mc_status = flib_error_to_mc_status(error2);
+		ERROR_PRINTF("MC error: %s (status %#x)\n",
+			     mc_status_to_string(mc_status), mc_status);
+		if (error == 0)
+			error = error2;
+	}
+
+	return error;
+}
+
+static int cmd_dpdmux_set_key(void)
+{
+	static const char usage_msg[] =
+		"\n"
+		"Usage: restool dpdmux set-key <dpdmux-object> --key=<fields>\n"
+		"\n"
+		"--key=<fields>\n"
+		"   Comma separated header fields the custom method classifies\n"
+		"   on: ethsrc, ethdst, ethtype, vlan, ipsrc, ipdst, ipproto,\n"
+		"   l4sport, l4dport, or the 5tuple preset.\n"
+		"\n"
+		"Only for DPDMUXes created with the custom method. Setting the key\n"
+		"removes all the rules of the DPDMUX.\n"
+		"\n"
+		"EXAMPLE:\n"
+		"   $ restool dpdmux set-key dpdmux.0 --key=ipdst\n"
+		"\n";
+
+	struct dpkg_profile_cfg key_cfg;
+	uint32_t dpdmux_id;
+	int error;
+
+	if (restool.cmd_option_mask & ONE_BIT_MASK(RULE_OPT_HELP)) {
+		puts(usage_msg);
+		restool.cmd_option_mask &= ~ONE_BIT_MASK(RULE_OPT_HELP);
+		return 0;
+	}
+
+	if (restool.obj_name == NULL) {
+		ERROR_PRINTF("<object> argument missing\n");
+		puts(usage_msg);
+		return -EINVAL;
+	}
+
+	error = parse_object_name(restool.obj_name, "dpdmux", &dpdmux_id);
+	if (error < 0)
+		return error;
+
+	if (!(restool.cmd_option_mask & ONE_BIT_MASK(RULE_OPT_KEY))) {
+		ERROR_PRINTF("--key option missing\n");
+		puts(usage_msg);
+		return -EINVAL;
+	}
+
+	restool.cmd_option_mask &= ~ONE_BIT_MASK(RULE_OPT_KEY);
+	error = parse_dpni_key(restool.cmd_option_args[RULE_OPT_KEY],
+			       &key_cfg);
+	if (error)
+		return error;
+
+	return set_dpdmux_key(dpdmux_id, &key_cfg);
+}
+
+/*
+ * Common part of dpdmux rule-add, rule-del and rule-load
+ */
+static int rule_dpdmux(const char *usage_msg, bool add, bool from_file)
+{
+	struct dpdmux_rule_batch batch;
+	uint32_t dpdmux_id;
+	int error;
+	long val;
+
+	if (restool.cmd_option_mask & ONE_BIT_MASK(RULE_OPT_HELP)) {
+		puts(usage_msg);
+		restool.cmd_option_mask &= ~ONE_BIT_MASK(RULE_OPT_HELP);
+		return 0;
+	}
+
+	if (restool.obj_name == NULL) {
+		ERROR_PRINTF("<object> argument missing\n");
+		puts(usage_msg);
+		return -EINVAL;
+	}
+
+	error = parse_object_name(restool.obj_name, "dpdmux", &dpdmux_id);
+	if (error < 0)
+		return error;
+
+	memset(&batch, 0, sizeof(batch));
+	batch.add = add;
+	if (restool.cmd_option_mask & ONE_BIT_MASK(RULE_OPT_KEY)) {
+		restool.cmd_option_mask &= ~ONE_BIT_MASK(RULE_OPT_KEY);
+		batch.key = restool.cmd_option_args[RULE_OPT_KEY];
+	}
+
+	if (from_file) {
+		if (!(restool.cmd_option_mask & ONE_BIT_MASK(RULE_OPT_FILE))) {
+			ERROR_PRINTF("--file option missing\n");
+			puts(usage_msg);
+			return -EINVAL;
+		}
+		restool.cmd_option_mask &= ~ONE_BIT_MASK(RULE_OPT_FILE);
+		batch.rule_file = restool.cmd_option_args[RULE_OPT_FILE];
+		return update_dpdmux_rules(dpdmux_id, &batch);
+	}
+
+	if (!(restool.cmd_option_mask & ONE_BIT_MASK(RULE_OPT_RULE))) {
+		ERROR_PRINTF("--rule option missing\n");
+		puts(usage_msg);
+		return -EINVAL;
+	}
+	restool.cmd_option_mask &= ~ONE_BIT_MASK(RULE_OPT_RULE);
+	batch.rule = restool.cmd_option_args[RULE_OPT_RULE];
+
+	/* checked against the DPDMUX method once it is known */
+	if (restool.cmd_option_mask & ONE_BIT_MASK(RULE_OPT_IF)) {
+		restool.cmd_option_mask &= ~ONE_BIT_MASK(RULE_OPT_IF);
+		error = get_option_value(RULE_OPT_IF, &val,
+					 "Invalid if value", 0, UINT16_MAX);
+		if (error)
+			return error;
+		batch.has_if = true;
+		batch.if_id = val;
+	}
+
+	return update_dpdmux_rules(dpdmux_id, &batch);
+}
+
+static int cmd_dpdmux_rule_add(void)
+{
+	static const char usage_msg[] =
+		"\n"
+		"Usage: restool dpdmux rule-add <dpdmux-object> --rule=<values>\n"
+		"		--if=<number> [--key=<fields>]\n"
+		"\n"
+		"--rule=<values>\n"
+		"   Comma separated values of the key fields, in key order:\n"
+		"	MAC method:		<ethdst>\n"
+		"	C-VLAN/S-VLAN method:	<vlan>\n"
+		"	C-VLAN+MAC method:	<ethdst>,<vlan>\n"
+		"	custom method:		the fields of --key\n"
+		"   A custom method DPDMUX created with DPDMUX_OPT_CLS_MASK_SUPPORT\n"
+		"   takes a /<mask> after any value.\n"
+		"--if=<number>\n"
+		"   Interface the matching frames go to: 0 is the uplink, 1 to\n"
+		"   <num-ifs> the downlinks.\n"
+		"\n"
+		"OPTIONS:\n"
+		"--key=<fields>\n"
+		"   Key of a custom method DPDMUX, as given to set-key.\n"
+		"\n"
+		"EXAMPLE:\n"
+		"Steer 00:00:05:00:00:05 to the third downlink of MAC method dpdmux.0:\n"
+		"   $ restool dpdmux rule-add dpdmux.0 --rule=00:00:05:00:00:05 --if=3\n"
+		"\n";
+
+	return rule_dpdmux(usage_msg, true, false);
+}
+
+static int cmd_dpdmux_rule_del(void)
+{
+	static const char usage_msg[] =
+		"\n"
+		"Usage: restool dpdmux rule-del <dpdmux-object> --rule=<values>\n"
+		"		[--if=<number>] [--key=<fields>]\n"
+		"\n"
+		"--rule=<values>\n"
+		"   Values of the rule, written as for rule-add.\n"
+		"\n"
+		"OPTIONS:\n"
+		"--if=<number>\n"
+		"   Interface of the rule; needed by the MAC and VLAN methods.\n"
+		"--key=<fields>\n"
+		"   Key of a custom method DPDMUX, as given to set-key.\n"
+		"\n"
+		"EXAMPLE:\n"
+		"   $ restool dpdmux rule-del dpdmux.0 --rule=00:00:05:00:00:05 --if=3\n"
+		"\n";
+
+	return rule_dpdmux(usage_msg, false, false);
+}
+
+static int cmd_dpdmux_rule_load(void)
+{
+	static const char usage_msg[] =
+		"\n"
+		"Usage: restool dpdmux rule-load <dpdmux-object> --file=<path>\n"
+		"		[--key=<fields>]\n"
+		"\n"
+		"--file=<path>\n"
+		"   File of rules, one per line: \"<values> <if>\", values being\n"
+		"   written as for rule-add. Blank lines and lines starting with\n"
+		"   '#' are skipped.\n"
+		"\n"
+		"OPTIONS:\n"
+		"--key=<fields>\n"
+		"   Key of a custom method DPDMUX, as given to set-key.\n"
+		"\n"
+		"The whole file is checked before the first rule is added, the\n"
+		"rules are then added in a single DPDMUX session. Loading stops at\n"
+		"the first rule rejected by MC.\n"
+		"\n"
+		"EXAMPLE:\n"
+		"   $ cat downlinks.rules\n"
+		"   00:00:05:00:00:05,100 1\n"
+		"   00:00:05:00:00:06,100 2\n"
+		"   $ restool dpdmux rule-load dpdmux.0 --file=downlinks.rules\n"
+		"\n";
+
+	return rule_dpdmux(usage_msg, true, true);
+}
+
 struct object_command dpdmux_commands_v9[] = {
 	{ .cmd_name = "help",
 	  .options = NULL,
@@ -1222,6 +1805,22 @@ struct object_command dpdmux_commands_v10[] = {
 	  .options = dpdmux_destroy_options,
 	  .cmd_func = cmd_dpdmux_destroy_v10 },
 
+	{ .cmd_name = "set-key",
+	  .options = dpdmux_rule_options,
+	  .cmd_func = cmd_dpdmux_set_key },
+
+	{ .cmd_name = "rule-add",
+	  .options = dpdmux_rule_options,
+	  .cmd_func = cmd_dpdmux_rule_add },
+
+	{ .cmd_name = "rule-del",
+	  .options = dpdmux_rule_options,
+	  .cmd_func = cmd_dpdmux_rule_del },
+
+	{ .cmd_name = "rule-load",
+	  .options = dpdmux_rule_options,
+	  .cmd_func = cmd_dpdmux_rule_load },
+
 	{ .cmd_name = NULL },
 };
 
@@ -37,11 +37,13 @@
 #include <errno.h>
 #include <assert.h>
 #include <getopt.h>
+#include <unistd.h>
 #include <sys/ioctl.h>
 #include "restool.h"
 #include "utils.h"
 #include "mc_v9/fsl_dpio.h"
 #include "mc_v10/fsl_dpio.h"
+#include "mc_v10/fsl_dpcon.h"
 
 enum mc_cmd_status mc_status;
 
@@ -117,6 +119,66 @@ static struct option dpio_create_options[] = {
 
 C_ASSERT(ARRAY_SIZE(dpio_create_options) <= MAX_NUM_CMD_LINE_OPTIONS + 1);
 
+/**
+ * dpio provision command options
+ */
+enum dpio_provision_options {
+	PROVISION_OPT_HELP = 0,
+	PROVISION_OPT_PER_CPU,
+	PROVISION_OPT_CPUS,
+	PROVISION_OPT_NUM_PRIORITIES,
+	PROVISION_OPT_DPCON,
+	PROVISION_OPT_PARENT_DPRC,
+};
+
+static struct option dpio_provision_options[] = {
+	[PROVISION_OPT_HELP] = {
+		.name = "help",
+		.has_arg = 0,
+		.flag = NULL,
+		.val = 0,
+	},
+
+	[PROVISION_OPT_PER_CPU] = {
+		.name = "per-cpu",
+		.has_arg = 0,
+		.flag = NULL,
+		.val = 0,
+	},
+
+	[PROVISION_OPT_CPUS] = {
+		.name = "cpus",
+		.has_arg = 1,
+		.flag = NULL,
+		.val = 0,
+	},
+
+	[PROVISION_OPT_NUM_PRIORITIES] = {
+		.name = "num-priorities",
+		.has_arg = 1,
+		.flag = NULL,
+		.val = 0,
+	},
+
+	[PROVISION_OPT_DPCON] = {
+		.name = "dpcon",
+		.has_arg = 0,
+		.flag = NULL,
+		.val = 0,
+	},
+
+	[PROVISION_OPT_PARENT_DPRC] = {
+		.name = "container",
+		.has_arg = 1,
+		.flag = NULL,
+		.val = 0,
+	},
+
+	{ 0 },
+};
+
+C_ASSERT(ARRAY_SIZE(dpio_provision_options) <= MAX_NUM_CMD_LINE_OPTIONS + 1);
+
 /**
  * dpio destroy command options
  */
@@ -137,7 +199,7 @@ static struct option dpio_destroy_options[] = {
 
 C_ASSERT(ARRAY_SIZE(dpio_destroy_options) <= MAX_NUM_CMD_LINE_OPTIONS + 1);
 
-static const struct flib_ops dpio_ops = {
+const struct flib_ops dpio_ops = {
 	.obj_open = dpio_open,
 	.obj_close = dpio_close,
 	.obj_get_irq_mask = dpio_get_irq_mask,
@@ -153,6 +215,7 @@ static int cmd_dpio_help(void)
 		"   info - displays detailed information about a DPIO object.\n"
 		"   create - creates a new child DPIO under the root DPRC.\n"
 		"   destroy - destroys a child DPIO under the root DPRC.\n"
+		"   provision - creates one DPIO per host CPU core (MC 10.x only).\n"
 		"\n"
 		"For command-specific help, use the --help option of each command.\n"
 		"\n";
@@ -347,7 +410,7 @@ static int print_dpio_info(uint32_t dpio_id, int mc_fw_version)
 
 	if (restool.cmd_option_mask & ONE_BIT_MASK(INFO_OPT_VERBOSE)) {
 		restool.cmd_option_mask &= ~ONE_BIT_MASK(INFO_OPT_VERBOSE);
-		error = print_obj_verbose(&target_obj_desc, &dpio_ops);
+		error = print_obj_verbose(&target_obj_desc);
 	}
 
 out:
@@ -744,6 +807,436 @@ static int cmd_dpio_destroy_v10(void)
 	return destroy_dpio(MC_FW_VERSION_10);
 }
 
+/**
+ * Highest number of CPUs dpio provision handles
+ */
+#define MAX_PROVISION_CPUS	1024
+
+#define SYSFS_CPU_DIR		"/sys/devices/system/cpu"
+
+/*
+ * CPU list as written by sysfs and taken by --cpus: comma separated CPU
+ * numbers and <first>-<last> ranges
+ */
+static int parse_cpu_list(const char *list_str, bool *cpus)
+{
+	char *list, *range, *saveptr, *endptr;
+	long first, last;
+	int error = 0;
+
+	list = strdup(list_str);
+	if (list == NULL) {
+		ERROR_PRINTF("strdup() failed\n");
+		return -ENOMEM;
+	}
+
+	memset(cpus, 0, MAX_PROVISION_CPUS * sizeof(*cpus));
+	for (range = strtok_r(list, ",\n", &saveptr); range != NULL;
+	     range = strtok_r(NULL, ",\n", &saveptr)) {
+		errno = 0;
+		first = strtol(range, &endptr, 10);
+		last = first;
+		if (errno == 0 && endptr != range && *endptr == '-') {
+			const char *last_str = endptr + 1;
+
+			last = strtol(last_str, &endptr, 10);
+			if (endptr == last_str)
+				errno = EINVAL;
+		}
+
+		if (errno || endptr == range || *endptr != '\0' ||
+		    first < 0 || last >= MAX_PROVISION_CPUS || first > last) {
+			ERROR_PRINTF("Invalid CPU list: %s\n", list_str);
+			error = -EINVAL;
+			break;
+		}
+
+		for (long cpu = first; cpu <= last; cpu++)
+			cpus[cpu] = true;
+	}
+
+	free(list);
+	return error;
+}
+
+static int read_sysfs_cpu_list(const char *file_name, bool *cpus)
+{
+	char list[4096];
+	FILE *fp;
+	int error;
+
+	fp = fopen(file_name, "r");
+	if (fp == NULL) {
+		error = -errno;
+		ERROR_PRINTF("fopen(%s) failed: %s\n", file_name,
+			     strerror(errno));
+		return error;
+	}
+
+	if (fgets(list, sizeof(list), fp) == NULL) {
+		ERROR_PRINTF("Could not read %s\n", file_name);
+		error = -EIO;
+	} else {
+		error = parse_cpu_list(list, cpus);
+	}
+
+	fclose(fp);
+	return error;
+}
+
+/*
+ * CPUs to provision: the online ones of --cpus, or one per online core
+ * (the first hardware thread of each) when --cpus is not given
+ */
+static int get_provision_cpus(const char *cpus_str, bool *cpus)
+{
+	bool online[MAX_PROVISION_CPUS];
+	bool siblings[MAX_PROVISION_CPUS];
+	char file_name[128];
+	int error;
+
+	error = read_sysfs_cpu_list(SYSFS_CPU_DIR "/online", online);
+	if (error)
+		return error;
+
+	if (cpus_str != NULL) {
+		error = parse_cpu_list(cpus_str, cpus);
+		if (error)
+			return error;
+
+		for (int cpu = 0; cpu < MAX_PROVISION_CPUS; cpu++) {
+			if (cpus[cpu] && !online[cpu]) {
+				ERROR_PRINTF("CPU %d is not online\n", cpu);
+				return -EINVAL;
+			}
+		}
+		return 0;
+	}
+
+	memcpy(cpus, online, sizeof(online));
+	for (int cpu = 0; cpu < MAX_PROVISION_CPUS; cpu++) {
+		if (!cpus[cpu])
+			continue;
+
+		snprintf(file_name, sizeof(file_name),
+			 SYSFS_CPU_DIR "/cpu%d/topology/thread_siblings_list",
+			 cpu);
+		if (access(file_name, R_OK) != 0)
+			continue;
+
+		error = read_sysfs_cpu_list(file_name, siblings);
+		if (error)
+			return error;
+
+		for (int sibling = cpu + 1; sibling < MAX_PROVISION_CPUS;
+		     sibling++) {
+			if (siblings[sibling])
+				cpus[sibling] = false;
+		}
+	}
+
+	return 0;
+}
+
+/**
+ * Objects dpio provision created for a CPU
+ */
+struct cpu_portal {
+	int cpu;
+	uint32_t dpio_id;
+	uint32_t dpcon_id;
+	bool has_dpcon;
+};
+
+static void destroy_cpu_portals(uint16_t dprc_handle,
+				const struct cpu_portal *portals,
+				int num_portals)
+{
+	for (int i = 0; i < num_portals; i++) {
+		(void)dpio_destroy_v10(&restool.mc_io, dprc_handle, 0,
+				       portals[i].dpio_id);
+		if (portals[i].has_dpcon)
+			(void)dpcon_destroy_v10(&restool.mc_io, dprc_handle, 0,
+						portals[i].dpcon_id);
+	}
+}
+
+static int create_cpu_portal(uint16_t dprc_handle,
+			     const struct dpio_cfg_v10 *dpio_cfg,
+			     const struct dpcon_cfg_v10 *dpcon_cfg,
+			     struct cpu_portal *portal)
+{
+	char label[MC_OBJ_LABEL_MAX_LENGTH + 1];
+	int error;
+
+	snprintf(label, sizeof(label), "cpu%d", portal->cpu);
+
+	error = dpio_create_v10(&restool.mc_io, dprc_handle, 0, dpio_cfg,
+				&portal->dpio_id);
+	if (error)
+		return error;
+
+	error = dprc_set_obj_label(&restool.mc_io, 0, dprc_handle, "dpio",
+				   portal->dpio_id, label);
+	if (error || dpcon_cfg == NULL)
+		goto out;
+
+	error = dpcon_create_v10(&restool.mc_io, dprc_handle, 0, dpcon_cfg,
+				 &portal->dpcon_id);
+	if (error)
+		goto out;
+	portal->has_dpcon = true;
+
+	error = dprc_set_obj_label(&restool.mc_io, 0, dprc_handle, "dpcon",
+				   portal->dpcon_id, label);
+
+out:
+	/* a CPU gets all of its objects or none of them */
+	if (error)
+		destroy_cpu_portals(dprc_handle, portal, 1);
+
+	return error;
+}
+
+static int plug_provision_obj(uint32_t dprc_id, uint16_t dprc_handle,
+			      const char *obj_type, uint32_t obj_id)
+{
+	struct dprc_res_req res_req;
+	int error;
+
+	memset(&res_req, 0, sizeof(res_req));
+	strcpy(res_req.type, obj_type);
+	res_req.num = 1;
+	res_req.options = DPRC_RES_REQ_OPT_EXPLICIT | DPRC_RES_REQ_OPT_PLUGGED;
+	res_req.id_base_align = obj_id;
+
+	error = dprc_assign(&restool.mc_io, 0, dprc_handle, dprc_id, &res_req);
+	if (error) {
+		mc_status = flib_error_to_mc_status(error);
+		ERROR_PRINTF("%s.%u: MC error: %s (status %#x)\n",
+			     obj_type, obj_id, mc_status_to_string(mc_status),
+			     mc_status);
+	}
+
+	return error;
+}
+
+/*
+ * Plugs the objects once all CPUs have theirs, so that a failed CPU
+ * never leaves objects behind that a driver has already bound. A DPCON
+ * goes first, its DPIO's driver may look for it.
+ */
+static int plug_cpu_portals(uint32_t dprc_id, uint16_t dprc_handle,
+			    const struct cpu_portal *portals, int num_portals)
+{
+	int error = 0;
+
+	for (int i = 0; i < num_portals && error == 0; i++) {
+		if (portals[i].has_dpcon)
+			error = plug_provision_obj(dprc_id, dprc_handle,
+						   "dpcon",
+						   portals[i].dpcon_id);
+		if (error == 0)
+			error = plug_provision_obj(dprc_id, dprc_handle,
+						   "dpio", portals[i].dpio_id);
+	}
+
+	if (error)
+		ERROR_PRINTF("The portals are created, the ones not plugged yet are left unplugged\n");
+
+	return error;
+}
+
+static void print_cpu_portals(uint32_t dprc_id,
+			      const struct cpu_portal *portals,
+			      int num_portals)
+{
+	printf("{\n");
+	printf("\t\"container\": \"dprc.%u\",\n", dprc_id);
+	printf("\t\"portals\": [\n");
+	for (int i = 0; i < num_portals; i++) {
+		printf("\t\t{ \"cpu\": %d, \"dpio\": \"dpio.%u\"",
+		       portals[i].cpu, portals[i].dpio_id);
+		if (portals[i].has_dpcon)
+			printf(", \"dpcon\": \"dpcon.%u\"", portals[i].dpcon_id);
+		printf(" }%s\n", i + 1 < num_portals ? "," : "");
+	}
+	printf("\t]\n");
+	printf("}\n");
+}
+
+/*
+ * Creates the DPIOs (and DPCONs) of all the CPUs with the container
+ * opened once, then plugs them; on a create failure, the objects created
+ * so far are destroyed
+ */
+static int provision_dpios(uint32_t dprc_id, const bool *cpus,
+			   const struct dpio_cfg_v10 *dpio_cfg,
+			   const struct dpcon_cfg_v10 *dpcon_cfg)
+{
+	struct cpu_portal *portals;
+	int num_portals = 0;
+	uint16_t dprc_handle;
+	int error = 0;
+	int error2;
+
+	portals = calloc(MAX_PROVISION_CPUS, sizeof(*portals));
+	if (portals == NULL) {
+		ERROR_PRINTF("Could not alloc memory!\n");
+		return -ENOMEM;
+	}
+
+	dprc_handle = restool.root_dprc_handle;
+	if (dprc_id != restool.root_dprc_id) {
+		error = open_dprc(dprc_id, &dprc_handle);
+		if (error)
+			goto out;
+	}
+
+	for (int cpu = 0; cpu < MAX_PROVISION_CPUS; cpu++) {
+		if (!cpus[cpu])
+			continue;
+
+		portals[num_portals].cpu = cpu;
+		error = create_cpu_portal(dprc_handle, dpio_cfg, dpcon_cfg,
+					  &portals[num_portals]);
+		if (error) {
+			mc_status = flib_error_to_mc_status(error);
+			ERROR_PRINTF("CPU %d: MC error: %s (status %#x)\n",
+				     cpu, mc_status_to_string(mc_status),
+				     mc_status);
+			destroy_cpu_portals(dprc_handle, portals, num_portals);
+			break;
+		}
+		num_portals++;
+	}
+
+	/* the portals are listed even if some were left unplugged */
+	if (error == 0) {
+		error = plug_cpu_portals(dprc_id, dprc_handle, portals,
+					 num_portals);
+		print_cpu_portals(dprc_id, portals, num_portals);
+	}
+
+	if (dprc_id != restool.root_dprc_id) {
+		error2 = dprc_close(&restool.mc_io, 0, dprc_handle);
+		if (error2) {
+			mc_status = flib_error_to_mc_status(error2);
+			ERROR_PRINTF("MC error: %s (status %#x)\n",
+				     mc_status_to_string(mc_status), mc_status);
+			if (error == 0)
+				error = error2;
+		}
+	}
+out:
+	free(portals);
+	return error;
+}
+
+static int cmd_dpio_provision(void)
+{
+	static const char usage_msg[] =
+		"\n"
+		"Usage: restool dpio provision --per-cpu [OPTIONS]\n"
+		"\n"
+		"--per-cpu\n"
+		"   Create one DPIO per CPU, labeled cpu<N>.\n"
+		"\n"
+		"OPTIONS:\n"
+		"--cpus=<cpu-list>\n"
+		"   CPUs to provision, e.g. 0-3,6. Default is one CPU per online\n"
+		"   core, as found in " SYSFS_CPU_DIR ".\n"
+		"--num-priorities=<number>\n"
+		"   Priorities of the DPIO (and DPCON) channels, 1-8. Default is 8.\n"
+		"--dpcon\n"
+		"   Also create one DPCON per CPU, labeled like its DPIO.\n"
+		"--container=<container-name>\n"
+		"   Specifies the parent container name. e.g. dprc.2, dprc.3 etc.\n"
+		"   If it is not specified, the objects are created under the default dprc.\n"
+		"\n"
+		"The objects of all the CPUs are created with the container opened\n"
+		"once; if one of them fails, those already created are destroyed.\n"
+		"Once all are created, they are plugged.\n"
+		"The CPU to object map is printed as JSON.\n"
+		"\n"
+		"EXAMPLE:\n"
+		"Create a DPIO and a DPCON per core of the host in dprc.2:\n"
+		"   $ restool dpio provision --per-cpu --dpcon --container=dprc.2\n"
+		"\n";
+
+	struct dpcon_cfg_v10 dpcon_cfg;
+	struct dpio_cfg_v10 dpio_cfg;
+	bool cpus[MAX_PROVISION_CPUS];
+	const char *cpus_str = NULL;
+	bool with_dpcon = false;
+	uint32_t dprc_id;
+	int error;
+	long val;
+
+	if (restool.cmd_option_mask & ONE_BIT_MASK(PROVISION_OPT_HELP)) {
+		puts(usage_msg);
+		restool.cmd_option_mask &= ~ONE_BIT_MASK(PROVISION_OPT_HELP);
+		return 0;
+	}
+
+	if (restool.obj_name != NULL) {
+		ERROR_PRINTF("Unexpected argument: \'%s\'\n\n",
+			     restool.obj_name);
+		puts(usage_msg);
+		return -EINVAL;
+	}
+
+	if (!(restool.cmd_option_mask & ONE_BIT_MASK(PROVISION_OPT_PER_CPU))) {
+		ERROR_PRINTF("--per-cpu option missing\n");
+		puts(usage_msg);
+		return -EINVAL;
+	}
+	restool.cmd_option_mask &= ~ONE_BIT_MASK(PROVISION_OPT_PER_CPU);
+
+	if (restool.cmd_option_mask & ONE_BIT_MASK(PROVISION_OPT_CPUS)) {
+		restool.cmd_option_mask &= ~ONE_BIT_MASK(PROVISION_OPT_CPUS);
+		cpus_str = restool.cmd_option_args[PROVISION_OPT_CPUS];
+	}
+
+	dpio_cfg.channel_mode = DPIO_LOCAL_CHANNEL;
+	dpio_cfg.num_priorities = 8;
+	if (restool.cmd_option_mask &
+	    ONE_BIT_MASK(PROVISION_OPT_NUM_PRIORITIES)) {
+		restool.cmd_option_mask &=
+			~ONE_BIT_MASK(PROVISION_OPT_NUM_PRIORITIES);
+		error = get_option_value(PROVISION_OPT_NUM_PRIORITIES, &val,
+					 "Invalid value: num-priorities option",
+					 1, 8);
+		if (error)
+			return -EINVAL;
+		dpio_cfg.num_priorities = (uint8_t)val;
+	}
+	dpcon_cfg.num_priorities = dpio_cfg.num_priorities;
+
+	if (restool.cmd_option_mask & ONE_BIT_MASK(PROVISION_OPT_DPCON)) {
+		restool.cmd_option_mask &= ~ONE_BIT_MASK(PROVISION_OPT_DPCON);
+		with_dpcon = true;
+	}
+
+	dprc_id = restool.root_dprc_id;
+	if (restool.cmd_option_mask & ONE_BIT_MASK(PROVISION_OPT_PARENT_DPRC)) {
+		restool.cmd_option_mask &=
+			~ONE_BIT_MASK(PROVISION_OPT_PARENT_DPRC);
+		error = parse_object_name(
+				restool.cmd_option_args[PROVISION_OPT_PARENT_DPRC],
+				"dprc", &dprc_id);
+		if (error)
+			return error;
+	}
+
+	error = get_provision_cpus(cpus_str, cpus);
+	if (error)
+		return error;
+
+	return provision_dpios(dprc_id, cpus, &dpio_cfg,
+			       with_dpcon ? &dpcon_cfg : NULL);
+}
+
 struct object_command dpio_commands_v9[] = {
 	{ .cmd_name = "help",
 	  .options = NULL,
@@ -781,6 +1274,10 @@ struct object_command dpio_commands_v10[] = {
 	  .options = dpio_destroy_options,
 	  .cmd_func = cmd_dpio_destroy_v10 },
 
+	{ .cmd_name = "provision",
+	  .options = dpio_provision_options,
+	  .cmd_func = cmd_dpio_provision },
+
 	{ .cmd_name = NULL },
 };
 
@@ -129,7 +129,7 @@ static struct option dpmac_destroy_options[] = {
 
 C_ASSERT(ARRAY_SIZE(dpmac_destroy_options) <= MAX_NUM_CMD_LINE_OPTIONS + 1);
 
-static const struct flib_ops dpmac_ops = {
+const struct flib_ops dpmac_ops = {
 	.obj_open = dpmac_open,
 	.obj_close = dpmac_close,
 	.obj_get_irq_mask = dpmac_get_irq_mask,
@@ -168,9 +168,7 @@ static int print_dpmac_endpoint(uint32_t target_id)
 	endpoint1.id = target_id;
 	endpoint1.if_id = 0;
 
-	error = dprc_get_connection(&restool.mc_io, 0,
-					restool.root_dprc_handle,
-					&endpoint1, &endpoint2, &state);
+	error = get_connection(&endpoint1, &endpoint2, &state);
 	printf("endpoint state: %d\n", state);
 
 	if (error == 0 && state == -1) {
@@ -432,7 +430,7 @@ static int print_dpmac_info(uint32_t dpmac_id, int mc_fw_version)
 
 	if (restool.cmd_option_mask & ONE_BIT_MASK(INFO_OPT_VERBOSE)) {
 		restool.cmd_option_mask &= ~ONE_BIT_MASK(INFO_OPT_VERBOSE);
-		error = print_obj_verbose(&target_obj_desc, &dpmac_ops);
+		error = print_obj_verbose(&target_obj_desc);
 	}
 
 out:
@@ -121,7 +121,7 @@ static struct option dpmcp_destroy_options[] = {
 
 C_ASSERT(ARRAY_SIZE(dpmcp_destroy_options) <= MAX_NUM_CMD_LINE_OPTIONS + 1);
 
-static const struct flib_ops dpmcp_ops = {
+const struct flib_ops dpmcp_ops = {
 	.obj_open = dpmcp_open,
 	.obj_close = dpmcp_close,
 	.obj_get_irq_mask = dpmcp_get_irq_mask,
@@ -305,7 +305,7 @@ static int print_dpmcp_info(uint32_t dpmcp_id, int mc_fw_version)
 
 	if (restool.cmd_option_mask & ONE_BIT_MASK(INFO_OPT_VERBOSE)) {
 		restool.cmd_option_mask &= ~ONE_BIT_MASK(INFO_OPT_VERBOSE);
-		error = print_obj_verbose(&target_obj_desc, &dpmcp_ops);
+		error = print_obj_verbose(&target_obj_desc);
 	}
 
 out:
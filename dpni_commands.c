@@ -37,11 +37,14 @@
 #include <errno.h>
 #include <assert.h>
 #include <getopt.h>
+#include <unistd.h>
 #include <sys/ioctl.h>
 #include "restool.h"
 #include "utils.h"
 #include "mc_v9/fsl_dpni.h"
 #include "mc_v10/fsl_dpni.h"
+#include "dpni_commands_classify.h"
+#include "dpni_commands_congestion.h"
 
 #define ALL_DPNI_OPTS (					\
 	DPNI_OPT_ALLOW_DIST_KEY_PER_TC |		\
@@ -78,6 +81,11 @@ enum mc_cmd_status mc_status;
  */
 #define MAX_DIST_SIZE	1024
 
+/**
+ * Maximum num_queues of a v10 DPNI
+ */
+#define MAX_NUM_QUEUES_V10	8
+
 struct dpni_config {
 	struct dpni_extended_cfg dpni_extended_cfg;
 	struct dpni_cfg_v9 dpni_cfg;
@@ -99,6 +107,7 @@ struct dpni_config {
 enum dpni_info_options {
 	INFO_OPT_HELP = 0,
 	INFO_OPT_VERBOSE,
+	INFO_OPT_CONFIG,
 };
 
 static struct option dpni_info_options[] = {
@@ -116,6 +125,13 @@ static struct option dpni_info_options[] = {
 		.val = 0,
 	},
 
+	[INFO_OPT_CONFIG] = {
+		.name = "config",
+		.has_arg = 0,
+		.flag = NULL,
+		.val = 0,
+	},
+
 	{ 0 },
 };
 
@@ -147,6 +163,8 @@ enum dpni_create_options {
 	CREATE_OPT_PARENT_DPRC,
 	CREATE_OPT_MAC_FILTER_ENTRIES,
 	CREATE_OPT_VLAN_FILTER_ENTRIES,
+	CREATE_OPT_PROFILE,
+	CREATE_OPT_DRY_RUN,
 };
 
 static struct option dpni_create_options[] = {
@@ -304,6 +322,20 @@ static struct option dpni_create_options[] = {
 		.val = 0,
 	},
 
+	[CREATE_OPT_PROFILE] = {
+		.name = "profile",
+		.has_arg = 1,
+		.flag = NULL,
+		.val = 0,
+	},
+
+	[CREATE_OPT_DRY_RUN] = {
+		.name = "dry-run",
+		.has_arg = 0,
+		.flag = NULL,
+		.val = 0,
+	},
+
 	{ 0 },
 };
 
@@ -332,6 +364,12 @@ C_ASSERT(ARRAY_SIZE(dpni_destroy_options) <= MAX_NUM_CMD_LINE_OPTIONS + 1);
 enum dpni_update_options_v10 {
 	UPDATE_OPT_HELP = 0,
 	UPDATE_MAC_ADDR,
+	UPDATE_MAX_FRAME_LENGTH,
+	UPDATE_RX_BUFFER_LAYOUT,
+	UPDATE_TX_BUFFER_LAYOUT,
+	UPDATE_TX_CONF_BUFFER_LAYOUT,
+	UPDATE_PAUSE,
+	UPDATE_PFC,
 };
 
 static struct option dpni_update_options_v10[] = {
@@ -349,12 +387,397 @@ static struct option dpni_update_options_v10[] = {
 		.val = 0,
 	},
 
+	[UPDATE_MAX_FRAME_LENGTH] = {
+		.name = "max-frame-length",
+		.has_arg = 1,
+		.flag = NULL,
+		.val = 0,
+	},
+
+	[UPDATE_RX_BUFFER_LAYOUT] = {
+		.name = "rx-buffer-layout",
+		.has_arg = 1,
+		.flag = NULL,
+		.val = 0,
+	},
+
+	[UPDATE_TX_BUFFER_LAYOUT] = {
+		.name = "tx-buffer-layout",
+		.has_arg = 1,
+		.flag = NULL,
+		.val = 0,
+	},
+
+	[UPDATE_TX_CONF_BUFFER_LAYOUT] = {
+		.name = "tx-conf-buffer-layout",
+		.has_arg = 1,
+		.flag = NULL,
+		.val = 0,
+	},
+
+	[UPDATE_PAUSE] = {
+		.name = "pause",
+		.has_arg = 1,
+		.flag = NULL,
+		.val = 0,
+	},
+
+	[UPDATE_PFC] = {
+		.name = "pfc",
+		.has_arg = 1,
+		.flag = NULL,
+		.val = 0,
+	},
+
 	{ 0 },
 };
 
 C_ASSERT(ARRAY_SIZE(dpni_update_options_v10) <= MAX_NUM_CMD_LINE_OPTIONS + 1);
 
-static const struct flib_ops dpni_ops = {
+/**
+ * dpni set-dist command options
+ */
+enum dpni_set_dist_options {
+	SET_DIST_OPT_HELP = 0,
+	SET_DIST_OPT_TC,
+	SET_DIST_OPT_DIST_SIZE,
+	SET_DIST_OPT_KEY,
+	SET_DIST_OPT_MODE,
+	SET_DIST_OPT_DEFAULT_FLOW,
+};
+
+static struct option dpni_set_dist_options[] = {
+	[SET_DIST_OPT_HELP] = {
+		.name = "help",
+	},
+
+	[SET_DIST_OPT_TC] = {
+		.name = "tc",
+		.has_arg = 1,
+	},
+
+	[SET_DIST_OPT_DIST_SIZE] = {
+		.name = "dist-size",
+		.has_arg = 1,
+	},
+
+	[SET_DIST_OPT_KEY] = {
+		.name = "key",
+		.has_arg = 1,
+	},
+
+	[SET_DIST_OPT_MODE] = {
+		.name = "mode",
+		.has_arg = 1,
+	},
+
+	[SET_DIST_OPT_DEFAULT_FLOW] = {
+		.name = "default-flow",
+		.has_arg = 1,
+	},
+
+	{ 0 },
+};
+
+C_ASSERT(ARRAY_SIZE(dpni_set_dist_options) <= MAX_NUM_CMD_LINE_OPTIONS + 1);
+
+/**
+ * dpni set-qos command options
+ */
+enum dpni_set_qos_options {
+	SET_QOS_OPT_HELP = 0,
+	SET_QOS_OPT_KEY,
+	SET_QOS_OPT_DEFAULT_TC,
+	SET_QOS_OPT_DISCARD,
+};
+
+static struct option dpni_set_qos_options[] = {
+	[SET_QOS_OPT_HELP] = {
+		.name = "help",
+	},
+
+	[SET_QOS_OPT_KEY] = {
+		.name = "key",
+		.has_arg = 1,
+	},
+
+	[SET_QOS_OPT_DEFAULT_TC] = {
+		.name = "default-tc",
+		.has_arg = 1,
+	},
+
+	[SET_QOS_OPT_DISCARD] = {
+		.name = "discard",
+	},
+
+	{ 0 },
+};
+
+C_ASSERT(ARRAY_SIZE(dpni_set_qos_options) <= MAX_NUM_CMD_LINE_OPTIONS + 1);
+
+/**
+ * dpni fs-add, fs-del, qos-add and qos-del command options
+ */
+enum dpni_rule_options {
+	RULE_OPT_HELP = 0,
+	RULE_OPT_KEY,
+	RULE_OPT_RULE,
+	RULE_OPT_FILE,
+	RULE_OPT_TC,
+	RULE_OPT_FLOW,
+	RULE_OPT_INDEX,
+};
+
+static struct option dpni_rule_options[] = {
+	[RULE_OPT_HELP] = {
+		.name = "help",
+	},
+
+	[RULE_OPT_KEY] = {
+		.name = "key",
+		.has_arg = 1,
+	},
+
+	[RULE_OPT_RULE] = {
+		.name = "rule",
+		.has_arg = 1,
+	},
+
+	[RULE_OPT_FILE] = {
+		.name = "file",
+		.has_arg = 1,
+	},
+
+	[RULE_OPT_TC] = {
+		.name = "tc",
+		.has_arg = 1,
+	},
+
+	[RULE_OPT_FLOW] = {
+		.name = "flow",
+		.has_arg = 1,
+	},
+
+	[RULE_OPT_INDEX] = {
+		.name = "index",
+		.has_arg = 1,
+	},
+
+	{ 0 },
+};
+
+C_ASSERT(ARRAY_SIZE(dpni_rule_options) <= MAX_NUM_CMD_LINE_OPTIONS + 1);
+
+/**
+ * dpni fs-clear and qos-clear command options
+ */
+enum dpni_clear_options {
+	CLEAR_OPT_HELP = 0,
+	CLEAR_OPT_TC,
+};
+
+static struct option dpni_clear_options[] = {
+	[CLEAR_OPT_HELP] = {
+		.name = "help",
+	},
+
+	[CLEAR_OPT_TC] = {
+		.name = "tc",
+		.has_arg = 1,
+	},
+
+	{ 0 },
+};
+
+C_ASSERT(ARRAY_SIZE(dpni_clear_options) <= MAX_NUM_CMD_LINE_OPTIONS + 1);
+
+/**
+ * dpni taildrop-set command options
+ */
+enum dpni_taildrop_set_options {
+	TAILDROP_SET_OPT_HELP = 0,
+	TAILDROP_SET_OPT_LEVEL,
+	TAILDROP_SET_OPT_TC,
+	TAILDROP_SET_OPT_QUEUE,
+	TAILDROP_SET_OPT_THRESHOLD,
+	TAILDROP_SET_OPT_UNITS,
+	TAILDROP_SET_OPT_DISABLE,
+};
+
+static struct option dpni_taildrop_set_options[] = {
+	[TAILDROP_SET_OPT_HELP] = {
+		.name = "help",
+	},
+
+	[TAILDROP_SET_OPT_LEVEL] = {
+		.name = "level",
+		.has_arg = 1,
+	},
+
+	[TAILDROP_SET_OPT_TC] = {
+		.name = "tc",
+		.has_arg = 1,
+	},
+
+	[TAILDROP_SET_OPT_QUEUE] = {
+		.name = "queue",
+		.has_arg = 1,
+	},
+
+	[TAILDROP_SET_OPT_THRESHOLD] = {
+		.name = "threshold",
+		.has_arg = 1,
+	},
+
+	[TAILDROP_SET_OPT_UNITS] = {
+		.name = "units",
+		.has_arg = 1,
+	},
+
+	[TAILDROP_SET_OPT_DISABLE] = {
+		.name = "disable",
+	},
+
+	{ 0 },
+};
+
+C_ASSERT(ARRAY_SIZE(dpni_taildrop_set_options) <= MAX_NUM_CMD_LINE_OPTIONS + 1);
+
+/**
+ * dpni taildrop-get command options
+ */
+enum dpni_taildrop_get_options {
+	TAILDROP_GET_OPT_HELP = 0,
+	TAILDROP_GET_OPT_LEVEL,
+};
+
+static struct option dpni_taildrop_get_options[] = {
+	[TAILDROP_GET_OPT_HELP] = {
+		.name = "help",
+	},
+
+	[TAILDROP_GET_OPT_LEVEL] = {
+		.name = "level",
+		.has_arg = 1,
+	},
+
+	{ 0 },
+};
+
+C_ASSERT(ARRAY_SIZE(dpni_taildrop_get_options) <= MAX_NUM_CMD_LINE_OPTIONS + 1);
+
+/**
+ * dpni congestion-set command options
+ */
+enum dpni_congestion_set_options {
+	CONGESTION_SET_OPT_HELP = 0,
+	CONGESTION_SET_OPT_QTYPE,
+	CONGESTION_SET_OPT_TC,
+	CONGESTION_SET_OPT_ENTRY,
+	CONGESTION_SET_OPT_EXIT,
+	CONGESTION_SET_OPT_UNITS,
+	CONGESTION_SET_OPT_DEST,
+	CONGESTION_SET_OPT_PRIORITY,
+	CONGESTION_SET_OPT_FLOW_CONTROL,
+	CONGESTION_SET_OPT_DISABLE,
+};
+
+static struct option dpni_congestion_set_options[] = {
+	[CONGESTION_SET_OPT_HELP] = {
+		.name = "help",
+	},
+
+	[CONGESTION_SET_OPT_QTYPE] = {
+		.name = "qtype",
+		.has_arg = 1,
+	},
+
+	[CONGESTION_SET_OPT_TC] = {
+		.name = "tc",
+		.has_arg = 1,
+	},
+
+	[CONGESTION_SET_OPT_ENTRY] = {
+		.name = "entry",
+		.has_arg = 1,
+	},
+
+	[CONGESTION_SET_OPT_EXIT] = {
+		.name = "exit",
+		.has_arg = 1,
+	},
+
+	[CONGESTION_SET_OPT_UNITS] = {
+		.name = "units",
+		.has_arg = 1,
+	},
+
+	[CONGESTION_SET_OPT_DEST] = {
+		.name = "dest",
+		.has_arg = 1,
+	},
+
+	[CONGESTION_SET_OPT_PRIORITY] = {
+		.name = "priority",
+		.has_arg = 1,
+	},
+
+	[CONGESTION_SET_OPT_FLOW_CONTROL] = {
+		.name = "flow-control",
+	},
+
+	[CONGESTION_SET_OPT_DISABLE] = {
+		.name = "disable",
+	},
+
+	{ 0 },
+};
+
+C_ASSERT(ARRAY_SIZE(dpni_congestion_set_options) <=
+	 MAX_NUM_CMD_LINE_OPTIONS + 1);
+
+/**
+ * dpni congestion-get command options
+ */
+enum dpni_congestion_get_options {
+	CONGESTION_GET_OPT_HELP = 0,
+	CONGESTION_GET_OPT_QTYPE,
+};
+
+static struct option dpni_congestion_get_options[] = {
+	[CONGESTION_GET_OPT_HELP] = {
+		.name = "help",
+	},
+
+	[CONGESTION_GET_OPT_QTYPE] = {
+		.name = "qtype",
+		.has_arg = 1,
+	},
+
+	{ 0 },
+};
+
+C_ASSERT(ARRAY_SIZE(dpni_congestion_get_options) <=
+	 MAX_NUM_CMD_LINE_OPTIONS + 1);
+
+/**
+ * dpni queues command options
+ */
+enum dpni_queues_options {
+	QUEUES_OPT_HELP = 0,
+};
+
+static struct option dpni_queues_options[] = {
+	[QUEUES_OPT_HELP] = {
+		.name = "help",
+	},
+
+	{ 0 },
+};
+
+C_ASSERT(ARRAY_SIZE(dpni_queues_options) <= MAX_NUM_CMD_LINE_OPTIONS + 1);
+
+const struct flib_ops dpni_ops = {
 	.obj_open = dpni_open,
 	.obj_close = dpni_close,
 	.obj_get_irq_mask = dpni_get_irq_mask,
@@ -454,6 +877,13 @@ static int cmd_dpni_help_v10(void)
 		"   create - creates a new child DPNI under the root DPRC.\n"
 		"   destroy - destroys a child DPNI under the root DPRC.\n"
 		"   update - update attributes of already created DPNI.\n"
+		"   set-dist - sets the hash distribution of a Rx traffic class.\n"
+		"   set-qos - sets the key of the QoS table.\n"
+		"   fs-add, fs-del, fs-clear - manage flow steering entries.\n"
+		"   qos-add, qos-del, qos-clear - manage QoS table entries.\n"
+		"   taildrop-set, taildrop-get - manage Rx taildrop thresholds.\n"
+		"   congestion-set, congestion-get - manage congestion notification.\n"
+		"   queues - lists the queues of a DPNI.\n"
 		"\n"
 		"For command-specific help, use the --help option of each command.\n"
 		"\n";
@@ -558,9 +988,7 @@ static int print_dpni_endpoint(uint32_t target_id)
 	endpoint1.id = target_id;
 	endpoint1.if_id = 0;
 
-	error = dprc_get_connection(&restool.mc_io, 0,
-					restool.root_dprc_handle,
-					&endpoint1, &endpoint2, &state);
+	error = get_connection(&endpoint1, &endpoint2, &state);
 	printf("endpoint state: %d\n", state);
 
 	if (error == 0 && state == -1) {
@@ -871,19 +1299,126 @@ out:
 	return error;
 }
 
-static int print_dpni_info(uint32_t dpni_id, int mc_fw_version)
+/**
+ * Buffer layouts shown by dpni info --config and set by dpni update
+ */
+static const struct {
+	enum dpni_queue_type qtype;
+	const char *name;
+} dpni_layout_qtypes[] = {
+	{ DPNI_QUEUE_RX, "rx" },
+	{ DPNI_QUEUE_TX, "tx" },
+	{ DPNI_QUEUE_TX_CONFIRM, "tx-conf" },
+};
+
+/*
+ * Rx and Tx pause as reported by the link options: PAUSE enables both
+ * directions, ASYM_PAUSE turns off the Tx one (or, alone, enables it)
+ */
+static const char *pause_to_string(uint64_t link_options)
 {
-	int error;
-	struct dprc_obj_desc target_obj_desc;
-	uint32_t target_parent_dprc_id;
-	bool found = false;
+	bool rx_pause = link_options & DPNI_LINK_OPT_PAUSE;
+	bool tx_pause = rx_pause ^ !!(link_options & DPNI_LINK_OPT_ASYM_PAUSE);
+
+	if (rx_pause && tx_pause)
+		return "on";
+	if (rx_pause)
+		return "rx";
+	if (tx_pause)
+		return "tx";
+	return "off";
+}
 
-	memset(&target_obj_desc, 0, sizeof(struct dprc_obj_desc));
-	error = find_target_obj_desc(restool.root_dprc_id,
-				restool.root_dprc_handle, 0, dpni_id,
-				"dpni", &target_obj_desc,
-				&target_parent_dprc_id, &found);
-	if (error < 0)
+static int print_dpni_config_v10(uint32_t dpni_id)
+{
+	struct dpni_link_state_v10 link_state;
+	struct dpni_buffer_layout layout;
+	uint16_t max_frame_length;
+	uint16_t dpni_handle;
+	int error, error2;
+
+	error = dpni_open_v10(&restool.mc_io, 0, dpni_id, &dpni_handle);
+	if (error < 0) {
+		mc_status = flib_error_to_mc_status(error);
+		ERROR_PRINTF("MC error: %s (status %#x)\n",
+			     mc_status_to_string(mc_status), mc_status);
+		return error;
+	}
+
+	error = dpni_get_max_frame_length_v10(&restool.mc_io, 0, dpni_handle,
+					      &max_frame_length);
+	if (error < 0)
+		goto mc_error;
+
+	printf("max frame length: %u\n", (uint32_t)max_frame_length);
+
+	for (unsigned int i = 0; i < ARRAY_SIZE(dpni_layout_qtypes); i++) {
+		memset(&layout, 0, sizeof(layout));
+		error = dpni_get_buffer_layout_v10(&restool.mc_io, 0,
+						   dpni_handle,
+						   dpni_layout_qtypes[i].qtype,
+						   &layout);
+		if (error < 0)
+			goto mc_error;
+
+		printf("%s buffer layout:\n", dpni_layout_qtypes[i].name);
+		printf("\theadroom: %u\n", (uint32_t)layout.data_head_room);
+		printf("\ttailroom: %u\n", (uint32_t)layout.data_tail_room);
+		printf("\tprivate data size: %u\n",
+		       (uint32_t)layout.private_data_size);
+		printf("\tdata alignment: %u\n", (uint32_t)layout.data_align);
+		printf("\ttimestamp: %d\n", layout.pass_timestamp);
+		printf("\tparser result: %d\n", layout.pass_parser_result);
+		printf("\tframe status: %d\n", layout.pass_frame_status);
+	}
+
+	memset(&link_state, 0, sizeof(link_state));
+	error = dpni_get_link_state_v10(&restool.mc_io, 0, dpni_handle,
+					&link_state);
+	if (error < 0)
+		goto mc_error;
+
+	printf("link rate: %u\n", link_state.rate);
+	printf("link autoneg: %s\n",
+	       link_state.options & DPNI_LINK_OPT_AUTONEG ? "on" : "off");
+	printf("link duplex: %s\n",
+	       link_state.options & DPNI_LINK_OPT_HALF_DUPLEX ?
+	       "half" : "full");
+	printf("pause: %s\n", pause_to_string(link_state.options));
+	printf("pfc: %s\n",
+	       link_state.options & DPNI_LINK_OPT_PFC_PAUSE ? "on" : "off");
+	goto out;
+
+mc_error:
+	mc_status = flib_error_to_mc_status(error);
+	ERROR_PRINTF("MC error: %s (status %#x)\n",
+		     mc_status_to_string(mc_status), mc_status);
+out:
+	error2 = dpni_close_v10(&restool.mc_io, 0, dpni_handle);
+	if (error2 < 0) {
+		mc_status = flib_error_to_mc_status(error2);
+		ERROR_PRINTF("MC error: %s (status %#x)\n",
+			     mc_status_to_string(mc_status), mc_status);
+		if (error == 0)
+			error = error2;
+	}
+
+	return error;
+}
+
+static int print_dpni_info(uint32_t dpni_id, int mc_fw_version)
+{
+	int error;
+	struct dprc_obj_desc target_obj_desc;
+	uint32_t target_parent_dprc_id;
+	bool found = false;
+
+	memset(&target_obj_desc, 0, sizeof(struct dprc_obj_desc));
+	error = find_target_obj_desc(restool.root_dprc_id,
+				restool.root_dprc_handle, 0, dpni_id,
+				"dpni", &target_obj_desc,
+				&target_parent_dprc_id, &found);
+	if (error < 0)
 		goto out;
 
 	if (strcmp(target_obj_desc.type, "dpni")) {
@@ -898,9 +1433,17 @@ static int print_dpni_info(uint32_t dpni_id, int mc_fw_version)
 	if (error < 0)
 		goto out;
 
+	if (mc_fw_version == MC_FW_VERSION_10 &&
+	    restool.cmd_option_mask & ONE_BIT_MASK(INFO_OPT_CONFIG)) {
+		restool.cmd_option_mask &= ~ONE_BIT_MASK(INFO_OPT_CONFIG);
+		error = print_dpni_config_v10(dpni_id);
+		if (error < 0)
+			goto out;
+	}
+
 	if (restool.cmd_option_mask & ONE_BIT_MASK(INFO_OPT_VERBOSE)) {
 		restool.cmd_option_mask &= ~ONE_BIT_MASK(INFO_OPT_VERBOSE);
-		error = print_obj_verbose(&target_obj_desc, &dpni_ops);
+		error = print_obj_verbose(&target_obj_desc);
 	}
 
 out:
@@ -911,11 +1454,14 @@ static int info_dpni(int mc_fw_version)
 {
 	static const char usage_msg[] =
 		"\n"
-		"Usage: restool dpni info <dpni-object> [--verbose]\n"
+		"Usage: restool dpni info <dpni-object> [--verbose] [--config]\n"
 		"\n"
 		"OPTIONS:\n"
 		"--verbose\n"
 		"   Shows extended/verbose information about the object\n"
+		"--config\n"
+		"   Shows the settings of dpni update: max frame length,\n"
+		"   buffer layouts, pause and PFC (MC 10.x only)\n"
 		"\n"
 		"EXAMPLE:\n"
 		"Display information about dpni.5:\n"
@@ -1379,12 +1925,133 @@ static int cmd_dpni_create_v9(void)
 	return create_dpni_v9(usage_msg);
 }
 
+/**
+ * DPNI configuration preset of dpni create --profile
+ */
+struct dpni_profile {
+	const char *name;
+	uint32_t options;
+
+	/**
+	 * 0 stands for the number of online host cores
+	 */
+	uint8_t num_queues;
+	uint8_t num_tcs;
+	uint16_t fs_entries;
+	uint8_t qos_entries;
+	uint8_t mac_filter_entries;
+	uint8_t vlan_filter_entries;
+};
+
+static const struct dpni_profile dpni_profiles[] = {
+	/*
+	 * A queue per core and no Tx confirmation: transmitted buffers go
+	 * straight back to the pool.
+	 */
+	{ "throughput", DPNI_OPT_TX_FRM_RELEASE, 0, 1, 64, 0, 16, 0 },
+	/*
+	 * A queue per core in each of 8 TCs, each TC having its own
+	 * congestion group so that a backed up TC does not stall the
+	 * others.
+	 */
+	{ "latency", DPNI_OPT_TX_FRM_RELEASE, 0, 8, 64, 64, 16, 0 },
+	/* The smallest footprint: one queue and no lookup tables */
+	{ "minimal", DPNI_OPT_NO_FS | DPNI_OPT_NO_MAC_FILTER, 1, 1, 0, 0, 0, 0 },
+	/*
+	 * The DPAA2 poll mode driver maps queues to its own lcores: all
+	 * queues and TCs, with VLAN filtering.
+	 */
+	{ "dpdk", 0, 8, 8, 64, 64, 16, 16 },
+};
+
+static uint8_t get_host_cores(void)
+{
+	long cores = sysconf(_SC_NPROCESSORS_ONLN);
+
+	if (cores < 1)
+		return 1;
+
+	return cores > MAX_NUM_QUEUES_V10 ? MAX_NUM_QUEUES_V10 : cores;
+}
+
+static int apply_dpni_profile(const char *name, struct dpni_cfg_v10 *cfg)
+{
+	const struct dpni_profile *profile = NULL;
+
+	for (unsigned int i = 0; i < ARRAY_SIZE(dpni_profiles); i++) {
+		if (strcmp(dpni_profiles[i].name, name) == 0) {
+			profile = &dpni_profiles[i];
+			break;
+		}
+	}
+
+	if (profile == NULL) {
+		ERROR_PRINTF("Invalid profile: %s\n", name);
+		return -EINVAL;
+	}
+
+	cfg->options = profile->options;
+	cfg->num_queues = profile->num_queues ? profile->num_queues :
+						get_host_cores();
+	cfg->num_tcs = profile->num_tcs;
+	cfg->fs_entries = profile->fs_entries;
+	cfg->qos_entries = profile->qos_entries;
+	cfg->mac_filter_entries = profile->mac_filter_entries;
+	cfg->vlan_filter_entries = profile->vlan_filter_entries;
+
+	return 0;
+}
+
+/*
+ * Prints cfg and what the MC allocates for it, with the MC defaults
+ * filled in for zeroed fields
+ */
+static void print_dpni_cfg_v10(const struct dpni_cfg_v10 *cfg)
+{
+	unsigned int num_queues = cfg->num_queues ? cfg->num_queues : 1;
+	unsigned int num_tcs = cfg->num_tcs ? cfg->num_tcs : 1;
+	unsigned int fs_entries, qos_entries, mac_entries;
+
+	fs_entries = cfg->options & DPNI_OPT_NO_FS ? 0 :
+		     cfg->fs_entries ? cfg->fs_entries : 64;
+	qos_entries = num_tcs == 1 ? 0 :
+		      cfg->qos_entries ? cfg->qos_entries : 64;
+	mac_entries = cfg->options & DPNI_OPT_NO_MAC_FILTER ? 0 :
+		      cfg->mac_filter_entries ? cfg->mac_filter_entries : 80;
+
+	printf("dpni_cfg.options value is: %#lx\n",
+	       (unsigned long)cfg->options);
+	print_dpni_options_v10(cfg->options);
+	printf("num_queues: %u\n", (uint32_t)cfg->num_queues);
+	printf("num_tcs: %u\n", (uint32_t)cfg->num_tcs);
+	printf("mac_filter_entries: %u\n", (uint32_t)cfg->mac_filter_entries);
+	printf("vlan_filter_entries: %u\n",
+	       (uint32_t)cfg->vlan_filter_entries);
+	printf("qos_entries: %u\n", (uint32_t)cfg->qos_entries);
+	printf("fs_entries: %u\n", (uint32_t)cfg->fs_entries);
+
+	printf("resources:\n");
+	printf("\trx queues: %u\n", num_queues * num_tcs);
+	printf("\ttx queues: %u\n", num_queues * num_tcs);
+	printf("\ttx confirmation queues: %u\n",
+	       cfg->options & DPNI_OPT_TX_FRM_RELEASE ? 0 : num_queues);
+	printf("\trx error queues: 1\n");
+	printf("\tcongestion groups: %u\n",
+	       cfg->options & DPNI_OPT_SHARED_CONGESTION ? 1 : num_tcs);
+	printf("\tflow steering entries: %u\n", fs_entries * num_tcs);
+	printf("\tqos entries: %u\n", qos_entries);
+	printf("\tmac filter entries: %u\n", mac_entries);
+	printf("\tvlan filter entries: %u\n",
+	       (uint32_t)cfg->vlan_filter_entries);
+}
+
 static int create_dpni_v10(const char *usage_msg)
 {
 	struct dpni_cfg_v10 dpni_cfg;
 	uint32_t dpni_id, dprc_id;
 	uint16_t dprc_handle;
 	bool dprc_opened;
+	bool dry_run = false;
 	long value;
 	int error;
 
@@ -1419,8 +2086,23 @@ static int create_dpni_v10(const char *usage_msg)
 		return -EINVAL;
 	}
 
+	if (restool.cmd_option_mask & ONE_BIT_MASK(CREATE_OPT_DRY_RUN)) {
+		restool.cmd_option_mask &= ~ONE_BIT_MASK(CREATE_OPT_DRY_RUN);
+		dry_run = true;
+	}
+
+	if (restool.cmd_option_mask & ONE_BIT_MASK(CREATE_OPT_PROFILE)) {
+		restool.cmd_option_mask &= ~ONE_BIT_MASK(CREATE_OPT_PROFILE);
+		error = apply_dpni_profile(
+				restool.cmd_option_args[CREATE_OPT_PROFILE],
+				&dpni_cfg);
+		if (error)
+			return error;
+	}
+
 	if (restool.cmd_option_mask & ONE_BIT_MASK(CREATE_OPT_OPTIONS)) {
 		restool.cmd_option_mask &= ~ONE_BIT_MASK(CREATE_OPT_OPTIONS);
+		dpni_cfg.options = 0;
 
 		if (restool.mc_fw_version.minor == 0)
 			error = parse_generic_create_options(
@@ -1524,7 +2206,7 @@ static int create_dpni_v10(const char *usage_msg)
 		if (error)
 			return error;
 
-		if (restool.root_dprc_id != dprc_id) {
+		if (restool.root_dprc_id != dprc_id && !dry_run) {
 			error = open_dprc(dprc_id, &dprc_handle);
 			if (error)
 				return error;
@@ -1532,6 +2214,11 @@ static int create_dpni_v10(const char *usage_msg)
 		}
 	}
 
+	if (dry_run) {
+		print_dpni_cfg_v10(&dpni_cfg);
+		return 0;
+	}
+
 	error = dpni_create_v10(&restool.mc_io, dprc_handle, 0,
 				&dpni_cfg, &dpni_id);
 	if (error) {
@@ -1551,6 +2238,20 @@ static int create_dpni_v10(const char *usage_msg)
 
 	return 0;
 }
+
+#define PROFILE_USAGE \
+	"--profile=<profile>\n" \
+	"   Starts from a preset, the other options overriding its values:\n" \
+	"	throughput - a queue per host core, no Tx confirmation.\n" \
+	"	latency - a queue per host core in each of 8 TCs, a\n" \
+	"		congestion group per TC, no Tx confirmation.\n" \
+	"	minimal - one queue, no flow steering or MAC filtering.\n" \
+	"	dpdk - 8 queues in each of 8 TCs, VLAN filtering.\n" \
+	"   --options replaces the option bits of the preset.\n" \
+	"--dry-run\n" \
+	"   Prints the DPNI configuration and the queues and table entries\n" \
+	"   it takes, without creating the DPNI.\n"
+
 static int cmd_dpni_create_v10(void)
 {
 	static const char usage_msg_v10_0[] =
@@ -1592,6 +2293,7 @@ static int cmd_dpni_create_v10(void)
 		"   Defaults to 64. Maximum value is 1024\n"
 		"--container=<container-name>\n"
 		"   Specifies the parent container name. e.g. dprc.2, dprc.3 etc.\n"
+		PROFILE_USAGE
 		"\n";
 
 	static const char usage_msg_v10_1[] =
@@ -1635,6 +2337,7 @@ static int cmd_dpni_create_v10(void)
 		"   Defaults to 64. Maximum value is 1024\n"
 		"--container=<container-name>\n"
 		"   Specifies the parent container name. e.g. dprc.2, dprc.3 etc.\n"
+		PROFILE_USAGE
 		"\n";
 
 	if (restool.mc_fw_version.minor == 0)
@@ -1794,17 +2497,211 @@ static int cmd_dpni_destroy_v10(void)
 	return destroy_dpni(MC_FW_VERSION_10);
 }
 
-static int update_dpni_v10(const char *usage_msg)
+/*
+ * Buffer layout of dpni update: comma separated <field>=<value> pairs,
+ * fields left out keep their value
+ */
+static int parse_dpni_buffer_layout(const char *layout_str,
+				    struct dpni_buffer_layout *layout)
+{
+	static const struct {
+		const char *name;
+		uint32_t option;
+		long max;
+	} fields[] = {
+		{ "headroom", DPNI_BUF_LAYOUT_OPT_DATA_HEAD_ROOM, UINT16_MAX },
+		{ "tailroom", DPNI_BUF_LAYOUT_OPT_DATA_TAIL_ROOM, UINT16_MAX },
+		{ "private", DPNI_BUF_LAYOUT_OPT_PRIVATE_DATA_SIZE, UINT16_MAX },
+		{ "align", DPNI_BUF_LAYOUT_OPT_DATA_ALIGN, UINT16_MAX },
+		{ "timestamp", DPNI_BUF_LAYOUT_OPT_TIMESTAMP, 1 },
+		{ "parser-result", DPNI_BUF_LAYOUT_OPT_PARSER_RESULT, 1 },
+		{ "frame-status", DPNI_BUF_LAYOUT_OPT_FRAME_STATUS, 1 },
+	};
+	char *fields_str, *field, *value, *saveptr, *endptr;
+	unsigned int i;
+	int error = 0;
+	long val;
+
+	fields_str = strdup(layout_str);
+	if (fields_str == NULL) {
+		ERROR_PRINTF("strdup() failed\n");
+		return -ENOMEM;
+	}
+
+	memset(layout, 0, sizeof(*layout));
+	for (field = strtok_r(fields_str, ",", &saveptr); field != NULL;
+	     field = strtok_r(NULL, ",", &saveptr)) {
+		value = strchr(field, '=');
+		if (value != NULL)
+			*value++ = '\0';
+
+		for (i = 0; i < ARRAY_SIZE(fields); i++) {
+			if (strcmp(fields[i].name, field) == 0)
+				break;
+		}
+
+		if (i == ARRAY_SIZE(fields) || value == NULL) {
+			ERROR_PRINTF("Invalid buffer layout field: %s\n",
+				     field);
+			error = -EINVAL;
+			break;
+		}
+
+		errno = 0;
+		val = strtol(value, &endptr, 0);
+		if (STRTOL_ERROR(value, endptr, val, errno) ||
+		    val < 0 || val > fields[i].max) {
+			ERROR_PRINTF("Invalid %s value: %s\n", field, value);
+			error = -EINVAL;
+			break;
+		}
+
+		layout->options |= fields[i].option;
+		switch (fields[i].option) {
+		case DPNI_BUF_LAYOUT_OPT_DATA_HEAD_ROOM:
+			layout->data_head_room = val;
+			break;
+		case DPNI_BUF_LAYOUT_OPT_DATA_TAIL_ROOM:
+			layout->data_tail_room = val;
+			break;
+		case DPNI_BUF_LAYOUT_OPT_PRIVATE_DATA_SIZE:
+			layout->private_data_size = val;
+			break;
+		case DPNI_BUF_LAYOUT_OPT_DATA_ALIGN:
+			layout->data_align = val;
+			break;
+		case DPNI_BUF_LAYOUT_OPT_TIMESTAMP:
+			layout->pass_timestamp = val;
+			break;
+		case DPNI_BUF_LAYOUT_OPT_PARSER_RESULT:
+			layout->pass_parser_result = val;
+			break;
+		case DPNI_BUF_LAYOUT_OPT_FRAME_STATUS:
+			layout->pass_frame_status = val;
+			break;
+		}
+	}
+
+	free(fields_str);
+	return error;
+}
+
+/*
+ * Inverse of pause_to_string(): the PAUSE and ASYM_PAUSE link options
+ * giving the requested Rx/Tx pause
+ */
+static int parse_dpni_pause(const char *pause, uint64_t *pause_options)
 {
+	if (strcmp(pause, "on") == 0) {
+		*pause_options = DPNI_LINK_OPT_PAUSE;
+	} else if (strcmp(pause, "rx") == 0) {
+		*pause_options = DPNI_LINK_OPT_PAUSE |
+				 DPNI_LINK_OPT_ASYM_PAUSE;
+	} else if (strcmp(pause, "tx") == 0) {
+		*pause_options = DPNI_LINK_OPT_ASYM_PAUSE;
+	} else if (strcmp(pause, "off") == 0) {
+		*pause_options = 0;
+	} else {
+		ERROR_PRINTF("Invalid pause value: %s\n", pause);
+		return -EINVAL;
+	}
+
+	return 0;
+}
+
+/**
+ * Settings of dpni update, all applied while the DPNI is open once
+ */
+struct dpni_update_cfg {
+	bool set_mac_addr;
 	uint8_t mac_addr[6];
+	bool set_max_frame_length;
+	uint16_t max_frame_length;
+
+	/**
+	 * layouts[i] applies to dpni_layout_qtypes[i] when options is
+	 * non-zero
+	 */
+	struct dpni_buffer_layout layouts[ARRAY_SIZE(dpni_layout_qtypes)];
+
+	/**
+	 * link options changed (mask) and their new value
+	 */
+	uint64_t link_options_mask;
+	uint64_t link_options;
+};
+
+static int apply_dpni_update_v10(uint16_t dpni_handle,
+				 const struct dpni_update_cfg *cfg)
+{
+	struct dpni_link_state_v10 link_state;
+	struct dpni_link_cfg link_cfg;
+	int error;
+
+	if (cfg->set_mac_addr) {
+		error = dpni_set_primary_mac_addr_v10(&restool.mc_io, 0,
+						      dpni_handle,
+						      cfg->mac_addr);
+		if (error < 0)
+			return error;
+	}
+
+	if (cfg->set_max_frame_length) {
+		error = dpni_set_max_frame_length_v10(&restool.mc_io, 0,
+						      dpni_handle,
+						      cfg->max_frame_length);
+		if (error < 0)
+			return error;
+	}
+
+	for (unsigned int i = 0; i < ARRAY_SIZE(dpni_layout_qtypes); i++) {
+		if (cfg->layouts[i].options == 0)
+			continue;
+
+		error = dpni_set_buffer_layout_v10(&restool.mc_io, 0,
+						   dpni_handle,
+						   dpni_layout_qtypes[i].qtype,
+						   &cfg->layouts[i]);
+		if (error < 0) {
+			ERROR_PRINTF("Buffer layouts can only be set while the DPNI is disabled\n");
+			return error;
+		}
+	}
+
+	if (cfg->link_options_mask == 0)
+		return 0;
+
+	/* the link configuration is written whole: start from the current one */
+	memset(&link_state, 0, sizeof(link_state));
+	error = dpni_get_link_state_v10(&restool.mc_io, 0, dpni_handle,
+					&link_state);
+	if (error < 0)
+		return error;
+
+	link_cfg.rate = link_state.rate;
+	link_cfg.options = (link_state.options & ~cfg->link_options_mask) |
+			   cfg->link_options;
+	return dpni_set_link_cfg_v10(&restool.mc_io, 0, dpni_handle,
+				     &link_cfg);
+}
+
+static int update_dpni_v10(const char *usage_msg)
+{
+	static const int layout_opts[ARRAY_SIZE(dpni_layout_qtypes)] = {
+		UPDATE_RX_BUFFER_LAYOUT,
+		UPDATE_TX_BUFFER_LAYOUT,
+		UPDATE_TX_CONF_BUFFER_LAYOUT,
+	};
+	struct dpni_update_cfg cfg;
+	uint64_t pause_options;
 	uint16_t dpni_handle;
 	uint32_t dpni_id;
-	int error = 0;
-	bool minimal_options = false;
+	int error, error2;
+	long value;
 
-	if (restool.cmd_option_mask & ONE_BIT_MASK(CREATE_OPT_HELP)) {
+	if (restool.cmd_option_mask & ONE_BIT_MASK(UPDATE_OPT_HELP)) {
 		puts(usage_msg);
-		restool.cmd_option_mask &= ~ONE_BIT_MASK(CREATE_OPT_HELP);
+		restool.cmd_option_mask &= ~ONE_BIT_MASK(UPDATE_OPT_HELP);
 		return 0;
 	}
 
@@ -1817,36 +2714,97 @@ static int update_dpni_v10(const char *usage_msg)
 	error = parse_object_name(restool.obj_name, "dpni", &dpni_id);
 	if (error) {
 		puts(usage_msg);
-		goto out;
+		return error;
 	}
 
-	error = dpni_open_v10(&restool.mc_io, 0, dpni_id, &dpni_handle);
-	if (error) {
-		ERROR_PRINTF("Could not open specified object!\n");
+	if (restool.cmd_option_mask == 0) {
+		ERROR_PRINTF("Specify at least an option to update!\n");
 		puts(usage_msg);
-		goto out;
+		return -EINVAL;
 	}
 
+	/* parse every setting before touching the DPNI */
+	memset(&cfg, 0, sizeof(cfg));
 	if (restool.cmd_option_mask & ONE_BIT_MASK(UPDATE_MAC_ADDR)) {
 		restool.cmd_option_mask &= ~ONE_BIT_MASK(UPDATE_MAC_ADDR);
-		error  = parse_dpni_mac_addr(
+		error = parse_dpni_mac_addr(
 				restool.cmd_option_args[UPDATE_MAC_ADDR],
-				mac_addr);
+				cfg.mac_addr);
+		if (error)
+			return error;
+		cfg.set_mac_addr = true;
+	}
 
-		error = dpni_set_primary_mac_addr_v10(&restool.mc_io, 0,
-						      dpni_handle, mac_addr);
+	if (restool.cmd_option_mask & ONE_BIT_MASK(UPDATE_MAX_FRAME_LENGTH)) {
+		restool.cmd_option_mask &=
+			~ONE_BIT_MASK(UPDATE_MAX_FRAME_LENGTH);
+		error = get_option_value(UPDATE_MAX_FRAME_LENGTH, &value,
+					 "Invalid max-frame-length value",
+					 64, 10240);
 		if (error)
-			ERROR_PRINTF("dpni_set_primary_mac_addr_v10() = %d\n", error);
+			return error;
+		cfg.max_frame_length = value;
+		cfg.set_max_frame_length = true;
+	}
+
+	for (unsigned int i = 0; i < ARRAY_SIZE(layout_opts); i++) {
+		if (!(restool.cmd_option_mask & ONE_BIT_MASK(layout_opts[i])))
+			continue;
 
-		minimal_options = true;
+		restool.cmd_option_mask &= ~ONE_BIT_MASK(layout_opts[i]);
+		error = parse_dpni_buffer_layout(
+				restool.cmd_option_args[layout_opts[i]],
+				&cfg.layouts[i]);
+		if (error)
+			return error;
 	}
 
-	dpni_close_v10(&restool.mc_io, 0, dpni_handle);
-out:
+	if (restool.cmd_option_mask & ONE_BIT_MASK(UPDATE_PAUSE)) {
+		restool.cmd_option_mask &= ~ONE_BIT_MASK(UPDATE_PAUSE);
+		error = parse_dpni_pause(restool.cmd_option_args[UPDATE_PAUSE],
+					 &pause_options);
+		if (error)
+			return error;
+		cfg.link_options_mask |= DPNI_LINK_OPT_PAUSE |
+					 DPNI_LINK_OPT_ASYM_PAUSE;
+		cfg.link_options |= pause_options;
+	}
 
-	if (!minimal_options && !error) {
-		ERROR_PRINTF("Specify at least an option to update!\n");
-		puts(usage_msg);
+	if (restool.cmd_option_mask & ONE_BIT_MASK(UPDATE_PFC)) {
+		restool.cmd_option_mask &= ~ONE_BIT_MASK(UPDATE_PFC);
+		if (strcmp(restool.cmd_option_args[UPDATE_PFC], "on") == 0) {
+			cfg.link_options |= DPNI_LINK_OPT_PFC_PAUSE;
+		} else if (strcmp(restool.cmd_option_args[UPDATE_PFC],
+				  "off") != 0) {
+			ERROR_PRINTF("Invalid pfc value: %s\n",
+				     restool.cmd_option_args[UPDATE_PFC]);
+			return -EINVAL;
+		}
+		cfg.link_options_mask |= DPNI_LINK_OPT_PFC_PAUSE;
+	}
+
+	error = dpni_open_v10(&restool.mc_io, 0, dpni_id, &dpni_handle);
+	if (error < 0) {
+		mc_status = flib_error_to_mc_status(error);
+		ERROR_PRINTF("MC error: %s (status %#x)\n",
+			     mc_status_to_string(mc_status), mc_status);
+		return error;
+	}
+
+	error = apply_dpni_update_v10(dpni_handle, &cfg);
+	if (error < 0) {
+		mc_status = flib_error_to_mc_status(error);
+		ERROR_PRINTF("MC error: %s (status %#x)\n",
+			     mc_status_to_string(mc_status), mc_status);
+	}
+
+	error2 = dpni_close_v10(&restool.mc_io, 0, dpni_handle);
+	if (error2 < 0) {
+		mc_status = flib_error_to_mc_status(error2);
+		ERROR_PRINTF("MC error: %s (status %#x)\n",
+			     mc_status_to_string(mc_status), mc_status);
+		if (error == 0)
+			error = error2;
 	}
 
 	return error;
@@ -1862,33 +2820,1211 @@ static int cmd_dpni_update_v10(void)
 		"OPTIONS:\n"
 		"   --mac-addr=<addr>\n"
 		"	String specifying primary MAC address (e.g. 00:00:05:00:00:05).\n"
+		"   --max-frame-length=<number>\n"
+		"	Largest Rx frame accepted, in bytes (64-10240).\n"
+		"   --rx-buffer-layout=<layout>\n"
+		"   --tx-buffer-layout=<layout>\n"
+		"   --tx-conf-buffer-layout=<layout>\n"
+		"	Buffer layout of Rx, Tx and Tx confirmation frames: comma\n"
+		"	separated <field>=<value> pairs, fields being headroom,\n"
+		"	tailroom, private (private data size), align (data\n"
+		"	alignment), timestamp, parser-result and frame-status (0 or\n"
+		"	1). Fields left out keep their value. Only allowed while the\n"
+		"	DPNI is disabled.\n"
+		"   --pause=on|off|rx|tx\n"
+		"	Directions in which link pause frames are honoured/sent.\n"
+		"   --pfc=on|off\n"
+		"	Priority flow control; see dpni congestion-set --flow-control\n"
+		"	for the per traffic class thresholds.\n"
+		"\n"
+		"All the settings are applied while the DPNI is opened once.\n"
+		"\n"
+		"EXAMPLE:\n"
+		"Set up dpni.1 for 9K jumbo frames with 256 bytes of Rx headroom:\n"
+		"   $ restool dpni update dpni.1 --max-frame-length=9600 \\\n"
+		"	--rx-buffer-layout=headroom=256,private=64,align=64\n"
 		"\n";
 
 	return update_dpni_v10(usage_msg);
 }
 
-struct object_command dpni_commands_v9[] = {
-	{ .cmd_name = "help",
-	  .options = NULL,
-	  .cmd_func = cmd_dpni_help },
+static int cmd_dpni_set_dist(void)
+{
+	static const char usage_msg[] =
+		"\n"
+		"Usage: restool dpni set-dist <dpni-object> --dist-size=<number>\n"
+		"		--key=<fields> [--tc=<number>] [--mode=hash|fs]\n"
+		"		[--default-flow=<number>]\n"
+		"\n"
+		"OPTIONS:\n"
+		"--dist-size=<number>\n"
+		"   Number of queues the traffic class spreads its frames over:\n"
+		"   1,2,3,4,6,7,8,12,14,16,24,28,32,48,56,64,96,112,128,192,224,\n"
+		"   256,384,448,512,768,896 or 1024, at most the DPNI num_queues.\n"
+		"--key=<fields>\n"
+		"   Comma separated list of the header fields hashed to pick the\n"
+		"   queue: ethsrc, ethdst, ethtype, vlan, ipsrc, ipdst, ipproto,\n"
+		"   l4sport, l4dport; or the preset 5tuple.\n"
+		"--tc=<number>\n"
+		"   Rx traffic class to configure. Defaults to 0.\n"
+		"--mode=hash|fs\n"
+		"   hash spreads frames by the hash of the key (default); fs picks\n"
+		"   the queue from the flow steering entries added by fs-add.\n"
+		"--default-flow=<number>\n"
+		"   In fs mode, queue of the frames no entry matches. Without it\n"
+		"   these frames are spread by hash.\n"
+		"\n"
+		"NOTES:\n"
+		"The key profile is handed to the MC in memory it reads by physical\n"
+		"address: restool needs CAP_SYS_ADMIN and the MC must access memory\n"
+		"without SMMU translation.\n"
+		"\n"
+		"EXAMPLE:\n"
+		"Spread the frames of dpni.1 over 8 queues by their 5-tuple:\n"
+		"   $ restool dpni set-dist dpni.1 --dist-size=8 --key=5tuple\n"
+		"\n";
 
-	{ .cmd_name = "info",
-	  .options = dpni_info_options,
-	  .cmd_func = cmd_dpni_info_v9 },
+	enum dpni_dist_mode dist_mode = DPNI_DIST_MODE_HASH;
+	struct dpni_fs_tbl_cfg fs_cfg;
+	struct dpkg_profile_cfg key_cfg;
+	const char *mode;
+	uint32_t dpni_id;
+	long tc_id = 0;
+	long dist_size;
+	long flow_id;
+	int error;
 
-	{ .cmd_name = "create",
-	  .options = dpni_create_options,
-	  .cmd_func = cmd_dpni_create_v9 },
+	if (restool.cmd_option_mask & ONE_BIT_MASK(SET_DIST_OPT_HELP)) {
+		puts(usage_msg);
+		restool.cmd_option_mask &= ~ONE_BIT_MASK(SET_DIST_OPT_HELP);
+		return 0;
+	}
 
-	{ .cmd_name = "destroy",
-	  .options = dpni_destroy_options,
-	  .cmd_func = cmd_dpni_destroy_v9 },
+	if (restool.obj_name == NULL) {
+		ERROR_PRINTF("<object> argument missing\n");
+		puts(usage_msg);
+		return -EINVAL;
+	}
 
-	{ .cmd_name = NULL },
-};
+	error = parse_object_name(restool.obj_name, "dpni", &dpni_id);
+	if (error < 0)
+		return error;
 
-struct object_command dpni_commands_v10[] = {
-	{ .cmd_name = "help",
+	if (!(restool.cmd_option_mask & ONE_BIT_MASK(SET_DIST_OPT_DIST_SIZE)) ||
+	    !(restool.cmd_option_mask & ONE_BIT_MASK(SET_DIST_OPT_KEY))) {
+		ERROR_PRINTF("--dist-size and --key are required\n");
+		puts(usage_msg);
+		return -EINVAL;
+	}
+
+	restool.cmd_option_mask &= ~ONE_BIT_MASK(SET_DIST_OPT_DIST_SIZE);
+	error = get_option_value(SET_DIST_OPT_DIST_SIZE, &dist_size,
+				 "Invalid dist-size value",
+				 1, MAX_DIST_SIZE);
+	if (error)
+		return error;
+
+	if (!is_valid_dist_size(dist_size)) {
+		ERROR_PRINTF("Unsupported dist-size value: %ld\n", dist_size);
+		return -EINVAL;
+	}
+
+	restool.cmd_option_mask &= ~ONE_BIT_MASK(SET_DIST_OPT_KEY);
+	error = parse_dpni_key(restool.cmd_option_args[SET_DIST_OPT_KEY],
+			       &key_cfg);
+	if (error)
+		return error;
+
+	if (restool.cmd_option_mask & ONE_BIT_MASK(SET_DIST_OPT_TC)) {
+		restool.cmd_option_mask &= ~ONE_BIT_MASK(SET_DIST_OPT_TC);
+		error = get_option_value(SET_DIST_OPT_TC, &tc_id,
+					 "Invalid tc value",
+					 0, DPNI_MAX_TC - 1);
+		if (error)
+			return error;
+	}
+
+	if (restool.cmd_option_mask & ONE_BIT_MASK(SET_DIST_OPT_MODE)) {
+		restool.cmd_option_mask &= ~ONE_BIT_MASK(SET_DIST_OPT_MODE);
+		mode = restool.cmd_option_args[SET_DIST_OPT_MODE];
+		if (strcmp(mode, "fs") == 0) {
+			dist_mode = DPNI_DIST_MODE_FS;
+		} else if (strcmp(mode, "hash") != 0) {
+			ERROR_PRINTF("Invalid mode: %s\n", mode);
+			return -EINVAL;
+		}
+	}
+
+	memset(&fs_cfg, 0, sizeof(fs_cfg));
+	if (dist_mode == DPNI_DIST_MODE_FS)
+		fs_cfg.miss_action = DPNI_FS_MISS_HASH;
+
+	if (restool.cmd_option_mask & ONE_BIT_MASK(SET_DIST_OPT_DEFAULT_FLOW)) {
+		restool.cmd_option_mask &=
+			~ONE_BIT_MASK(SET_DIST_OPT_DEFAULT_FLOW);
+		if (dist_mode != DPNI_DIST_MODE_FS) {
+			ERROR_PRINTF("--default-flow needs --mode=fs\n");
+			return -EINVAL;
+		}
+
+		error = get_option_value(SET_DIST_OPT_DEFAULT_FLOW, &flow_id,
+					 "Invalid default-flow value",
+					 0, dist_size - 1);
+		if (error)
+			return error;
+
+		fs_cfg.miss_action = DPNI_FS_MISS_EXPLICIT_FLOWID;
+		fs_cfg.default_flow_id = flow_id;
+	}
+
+	return dpni_set_dist(dpni_id, tc_id, dist_size, &key_cfg, dist_mode,
+			     &fs_cfg);
+}
+
+static int cmd_dpni_set_qos(void)
+{
+	static const char usage_msg[] =
+		"\n"
+		"Usage: restool dpni set-qos <dpni-object> --key=<fields>\n"
+		"		[--default-tc=<number>] [--discard]\n"
+		"\n"
+		"OPTIONS:\n"
+		"--key=<fields>\n"
+		"   Comma separated list of the header fields QoS entries match\n"
+		"   on: ethsrc, ethdst, ethtype, vlan, ipsrc, ipdst, ipproto,\n"
+		"   l4sport, l4dport; or the preset 5tuple.\n"
+		"--default-tc=<number>\n"
+		"   Traffic class of the frames no entry matches. Defaults to 0.\n"
+		"--discard\n"
+		"   Drop the frames no entry matches instead.\n"
+		"\n"
+		"NOTES:\n"
+		"Setting the key clears the QoS table. The key profile is handed\n"
+		"to the MC in memory it reads by physical address: restool needs\n"
+		"CAP_SYS_ADMIN and the MC must access memory without SMMU\n"
+		"translation.\n"
+		"\n"
+		"EXAMPLE:\n"
+		"Classify the frames of dpni.1 by VLAN TCI:\n"
+		"   $ restool dpni set-qos dpni.1 --key=vlan\n"
+		"\n";
+
+	struct dpkg_profile_cfg key_cfg;
+	bool discard_on_miss = false;
+	long default_tc = 0;
+	uint32_t dpni_id;
+	int error;
+
+	if (restool.cmd_option_mask & ONE_BIT_MASK(SET_QOS_OPT_HELP)) {
+		puts(usage_msg);
+		restool.cmd_option_mask &= ~ONE_BIT_MASK(SET_QOS_OPT_HELP);
+		return 0;
+	}
+
+	if (restool.obj_name == NULL) {
+		ERROR_PRINTF("<object> argument missing\n");
+		puts(usage_msg);
+		return -EINVAL;
+	}
+
+	error = parse_object_name(restool.obj_name, "dpni", &dpni_id);
+	if (error < 0)
+		return error;
+
+	if (!(restool.cmd_option_mask & ONE_BIT_MASK(SET_QOS_OPT_KEY))) {
+		ERROR_PRINTF("--key option missing\n");
+		puts(usage_msg);
+		return -EINVAL;
+	}
+
+	restool.cmd_option_mask &= ~ONE_BIT_MASK(SET_QOS_OPT_KEY);
+	error = parse_dpni_key(restool.cmd_option_args[SET_QOS_OPT_KEY],
+			       &key_cfg);
+	if (error)
+		return error;
+
+	if (restool.cmd_option_mask & ONE_BIT_MASK(SET_QOS_OPT_DEFAULT_TC)) {
+		restool.cmd_option_mask &= ~ONE_BIT_MASK(SET_QOS_OPT_DEFAULT_TC);
+		error = get_option_value(SET_QOS_OPT_DEFAULT_TC, &default_tc,
+					 "Invalid default-tc value",
+					 0, DPNI_MAX_TC - 1);
+		if (error)
+			return error;
+	}
+
+	if (restool.cmd_option_mask & ONE_BIT_MASK(SET_QOS_OPT_DISCARD)) {
+		restool.cmd_option_mask &= ~ONE_BIT_MASK(SET_QOS_OPT_DISCARD);
+		discard_on_miss = true;
+	}
+
+	return dpni_set_qos(dpni_id, &key_cfg, discard_on_miss, default_tc);
+}
+
+static int update_dpni_rules(const char *usage_msg, enum dpni_table table,
+			     enum dpni_rule_op op)
+{
+	struct dpkg_profile_cfg key_cfg;
+	struct dpni_rule_batch batch;
+	bool has_rule, has_file;
+	uint32_t dpni_id;
+	long val;
+	int error;
+
+	if (restool.cmd_option_mask & ONE_BIT_MASK(RULE_OPT_HELP)) {
+		puts(usage_msg);
+		restool.cmd_option_mask &= ~ONE_BIT_MASK(RULE_OPT_HELP);
+		return 0;
+	}
+
+	if (restool.obj_name == NULL) {
+		ERROR_PRINTF("<object> argument missing\n");
+		puts(usage_msg);
+		return -EINVAL;
+	}
+
+	error = parse_object_name(restool.obj_name, "dpni", &dpni_id);
+	if (error < 0)
+		return error;
+
+	has_rule = restool.cmd_option_mask & ONE_BIT_MASK(RULE_OPT_RULE);
+	has_file = restool.cmd_option_mask & ONE_BIT_MASK(RULE_OPT_FILE);
+	if (!(restool.cmd_option_mask & ONE_BIT_MASK(RULE_OPT_KEY)) ||
+	    has_rule == has_file) {
+		ERROR_PRINTF("--key and one of --rule or --file are required\n");
+		puts(usage_msg);
+		return -EINVAL;
+	}
+
+	memset(&batch, 0, sizeof(batch));
+	batch.table = table;
+	batch.op = op;
+	batch.key_cfg = &key_cfg;
+
+	restool.cmd_option_mask &= ~ONE_BIT_MASK(RULE_OPT_KEY);
+	error = parse_dpni_key(restool.cmd_option_args[RULE_OPT_KEY],
+			       &key_cfg);
+	if (error)
+		return error;
+
+	if (has_rule) {
+		restool.cmd_option_mask &= ~ONE_BIT_MASK(RULE_OPT_RULE);
+		batch.rule = restool.cmd_option_args[RULE_OPT_RULE];
+	} else {
+		restool.cmd_option_mask &= ~ONE_BIT_MASK(RULE_OPT_FILE);
+		batch.rule_file = restool.cmd_option_args[RULE_OPT_FILE];
+	}
+
+	/*
+	 * --tc is the flow steering table of FS entries and the target of
+	 * QoS entries; --flow is the target of FS entries
+	 */
+	if (restool.cmd_option_mask & ONE_BIT_MASK(RULE_OPT_TC)) {
+		restool.cmd_option_mask &= ~ONE_BIT_MASK(RULE_OPT_TC);
+		error = get_option_value(RULE_OPT_TC, &val,
+					 "Invalid tc value",
+					 0, DPNI_MAX_TC - 1);
+		if (error)
+			return error;
+
+		if (table == DPNI_TABLE_FS)
+			batch.tc_id = val;
+		else
+			batch.target = val;
+	}
+
+	if (restool.cmd_option_mask & ONE_BIT_MASK(RULE_OPT_FLOW)) {
+		restool.cmd_option_mask &= ~ONE_BIT_MASK(RULE_OPT_FLOW);
+		if (table != DPNI_TABLE_FS) {
+			ERROR_PRINTF("--flow applies to flow steering entries\n");
+			return -EINVAL;
+		}
+
+		error = get_option_value(RULE_OPT_FLOW, &val,
+					 "Invalid flow value",
+					 0, MAX_DIST_SIZE - 1);
+		if (error)
+			return error;
+
+		batch.target = val;
+	}
+
+	if (restool.cmd_option_mask & ONE_BIT_MASK(RULE_OPT_INDEX)) {
+		restool.cmd_option_mask &= ~ONE_BIT_MASK(RULE_OPT_INDEX);
+		error = get_option_value(RULE_OPT_INDEX, &val,
+					 "Invalid index value",
+					 0, UINT16_MAX);
+		if (error)
+			return error;
+
+		batch.index = val;
+	}
+
+	return dpni_update_rules(dpni_id, &batch);
+}
+
+static int cmd_dpni_fs_add(void)
+{
+	static const char usage_msg[] =
+		"\n"
+		"Usage: restool dpni fs-add <dpni-object> --key=<fields>\n"
+		"		--rule=<values> | --file=<path>\n"
+		"		[--tc=<number>] [--flow=<number>] [--index=<number>]\n"
+		"\n"
+		"OPTIONS:\n"
+		"--key=<fields>\n"
+		"   Key the traffic class was set up with by set-dist --mode=fs.\n"
+		"--rule=<values>\n"
+		"   Comma separated field values, in key order. A value can be\n"
+		"   followed by /<mask>, e.g. 10.0.0.0/255.0.0.0.\n"
+		"--file=<path>\n"
+		"   File of entries, one \"<values> <flow>\" per line; lines\n"
+		"   starting with '#' are skipped. All entries are added in one\n"
+		"   MC session.\n"
+		"--tc=<number>\n"
+		"   Rx traffic class the entries belong to. Defaults to 0.\n"
+		"--flow=<number>\n"
+		"   Queue of the frames matching --rule. Defaults to 0.\n"
+		"--index=<number>\n"
+		"   Table position of the first entry, for DPNIs with masking.\n"
+		"   Defaults to 0.\n"
+		"\n"
+		"EXAMPLE:\n"
+		"Pin one TCP flow of dpni.1 to queue 7:\n"
+		"   $ restool dpni set-dist dpni.1 --dist-size=8 --key=5tuple --mode=fs\n"
+		"   $ restool dpni fs-add dpni.1 --key=5tuple \\\n"
+		"	--rule=10.0.0.1,10.0.0.2,6,5000,80 --flow=7\n"
+		"\n";
+
+	return update_dpni_rules(usage_msg, DPNI_TABLE_FS, DPNI_RULE_ADD);
+}
+
+static int cmd_dpni_fs_del(void)
+{
+	static const char usage_msg[] =
+		"\n"
+		"Usage: restool dpni fs-del <dpni-object> --key=<fields>\n"
+		"		--rule=<values> | --file=<path> [--tc=<number>]\n"
+		"\n"
+		"OPTIONS:\n"
+		"--key=<fields>\n"
+		"   Key the traffic class was set up with by set-dist --mode=fs.\n"
+		"--rule=<values>\n"
+		"   Values of the entry to remove, as given to fs-add.\n"
+		"--file=<path>\n"
+		"   File of entries to remove, in the fs-add format.\n"
+		"--tc=<number>\n"
+		"   Rx traffic class the entries belong to. Defaults to 0.\n"
+		"\n";
+
+	return update_dpni_rules(usage_msg, DPNI_TABLE_FS, DPNI_RULE_DEL);
+}
+
+static int cmd_dpni_qos_add(void)
+{
+	static const char usage_msg[] =
+		"\n"
+		"Usage: restool dpni qos-add <dpni-object> --key=<fields>\n"
+		"		--rule=<values> | --file=<path>\n"
+		"		[--tc=<number>] [--index=<number>]\n"
+		"\n"
+		"OPTIONS:\n"
+		"--key=<fields>\n"
+		"   Key the QoS table was set up with by set-qos.\n"
+		"--rule=<values>\n"
+		"   Comma separated field values, in key order. A value can be\n"
+		"   followed by /<mask>, e.g. 0x0100/0x0fff.\n"
+		"--file=<path>\n"
+		"   File of entries, one \"<values> <tc>\" per line; lines\n"
+		"   starting with '#' are skipped. All entries are added in one\n"
+		"   MC session.\n"
+		"--tc=<number>\n"
+		"   Traffic class of the frames matching --rule. Defaults to 0.\n"
+		"--index=<number>\n"
+		"   Table position of the first entry, for DPNIs with masking.\n"
+		"   Defaults to 0.\n"
+		"\n"
+		"EXAMPLE:\n"
+		"Send the frames of VLAN 100 of dpni.1 to traffic class 1:\n"
+		"   $ restool dpni qos-add dpni.1 --key=vlan --rule=100/0x0fff --tc=1\n"
+		"\n";
+
+	return update_dpni_rules(usage_msg, DPNI_TABLE_QOS, DPNI_RULE_ADD);
+}
+
+static int cmd_dpni_qos_del(void)
+{
+	static const char usage_msg[] =
+		"\n"
+		"Usage: restool dpni qos-del <dpni-object> --key=<fields>\n"
+		"		--rule=<values> | --file=<path>\n"
+		"\n"
+		"OPTIONS:\n"
+		"--key=<fields>\n"
+		"   Key the QoS table was set up with by set-qos.\n"
+		"--rule=<values>\n"
+		"   Values of the entry to remove, as given to qos-add.\n"
+		"--file=<path>\n"
+		"   File of entries to remove, in the qos-add format.\n"
+		"\n";
+
+	return update_dpni_rules(usage_msg, DPNI_TABLE_QOS, DPNI_RULE_DEL);
+}
+
+static int clear_dpni_rules(const char *usage_msg, enum dpni_table table)
+{
+	uint32_t dpni_id;
+	long tc_id = 0;
+	int error;
+
+	if (restool.cmd_option_mask & ONE_BIT_MASK(CLEAR_OPT_HELP)) {
+		puts(usage_msg);
+		restool.cmd_option_mask &= ~ONE_BIT_MASK(CLEAR_OPT_HELP);
+		return 0;
+	}
+
+	if (restool.obj_name == NULL) {
+		ERROR_PRINTF("<object> argument missing\n");
+		puts(usage_msg);
+		return -EINVAL;
+	}
+
+	error = parse_object_name(restool.obj_name, "dpni", &dpni_id);
+	if (error < 0)
+		return error;
+
+	if (restool.cmd_option_mask & ONE_BIT_MASK(CLEAR_OPT_TC)) {
+		restool.cmd_option_mask &= ~ONE_BIT_MASK(CLEAR_OPT_TC);
+		if (table != DPNI_TABLE_FS) {
+			ERROR_PRINTF("--tc applies to flow steering tables\n");
+			return -EINVAL;
+		}
+
+		error = get_option_value(CLEAR_OPT_TC, &tc_id,
+					 "Invalid tc value",
+					 0, DPNI_MAX_TC - 1);
+		if (error)
+			return error;
+	}
+
+	return dpni_clear_rules(dpni_id, table, tc_id);
+}
+
+static int cmd_dpni_fs_clear(void)
+{
+	static const char usage_msg[] =
+		"\n"
+		"Usage: restool dpni fs-clear <dpni-object> [--tc=<number>]\n"
+		"\n"
+		"OPTIONS:\n"
+		"--tc=<number>\n"
+		"   Rx traffic class whose flow steering entries are removed.\n"
+		"   Defaults to 0.\n"
+		"\n";
+
+	return clear_dpni_rules(usage_msg, DPNI_TABLE_FS);
+}
+
+static int cmd_dpni_qos_clear(void)
+{
+	static const char usage_msg[] =
+		"\n"
+		"Usage: restool dpni qos-clear <dpni-object>\n"
+		"\n"
+		"Removes all the entries of the QoS table.\n"
+		"\n";
+
+	return clear_dpni_rules(usage_msg, DPNI_TABLE_QOS);
+}
+
+static int parse_cg_point(const char *level,
+			  enum dpni_congestion_point *cg_point)
+{
+	if (strcmp(level, "queue") == 0) {
+		*cg_point = DPNI_CP_QUEUE;
+	} else if (strcmp(level, "tc") == 0) {
+		*cg_point = DPNI_CP_GROUP;
+	} else {
+		ERROR_PRINTF("Invalid level: %s\n", level);
+		return -EINVAL;
+	}
+
+	return 0;
+}
+
+static int parse_congestion_units(const char *units_str,
+				  enum dpni_congestion_unit *units)
+{
+	if (strcmp(units_str, "bytes") == 0) {
+		*units = DPNI_CONGESTION_UNIT_BYTES;
+	} else if (strcmp(units_str, "frames") == 0) {
+		*units = DPNI_CONGESTION_UNIT_FRAMES;
+	} else {
+		ERROR_PRINTF("Invalid units: %s\n", units_str);
+		return -EINVAL;
+	}
+
+	return 0;
+}
+
+static int parse_queue_type(const char *qtype_str,
+			    enum dpni_queue_type *qtype)
+{
+	if (strcmp(qtype_str, "rx") == 0) {
+		*qtype = DPNI_QUEUE_RX;
+	} else if (strcmp(qtype_str, "tx") == 0) {
+		*qtype = DPNI_QUEUE_TX;
+	} else {
+		ERROR_PRINTF("Invalid qtype: %s\n", qtype_str);
+		return -EINVAL;
+	}
+
+	return 0;
+}
+
+/*
+ * Parses a --tc or --queue option: a number below max, or "all"
+ */
+static int get_index_option(int option, const char *error_msg, long max,
+			    int *index)
+{
+	long val;
+	int error;
+
+	if (strcmp(restool.cmd_option_args[option], "all") == 0) {
+		*index = DPNI_ALL;
+		return 0;
+	}
+
+	error = get_option_value(option, &val, error_msg, 0, max - 1);
+	if (error)
+		return error;
+
+	*index = val;
+	return 0;
+}
+
+static int cmd_dpni_taildrop_set(void)
+{
+	static const char usage_msg[] =
+		"\n"
+		"Usage: restool dpni taildrop-set <dpni-objects>\n"
+		"		--threshold=<number> | --disable\n"
+		"		[--level=queue|tc] [--tc=<number>|all]\n"
+		"		[--queue=<number>|all] [--units=bytes|frames]\n"
+		"\n"
+		"<dpni-objects> is one DPNI or a comma separated list of them\n"
+		"(e.g. dpni.1,dpni.2), all configured in one session.\n"
+		"\n"
+		"OPTIONS:\n"
+		"--threshold=<number>\n"
+		"   Fill level above which Rx frames are dropped.\n"
+		"--disable\n"
+		"   Turn taildrop off.\n"
+		"--level=queue|tc\n"
+		"   Apply the threshold to each Rx queue (default) or to the\n"
+		"   congestion group of each traffic class. A DPNI created with\n"
+		"   DPNI_OPT_SHARED_CONGESTION has a single group, tc 0.\n"
+		"--tc=<number>|all\n"
+		"   Traffic class to configure. Defaults to all.\n"
+		"--queue=<number>|all\n"
+		"   Queue of the traffic class to configure, at queue level.\n"
+		"   Defaults to all.\n"
+		"--units=bytes|frames\n"
+		"   Unit of --threshold. Defaults to bytes; queues only support\n"
+		"   bytes.\n"
+		"\n"
+		"EXAMPLE:\n"
+		"Drop frames beyond 64KB on every Rx queue of dpni.1 and dpni.2:\n"
+		"   $ restool dpni taildrop-set dpni.1,dpni.2 --threshold=65536\n"
+		"\n";
+
+	struct dpni_taildrop_req req;
+	uint32_t *dpni_ids;
+	int num_dpnis;
+	long threshold;
+	int error;
+
+	if (restool.cmd_option_mask & ONE_BIT_MASK(TAILDROP_SET_OPT_HELP)) {
+		puts(usage_msg);
+		restool.cmd_option_mask &= ~ONE_BIT_MASK(TAILDROP_SET_OPT_HELP);
+		return 0;
+	}
+
+	if (restool.obj_name == NULL) {
+		ERROR_PRINTF("<object> argument missing\n");
+		puts(usage_msg);
+		return -EINVAL;
+	}
+
+	memset(&req, 0, sizeof(req));
+	req.cg_point = DPNI_CP_QUEUE;
+	req.tc = DPNI_ALL;
+	req.queue = DPNI_ALL;
+
+	if (restool.cmd_option_mask & ONE_BIT_MASK(TAILDROP_SET_OPT_DISABLE)) {
+		restool.cmd_option_mask &=
+			~ONE_BIT_MASK(TAILDROP_SET_OPT_DISABLE);
+	} else if (restool.cmd_option_mask &
+		   ONE_BIT_MASK(TAILDROP_SET_OPT_THRESHOLD)) {
+		restool.cmd_option_mask &=
+			~ONE_BIT_MASK(TAILDROP_SET_OPT_THRESHOLD);
+		error = get_option_value(TAILDROP_SET_OPT_THRESHOLD, &threshold,
+					 "Invalid threshold value",
+					 1, UINT32_MAX);
+		if (error)
+			return error;
+
+		req.taildrop.enable = 1;
+		req.taildrop.threshold = threshold;
+	} else {
+		ERROR_PRINTF("--threshold or --disable is required\n");
+		puts(usage_msg);
+		return -EINVAL;
+	}
+
+	if (restool.cmd_option_mask & ONE_BIT_MASK(TAILDROP_SET_OPT_LEVEL)) {
+		restool.cmd_option_mask &= ~ONE_BIT_MASK(TAILDROP_SET_OPT_LEVEL);
+		error = parse_cg_point(
+				restool.cmd_option_args[TAILDROP_SET_OPT_LEVEL],
+				&req.cg_point);
+		if (error)
+			return error;
+	}
+
+	if (restool.cmd_option_mask & ONE_BIT_MASK(TAILDROP_SET_OPT_TC)) {
+		restool.cmd_option_mask &= ~ONE_BIT_MASK(TAILDROP_SET_OPT_TC);
+		error = get_index_option(TAILDROP_SET_OPT_TC,
+					 "Invalid tc value", DPNI_MAX_TC,
+					 &req.tc);
+		if (error)
+			return error;
+	}
+
+	if (restool.cmd_option_mask & ONE_BIT_MASK(TAILDROP_SET_OPT_QUEUE)) {
+		restool.cmd_option_mask &= ~ONE_BIT_MASK(TAILDROP_SET_OPT_QUEUE);
+		if (req.cg_point != DPNI_CP_QUEUE) {
+			ERROR_PRINTF("--queue applies to --level=queue\n");
+			return -EINVAL;
+		}
+
+		error = get_index_option(TAILDROP_SET_OPT_QUEUE,
+					 "Invalid queue value", UINT8_MAX + 1,
+					 &req.queue);
+		if (error)
+			return error;
+	}
+
+	if (restool.cmd_option_mask & ONE_BIT_MASK(TAILDROP_SET_OPT_UNITS)) {
+		restool.cmd_option_mask &= ~ONE_BIT_MASK(TAILDROP_SET_OPT_UNITS);
+		error = parse_congestion_units(
+				restool.cmd_option_args[TAILDROP_SET_OPT_UNITS],
+				&req.taildrop.units);
+		if (error)
+			return error;
+
+		if (req.cg_point == DPNI_CP_QUEUE &&
+		    req.taildrop.units != DPNI_CONGESTION_UNIT_BYTES) {
+			ERROR_PRINTF("Queue taildrop only supports bytes\n");
+			return -EINVAL;
+		}
+	}
+
+	error = parse_dpni_list(restool.obj_name, &dpni_ids, &num_dpnis);
+	if (error)
+		return error;
+
+	error = dpni_set_taildrop(dpni_ids, num_dpnis, &req);
+	free(dpni_ids);
+	return error;
+}
+
+static int cmd_dpni_taildrop_get(void)
+{
+	static const char usage_msg[] =
+		"\n"
+		"Usage: restool dpni taildrop-get <dpni-objects> [--level=queue|tc]\n"
+		"\n"
+		"<dpni-objects> is one DPNI or a comma separated list of them.\n"
+		"\n"
+		"OPTIONS:\n"
+		"--level=queue|tc\n"
+		"   Show the taildrop of each Rx queue (default) or of the\n"
+		"   congestion group of each traffic class.\n"
+		"\n";
+
+	enum dpni_congestion_point cg_point = DPNI_CP_QUEUE;
+	uint32_t *dpni_ids;
+	int num_dpnis;
+	int error;
+
+	if (restool.cmd_option_mask & ONE_BIT_MASK(TAILDROP_GET_OPT_HELP)) {
+		puts(usage_msg);
+		restool.cmd_option_mask &= ~ONE_BIT_MASK(TAILDROP_GET_OPT_HELP);
+		return 0;
+	}
+
+	if (restool.obj_name == NULL) {
+		ERROR_PRINTF("<object> argument missing\n");
+		puts(usage_msg);
+		return -EINVAL;
+	}
+
+	if (restool.cmd_option_mask & ONE_BIT_MASK(TAILDROP_GET_OPT_LEVEL)) {
+		restool.cmd_option_mask &= ~ONE_BIT_MASK(TAILDROP_GET_OPT_LEVEL);
+		error = parse_cg_point(
+				restool.cmd_option_args[TAILDROP_GET_OPT_LEVEL],
+				&cg_point);
+		if (error)
+			return error;
+	}
+
+	error = parse_dpni_list(restool.obj_name, &dpni_ids, &num_dpnis);
+	if (error)
+		return error;
+
+	error = dpni_print_taildrop(dpni_ids, num_dpnis, cg_point);
+	free(dpni_ids);
+	return error;
+}
+
+static int parse_congestion_dest(const char *dest,
+				 struct dpni_dest_cfg_v10 *dest_cfg)
+{
+	uint32_t dest_id;
+	int error;
+
+	if (strncmp(dest, "dpio.", strlen("dpio.")) == 0) {
+		error = parse_object_name(dest, "dpio", &dest_id);
+		dest_cfg->dest_type = DPNI_DEST_DPIO_V10;
+	} else if (strncmp(dest, "dpcon.", strlen("dpcon.")) == 0) {
+		error = parse_object_name(dest, "dpcon", &dest_id);
+		dest_cfg->dest_type = DPNI_DEST_DPCON_V10;
+	} else {
+		ERROR_PRINTF("Invalid dest: %s\n", dest);
+		return -EINVAL;
+	}
+
+	if (error < 0)
+		return error;
+
+	dest_cfg->dest_id = dest_id;
+	return 0;
+}
+
+static int cmd_dpni_congestion_set(void)
+{
+	static const char usage_msg[] =
+		"\n"
+		"Usage: restool dpni congestion-set <dpni-objects>\n"
+		"		--entry=<number> --exit=<number> | --disable\n"
+		"		[--qtype=rx|tx] [--tc=<number>|all]\n"
+		"		[--units=bytes|frames] [--dest=<dpio-or-dpcon>]\n"
+		"		[--priority=<number>] [--flow-control]\n"
+		"\n"
+		"<dpni-objects> is one DPNI or a comma separated list of them\n"
+		"(e.g. dpni.1,dpni.2), all configured in one session.\n"
+		"\n"
+		"OPTIONS:\n"
+		"--entry=<number>\n"
+		"   Fill level of the congestion group above which it is\n"
+		"   congested.\n"
+		"--exit=<number>\n"
+		"   Fill level below which it is no longer congested, at most\n"
+		"   --entry.\n"
+		"--disable\n"
+		"   Turn congestion notification off.\n"
+		"--qtype=rx|tx\n"
+		"   Queues of the congestion group. Defaults to rx.\n"
+		"--tc=<number>|all\n"
+		"   Traffic class to configure. Defaults to all. A DPNI created\n"
+		"   with DPNI_OPT_SHARED_CONGESTION has a single group, tc 0.\n"
+		"--units=bytes|frames\n"
+		"   Unit of --entry and --exit. Defaults to bytes.\n"
+		"--dest=<dpio-or-dpcon>\n"
+		"   DPIO or DPCON notified when the group enters and exits\n"
+		"   congestion (e.g. dpio.0).\n"
+		"--priority=<number>\n"
+		"   Priority of the notifications in the --dest channel.\n"
+		"   Defaults to 0.\n"
+		"--flow-control\n"
+		"   Send pause frames while the group is congested.\n"
+		"\n"
+		"EXAMPLE:\n"
+		"Pause the link while the Rx queues of dpni.1 hold over 1MB:\n"
+		"   $ restool dpni congestion-set dpni.1 --entry=1048576 \\\n"
+		"	--exit=524288 --flow-control\n"
+		"\n";
+
+	struct dpni_congestion_notification_cfg *cfg;
+	struct dpni_congestion_req req;
+	uint32_t *dpni_ids;
+	int num_dpnis;
+	long val;
+	int error;
+
+	if (restool.cmd_option_mask & ONE_BIT_MASK(CONGESTION_SET_OPT_HELP)) {
+		puts(usage_msg);
+		restool.cmd_option_mask &=
+			~ONE_BIT_MASK(CONGESTION_SET_OPT_HELP);
+		return 0;
+	}
+
+	if (restool.obj_name == NULL) {
+		ERROR_PRINTF("<object> argument missing\n");
+		puts(usage_msg);
+		return -EINVAL;
+	}
+
+	memset(&req, 0, sizeof(req));
+	req.qtype = DPNI_QUEUE_RX;
+	req.tc = DPNI_ALL;
+	cfg = &req.cfg;
+
+	if (restool.cmd_option_mask & ONE_BIT_MASK(CONGESTION_SET_OPT_QTYPE)) {
+		restool.cmd_option_mask &=
+			~ONE_BIT_MASK(CONGESTION_SET_OPT_QTYPE);
+		error = parse_queue_type(
+			restool.cmd_option_args[CONGESTION_SET_OPT_QTYPE],
+			&req.qtype);
+		if (error)
+			return error;
+	}
+
+	if (restool.cmd_option_mask & ONE_BIT_MASK(CONGESTION_SET_OPT_TC)) {
+		restool.cmd_option_mask &= ~ONE_BIT_MASK(CONGESTION_SET_OPT_TC);
+		error = get_index_option(CONGESTION_SET_OPT_TC,
+					 "Invalid tc value", DPNI_MAX_TC,
+					 &req.tc);
+		if (error)
+			return error;
+	}
+
+	if (restool.cmd_option_mask &
+	    ONE_BIT_MASK(CONGESTION_SET_OPT_DISABLE)) {
+		restool.cmd_option_mask &=
+			~ONE_BIT_MASK(CONGESTION_SET_OPT_DISABLE);
+		goto set;
+	}
+
+	if (!(restool.cmd_option_mask &
+	      ONE_BIT_MASK(CONGESTION_SET_OPT_ENTRY)) ||
+	    !(restool.cmd_option_mask &
+	      ONE_BIT_MASK(CONGESTION_SET_OPT_EXIT))) {
+		ERROR_PRINTF("--entry and --exit, or --disable, are required\n");
+		puts(usage_msg);
+		return -EINVAL;
+	}
+
+	restool.cmd_option_mask &= ~ONE_BIT_MASK(CONGESTION_SET_OPT_ENTRY);
+	error = get_option_value(CONGESTION_SET_OPT_ENTRY, &val,
+				 "Invalid entry value", 1, UINT32_MAX);
+	if (error)
+		return error;
+	cfg->threshold_entry = val;
+
+	restool.cmd_option_mask &= ~ONE_BIT_MASK(CONGESTION_SET_OPT_EXIT);
+	error = get_option_value(CONGESTION_SET_OPT_EXIT, &val,
+				 "Invalid exit value", 0,
+				 cfg->threshold_entry);
+	if (error)
+		return error;
+	cfg->threshold_exit = val;
+
+	if (restool.cmd_option_mask & ONE_BIT_MASK(CONGESTION_SET_OPT_UNITS)) {
+		restool.cmd_option_mask &=
+			~ONE_BIT_MASK(CONGESTION_SET_OPT_UNITS);
+		error = parse_congestion_units(
+			restool.cmd_option_args[CONGESTION_SET_OPT_UNITS],
+			&cfg->units);
+		if (error)
+			return error;
+	}
+
+	if (restool.cmd_option_mask & ONE_BIT_MASK(CONGESTION_SET_OPT_DEST)) {
+		restool.cmd_option_mask &=
+			~ONE_BIT_MASK(CONGESTION_SET_OPT_DEST);
+		error = parse_congestion_dest(
+			restool.cmd_option_args[CONGESTION_SET_OPT_DEST],
+			&cfg->dest_cfg);
+		if (error)
+			return error;
+
+		cfg->notification_mode |= DPNI_CONG_OPT_NOTIFY_DEST_ON_ENTER |
+					  DPNI_CONG_OPT_NOTIFY_DEST_ON_EXIT;
+	}
+
+	if (restool.cmd_option_mask &
+	    ONE_BIT_MASK(CONGESTION_SET_OPT_PRIORITY)) {
+		restool.cmd_option_mask &=
+			~ONE_BIT_MASK(CONGESTION_SET_OPT_PRIORITY);
+		if (cfg->dest_cfg.dest_type == DPNI_DEST_NONE_V10) {
+			ERROR_PRINTF("--priority needs --dest\n");
+			return -EINVAL;
+		}
+
+		error = get_option_value(CONGESTION_SET_OPT_PRIORITY, &val,
+					 "Invalid priority value", 0, 7);
+		if (error)
+			return error;
+		cfg->dest_cfg.priority = val;
+	}
+
+	if (restool.cmd_option_mask &
+	    ONE_BIT_MASK(CONGESTION_SET_OPT_FLOW_CONTROL)) {
+		restool.cmd_option_mask &=
+			~ONE_BIT_MASK(CONGESTION_SET_OPT_FLOW_CONTROL);
+		cfg->notification_mode |= DPNI_CONG_OPT_FLOW_CONTROL;
+	}
+
+set:
+	error = parse_dpni_list(restool.obj_name, &dpni_ids, &num_dpnis);
+	if (error)
+		return error;
+
+	error = dpni_set_congestion(dpni_ids, num_dpnis, &req);
+	free(dpni_ids);
+	return error;
+}
+
+static int cmd_dpni_congestion_get(void)
+{
+	static const char usage_msg[] =
+		"\n"
+		"Usage: restool dpni congestion-get <dpni-objects> [--qtype=rx|tx]\n"
+		"\n"
+		"<dpni-objects> is one DPNI or a comma separated list of them.\n"
+		"\n"
+		"OPTIONS:\n"
+		"--qtype=rx|tx\n"
+		"   Queues of the congestion groups to show. Defaults to rx.\n"
+		"\n";
+
+	enum dpni_queue_type qtype = DPNI_QUEUE_RX;
+	uint32_t *dpni_ids;
+	int num_dpnis;
+	int error;
+
+	if (restool.cmd_option_mask & ONE_BIT_MASK(CONGESTION_GET_OPT_HELP)) {
+		puts(usage_msg);
+		restool.cmd_option_mask &=
+			~ONE_BIT_MASK(CONGESTION_GET_OPT_HELP);
+		return 0;
+	}
+
+	if (restool.obj_name == NULL) {
+		ERROR_PRINTF("<object> argument missing\n");
+		puts(usage_msg);
+		return -EINVAL;
+	}
+
+	if (restool.cmd_option_mask & ONE_BIT_MASK(CONGESTION_GET_OPT_QTYPE)) {
+		restool.cmd_option_mask &=
+			~ONE_BIT_MASK(CONGESTION_GET_OPT_QTYPE);
+		error = parse_queue_type(
+			restool.cmd_option_args[CONGESTION_GET_OPT_QTYPE],
+			&qtype);
+		if (error)
+			return error;
+	}
+
+	error = parse_dpni_list(restool.obj_name, &dpni_ids, &num_dpnis);
+	if (error)
+		return error;
+
+	error = dpni_print_congestion(dpni_ids, num_dpnis, qtype);
+	free(dpni_ids);
+	return error;
+}
+
+static const struct {
+	enum dpni_queue_type qtype;
+	const char *name;
+} dpni_queue_types[] = {
+	{ DPNI_QUEUE_RX, "rx" },
+	{ DPNI_QUEUE_TX, "tx" },
+	{ DPNI_QUEUE_TX_CONFIRM, "tx-confirm" },
+	{ DPNI_QUEUE_RX_ERR, "rx-err" },
+};
+
+static void print_dpni_queue(const char *qtype_name, int tc, int index,
+			     const struct dpni_queue *queue,
+			     const struct dpni_queue_id *qid)
+{
+	char dest[16];
+
+	switch (queue->destination.type) {
+	case DPNI_DEST_DPIO_V10:
+		snprintf(dest, sizeof(dest), "dpio.%u", queue->destination.id);
+		break;
+	case DPNI_DEST_DPCON_V10:
+		snprintf(dest, sizeof(dest), "dpcon.%u", queue->destination.id);
+		break;
+	default:
+		snprintf(dest, sizeof(dest), "none");
+		break;
+	}
+
+	printf("%-10s %2d %5d  %#8x  %-10s %4u  %#18llx  %s\n",
+	       qtype_name, tc, index, qid->fqid, dest,
+	       queue->destination.priority,
+	       (unsigned long long)queue->flc.value,
+	       queue->flc.stash_control ? "on" : "off");
+}
+
+static int print_dpni_queues(uint32_t dpni_id)
+{
+	struct dpni_attr_v10 dpni_attr;
+	struct dpni_queue_id qid;
+	struct dpni_queue queue;
+	int num_tcs, num_queues;
+	enum dpni_queue_type qtype;
+	uint16_t dpni_handle;
+	int error, error2;
+	uint16_t qdid;
+	int ret = 0;
+
+	error = dpni_open_v10(&restool.mc_io, 0, dpni_id, &dpni_handle);
+	if (error < 0) {
+		mc_status = flib_error_to_mc_status(error);
+		ERROR_PRINTF("MC error: %s (status %#x)\n",
+			     mc_status_to_string(mc_status), mc_status);
+		return error;
+	}
+
+	memset(&dpni_attr, 0, sizeof(dpni_attr));
+	error = dpni_get_attributes_v10(&restool.mc_io, 0, dpni_handle,
+					&dpni_attr);
+	if (error < 0) {
+		mc_status = flib_error_to_mc_status(error);
+		ERROR_PRINTF("MC error: %s (status %#x)\n",
+			     mc_status_to_string(mc_status), mc_status);
+		goto out;
+	}
+
+	error = dpni_get_qdid_v10(&restool.mc_io, 0, dpni_handle,
+				  DPNI_QUEUE_TX, &qdid);
+	if (error < 0) {
+		mc_status = flib_error_to_mc_status(error);
+		ERROR_PRINTF("MC error: %s (status %#x)\n",
+			     mc_status_to_string(mc_status), mc_status);
+		goto out;
+	}
+
+	printf("tx qdid: %u\n", qdid);
+	printf("%-10s %2s %5s  %8s  %-10s %4s  %18s  %s\n",
+	       "type", "tc", "queue", "fqid", "dest", "prio", "flc", "stash");
+
+	/*
+	 * Rx and Tx queues exist per traffic class and flow, Tx
+	 * confirmation queues per flow and the Rx error queue once. A
+	 * queue type the MC does not serve is reported and skipped.
+	 */
+	for (unsigned int i = 0; i < ARRAY_SIZE(dpni_queue_types); i++) {
+		qtype = dpni_queue_types[i].qtype;
+		num_tcs = qtype == DPNI_QUEUE_RX ? dpni_attr.num_rx_tcs :
+			  qtype == DPNI_QUEUE_TX ? dpni_attr.num_tx_tcs : 1;
+		num_queues = qtype == DPNI_QUEUE_RX_ERR ? 1 :
+			     dpni_attr.num_queues;
+
+		error = 0;
+		for (int tc = 0; tc < num_tcs && error == 0; tc++) {
+			for (int index = 0; index < num_queues; index++) {
+				memset(&queue, 0, sizeof(queue));
+				memset(&qid, 0, sizeof(qid));
+				error = dpni_get_queue_v10(&restool.mc_io, 0,
+							   dpni_handle, qtype,
+							   tc, index, &queue,
+							   &qid);
+				if (error < 0) {
+					mc_status =
+						flib_error_to_mc_status(error);
+					ERROR_PRINTF("%s queues: MC error: %s (status %#x)\n",
+						     dpni_queue_types[i].name,
+						     mc_status_to_string(mc_status),
+						     mc_status);
+					if (ret == 0)
+						ret = error;
+					break;
+				}
+
+				print_dpni_queue(dpni_queue_types[i].name,
+						 tc, index, &queue, &qid);
+			}
+		}
+	}
+	error = ret;
+
+out:
+	error2 = dpni_close_v10(&restool.mc_io, 0, dpni_handle);
+	if (error2 < 0) {
+		mc_status = flib_error_to_mc_status(error2);
+		ERROR_PRINTF("MC error: %s (status %#x)\n",
+			     mc_status_to_string(mc_status), mc_status);
+		if (error == 0)
+			error = error2;
+	}
+
+	return error;
+}
+
+static int cmd_dpni_queues(void)
+{
+	static const char usage_msg[] =
+		"\n"
+		"Usage: restool dpni queues <dpni-object>\n"
+		"\n"
+		"Lists the Rx, Tx, Tx confirmation and Rx error queues of the\n"
+		"DPNI with their FQID, destination (DPIO or DPCON), priority\n"
+		"within the destination, flow context and stashing control.\n"
+		"\n"
+		"EXAMPLE:\n"
+		"   $ restool dpni queues dpni.1\n"
+		"\n";
+
+	uint32_t dpni_id;
+	int error;
+
+	if (restool.cmd_option_mask & ONE_BIT_MASK(QUEUES_OPT_HELP)) {
+		puts(usage_msg);
+		restool.cmd_option_mask &= ~ONE_BIT_MASK(QUEUES_OPT_HELP);
+		return 0;
+	}
+
+	if (restool.obj_name == NULL) {
+		ERROR_PRINTF("<object> argument missing\n");
+		puts(usage_msg);
+		return -EINVAL;
+	}
+
+	error = parse_object_name(restool.obj_name, "dpni", &dpni_id);
+	if (error < 0)
+		return error;
+
+	return print_dpni_queues(dpni_id);
+}
+
+struct object_command dpni_commands_v9[] = {
+	{ .cmd_name = "help",
+	  .options = NULL,
+	  .cmd_func = cmd_dpni_help },
+
+	{ .cmd_name = "info",
+	  .options = dpni_info_options,
+	  .cmd_func = cmd_dpni_info_v9 },
+
+	{ .cmd_name = "create",
+	  .options = dpni_create_options,
+	  .cmd_func = cmd_dpni_create_v9 },
+
+	{ .cmd_name = "destroy",
+	  .options = dpni_destroy_options,
+	  .cmd_func = cmd_dpni_destroy_v9 },
+
+	{ .cmd_name = NULL },
+};
+
+struct object_command dpni_commands_v10[] = {
+	{ .cmd_name = "help",
 	  .options = NULL,
 	  .cmd_func = cmd_dpni_help_v10 },
 
@@ -1908,6 +4044,58 @@ struct object_command dpni_commands_v10[] = {
 	  .options = dpni_update_options_v10,
 	  .cmd_func = cmd_dpni_update_v10 },
 
+	{ .cmd_name = "set-dist",
+	  .options = dpni_set_dist_options,
+	  .cmd_func = cmd_dpni_set_dist },
+
+	{ .cmd_name = "set-qos",
+	  .options = dpni_set_qos_options,
+	  .cmd_func = cmd_dpni_set_qos },
+
+	{ .cmd_name = "fs-add",
+	  .options = dpni_rule_options,
+	  .cmd_func = cmd_dpni_fs_add },
+
+	{ .cmd_name = "fs-del",
+	  .options = dpni_rule_options,
+	  .cmd_func = cmd_dpni_fs_del },
+
+	{ .cmd_name = "fs-clear",
+	  .options = dpni_clear_options,
+	  .cmd_func = cmd_dpni_fs_clear },
+
+	{ .cmd_name = "qos-add",
+	  .options = dpni_rule_options,
+	  .cmd_func = cmd_dpni_qos_add },
+
+	{ .cmd_name = "qos-del",
+	  .options = dpni_rule_options,
+	  .cmd_func = cmd_dpni_qos_del },
+
+	{ .cmd_name = "qos-clear",
+	  .options = dpni_clear_options,
+	  .cmd_func = cmd_dpni_qos_clear },
+
+	{ .cmd_name = "taildrop-set",
+	  .options = dpni_taildrop_set_options,
+	  .cmd_func = cmd_dpni_taildrop_set },
+
+	{ .cmd_name = "taildrop-get",
+	  .options = dpni_taildrop_get_options,
+	  .cmd_func = cmd_dpni_taildrop_get },
+
+	{ .cmd_name = "congestion-set",
+	  .options = dpni_congestion_set_options,
+	  .cmd_func = cmd_dpni_congestion_set },
+
+	{ .cmd_name = "congestion-get",
+	  .options = dpni_congestion_get_options,
+	  .cmd_func = cmd_dpni_congestion_get },
+
+	{ .cmd_name = "queues",
+	  .options = dpni_queues_options,
+	  .cmd_func = cmd_dpni_queues },
+
 	{ .cmd_name = NULL },
 };
 
@@ -0,0 +1,748 @@
+/* Copyright 2026 NXP
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * * Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ * * Neither the name of the above-listed copyright holders nor the
+ * names of any contributors may be used to endorse or promote products
+ * derived from this software without specific prior written permission.
+ *
+ *
+ * ALTERNATIVELY, this software may be distributed under the terms of the
+ * GNU General Public License ("GPL") as published by the Free Software
+ * Foundation, either version 2 of that License or (at your option) any
+ * later version.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDERS OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <errno.h>
+#include <assert.h>
+#include <ctype.h>
+#include <arpa/inet.h>
+#include "restool.h"
+#include "utils.h"
+#include "dpni_commands_classify.h"
+
+enum mc_cmd_status mc_status;
+
+/**
+ * How the value of a key field is written in a rule
+ */
+enum key_field_format {
+	KEY_FMT_NUM,
+	KEY_FMT_MAC,
+	KEY_FMT_IPV4,
+};
+
+/**
+ * Header field a distribution or classification key can be built from
+ */
+struct dpni_key_field {
+	const char *name;
+	enum net_prot prot;
+	uint32_t field;
+
+	/**
+	 * bytes the field takes in the key
+	 */
+	uint8_t size;
+	enum key_field_format format;
+};
+
+/*
+ * Frames are classified on the outer headers; the MC matches the L4
+ * ports of both TCP and UDP with the UDP fields.
+ */
+static const struct dpni_key_field key_fields[] = {
+	{ "ethsrc", NET_PROT_ETH, NH_FLD_ETH_SA, 6, KEY_FMT_MAC },
+	{ "ethdst", NET_PROT_ETH, NH_FLD_ETH_DA, 6, KEY_FMT_MAC },
+	{ "ethtype", NET_PROT_ETH, NH_FLD_ETH_TYPE, 2, KEY_FMT_NUM },
+	{ "vlan", NET_PROT_VLAN, NH_FLD_VLAN_TCI, 2, KEY_FMT_NUM },
+	{ "ipsrc", NET_PROT_IP, NH_FLD_IP_SRC, 4, KEY_FMT_IPV4 },
+	{ "ipdst", NET_PROT_IP, NH_FLD_IP_DST, 4, KEY_FMT_IPV4 },
+	{ "ipproto", NET_PROT_IP, NH_FLD_IP_PROTO, 1, KEY_FMT_NUM },
+	{ "l4sport", NET_PROT_UDP, NH_FLD_UDP_PORT_SRC, 2, KEY_FMT_NUM },
+	{ "l4dport", NET_PROT_UDP, NH_FLD_UDP_PORT_DST, 2, KEY_FMT_NUM },
+};
+
+static const struct {
+	const char *name;
+	const char *fields;
+} key_presets[] = {
+	{ "5tuple", "ipsrc,ipdst,ipproto,l4sport,l4dport" },
+};
+
+/* distribution sizes supported by the MC */
+static const uint16_t dist_sizes[] = {
+	1, 2, 3, 4, 6, 7, 8, 12, 14, 16, 24, 28, 32, 48, 56, 64, 96, 112, 128,
+	192, 224, 256, 384, 448, 512, 768, 896, 1024,
+};
+
+static const struct dpni_key_field *find_key_field(const char *name)
+{
+	for (unsigned int i = 0; i < ARRAY_SIZE(key_fields); i++) {
+		if (strcmp(key_fields[i].name, name) == 0)
+			return &key_fields[i];
+	}
+
+	return NULL;
+}
+
+static const struct dpni_key_field *
+get_extract_field(const struct dpkg_extract *extract)
+{
+	for (unsigned int i = 0; i < ARRAY_SIZE(key_fields); i++) {
+		if (key_fields[i].prot == extract->extract.from_hdr.prot &&
+		    key_fields[i].field == extract->extract.from_hdr.field)
+			return &key_fields[i];
+	}
+
+	assert(false);
+	return NULL;
+}
+
+static bool key_has_field(const struct dpkg_profile_cfg *cfg,
+			  const struct dpni_key_field *key_field)
+{
+	for (int i = 0; i < cfg->num_extracts; i++) {
+		if (cfg->extracts[i].extract.from_hdr.prot == key_field->prot &&
+		    cfg->extracts[i].extract.from_hdr.field == key_field->field)
+			return true;
+	}
+
+	return false;
+}
+
+int parse_dpni_key(const char *key_str, struct dpkg_profile_cfg *cfg)
+{
+	const struct dpni_key_field *key_field;
+	struct dpkg_extract *extract;
+	char *fields, *name, *saveptr;
+	int error = 0;
+
+	for (unsigned int i = 0; i < ARRAY_SIZE(key_presets); i++) {
+		if (strcmp(key_presets[i].name, key_str) == 0) {
+			key_str = key_presets[i].fields;
+			break;
+		}
+	}
+
+	fields = strdup(key_str);
+	if (fields == NULL) {
+		ERROR_PRINTF("strdup() failed\n");
+		return -ENOMEM;
+	}
+
+	memset(cfg, 0, sizeof(*cfg));
+	for (name = strtok_r(fields, ",", &saveptr); name != NULL;
+	     name = strtok_r(NULL, ",", &saveptr)) {
+		key_field = find_key_field(name);
+		if (key_field == NULL) {
+			ERROR_PRINTF("Invalid key field: %s\n", name);
+			error = -EINVAL;
+			break;
+		}
+
+		if (key_has_field(cfg, key_field)) {
+			ERROR_PRINTF("Key field %s given twice\n", name);
+			error = -EINVAL;
+			break;
+		}
+
+		if (cfg->num_extracts == DPKG_MAX_NUM_OF_EXTRACTS) {
+			ERROR_PRINTF("A key holds at most %d fields\n",
+				     DPKG_MAX_NUM_OF_EXTRACTS);
+			error = -EINVAL;
+			break;
+		}
+
+		extract = &cfg->extracts[cfg->num_extracts++];
+		extract->type = DPKG_EXTRACT_FROM_HDR;
+		extract->extract.from_hdr.prot = key_field->prot;
+		extract->extract.from_hdr.type = DPKG_FULL_FIELD;
+		extract->extract.from_hdr.field = key_field->field;
+	}
+
+	if (error == 0 && cfg->num_extracts == 0) {
+		ERROR_PRINTF("Empty key\n");
+		error = -EINVAL;
+	}
+
+	free(fields);
+	return error;
+}
+
+bool is_valid_dist_size(long dist_size)
+{
+	for (unsigned int i = 0; i < ARRAY_SIZE(dist_sizes); i++) {
+		if (dist_sizes[i] == dist_size)
+			return true;
+	}
+
+	return false;
+}
+
+int dpni_set_dist(uint32_t dpni_id, uint8_t tc_id, uint16_t dist_size,
+		  const struct dpkg_profile_cfg *key_cfg,
+		  enum dpni_dist_mode dist_mode,
+		  const struct dpni_fs_tbl_cfg *fs_cfg)
+{
+	struct dpni_rx_tc_dist_cfg dist_cfg;
+	struct dpni_attr_v10 dpni_attr;
+	uint16_t dpni_handle;
+	void *key_cfg_buf;
+	int error, error2;
+
+	error = dpni_open_v10(&restool.mc_io, 0, dpni_id, &dpni_handle);
+	if (error < 0) {
+		mc_status = flib_error_to_mc_status(error);
+		ERROR_PRINTF("MC error: %s (status %#x)\n",
+			     mc_status_to_string(mc_status), mc_status);
+		return error;
+	}
+
+	memset(&dpni_attr, 0, sizeof(dpni_attr));
+	error = dpni_get_attributes_v10(&restool.mc_io, 0, dpni_handle,
+					&dpni_attr);
+	if (error < 0) {
+		mc_status = flib_error_to_mc_status(error);
+		ERROR_PRINTF("MC error: %s (status %#x)\n",
+			     mc_status_to_string(mc_status), mc_status);
+		goto out;
+	}
+
+	if (tc_id >= dpni_attr.num_rx_tcs) {
+		ERROR_PRINTF("dpni.%u has %u traffic classes\n",
+			     dpni_id, dpni_attr.num_rx_tcs);
+		error = -EINVAL;
+		goto out;
+	}
+
+	if (dist_size > dpni_attr.num_queues) {
+		ERROR_PRINTF("dpni.%u has %u queues per traffic class\n",
+			     dpni_id, dpni_attr.num_queues);
+		error = -EINVAL;
+		goto out;
+	}
+
+	error = alloc_dma_buf(DPNI_KEY_CFG_SIZE, &key_cfg_buf,
+			      &dist_cfg.key_cfg_iova);
+	if (error)
+		goto out;
+
+	error = dpni_prepare_key_cfg(key_cfg, key_cfg_buf);
+	if (error == 0) {
+		dist_cfg.fs_cfg = *fs_cfg;
+		dist_cfg.dist_size = dist_size;
+		dist_cfg.dist_mode = dist_mode;
+		error = dpni_set_rx_tc_dist_v10(&restool.mc_io, 0, dpni_handle,
+						tc_id, &dist_cfg);
+		if (error < 0) {
+			mc_status = flib_error_to_mc_status(error);
+			ERROR_PRINTF("MC error: %s (status %#x)\n",
+				     mc_status_to_string(mc_status), mc_status);
+		}
+	}
+
+	free_dma_buf(key_cfg_buf);
+
+out:
+	error2 = dpni_close_v10(&restool.mc_io, 0, dpni_handle);
+	if (error2 < 0) {
+		mc_status = flib_error_to_mc_status(error2);
+		ERROR_PRINTF("MC error: %s (status %#x)\n",
+			     mc_status_to_string(mc_status), mc_status);
+		if (error == 0)
+			error = error2;
+	}
+
+	return error;
+}
+
+int dpni_set_qos(uint32_t dpni_id, const struct dpkg_profile_cfg *key_cfg,
+		 bool discard_on_miss, uint8_t default_tc)
+{
+	struct dpni_qos_tbl_cfg qos_cfg;
+	uint16_t dpni_handle;
+	void *key_cfg_buf;
+	int error, error2;
+
+	error = dpni_open_v10(&restool.mc_io, 0, dpni_id, &dpni_handle);
+	if (error < 0) {
+		mc_status = flib_error_to_mc_status(error);
+		ERROR_PRINTF("MC error: %s (status %#x)\n",
+			     mc_status_to_string(mc_status), mc_status);
+		return error;
+	}
+
+	error = alloc_dma_buf(DPNI_KEY_CFG_SIZE, &key_cfg_buf,
+			      &qos_cfg.key_cfg_iova);
+	if (error)
+		goto out;
+
+	error = dpni_prepare_key_cfg(key_cfg, key_cfg_buf);
+	if (error == 0) {
+		qos_cfg.discard_on_miss = discard_on_miss;
+		qos_cfg.default_tc = default_tc;
+		error = dpni_set_qos_table_v10(&restool.mc_io, 0, dpni_handle,
+					       &qos_cfg);
+		if (error < 0) {
+			mc_status = flib_error_to_mc_status(error);
+			ERROR_PRINTF("MC error: %s (status %#x)\n",
+				     mc_status_to_string(mc_status), mc_status);
+		}
+	}
+
+	free_dma_buf(key_cfg_buf);
+
+out:
+	error2 = dpni_close_v10(&restool.mc_io, 0, dpni_handle);
+	if (error2 < 0) {
+		mc_status = flib_error_to_mc_status(error2);
+		ERROR_PRINTF("MC error: %s (status %#x)\n",
+			     mc_status_to_string(mc_status), mc_status);
+		if (error == 0)
+			error = error2;
+	}
+
+	return error;
+}
+
+int get_dpni_key_size(const struct dpkg_profile_cfg *key_cfg)
+{
+	int key_size = 0;
+
+	for (int i = 0; i < key_cfg->num_extracts; i++)
+		key_size += get_extract_field(&key_cfg->extracts[i])->size;
+
+	return key_size;
+}
+
+static int parse_mac_value(const char *str, uint8_t *value)
+{
+	unsigned int bytes[6];
+	char end;
+
+	if (sscanf(str, "%2x:%2x:%2x:%2x:%2x:%2x%c", &bytes[0], &bytes[1],
+		   &bytes[2], &bytes[3], &bytes[4], &bytes[5], &end) != 6)
+		return -EINVAL;
+
+	for (int i = 0; i < 6; i++)
+		value[i] = bytes[i];
+
+	return 0;
+}
+
+static int parse_num_value(const char *str, uint8_t size, uint8_t *value)
+{
+	char *endptr;
+	long val;
+
+	errno = 0;
+	val = strtol(str, &endptr, 0);
+	if (STRTOL_ERROR(str, endptr, val, errno) ||
+	    val < 0 || val >= (1L << (8 * size)))
+		return -EINVAL;
+
+	/* keys hold header fields in network order */
+	for (int i = size - 1; i >= 0; i--) {
+		value[i] = val & 0xff;
+		val >>= 8;
+	}
+
+	return 0;
+}
+
+static int parse_field_value(const struct dpni_key_field *key_field,
+			     const char *str, uint8_t *value)
+{
+	switch (key_field->format) {
+	case KEY_FMT_MAC:
+		return parse_mac_value(str, value);
+	case KEY_FMT_IPV4:
+		return inet_pton(AF_INET, str, value) == 1 ? 0 : -EINVAL;
+	case KEY_FMT_NUM:
+		return parse_num_value(str, key_field->size, value);
+	}
+
+	return -EINVAL;
+}
+
+/*
+ * Values of a rule: one per key field, in key order, each one optionally
+ * followed by /<mask> written the same way as the value
+ */
+int parse_dpni_rule_values(const struct dpkg_profile_cfg *key_cfg,
+			   char *values, struct dpni_rule *rule)
+{
+	const struct dpni_key_field *key_field;
+	char *value, *mask, *saveptr;
+	int offset = 0;
+	int i = 0;
+
+	memset(rule->key, 0, sizeof(rule->key));
+	memset(rule->mask, 0xff, sizeof(rule->mask));
+	rule->has_mask = false;
+
+	for (value = strtok_r(values, ",", &saveptr); value != NULL;
+	     value = strtok_r(NULL, ",", &saveptr), i++) {
+		if (i == key_cfg->num_extracts) {
+			ERROR_PRINTF("More values than key fields\n");
+			return -EINVAL;
+		}
+
+		key_field = get_extract_field(&key_cfg->extracts[i]);
+		mask = strchr(value, '/');
+		if (mask != NULL) {
+			*mask++ = '\0';
+			rule->has_mask = true;
+			if (parse_field_value(key_field, mask,
+					      &rule->mask[offset])) {
+				ERROR_PRINTF("Invalid %s mask: %s\n",
+					     key_field->name, mask);
+				return -EINVAL;
+			}
+		}
+
+		if (parse_field_value(key_field, value, &rule->key[offset])) {
+			ERROR_PRINTF("Invalid %s value: %s\n",
+				     key_field->name, value);
+			return -EINVAL;
+		}
+
+		offset += key_field->size;
+	}
+
+	if (i != key_cfg->num_extracts) {
+		ERROR_PRINTF("Fewer values than key fields\n");
+		return -EINVAL;
+	}
+
+	return 0;
+}
+
+/*
+ * Rule file: one entry per line, "<values> [<target>]"; blank lines and
+ * lines starting with '#' are skipped
+ */
+int read_dpni_rule_file(const char *rule_file,
+			const struct dpkg_profile_cfg *key_cfg,
+			bool need_target, struct dpni_rule **rules_out,
+			int *num_rules_out)
+{
+	struct dpni_rule *rules = NULL;
+	struct dpni_rule *new_rules;
+	char *values, *target, *saveptr;
+	int num_rules = 0;
+	int max_rules = 0;
+	char line[256];
+	int line_num = 0;
+	int error = 0;
+	char *endptr;
+	long val;
+	FILE *fp;
+
+	fp = fopen(rule_file, "r");
+	if (fp == NULL) {
+		error = -errno;
+		ERROR_PRINTF("fopen(%s) failed: %s\n", rule_file,
+			     strerror(errno));
+		return error;
+	}
+
+	while (fgets(line, sizeof(line), fp) != NULL) {
+		line_num++;
+		values = strtok_r(line, " \t\r\n", &saveptr);
+		if (values == NULL || values[0] == '#')
+			continue;
+
+		if (num_rules == max_rules) {
+			max_rules = max_rules ? max_rules * 2 : 64;
+			new_rules = realloc(rules, max_rules * sizeof(*rules));
+			if (new_rules == NULL) {
+				ERROR_PRINTF("Could not alloc memory!\n");
+				error = -ENOMEM;
+				break;
+			}
+			rules = new_rules;
+		}
+
+		rules[num_rules].line = line_num;
+		rules[num_rules].target = 0;
+		target = strtok_r(NULL, " \t\r\n", &saveptr);
+		if (need_target) {
+			errno = 0;
+			val = target ? strtol(target, &endptr, 0) : -1;
+			if (target == NULL ||
+			    STRTOL_ERROR(target, endptr, val, errno) ||
+			    val < 0 || val > UINT16_MAX) {
+				ERROR_PRINTF("%s:%d: missing or invalid target\n",
+					     rule_file, line_num);
+				error = -EINVAL;
+				break;
+			}
+			rules[num_rules].target = val;
+		}
+
+		error = parse_dpni_rule_values(key_cfg, values,
+					       &rules[num_rules]);
+		if (error) {
+			ERROR_PRINTF("%s:%d: invalid rule\n", rule_file,
+				     line_num);
+			break;
+		}
+		num_rules++;
+	}
+
+	fclose(fp);
+	if (error) {
+		free(rules);
+		return error;
+	}
+
+	*rules_out = rules;
+	*num_rules_out = num_rules;
+	return 0;
+}
+
+static int apply_rule(uint16_t dpni_handle,
+		      const struct dpni_rule_batch *batch,
+		      const struct dpni_rule *rule, uint16_t index,
+		      void *key_buf, struct dpni_rule_cfg *rule_cfg,
+		      uint64_t mask_iova)
+{
+	struct dpni_fs_action_cfg action;
+	uint8_t *key = key_buf;
+
+	memcpy(key, rule->key, rule_cfg->key_size);
+	memcpy(key + DPNI_MAX_KEY_SIZE, rule->mask, rule_cfg->key_size);
+	rule_cfg->mask_iova = rule->has_mask ? mask_iova : 0;
+
+	if (batch->table == DPNI_TABLE_FS && batch->op == DPNI_RULE_ADD) {
+		memset(&action, 0, sizeof(action));
+		action.flow_id = rule->target;
+		return dpni_add_fs_entry_v10(&restool.mc_io, 0, dpni_handle,
+					     batch->tc_id, index, rule_cfg,
+					     &action);
+	}
+
+	if (batch->table == DPNI_TABLE_FS)
+		return dpni_remove_fs_entry_v10(&restool.mc_io, 0, dpni_handle,
+						batch->tc_id, rule_cfg);
+
+	if (batch->op == DPNI_RULE_ADD)
+		return dpni_add_qos_entry_v10(&restool.mc_io, 0, dpni_handle,
+					      rule_cfg, rule->target, index);
+
+	return dpni_remove_qos_entry_v10(&restool.mc_io, 0, dpni_handle,
+					 rule_cfg);
+}
+
+static int check_rule_batch(uint32_t dpni_id, uint16_t dpni_handle,
+			    const struct dpni_rule_batch *batch,
+			    const struct dpni_rule *rules, int num_rules,
+			    int key_size)
+{
+	struct dpni_attr_v10 dpni_attr;
+	int max_key_size, max_target;
+	int error;
+
+	memset(&dpni_attr, 0, sizeof(dpni_attr));
+	error = dpni_get_attributes_v10(&restool.mc_io, 0, dpni_handle,
+					&dpni_attr);
+	if (error < 0) {
+		mc_status = flib_error_to_mc_status(error);
+		ERROR_PRINTF("MC error: %s (status %#x)\n",
+			     mc_status_to_string(mc_status), mc_status);
+		return error;
+	}
+
+	if (batch->tc_id >= dpni_attr.num_rx_tcs) {
+		ERROR_PRINTF("dpni.%u has %u traffic classes\n",
+			     dpni_id, dpni_attr.num_rx_tcs);
+		return -EINVAL;
+	}
+
+	max_key_size = batch->table == DPNI_TABLE_FS ?
+		       dpni_attr.fs_key_size : dpni_attr.qos_key_size;
+	if (key_size > max_key_size) {
+		ERROR_PRINTF("The key takes %d bytes, dpni.%u %s keys hold %d\n",
+			     key_size, dpni_id,
+			     batch->table == DPNI_TABLE_FS ? "FS" : "QoS",
+			     max_key_size);
+		return -EINVAL;
+	}
+
+	if (batch->op != DPNI_RULE_ADD)
+		return 0;
+
+	/* FS entries pick a queue of the TC, QoS entries pick a TC */
+	max_target = batch->table == DPNI_TABLE_FS ?
+		     dpni_attr.num_queues : dpni_attr.num_rx_tcs;
+	for (int i = 0; i < num_rules; i++) {
+		if (rules[i].target < max_target)
+			continue;
+
+		ERROR_PRINTF("%s %u is out of range, dpni.%u has %d\n",
+			     batch->table == DPNI_TABLE_FS ?
+			     "Flow" : "Traffic class",
+			     rules[i].target, dpni_id, max_target);
+		if (rules[i].line)
+			ERROR_PRINTF("%s:%d: invalid target\n",
+				     batch->rule_file, rules[i].line);
+		return -EINVAL;
+	}
+
+	return 0;
+}
+
+int dpni_update_rules(uint32_t dpni_id, const struct dpni_rule_batch *batch)
+{
+	struct dpni_rule_cfg rule_cfg;
+	struct dpni_rule *rules = NULL;
+	struct dpni_rule rule;
+	uint16_t dpni_handle;
+	uint64_t key_iova;
+	int num_rules = 1;
+	char *values;
+	void *key_buf;
+	int error, error2;
+	int done;
+
+	if (batch->rule_file != NULL) {
+		error = read_dpni_rule_file(batch->rule_file, batch->key_cfg,
+				       batch->op == DPNI_RULE_ADD, &rules,
+				       &num_rules);
+		if (error)
+			return error;
+	} else {
+		values = strdup(batch->rule);
+		if (values == NULL) {
+			ERROR_PRINTF("strdup() failed\n");
+			return -ENOMEM;
+		}
+		rule.line = 0;
+		rule.target = batch->target;
+		error = parse_dpni_rule_values(batch->key_cfg, values, &rule);
+		free(values);
+		if (error)
+			return error;
+		rules = &rule;
+	}
+
+	error = dpni_open_v10(&restool.mc_io, 0, dpni_id, &dpni_handle);
+	if (error < 0) {
+		mc_status = flib_error_to_mc_status(error);
+		ERROR_PRINTF("MC error: %s (status %#x)\n",
+			     mc_status_to_string(mc_status), mc_status);
+		goto free_rules;
+	}
+
+	memset(&rule_cfg, 0, sizeof(rule_cfg));
+	rule_cfg.key_size = get_dpni_key_size(batch->key_cfg);
+	error = check_rule_batch(dpni_id, dpni_handle, batch, rules,
+				 num_rules, rule_cfg.key_size);
+	if (error)
+		goto close;
+
+	/* key and mask share one buffer for the whole batch */
+	error = alloc_dma_buf(2 * DPNI_MAX_KEY_SIZE, &key_buf, &key_iova);
+	if (error)
+		goto close;
+
+	rule_cfg.key_iova = key_iova;
+	for (done = 0; done < num_rules; done++) {
+		error = apply_rule(dpni_handle, batch, &rules[done],
+				   batch->index + done, key_buf, &rule_cfg,
+				   key_iova + DPNI_MAX_KEY_SIZE);
+		if (error < 0) {
+			mc_status = flib_error_to_mc_status(error);
+			if (rules[done].line)
+				ERROR_PRINTF("%s:%d: MC error: %s (status %#x)\n",
+					     batch->rule_file,
+					     rules[done].line,
+					     mc_status_to_string(mc_status),
+					     mc_status);
+			else
+				ERROR_PRINTF("MC error: %s (status %#x)\n",
+					     mc_status_to_string(mc_status),
+					     mc_status);
+			break;
+		}
+	}
+
+	free_dma_buf(key_buf);
+	if (batch->rule_file != NULL)
+		printf("%d of %d entries %s\n", done, num_rules,
+		       batch->op == DPNI_RULE_ADD ? "added" : "removed");
+
+close:
+	error2 = dpni_close_v10(&restool.mc_io, 0, dpni_handle);
+	if (error2 < 0) {
+		mc_status = flib_error_to_mc_status(error2);
+		ERROR_PRINTF("MC error: %s (status %#x)\n",
+			     mc_status_to_string(mc_status), mc_status);
+		if (error == 0)
+			error = error2;
+	}
+free_rules:
+	if (batch->rule_file != NULL)
+		free(rules);
+
+	return error;
+}
+
+int dpni_clear_rules(uint32_t dpni_id, enum dpni_table table, uint8_t tc_id)
+{
+	uint16_t dpni_handle;
+	int error, error2;
+
+	error = dpni_open_v10(&restool.mc_io, 0, dpni_id, &dpni_handle);
+	if (error < 0) {
+		mc_status = flib_error_to_mc_status(error);
+		ERROR_PRINTF("MC error: %s (status %#x)\n",
+			     mc_status_to_string(mc_status), mc_status);
+		return error;
+	}
+
+	if (table == DPNI_TABLE_FS)
+		error = dpni_clear_fs_entries_v10(&restool.mc_io, 0,
+						  dpni_handle, tc_id);
+	else
+		error = dpni_clear_qos_table_v10(&restool.mc_io, 0,
+						 dpni_handle);
+	if (error < 0) {
+		mc_status = flib_error_to_mc_status(error);
+		ERROR_PRINTF("MC error: %s (status %#x)\n",
+			     mc_status_to_string(mc_status), mc_status);
+	}
+
+	error2 = dpni_close_v10(&restool.mc_io, 0, dpni_handle);
+	if (error2 < 0) {
+		mc_status = flib_error_to_mc_status(error2);
+		ERROR_PRINTF("MC error: %s (status %#x)\n",
+			     mc_status_to_string(mc_status), mc_status);
+		if (error == 0)
+			error = error2;
+	}
+
+	return error;
+}
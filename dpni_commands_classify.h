@@ -0,0 +1,146 @@
+/* Copyright 2026 NXP
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * * Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ * * Neither the name of the above-listed copyright holders nor the
+ * names of any contributors may be used to endorse or promote products
+ * derived from this software without specific prior written permission.
+ *
+ *
+ * ALTERNATIVELY, this software may be distributed under the terms of the
+ * GNU General Public License ("GPL") as published by the Free Software
+ * Foundation, either version 2 of that License or (at your option) any
+ * later version.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDERS OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "mc_v10/fsl_dpni.h"
+
+/**
+ * dpni set-dist command
+ */
+
+/*
+ * Fills cfg with the header fields of key_str: a comma separated list of
+ * field names (ipsrc, ipdst, ipproto, l4sport, l4dport, ethsrc, ethdst,
+ * ethtype, vlan) or a preset (5tuple).
+ */
+int parse_dpni_key(const char *key_str, struct dpkg_profile_cfg *cfg);
+
+bool is_valid_dist_size(long dist_size);
+
+int dpni_set_dist(uint32_t dpni_id, uint8_t tc_id, uint16_t dist_size,
+		  const struct dpkg_profile_cfg *key_cfg,
+		  enum dpni_dist_mode dist_mode,
+		  const struct dpni_fs_tbl_cfg *fs_cfg);
+
+/**
+ * dpni set-qos, fs-* and qos-* commands
+ */
+
+enum dpni_table {
+	DPNI_TABLE_FS,
+	DPNI_TABLE_QOS,
+};
+
+enum dpni_rule_op {
+	DPNI_RULE_ADD,
+	DPNI_RULE_DEL,
+};
+
+/**
+ * Entries to add to or remove from a flow steering or QoS table, all in
+ * one MC session
+ */
+struct dpni_rule_batch {
+	enum dpni_table table;
+	enum dpni_rule_op op;
+
+	/**
+	 * flow steering table, unused for QoS
+	 */
+	uint8_t tc_id;
+
+	/**
+	 * key profile the table was set up with
+	 */
+	const struct dpkg_profile_cfg *key_cfg;
+
+	/**
+	 * either a single rule and its target (flow id or traffic class),
+	 * or a file of rules
+	 */
+	const char *rule;
+	uint16_t target;
+	const char *rule_file;
+
+	/**
+	 * table position of the first entry, used by tables with masking
+	 */
+	uint16_t index;
+};
+
+int dpni_set_qos(uint32_t dpni_id, const struct dpkg_profile_cfg *key_cfg,
+		 bool discard_on_miss, uint8_t default_tc);
+
+int dpni_update_rules(uint32_t dpni_id, const struct dpni_rule_batch *batch);
+
+int dpni_clear_rules(uint32_t dpni_id, enum dpni_table table, uint8_t tc_id);
+
+/**
+ * Rules parsing, shared with the dpdmux rule-* commands
+ */
+
+/**
+ * Flow steering or QoS table entry, as handed to the MC
+ */
+struct dpni_rule {
+	uint8_t key[DPNI_MAX_KEY_SIZE];
+	uint8_t mask[DPNI_MAX_KEY_SIZE];
+	bool has_mask;
+
+	/**
+	 * flow id of a flow steering entry, traffic class of a QoS entry,
+	 * interface of a DPDMUX entry
+	 */
+	uint16_t target;
+
+	/**
+	 * line of the rule file the entry comes from, 0 for --rule
+	 */
+	int line;
+};
+
+int get_dpni_key_size(const struct dpkg_profile_cfg *key_cfg);
+
+/*
+ * Values of a rule: one per key field, in key order, each one optionally
+ * followed by /<mask> written the same way as the value
+ */
+int parse_dpni_rule_values(const struct dpkg_profile_cfg *key_cfg,
+			   char *values, struct dpni_rule *rule);
+
+/*
+ * Rule file: one entry per line, "<values> [<target>]"; blank lines and
+ * lines starting with '#' are skipped
+ */
+int read_dpni_rule_file(const char *rule_file,
+			const struct dpkg_profile_cfg *key_cfg,
+			bool need_target, struct dpni_rule **rules_out,
+			int *num_rules_out);
@@ -0,0 +1,394 @@
+/* Copyright 2026 NXP
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * * Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ * * Neither the name of the above-listed copyright holders nor the
+ * names of any contributors may be used to endorse or promote products
+ * derived from this software without specific prior written permission.
+ *
+ *
+ * ALTERNATIVELY, this software may be distributed under the terms of the
+ * GNU General Public License ("GPL") as published by the Free Software
+ * Foundation, either version 2 of that License or (at your option) any
+ * later version.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDERS OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <errno.h>
+#include "restool.h"
+#include "utils.h"
+#include "dpni_commands_congestion.h"
+
+enum mc_cmd_status mc_status;
+
+/**
+ * Work done on one open DPNI by a taildrop or congestion command
+ */
+typedef int dpni_visitor_t(uint32_t dpni_id, uint16_t dpni_handle,
+			   const struct dpni_attr_v10 *dpni_attr,
+			   const void *arg);
+
+int parse_dpni_list(const char *list_str, uint32_t **dpni_ids,
+		    int *num_dpnis)
+{
+	char *names, *name, *saveptr;
+	uint32_t *ids;
+	int num_ids = 1;
+	int error = 0;
+	int n = 0;
+
+	for (const char *c = list_str; *c != '\0'; c++) {
+		if (*c == ',')
+			num_ids++;
+	}
+
+	names = strdup(list_str);
+	ids = malloc(num_ids * sizeof(*ids));
+	if (names == NULL || ids == NULL) {
+		ERROR_PRINTF("Could not alloc memory!\n");
+		free(names);
+		free(ids);
+		return -ENOMEM;
+	}
+
+	for (name = strtok_r(names, ",", &saveptr); name != NULL;
+	     name = strtok_r(NULL, ",", &saveptr)) {
+		error = parse_object_name(name, "dpni", &ids[n]);
+		if (error < 0)
+			break;
+		n++;
+	}
+
+	free(names);
+	if (error == 0 && n == 0) {
+		ERROR_PRINTF("No DPNI given\n");
+		error = -EINVAL;
+	}
+
+	if (error < 0) {
+		free(ids);
+		return error;
+	}
+
+	*dpni_ids = ids;
+	*num_dpnis = n;
+	return 0;
+}
+
+/*
+ * Opens each DPNI in turn and hands it to visit. A failing DPNI does not
+ * stop the others; the first error is returned.
+ */
+static int for_each_dpni(const uint32_t *dpni_ids, int num_dpnis,
+			 dpni_visitor_t *visit, const void *arg)
+{
+	struct dpni_attr_v10 dpni_attr;
+	uint16_t dpni_handle;
+	int error, error2;
+	int ret = 0;
+
+	for (int i = 0; i < num_dpnis; i++) {
+		error = dpni_open_v10(&restool.mc_io, 0, dpni_ids[i],
+				      &dpni_handle);
+		if (error < 0) {
+			mc_status = flib_error_to_mc_status(error);
+			ERROR_PRINTF("dpni.%u: MC error: %s (status %#x)\n",
+				     dpni_ids[i],
+				     mc_status_to_string(mc_status), mc_status);
+			if (ret == 0)
+				ret = error;
+			continue;
+		}
+
+		memset(&dpni_attr, 0, sizeof(dpni_attr));
+		error = dpni_get_attributes_v10(&restool.mc_io, 0, dpni_handle,
+						&dpni_attr);
+		if (error < 0) {
+			mc_status = flib_error_to_mc_status(error);
+			ERROR_PRINTF("dpni.%u: MC error: %s (status %#x)\n",
+				     dpni_ids[i],
+				     mc_status_to_string(mc_status), mc_status);
+		} else {
+			error = visit(dpni_ids[i], dpni_handle, &dpni_attr,
+				      arg);
+		}
+
+		error2 = dpni_close_v10(&restool.mc_io, 0, dpni_handle);
+		if (error2 < 0) {
+			mc_status = flib_error_to_mc_status(error2);
+			ERROR_PRINTF("dpni.%u: MC error: %s (status %#x)\n",
+				     dpni_ids[i],
+				     mc_status_to_string(mc_status), mc_status);
+			if (error == 0)
+				error = error2;
+		}
+
+		if (ret == 0)
+			ret = error;
+	}
+
+	return ret;
+}
+
+/*
+ * Traffic classes having a congestion group of their own: a DPNI created
+ * with DPNI_OPT_SHARED_CONGESTION has a single group for all of them.
+ */
+static int get_num_tcs(const struct dpni_attr_v10 *dpni_attr,
+		       enum dpni_queue_type qtype, bool per_group)
+{
+	if (per_group && (dpni_attr->options & DPNI_OPT_SHARED_CONGESTION))
+		return 1;
+
+	return qtype == DPNI_QUEUE_TX ? dpni_attr->num_tx_tcs :
+					dpni_attr->num_rx_tcs;
+}
+
+static int get_range(uint32_t dpni_id, const char *what, int index, int num,
+		     int *first, int *last)
+{
+	if (index == DPNI_ALL) {
+		*first = 0;
+		*last = num - 1;
+		return 0;
+	}
+
+	if (index >= num) {
+		ERROR_PRINTF("dpni.%u has %d %s\n", dpni_id, num, what);
+		return -EINVAL;
+	}
+
+	*first = index;
+	*last = index;
+	return 0;
+}
+
+static const char *units_to_string(enum dpni_congestion_unit units)
+{
+	return units == DPNI_CONGESTION_UNIT_FRAMES ? "frames" : "bytes";
+}
+
+static int set_dpni_taildrop(uint32_t dpni_id, uint16_t dpni_handle,
+			     const struct dpni_attr_v10 *dpni_attr,
+			     const void *arg)
+{
+	const struct dpni_taildrop_req *req = arg;
+	int first_tc, last_tc, first_queue, last_queue;
+	bool per_group = req->cg_point == DPNI_CP_GROUP;
+	int error;
+
+	error = get_range(dpni_id, "congestion groups", req->tc,
+			  get_num_tcs(dpni_attr, DPNI_QUEUE_RX, per_group),
+			  &first_tc, &last_tc);
+	if (error)
+		return error;
+
+	if (per_group) {
+		first_queue = 0;
+		last_queue = 0;
+	} else {
+		error = get_range(dpni_id, "queues per traffic class",
+				  req->queue, dpni_attr->num_queues,
+				  &first_queue, &last_queue);
+		if (error)
+			return error;
+	}
+
+	for (int tc = first_tc; tc <= last_tc; tc++) {
+		for (int queue = first_queue; queue <= last_queue; queue++) {
+			error = dpni_set_taildrop_v10(&restool.mc_io, 0,
+						      dpni_handle,
+						      req->cg_point,
+						      DPNI_QUEUE_RX, tc, queue,
+						      &req->taildrop);
+			if (error < 0) {
+				mc_status = flib_error_to_mc_status(error);
+				ERROR_PRINTF("dpni.%u tc %d queue %d: MC error: %s (status %#x)\n",
+					     dpni_id, tc, queue,
+					     mc_status_to_string(mc_status),
+					     mc_status);
+				return error;
+			}
+		}
+	}
+
+	return 0;
+}
+
+int dpni_set_taildrop(const uint32_t *dpni_ids, int num_dpnis,
+		      const struct dpni_taildrop_req *req)
+{
+	return for_each_dpni(dpni_ids, num_dpnis, set_dpni_taildrop, req);
+}
+
+static int print_dpni_taildrop(uint32_t dpni_id, uint16_t dpni_handle,
+			       const struct dpni_attr_v10 *dpni_attr,
+			       const void *arg)
+{
+	const enum dpni_congestion_point *cg_point = arg;
+	bool per_group = *cg_point == DPNI_CP_GROUP;
+	int num_tcs = get_num_tcs(dpni_attr, DPNI_QUEUE_RX, per_group);
+	int num_queues = per_group ? 1 : dpni_attr->num_queues;
+	struct dpni_taildrop taildrop;
+	int error;
+
+	printf("dpni.%u:\n", dpni_id);
+	for (int tc = 0; tc < num_tcs; tc++) {
+		for (int queue = 0; queue < num_queues; queue++) {
+			memset(&taildrop, 0, sizeof(taildrop));
+			error = dpni_get_taildrop_v10(&restool.mc_io, 0,
+						      dpni_handle, *cg_point,
+						      DPNI_QUEUE_RX, tc, queue,
+						      &taildrop);
+			if (error < 0) {
+				mc_status = flib_error_to_mc_status(error);
+				ERROR_PRINTF("dpni.%u tc %d queue %d: MC error: %s (status %#x)\n",
+					     dpni_id, tc, queue,
+					     mc_status_to_string(mc_status),
+					     mc_status);
+				return error;
+			}
+
+			if (per_group)
+				printf("tc %d taildrop: ", tc);
+			else
+				printf("tc %d queue %d taildrop: ", tc, queue);
+
+			if (taildrop.enable)
+				printf("%u %s\n", taildrop.threshold,
+				       units_to_string(taildrop.units));
+			else
+				printf("disabled\n");
+		}
+	}
+
+	return 0;
+}
+
+int dpni_print_taildrop(const uint32_t *dpni_ids, int num_dpnis,
+			enum dpni_congestion_point cg_point)
+{
+	return for_each_dpni(dpni_ids, num_dpnis, print_dpni_taildrop,
+			     &cg_point);
+}
+
+static int set_dpni_congestion(uint32_t dpni_id, uint16_t dpni_handle,
+			       const struct dpni_attr_v10 *dpni_attr,
+			       const void *arg)
+{
+	const struct dpni_congestion_req *req = arg;
+	int first_tc, last_tc;
+	int error;
+
+	error = get_range(dpni_id, "congestion groups", req->tc,
+			  get_num_tcs(dpni_attr, req->qtype, true),
+			  &first_tc, &last_tc);
+	if (error)
+		return error;
+
+	for (int tc = first_tc; tc <= last_tc; tc++) {
+		error = dpni_set_congestion_notification_v10(&restool.mc_io, 0,
+							     dpni_handle,
+							     req->qtype, tc,
+							     &req->cfg);
+		if (error < 0) {
+			mc_status = flib_error_to_mc_status(error);
+			ERROR_PRINTF("dpni.%u tc %d: MC error: %s (status %#x)\n",
+				     dpni_id, tc,
+				     mc_status_to_string(mc_status), mc_status);
+			return error;
+		}
+	}
+
+	return 0;
+}
+
+int dpni_set_congestion(const uint32_t *dpni_ids, int num_dpnis,
+			const struct dpni_congestion_req *req)
+{
+	return for_each_dpni(dpni_ids, num_dpnis, set_dpni_congestion, req);
+}
+
+static void print_congestion_cfg(const struct dpni_congestion_notification_cfg *cfg)
+{
+	if (cfg->threshold_entry == 0 && cfg->notification_mode == 0) {
+		printf("disabled\n");
+		return;
+	}
+
+	printf("entry %u, exit %u %s", cfg->threshold_entry,
+	       cfg->threshold_exit, units_to_string(cfg->units));
+
+	if (cfg->dest_cfg.dest_type == DPNI_DEST_DPIO_V10)
+		printf(", notify dpio.%d", cfg->dest_cfg.dest_id);
+	else if (cfg->dest_cfg.dest_type == DPNI_DEST_DPCON_V10)
+		printf(", notify dpcon.%d", cfg->dest_cfg.dest_id);
+	if (cfg->dest_cfg.dest_type != DPNI_DEST_NONE_V10)
+		printf(" priority %u", cfg->dest_cfg.priority);
+
+	if (cfg->notification_mode & (DPNI_CONG_OPT_WRITE_MEM_ON_ENTER |
+				      DPNI_CONG_OPT_WRITE_MEM_ON_EXIT))
+		printf(", write to %#llx",
+		       (unsigned long long)cfg->message_iova);
+
+	if (cfg->notification_mode & DPNI_CONG_OPT_FLOW_CONTROL)
+		printf(", flow control");
+
+	printf("\n");
+}
+
+static int print_dpni_congestion(uint32_t dpni_id, uint16_t dpni_handle,
+				 const struct dpni_attr_v10 *dpni_attr,
+				 const void *arg)
+{
+	const enum dpni_queue_type *qtype = arg;
+	struct dpni_congestion_notification_cfg cfg;
+	int num_tcs = get_num_tcs(dpni_attr, *qtype, true);
+	int error;
+
+	printf("dpni.%u:\n", dpni_id);
+	for (int tc = 0; tc < num_tcs; tc++) {
+		memset(&cfg, 0, sizeof(cfg));
+		error = dpni_get_congestion_notification_v10(&restool.mc_io, 0,
+							     dpni_handle,
+							     *qtype, tc, &cfg);
+		if (error < 0) {
+			mc_status = flib_error_to_mc_status(error);
+			ERROR_PRINTF("dpni.%u tc %d: MC error: %s (status %#x)\n",
+				     dpni_id, tc,
+				     mc_status_to_string(mc_status), mc_status);
+			return error;
+		}
+
+		printf("tc %d congestion: ", tc);
+		print_congestion_cfg(&cfg);
+	}
+
+	return 0;
+}
+
+int dpni_print_congestion(const uint32_t *dpni_ids, int num_dpnis,
+			  enum dpni_queue_type qtype)
+{
+	return for_each_dpni(dpni_ids, num_dpnis, print_dpni_congestion,
+			     &qtype);
+}
@@ -0,0 +1,83 @@
+/* Copyright 2026 NXP
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * * Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ * * Neither the name of the above-listed copyright holders nor the
+ * names of any contributors may be used to endorse or promote products
+ * derived from this software without specific prior written permission.
+ *
+ *
+ * ALTERNATIVELY, this software may be distributed under the terms of the
+ * GNU General Public License ("GPL") as published by the Free Software
+ * Foundation, either version 2 of that License or (at your option) any
+ * later version.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDERS OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "mc_v10/fsl_dpni.h"
+
+/**
+ * dpni taildrop-* and congestion-* commands
+ */
+
+/**
+ * Traffic class or queue argument standing for all of them
+ */
+#define DPNI_ALL	(-1)
+
+/**
+ * Parses a comma separated list of DPNIs (e.g. dpni.1,dpni.2) into an
+ * array to be freed by the caller
+ */
+int parse_dpni_list(const char *list_str, uint32_t **dpni_ids,
+		    int *num_dpnis);
+
+struct dpni_taildrop_req {
+	enum dpni_congestion_point cg_point;
+
+	/**
+	 * traffic class and queue to configure, or DPNI_ALL; queue is
+	 * unused for DPNI_CP_GROUP
+	 */
+	int tc;
+	int queue;
+	struct dpni_taildrop taildrop;
+};
+
+int dpni_set_taildrop(const uint32_t *dpni_ids, int num_dpnis,
+		      const struct dpni_taildrop_req *req);
+
+int dpni_print_taildrop(const uint32_t *dpni_ids, int num_dpnis,
+			enum dpni_congestion_point cg_point);
+
+struct dpni_congestion_req {
+	enum dpni_queue_type qtype;
+
+	/**
+	 * traffic class to configure, or DPNI_ALL
+	 */
+	int tc;
+	struct dpni_congestion_notification_cfg cfg;
+};
+
+int dpni_set_congestion(const uint32_t *dpni_ids, int num_dpnis,
+			const struct dpni_congestion_req *req);
+
+int dpni_print_congestion(const uint32_t *dpni_ids, int num_dpnis,
+			  enum dpni_queue_type qtype);
@@ -42,6 +42,26 @@
 #include "restool.h"
 #include "utils.h"
 #include "dprc_commands_generate_dpl.h"
+#include "dprc_commands_clone.h"
+#include "dprc_commands_apply_dpl.h"
+#include "mc_v9/fsl_dpaiop.h"
+#include "mc_v9/fsl_dpbp.h"
+#include "mc_v9/fsl_dpci.h"
+#include "mc_v9/fsl_dpcon.h"
+#include "mc_v10/fsl_dpaiop.h"
+#include "mc_v10/fsl_dpbp.h"
+#include "mc_v10/fsl_dpci.h"
+#include "mc_v10/fsl_dpcon.h"
+#include "mc_v10/fsl_dpdcei.h"
+#include "mc_v10/fsl_dpdmai.h"
+#include "mc_v10/fsl_dpdmux.h"
+#include "mc_v10/fsl_dpio.h"
+#include "mc_v10/fsl_dpmac.h"
+#include "mc_v10/fsl_dpmcp.h"
+#include "mc_v10/fsl_dpni.h"
+#include "mc_v10/fsl_dprtc.h"
+#include "mc_v10/fsl_dpseci.h"
+#include "mc_v10/fsl_dpsw.h"
 
 #define ALL_DPRC_OPTS (				\
 	DPRC_CFG_OPT_SPAWN_ALLOWED |		\
@@ -175,6 +195,8 @@ C_ASSERT(ARRAY_SIZE(dprc_create_child_options) <= MAX_NUM_CMD_LINE_OPTIONS + 1);
  */
 enum dprc_destroy_options {
 	DESTROY_OPT_HELP = 0,
+	DESTROY_OPT_RECURSIVE,
+	DESTROY_OPT_UNBIND,
 };
 
 static struct option dprc_destroy_options[] = {
@@ -182,6 +204,14 @@ static struct option dprc_destroy_options[] = {
 		.name = "help",
 	},
 
+	[DESTROY_OPT_RECURSIVE] = {
+		.name = "recursive",
+	},
+
+	[DESTROY_OPT_UNBIND] = {
+		.name = "unbind",
+	},
+
 	{ 0 },
 };
 
@@ -266,6 +296,7 @@ enum dprc_connect_options {
 	CONNECT_OPT_ENDPOINT2,
 	CONNECT_OPT_COMMITTED_RATE,
 	CONNECT_OPT_MAX_RATE,
+	CONNECT_OPT_LINKS,
 };
 
 static struct option dprc_connect_options[] = {
@@ -296,6 +327,11 @@ static struct option dprc_connect_options[] = {
 		.flag = NULL,
 		.val = 0,
 	},
+
+	[CONNECT_OPT_LINKS] = {
+		.name = "links",
+		.has_arg = 1,
+	},
 	{ 0 },
 };
 
@@ -307,6 +343,7 @@ C_ASSERT(ARRAY_SIZE(dprc_connect_options) <= MAX_NUM_CMD_LINE_OPTIONS + 1);
 enum dprc_disconnect_options {
 	DISCONNECT_OPT_HELP = 0,
 	DISCONNECT_OPT_ENDPOINT,
+	DISCONNECT_OPT_LINKS,
 };
 
 static struct option dprc_disconnect_options[] = {
@@ -319,6 +356,11 @@ static struct option dprc_disconnect_options[] = {
 		.has_arg = 1,
 	},
 
+	[DISCONNECT_OPT_LINKS] = {
+		.name = "links",
+		.has_arg = 1,
+	},
+
 	{ 0 },
 };
 
@@ -329,6 +371,7 @@ C_ASSERT(ARRAY_SIZE(dprc_disconnect_options) <= MAX_NUM_CMD_LINE_OPTIONS + 1);
  */
 enum dpl_generate_options {
 	GENERATE_OPT_HELP = 0,
+	GENERATE_OPT_OUTPUT,
 };
 
 struct option dpl_generate_options[] = {
@@ -336,12 +379,74 @@ struct option dpl_generate_options[] = {
 		.name = "help",
 	},
 
+	[GENERATE_OPT_OUTPUT] = {
+		.name = "output",
+		.has_arg = 1,
+	},
+
 	{ 0 },
 };
 
 C_ASSERT(ARRAY_SIZE(dpl_generate_options) <= MAX_NUM_CMD_LINE_OPTIONS + 1);
 
-static const struct flib_ops dprc_ops = {
+/**
+ * dprc clone command options
+ */
+enum dprc_clone_options {
+	CLONE_OPT_HELP = 0,
+	CLONE_OPT_COUNT,
+	CLONE_OPT_PARENT,
+};
+
+static struct option dprc_clone_options[] = {
+	[CLONE_OPT_HELP] = {
+		.name = "help",
+	},
+
+	[CLONE_OPT_COUNT] = {
+		.name = "count",
+		.has_arg = 1,
+	},
+
+	[CLONE_OPT_PARENT] = {
+		.name = "parent",
+		.has_arg = 1,
+	},
+
+	{ 0 },
+};
+
+C_ASSERT(ARRAY_SIZE(dprc_clone_options) <= MAX_NUM_CMD_LINE_OPTIONS + 1);
+
+/**
+ * dprc apply-dpl command options
+ */
+enum dprc_apply_dpl_options {
+	APPLY_DPL_OPT_HELP = 0,
+	APPLY_DPL_OPT_CONTAINER,
+	APPLY_DPL_OPT_DRY_RUN,
+};
+
+static struct option dprc_apply_dpl_options[] = {
+	[APPLY_DPL_OPT_HELP] = {
+		.name = "help",
+	},
+
+	[APPLY_DPL_OPT_CONTAINER] = {
+		.name = "container",
+		.has_arg = 1,
+	},
+
+	[APPLY_DPL_OPT_DRY_RUN] = {
+		.name = "dry-run",
+	},
+
+	{ 0 },
+};
+
+C_ASSERT(ARRAY_SIZE(dprc_apply_dpl_options) <= MAX_NUM_CMD_LINE_OPTIONS + 1);
+
+const struct flib_ops dprc_ops = {
 	.obj_open = dprc_open,
 	.obj_close = dprc_close,
 	.obj_get_irq_mask = dprc_get_irq_mask,
@@ -369,15 +474,20 @@ static int cmd_dprc_help(void)
 		"   show         - displays the object contents of a DPRC object.\n"
 		"   info         - displays detailed information about a DPRC object.\n"
 		"   create       - creates a new child DPRC under the specified parent.\n"
-		"   destroy      - destroys a child DPRC under the specified parent.\n"
+		"   destroy      - destroys a child DPRC under the specified parent,\n"
+		"		   optionally with all the objects it holds.\n"
 		"   assign       - moves an object from a parent container to a child container.\n"
 		"                  change an object's plugged state\n"
 		"   unassign     - moves an object from a child container to a parent container.\n"
 		"   set-label    - sets label/alias for any objects except root container.\n"
-		"   connect      - connects 2 objects, creating a link between them.\n"
+		"   connect      - connects 2 objects, creating a link between them,\n"
+		"		   or all links listed in a file.\n"
 		"   disconnect   - removes the link between two objects. Either endpoint can\n"
 		"		   be specified as the target of the operation.\n"
 		"   generate-dpl - generate DPL syntax for the specified container\n"
+		"   clone        - creates copies of a container with its objects and links.\n"
+		"   apply-dpl    - creates the containers, objects and links of a DPL file.\n"
+		"   reconcile    - changes the live containers to match a DPL file.\n"
 		"\n"
 		"For command-specific help, use the --help option of each command.\n"
 		"\n";
@@ -957,7 +1067,7 @@ static int print_dprc_info(uint32_t dprc_id)
 
 	if (restool.cmd_option_mask & ONE_BIT_MASK(INFO_OPT_VERBOSE)) {
 		restool.cmd_option_mask &= ~ONE_BIT_MASK(INFO_OPT_VERBOSE);
-		error = print_obj_verbose(&target_obj_desc, &dprc_ops);
+		error = print_obj_verbose(&target_obj_desc);
 	}
 
 out:
@@ -1185,14 +1295,495 @@ out:
 	return error;
 }
 
+typedef int flib_obj_destroy_v9_t(struct fsl_mc_io *mc_io,
+				  uint32_t cmd_flags,
+				  uint16_t token);
+typedef int flib_obj_destroy_v10_t(struct fsl_mc_io *mc_io,
+				   uint16_t dprc_token,
+				   uint32_t cmd_flags,
+				   uint32_t obj_id);
+
+/**
+ * Per object type operations needed to destroy an object. MC v9 objects
+ * are destroyed through their own control session, MC v10 objects through
+ * the container that holds them.
+ */
+struct obj_destroy_ops {
+	const char *obj_type;
+	flib_obj_open_t *obj_open;
+	flib_obj_close_t *obj_close;
+	flib_obj_destroy_v9_t *obj_destroy_v9;
+	flib_obj_destroy_v10_t *obj_destroy_v10;
+};
+
+static const struct obj_destroy_ops obj_destroy_ops[] = {
+	{ "dpaiop", dpaiop_open, dpaiop_close, dpaiop_destroy,
+	  dpaiop_destroy_v10 },
+	{ "dpbp", dpbp_open, dpbp_close, dpbp_destroy, dpbp_destroy_v10 },
+	{ "dpci", dpci_open, dpci_close, dpci_destroy, dpci_destroy_v10 },
+	{ "dpcon", dpcon_open, dpcon_close, dpcon_destroy, dpcon_destroy_v10 },
+	{ "dpdcei", dpdcei_open, dpdcei_close, dpdcei_destroy,
+	  dpdcei_destroy_v10 },
+	{ "dpdmai", dpdmai_open, dpdmai_close, dpdmai_destroy,
+	  dpdmai_destroy_v10 },
+	{ "dpdmux", dpdmux_open, dpdmux_close, dpdmux_destroy,
+	  dpdmux_destroy_v10 },
+	{ "dpio", dpio_open, dpio_close, dpio_destroy, dpio_destroy_v10 },
+	{ "dpmac", dpmac_open, dpmac_close, dpmac_destroy, dpmac_destroy_v10 },
+	{ "dpmcp", dpmcp_open, dpmcp_close, dpmcp_destroy, dpmcp_destroy_v10 },
+	{ "dpni", dpni_open, dpni_close, dpni_destroy, dpni_destroy_v10 },
+	{ "dprtc", dprtc_open, dprtc_close, dprtc_destroy, dprtc_destroy_v10 },
+	{ "dpseci", dpseci_open, dpseci_close, dpseci_destroy,
+	  dpseci_destroy_v10 },
+	{ "dpsw", dpsw_open, dpsw_close, dpsw_destroy, dpsw_destroy_v10 },
+};
+
+static const struct obj_destroy_ops *get_obj_destroy_ops(const char *obj_type)
+{
+	for (unsigned int i = 0; i < ARRAY_SIZE(obj_destroy_ops); i++) {
+		if (strcmp(obj_destroy_ops[i].obj_type, obj_type) == 0)
+			return &obj_destroy_ops[i];
+	}
+
+	return NULL;
+}
+
+static int destroy_obj(const struct dprc_obj_desc *obj_desc,
+		       uint16_t dprc_handle)
+{
+	const struct obj_destroy_ops *ops;
+	uint16_t obj_handle;
+	int error, error2;
+
+	ops = get_obj_destroy_ops(obj_desc->type);
+	if (ops == NULL) {
+		ERROR_PRINTF("%s.%d cannot be destroyed\n",
+			     obj_desc->type, obj_desc->id);
+		return -EINVAL;
+	}
+
+	if (restool.mc_fw_version.major == MC_FW_VERSION_9) {
+		error = ops->obj_open(&restool.mc_io, 0, obj_desc->id,
+				      &obj_handle);
+		if (error == 0) {
+			error = ops->obj_destroy_v9(&restool.mc_io, 0,
+						    obj_handle);
+			if (error < 0) {
+				error2 = ops->obj_close(&restool.mc_io, 0,
+							obj_handle);
+				if (error2 < 0)
+					DEBUG_PRINTF("close failed with error %d\n",
+						     error2);
+			}
+		}
+	} else {
+		error = ops->obj_destroy_v10(&restool.mc_io, dprc_handle, 0,
+					     obj_desc->id);
+	}
+
+	if (error < 0) {
+		mc_status = flib_error_to_mc_status(error);
+		ERROR_PRINTF("%s.%d: MC error: %s (status %#x)\n",
+			     obj_desc->type, obj_desc->id,
+			     mc_status_to_string(mc_status), mc_status);
+		return error;
+	}
+
+	printf("%s.%d is destroyed\n", obj_desc->type, obj_desc->id);
+	return 0;
+}
+
+/**
+ * Returns the number of endpoints an object can be connected through
+ */
+static int get_num_endpoints(const struct dprc_obj_desc *obj_desc,
+			     uint16_t *num_ifs)
+{
+	uint16_t obj_handle;
+	int error, error2;
+
+	*num_ifs = 0;
+	if (strcmp(obj_desc->type, "dpni") == 0 ||
+	    strcmp(obj_desc->type, "dpmac") == 0 ||
+	    strcmp(obj_desc->type, "dpci") == 0) {
+		*num_ifs = 1;
+		return 0;
+	}
+
+	if (strcmp(obj_desc->type, "dpsw") == 0) {
+		error = dpsw_open(&restool.mc_io, 0, obj_desc->id,
+				  &obj_handle);
+		if (error < 0)
+			goto out;
+
+		if (restool.mc_fw_version.major == MC_FW_VERSION_9) {
+			struct dpsw_attr_v9 dpsw_attr;
+
+			error = dpsw_get_attributes_v9(&restool.mc_io, 0,
+						       obj_handle, &dpsw_attr);
+			*num_ifs = dpsw_attr.num_ifs;
+		} else {
+			struct dpsw_attr_v10 dpsw_attr;
+
+			error = dpsw_get_attributes_v10(&restool.mc_io, 0,
+							obj_handle,
+							&dpsw_attr);
+			*num_ifs = dpsw_attr.num_ifs;
+		}
+
+		error2 = dpsw_close(&restool.mc_io, 0, obj_handle);
+		if (error == 0)
+			error = error2;
+	} else if (strcmp(obj_desc->type, "dpdmux") == 0) {
+		error = dpdmux_open(&restool.mc_io, 0, obj_desc->id,
+				    &obj_handle);
+		if (error < 0)
+			goto out;
+
+		/* the uplink interface 0 is not counted in num_ifs */
+		if (restool.mc_fw_version.major == MC_FW_VERSION_9) {
+			struct dpdmux_attr_v9 dpdmux_attr;
+
+			error = dpdmux_get_attributes_v9(&restool.mc_io, 0,
+							 obj_handle,
+							 &dpdmux_attr);
+			*num_ifs = dpdmux_attr.num_ifs + 1;
+		} else {
+			struct dpdmux_attr_v10 dpdmux_attr;
+
+			error = dpdmux_get_attributes_v10(&restool.mc_io, 0,
+							  obj_handle,
+							  &dpdmux_attr);
+			*num_ifs = dpdmux_attr.num_ifs + 1;
+		}
+
+		error2 = dpdmux_close(&restool.mc_io, 0, obj_handle);
+		if (error == 0)
+			error = error2;
+	} else {
+		return 0;
+	}
+
+out:
+	if (error < 0) {
+		mc_status = flib_error_to_mc_status(error);
+		ERROR_PRINTF("%s.%d: MC error: %s (status %#x)\n",
+			     obj_desc->type, obj_desc->id,
+			     mc_status_to_string(mc_status), mc_status);
+		*num_ifs = 0;
+	}
+
+	return error;
+}
+
+/**
+ * Removes all links of an object. Disconnect is issued on the root
+ * container, which is an ancestor of both ends of any link.
+ */
+static int disconnect_obj(const struct dprc_obj_desc *obj_desc)
+{
+	struct dprc_endpoint endpoint1;
+	struct dprc_endpoint endpoint2;
+	uint16_t num_ifs;
+	int state;
+	int error;
+
+	error = get_num_endpoints(obj_desc, &num_ifs);
+	if (error < 0)
+		return error;
+
+	for (uint16_t i = 0; i < num_ifs; i++) {
+		memset(&endpoint1, 0, sizeof(endpoint1));
+		memset(&endpoint2, 0, sizeof(endpoint2));
+		strcpy(endpoint1.type, obj_desc->type);
+		endpoint1.id = obj_desc->id;
+		endpoint1.if_id = i;
+
+		error = dprc_get_connection(&restool.mc_io, 0,
+					    restool.root_dprc_handle,
+					    &endpoint1, &endpoint2, &state);
+		if (error < 0 || state == -1)
+			continue;
+
+		error = dprc_disconnect(&restool.mc_io, 0,
+					restool.root_dprc_handle,
+					&endpoint1);
+		if (error < 0) {
+			mc_status = flib_error_to_mc_status(error);
+			ERROR_PRINTF("%s.%d.%u: MC error: %s (status %#x)\n",
+				     obj_desc->type, obj_desc->id, i,
+				     mc_status_to_string(mc_status),
+				     mc_status);
+			return error;
+		}
+
+		DEBUG_PRINTF("%s.%d.%u disconnected from %s.%d.%u\n",
+			     obj_desc->type, obj_desc->id, i,
+			     endpoint2.type, endpoint2.id, endpoint2.if_id);
+	}
+
+	return 0;
+}
+
+/**
+ * Open handle on one of the containers of a subtree being destroyed
+ */
+struct dprc_handle_entry {
+	uint32_t dprc_id;
+	uint16_t dprc_handle;
+};
+
+static int lookup_dprc_handle(const struct dprc_handle_entry *handles,
+			      int num_handles, uint32_t dprc_id,
+			      uint16_t *dprc_handle)
+{
+	for (int i = 0; i < num_handles; i++) {
+		if (handles[i].dprc_id == dprc_id) {
+			*dprc_handle = handles[i].dprc_handle;
+			return 0;
+		}
+	}
+
+	return -ENOENT;
+}
+
+/**
+ * Unbinds the driver of an object if asked to, otherwise counts it as
+ * in use when it is bound. *unbound tells whether a driver was unbound.
+ */
+static int release_obj_driver(const char *obj_type, int obj_id, bool unbind,
+			      int *num_in_use, bool *unbound)
+{
+	char driver_path[PATH_MAX];
+	char obj_name[32];
+	int error;
+
+	sprintf(obj_name, "%.15s.%d", obj_type, obj_id);
+	if (unbind) {
+		snprintf(driver_path, sizeof(driver_path),
+			 "/sys/bus/fsl-mc/devices/%s/driver", obj_name);
+		if (access(driver_path, F_OK) != 0)
+			return 0;
+
+		error = unbind_obj_driver(obj_name);
+		if (error == 0)
+			*unbound = true;
+		return error;
+	}
+
+	if (in_use(obj_name, "destroyed"))
+		(*num_in_use)++;
+
+	return 0;
+}
+
+/**
+ * Destroys a container together with everything it holds. The subtree is
+ * walked once; then all links are removed, the leaf objects are destroyed
+ * and finally the nested containers, deepest first. Drivers cannot be
+ * bound back, so on failure the objects left unbound are listed.
+ */
+static int destroy_dprc_recursive(uint32_t dprc_id,
+				  uint16_t parent_dprc_handle, bool unbind)
+{
+	struct dprc_handle_entry *handles = NULL;
+	struct topology topology = { 0 };
+	struct topology_obj *obj;
+	uint16_t obj_dprc_handle;
+	uint16_t dprc_handle;
+	/* indexed like topology.objs, the last entry is the container */
+	bool *unbound = NULL;
+	int num_handles = 0;
+	int num_in_use = 0;
+	int error, error2;
+	int i;
+
+	error = open_dprc(dprc_id, &dprc_handle);
+	if (error < 0)
+		return error;
+
+	error = get_topology(dprc_id, dprc_handle, 0, &topology);
+	if (error == 0) {
+		handles = malloc((topology.num_objs + 1) * sizeof(*handles));
+		unbound = calloc(topology.num_objs + 1, sizeof(*unbound));
+		if (handles == NULL || unbound == NULL) {
+			ERROR_PRINTF("Could not alloc memory for dprc handles!\n");
+			error = -ENOMEM;
+		}
+	}
+
+	if (error < 0) {
+		error2 = dprc_close(&restool.mc_io, 0, dprc_handle);
+		if (error2 < 0)
+			DEBUG_PRINTF("dprc_close() failed with error %d\n",
+				     error2);
+		free_topology(&topology);
+		free(handles);
+		free(unbound);
+		return error;
+	}
+
+	handles[num_handles].dprc_id = dprc_id;
+	handles[num_handles].dprc_handle = dprc_handle;
+	num_handles++;
+
+	/*
+	 * Check drivers before touching anything, so that a refused
+	 * destroy leaves the subtree intact
+	 */
+	for (i = topology.num_objs - 1; i >= 0; i--) {
+		obj = &topology.objs[i];
+		error = release_obj_driver(obj->desc.type, obj->desc.id,
+					   unbind, &num_in_use, &unbound[i]);
+		if (error < 0)
+			goto out;
+	}
+
+	error = release_obj_driver("dprc", dprc_id, unbind, &num_in_use,
+				   &unbound[topology.num_objs]);
+	if (error < 0)
+		goto out;
+
+	if (num_in_use != 0) {
+		ERROR_PRINTF("(use --unbind to unbind drivers)\n");
+		error = -EBUSY;
+		goto out;
+	}
+
+	for (i = 0; i < topology.num_objs; i++) {
+		obj = &topology.objs[i];
+		if (strcmp(obj->desc.type, "dprc") != 0)
+			continue;
+
+		error = open_dprc(obj->desc.id,
+				  &handles[num_handles].dprc_handle);
+		if (error < 0)
+			goto out;
+
+		handles[num_handles].dprc_id = obj->desc.id;
+		num_handles++;
+	}
+
+	for (i = 0; i < topology.num_objs; i++) {
+		obj = &topology.objs[i];
+		if (strcmp(obj->desc.type, "dprc") == 0)
+			continue;
+
+		error = disconnect_obj(&obj->desc);
+		if (error < 0)
+			goto out;
+	}
+
+	for (i = topology.num_objs - 1; i >= 0; i--) {
+		obj = &topology.objs[i];
+		if (strcmp(obj->desc.type, "dprc") == 0)
+			continue;
+
+		error = lookup_dprc_handle(handles, num_handles,
+					   obj->parent_dprc_id,
+					   &obj_dprc_handle);
+		assert(error == 0);
+		error = destroy_obj(&obj->desc, obj_dprc_handle);
+		if (error < 0)
+			goto out;
+
+		unbound[i] = false;
+	}
+
+	/*
+	 * A nested container is always found after its own parent in the
+	 * walk, so going backwards destroys the deepest containers first.
+	 * The last iteration (i == -1) destroys the container itself.
+	 */
+	for (i = topology.num_objs - 1; i >= -1; i--) {
+		uint32_t obj_dprc_id;
+
+		obj = i >= 0 ? &topology.objs[i] : NULL;
+		if (obj != NULL && strcmp(obj->desc.type, "dprc") != 0)
+			continue;
+
+		num_handles--;
+		obj_dprc_id = handles[num_handles].dprc_id;
+		assert(obj == NULL || obj_dprc_id == (uint32_t)obj->desc.id);
+		error = dprc_close(&restool.mc_io, 0,
+				   handles[num_handles].dprc_handle);
+		if (error < 0)
+			goto mc_error;
+
+		if (obj != NULL) {
+			error = lookup_dprc_handle(handles, num_handles,
+						   obj->parent_dprc_id,
+						   &obj_dprc_handle);
+			assert(error == 0);
+		} else {
+			obj_dprc_handle = parent_dprc_handle;
+		}
+
+		error = dprc_destroy_container(&restool.mc_io, 0,
+					       obj_dprc_handle, obj_dprc_id);
+		if (error < 0)
+			goto mc_error;
+
+		unbound[i >= 0 ? i : topology.num_objs] = false;
+		printf("dprc.%u is destroyed\n", obj_dprc_id);
+	}
+
+	assert(num_handles == 0);
+	goto out;
+
+mc_error:
+	mc_status = flib_error_to_mc_status(error);
+	ERROR_PRINTF("MC error: %s (status %#x)\n",
+		     mc_status_to_string(mc_status), mc_status);
+out:
+	for (i = 0; i < num_handles; i++) {
+		error2 = dprc_close(&restool.mc_io, 0, handles[i].dprc_handle);
+		if (error2 < 0) {
+			mc_status = flib_error_to_mc_status(error2);
+			ERROR_PRINTF("MC error: %s (status %#x)\n",
+				     mc_status_to_string(mc_status), mc_status);
+		}
+	}
+
+	for (i = 0; i <= topology.num_objs; i++) {
+		if (!unbound[i])
+			continue;
+
+		if (i < topology.num_objs)
+			ERROR_PRINTF("%s.%d was left unbound from its driver\n",
+				     topology.objs[i].desc.type,
+				     topology.objs[i].desc.id);
+		else
+			ERROR_PRINTF("dprc.%u was left unbound from its driver\n",
+				     dprc_id);
+	}
+
+	free_topology(&topology);
+	free(handles);
+	free(unbound);
+	return error;
+}
+
 static int cmd_dprc_destroy_child(void)
 {
 	static const char usage_msg[] =
 		"\n"
-		"Usage: restool dprc destroy <container>\n"
+		"Usage: restool dprc destroy <container> [OPTIONS]\n"
+		"\n"
+		"OPTIONS:\n"
+		"--recursive\n"
+		"   Also destroys all objects and nested containers held by\n"
+		"   <container>, after removing their links.\n"
+		"--unbind\n"
+		"   Unbinds the objects from their drivers before destroying them.\n"
+		"   Only valid with --recursive.\n"
 		"\n"
 		"NOTE:\n"
 		" -<container> cannot be the root container\n"
+		"\n"
+		"EXAMPLE:\n"
+		"Destroy dprc.2 and everything it holds:\n"
+		"   $ restool dprc destroy dprc.2 --recursive --unbind\n"
 		"\n";
 
 	int error;
@@ -1201,6 +1792,8 @@ static int cmd_dprc_destroy_child(void)
 	uint32_t parent_dprc_id;
 	uint16_t parent_dprc_handle;
 	bool found = false;
+	bool recursive = false;
+	bool unbind = false;
 
 	if (restool.cmd_option_mask & ONE_BIT_MASK(DESTROY_OPT_HELP)) {
 		puts(usage_msg);
@@ -1215,7 +1808,23 @@ static int cmd_dprc_destroy_child(void)
 		goto out;
 	}
 
-	if (in_use(restool.obj_name, "destroyed")) {
+	if (restool.cmd_option_mask & ONE_BIT_MASK(DESTROY_OPT_RECURSIVE)) {
+		restool.cmd_option_mask &= ~ONE_BIT_MASK(DESTROY_OPT_RECURSIVE);
+		recursive = true;
+	}
+
+	if (restool.cmd_option_mask & ONE_BIT_MASK(DESTROY_OPT_UNBIND)) {
+		restool.cmd_option_mask &= ~ONE_BIT_MASK(DESTROY_OPT_UNBIND);
+		if (!recursive) {
+			ERROR_PRINTF("--unbind is only valid with --recursive\n");
+			puts(usage_msg);
+			error = -EINVAL;
+			goto out;
+		}
+		unbind = true;
+	}
+
+	if (!recursive && in_use(restool.obj_name, "destroyed")) {
 		error = -EBUSY;
 		goto out;
 	}
@@ -1253,23 +1862,32 @@ static int cmd_dprc_destroy_child(void)
 		if (error < 0)
 			goto out;
 	}
-	/*
-	 * Destroy child container in the MC:
-	 */
-	error = dprc_destroy_container(&restool.mc_io, 0, parent_dprc_handle,
-					child_dprc_id);
-	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
-		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
-
-		goto out;
-	}
-
-	printf("dprc.%u is destroyed\n", child_dprc_id);
 
-	if (parent_dprc_id != restool.root_dprc_id)
-		error = dprc_close(&restool.mc_io, 0, parent_dprc_handle);
+	if (recursive) {
+		error = destroy_dprc_recursive(child_dprc_id,
+					       parent_dprc_handle, unbind);
+		if (error < 0)
+			goto out;
+	} else {
+		/*
+		 * Destroy child container in the MC:
+		 */
+		error = dprc_destroy_container(&restool.mc_io, 0,
+					       parent_dprc_handle,
+					       child_dprc_id);
+		if (error < 0) {
+			mc_status = flib_error_to_mc_status(error);
+			ERROR_PRINTF("MC error: %s (status %#x)\n",
+				     mc_status_to_string(mc_status), mc_status);
+
+			goto out;
+		}
+
+		printf("dprc.%u is destroyed\n", child_dprc_id);
+	}
+
+	if (parent_dprc_id != restool.root_dprc_id)
+		error = dprc_close(&restool.mc_io, 0, parent_dprc_handle);
 
 out:
 	return error;
@@ -1803,6 +2421,376 @@ static int parse_endpoint(char *endpoint_str, struct dprc_endpoint *endpoint)
 	return 0;
 }
 
+/**
+ * One line of a link list: a pair of endpoints and the connection rates
+ */
+struct link_entry {
+	struct dprc_endpoint endpoint1;
+	struct dprc_endpoint endpoint2;
+	struct dprc_connection_cfg cfg;
+	int line_num;
+};
+
+struct link_list {
+	struct link_entry *links;
+	int num_links;
+	int max_links;
+};
+
+static int parse_rate(const char *str, uint32_t *rate)
+{
+	char *endptr;
+	long val;
+
+	errno = 0;
+	val = strtol(str, &endptr, 0);
+	if (STRTOL_ERROR(str, endptr, val, errno) ||
+	    val < 1 || val > UINT32_MAX)
+		return -EINVAL;
+
+	*rate = val;
+	return 0;
+}
+
+/**
+ * Parses a link list line of the form:
+ *	<endpoint1> <endpoint2> [--committed-rate=<n> --max-rate=<n>]
+ */
+static int parse_link_line(char *line, int line_num,
+			   const struct dprc_connection_cfg *default_cfg,
+			   struct link_entry *link)
+{
+	static const char committed_rate_opt[] = "--committed-rate=";
+	static const char max_rate_opt[] = "--max-rate=";
+	bool committed_rate_given = false;
+	bool max_rate_given = false;
+	char *saveptr = NULL;
+	int num_tokens = 0;
+	char *token;
+	int error;
+
+	memset(link, 0, sizeof(*link));
+	link->cfg = *default_cfg;
+	link->line_num = line_num;
+
+	for (token = strtok_r(line, " \t\r\n", &saveptr);
+	     token != NULL;
+	     token = strtok_r(NULL, " \t\r\n", &saveptr)) {
+		if (num_tokens == 0) {
+			error = parse_endpoint(token, &link->endpoint1);
+		} else if (num_tokens == 1) {
+			error = parse_endpoint(token, &link->endpoint2);
+		} else if (strncmp(token, committed_rate_opt,
+				   sizeof(committed_rate_opt) - 1) == 0) {
+			error = parse_rate(token + sizeof(committed_rate_opt) - 1,
+					   &link->cfg.committed_rate);
+			committed_rate_given = true;
+		} else if (strncmp(token, max_rate_opt,
+				   sizeof(max_rate_opt) - 1) == 0) {
+			error = parse_rate(token + sizeof(max_rate_opt) - 1,
+					   &link->cfg.max_rate);
+			max_rate_given = true;
+		} else {
+			error = -EINVAL;
+		}
+
+		if (error < 0) {
+			ERROR_PRINTF("line %d: invalid argument '%s'\n",
+				     line_num, token);
+			return error;
+		}
+
+		num_tokens++;
+	}
+
+	if (num_tokens < 2) {
+		ERROR_PRINTF("line %d: two endpoints expected\n", line_num);
+		return -EINVAL;
+	}
+
+	if (committed_rate_given != max_rate_given) {
+		ERROR_PRINTF("line %d: both committed-rate and max-rate must be provided!\n",
+			     line_num);
+		return -EINVAL;
+	}
+
+	if (link->cfg.max_rate < link->cfg.committed_rate) {
+		ERROR_PRINTF("line %d: value of max-rate must be bigger than committed-rate!\n",
+			     line_num);
+		return -EINVAL;
+	}
+
+	return 0;
+}
+
+/**
+ * Reads a link list from a file, or from stdin if the file name is "-".
+ * Empty lines and anything following a '#' are ignored.
+ */
+static int read_link_list(const char *file_name,
+			  const struct dprc_connection_cfg *default_cfg,
+			  struct link_list *list)
+{
+	size_t line_size = 0;
+	char *line = NULL;
+	int line_num = 0;
+	int error = 0;
+	FILE *fp;
+
+	if (strcmp(file_name, "-") == 0) {
+		fp = stdin;
+	} else {
+		fp = fopen(file_name, "r");
+		if (fp == NULL) {
+			error = -errno;
+			ERROR_PRINTF("Could not open link list '%s': %s\n",
+				     file_name, strerror(errno));
+			return error;
+		}
+	}
+
+	while (getline(&line, &line_size, fp) != -1) {
+		char *comment;
+
+		line_num++;
+		comment = strchr(line, '#');
+		if (comment != NULL)
+			*comment = '\0';
+
+		if (line[strspn(line, " \t\r\n")] == '\0')
+			continue;
+
+		if (list->num_links == list->max_links) {
+			struct link_entry *links;
+			int max_links;
+
+			max_links = list->max_links ? list->max_links * 2 : 32;
+			links = realloc(list->links,
+					max_links * sizeof(*links));
+			if (links == NULL) {
+				ERROR_PRINTF("Could not alloc memory for link list!\n");
+				error = -ENOMEM;
+				break;
+			}
+			list->links = links;
+			list->max_links = max_links;
+		}
+
+		error = parse_link_line(line, line_num, default_cfg,
+					&list->links[list->num_links]);
+		if (error < 0)
+			break;
+
+		list->num_links++;
+	}
+
+	free(line);
+	if (fp != stdin)
+		fclose(fp);
+
+	if (error == 0 && list->num_links == 0) {
+		ERROR_PRINTF("No links found in '%s'\n", file_name);
+		error = -EINVAL;
+	}
+
+	return error;
+}
+
+static bool link_endpoint_equal(const struct dprc_endpoint *endpoint1,
+				const struct dprc_endpoint *endpoint2)
+{
+	return endpoint1->id == endpoint2->id &&
+	       endpoint1->if_id == endpoint2->if_id &&
+	       strcmp(endpoint1->type, endpoint2->type) == 0;
+}
+
+/**
+ * Checks one endpoint of a link list against the hierarchy snapshot and
+ * the endpoints already checked. When connecting, the endpoint must be
+ * free; when disconnecting, it must be linked, and its peer is added to
+ * the checked ones so that the same link cannot be removed twice.
+ */
+static int validate_link_endpoint(const struct topology *topology,
+				  uint32_t dprc_id, int line_num,
+				  const struct dprc_endpoint *endpoint,
+				  bool do_connect,
+				  struct dprc_endpoint *checked,
+				  int *num_checked)
+{
+	struct dprc_endpoint peer;
+	int state;
+	int error;
+
+	if (!topology_find(topology, endpoint->type, endpoint->id)) {
+		ERROR_PRINTF("line %d: %s.%d does not exist in dprc.%u\n",
+			     line_num, endpoint->type, endpoint->id, dprc_id);
+		return -ENOENT;
+	}
+
+	for (int i = 0; i < *num_checked; i++) {
+		if (link_endpoint_equal(&checked[i], endpoint)) {
+			ERROR_PRINTF("line %d: %s.%d.%d is used by more than one link\n",
+				     line_num, endpoint->type, endpoint->id,
+				     endpoint->if_id);
+			return -EINVAL;
+		}
+	}
+
+	checked[(*num_checked)++] = *endpoint;
+
+	error = get_connection(endpoint, &peer, &state);
+	if (error < 0) {
+		mc_status = flib_error_to_mc_status(error);
+		ERROR_PRINTF("line %d: MC error: %s (status %#x)\n",
+			     line_num, mc_status_to_string(mc_status),
+			     mc_status);
+		return error;
+	}
+
+	if (do_connect && state != -1) {
+		ERROR_PRINTF("line %d: %s.%d.%d is already linked to %s.%d.%d\n",
+			     line_num, endpoint->type, endpoint->id,
+			     endpoint->if_id, peer.type, peer.id, peer.if_id);
+		return -EBUSY;
+	}
+
+	if (!do_connect) {
+		if (state == -1) {
+			ERROR_PRINTF("line %d: %s.%d.%d is not linked\n",
+				     line_num, endpoint->type, endpoint->id,
+				     endpoint->if_id);
+			return -ENOTCONN;
+		}
+
+		for (int i = 0; i < *num_checked; i++) {
+			if (link_endpoint_equal(&checked[i], &peer)) {
+				ERROR_PRINTF("line %d: the link of %s.%d.%d is listed twice\n",
+					     line_num, endpoint->type,
+					     endpoint->id, endpoint->if_id);
+				return -EINVAL;
+			}
+		}
+
+		checked[(*num_checked)++] = peer;
+	}
+
+	return 0;
+}
+
+/**
+ * Checks a link list against a single walk of the container hierarchy
+ * and a single snapshot of its links: every endpoint must exist, appear
+ * in one link only and, when connecting, be free. Nothing is connected
+ * or disconnected unless the whole list is valid.
+ */
+static int validate_link_list(uint32_t dprc_id, uint16_t dprc_handle,
+			      const struct link_list *list,
+			      bool do_connect)
+{
+	struct topology topology = { 0 };
+	struct dprc_endpoint *checked;
+	int num_checked = 0;
+	int num_invalid = 0;
+	int error;
+
+	/* two endpoints per link, either both given or one and its peer */
+	checked = malloc(2 * list->num_links * sizeof(*checked));
+	if (checked == NULL) {
+		ERROR_PRINTF("Could not alloc memory for link list!\n");
+		return -ENOMEM;
+	}
+
+	error = get_topology(dprc_id, dprc_handle, 0, &topology);
+	if (error < 0)
+		goto out;
+
+	for (int i = 0; i < list->num_links; i++) {
+		const struct link_entry *link = &list->links[i];
+
+		error = validate_link_endpoint(&topology, dprc_id,
+					       link->line_num,
+					       &link->endpoint1, do_connect,
+					       checked, &num_checked);
+		if (error == 0 && do_connect)
+			error = validate_link_endpoint(&topology, dprc_id,
+						       link->line_num,
+						       &link->endpoint2,
+						       do_connect, checked,
+						       &num_checked);
+		if (error < 0)
+			num_invalid++;
+	}
+
+	error = 0;
+	if (num_invalid != 0) {
+		ERROR_PRINTF("%d invalid link(s), no link was changed\n",
+			     num_invalid);
+		error = -EINVAL;
+	}
+
+out:
+	free_topology(&topology);
+	free(checked);
+	return error;
+}
+
+/**
+ * Connects or disconnects all links of a link list, back-to-back on the
+ * same container handle, and prints a summary
+ */
+static int apply_link_list(uint32_t dprc_id, uint16_t dprc_handle,
+			   const char *file_name,
+			   const struct dprc_connection_cfg *default_cfg,
+			   bool do_connect)
+{
+	struct link_list list = { 0 };
+	int num_failed = 0;
+	int error;
+
+	error = read_link_list(file_name, default_cfg, &list);
+	if (error < 0)
+		goto out;
+
+	error = validate_link_list(dprc_id, dprc_handle, &list, do_connect);
+	if (error < 0)
+		goto out;
+
+	for (int i = 0; i < list.num_links; i++) {
+		struct link_entry *link = &list.links[i];
+		int error2;
+
+		if (do_connect)
+			error2 = dprc_connect(&restool.mc_io, 0, dprc_handle,
+					      &link->endpoint1,
+					      &link->endpoint2,
+					      &link->cfg);
+		else
+			error2 = dprc_disconnect(&restool.mc_io, 0,
+						 dprc_handle,
+						 &link->endpoint1);
+		if (error2 < 0) {
+			mc_status = flib_error_to_mc_status(error2);
+			ERROR_PRINTF("line %d: MC error: %s (status %#x)\n",
+				     link->line_num,
+				     mc_status_to_string(mc_status), mc_status);
+			if (error == 0)
+				error = error2;
+			num_failed++;
+		}
+	}
+
+	/* the links seen by validate_link_list() have changed */
+	flush_connection_cache();
+
+	printf("%d link(s) %s, %d failed\n",
+	       list.num_links - num_failed,
+	       do_connect ? "connected" : "disconnected",
+	       num_failed);
+out:
+	free(list.links);
+	return error;
+}
+
 
 static int cmd_dprc_connect(void)
 {
@@ -1810,6 +2798,7 @@ static int cmd_dprc_connect(void)
 		"\n"
 		"Usage: restool dprc connect <parent-container> --endpoint1=<object>\n"
 		"		--endpoint2=<object> [OPTIONS]\n"
+		"       restool dprc connect <parent-container> --links=<file> [OPTIONS]\n"
 		"\n"
 		"  <parent-container>\n"
 		"    Specifies the parent-container.\n"
@@ -1817,12 +2806,18 @@ static int cmd_dprc_connect(void)
 		"    Specifies an endpoint object.\n"
 		"  --endpoint2=<object>\n"
 		"    Specifies an endpoint object.\n"
+		"  --links=<file>\n"
+		"    Connects all links listed in <file>, or read from stdin if <file>\n"
+		"    is '-'. Each line has the form:\n"
+		"      <object> <object> [--committed-rate=<number> --max-rate=<number>]\n"
+		"    Empty lines and text following a '#' are ignored.\n"
 		"\n"
 		"OPTIONS:\n"
 		"  --committed-rate=<number>\n"
 		"    Committed rate (Mbits/s). Must be provided alongside max-rate.\n"
 		"  --max-rate=<number>\n"
 		"    Maximum rate (Mbits/s). Must be provided alongside committed-rate.\n"
+		"    With --links, the rates apply to lines that do not set their own.\n"
 		"\n"
 		"NOTES:\n"
 		"  -<parent-container> must be a common ancestor of both <object> arguments\n"
@@ -1832,10 +2827,13 @@ static int cmd_dprc_connect(void)
 		"   (use 'dprc disconnect' to disconnect endpoints)\n"
 		"  -multi-port objects such as a dpsw or dpdmux use the following naming\n"
 		"   convention to specify endpoints: <object>.<id>.<port>\n"
+		"  -with --links, all endpoints are checked before any link is made.\n"
 		"\n"
 		"EXAMPLE:\n"
 		"To connect dpni.8 to dpsw.0.0:\n"
 		"   $ restool dprc connect dprc.1 --endpoint1=dpsw.0.0 --endpoint2=dpni.8\n"
+		"To connect all links listed in links.txt:\n"
+		"   $ restool dprc connect dprc.1 --links=links.txt\n"
 		"\n";
 
 	struct dprc_connection_cfg dprc_connection_cfg;
@@ -1843,6 +2841,7 @@ static int cmd_dprc_connect(void)
 	bool max_rate_given = false;
 	struct dprc_endpoint endpoint1;
 	struct dprc_endpoint endpoint2;
+	char *links_file = NULL;
 	bool dprc_opened = false;
 	uint32_t parent_dprc_id;
 	uint16_t dprc_handle;
@@ -1878,38 +2877,59 @@ static int cmd_dprc_connect(void)
 		dprc_handle = restool.root_dprc_handle;
 	}
 
-	if (!(restool.cmd_option_mask & ONE_BIT_MASK(CONNECT_OPT_ENDPOINT1))) {
-		ERROR_PRINTF("--endpoint1 option missing\n");
-		puts(usage_msg);
-		error = -EINVAL;
-		goto out;
-	}
+	if (restool.cmd_option_mask & ONE_BIT_MASK(CONNECT_OPT_LINKS)) {
+		restool.cmd_option_mask &= ~ONE_BIT_MASK(CONNECT_OPT_LINKS);
+		assert(restool.cmd_option_args[CONNECT_OPT_LINKS] != NULL);
+		links_file = restool.cmd_option_args[CONNECT_OPT_LINKS];
 
-	restool.cmd_option_mask &= ~ONE_BIT_MASK(CONNECT_OPT_ENDPOINT1);
-	assert(restool.cmd_option_args[CONNECT_OPT_ENDPOINT1] != NULL);
-	error = parse_endpoint(restool.cmd_option_args[CONNECT_OPT_ENDPOINT1],
-			       &endpoint1);
-	if (error < 0) {
-		ERROR_PRINTF("Invalid --endpoint1 arg: '%s'\n",
-			     restool.cmd_option_args[CONNECT_OPT_ENDPOINT1]);
-		goto out;
+		if (restool.cmd_option_mask &
+		    (ONE_BIT_MASK(CONNECT_OPT_ENDPOINT1) |
+		     ONE_BIT_MASK(CONNECT_OPT_ENDPOINT2))) {
+			ERROR_PRINTF("--links cannot be used with --endpoint1 or --endpoint2\n");
+			puts(usage_msg);
+			error = -EINVAL;
+			goto out;
+		}
 	}
 
-	if (!(restool.cmd_option_mask & ONE_BIT_MASK(CONNECT_OPT_ENDPOINT2))) {
-		ERROR_PRINTF("--endpoint2 option missing\n");
-		puts(usage_msg);
-		error = -EINVAL;
-		goto out;
-	}
+	if (links_file == NULL) {
+		if (!(restool.cmd_option_mask &
+		      ONE_BIT_MASK(CONNECT_OPT_ENDPOINT1))) {
+			ERROR_PRINTF("--endpoint1 option missing\n");
+			puts(usage_msg);
+			error = -EINVAL;
+			goto out;
+		}
 
-	restool.cmd_option_mask &= ~ONE_BIT_MASK(CONNECT_OPT_ENDPOINT2);
-	assert(restool.cmd_option_args[CONNECT_OPT_ENDPOINT2] != NULL);
-	error = parse_endpoint(restool.cmd_option_args[CONNECT_OPT_ENDPOINT2],
-			       &endpoint2);
-	if (error < 0) {
-		ERROR_PRINTF("Invalid --endpoint2 arg: '%s'\n",
-			     restool.cmd_option_args[CONNECT_OPT_ENDPOINT2]);
-		goto out;
+		restool.cmd_option_mask &= ~ONE_BIT_MASK(CONNECT_OPT_ENDPOINT1);
+		assert(restool.cmd_option_args[CONNECT_OPT_ENDPOINT1] != NULL);
+		error = parse_endpoint(
+				restool.cmd_option_args[CONNECT_OPT_ENDPOINT1],
+				&endpoint1);
+		if (error < 0) {
+			ERROR_PRINTF("Invalid --endpoint1 arg: '%s'\n",
+				     restool.cmd_option_args[CONNECT_OPT_ENDPOINT1]);
+			goto out;
+		}
+
+		if (!(restool.cmd_option_mask &
+		      ONE_BIT_MASK(CONNECT_OPT_ENDPOINT2))) {
+			ERROR_PRINTF("--endpoint2 option missing\n");
+			puts(usage_msg);
+			error = -EINVAL;
+			goto out;
+		}
+
+		restool.cmd_option_mask &= ~ONE_BIT_MASK(CONNECT_OPT_ENDPOINT2);
+		assert(restool.cmd_option_args[CONNECT_OPT_ENDPOINT2] != NULL);
+		error = parse_endpoint(
+				restool.cmd_option_args[CONNECT_OPT_ENDPOINT2],
+				&endpoint2);
+		if (error < 0) {
+			ERROR_PRINTF("Invalid --endpoint2 arg: '%s'\n",
+				     restool.cmd_option_args[CONNECT_OPT_ENDPOINT2]);
+			goto out;
+		}
 	}
 
 	if (restool.cmd_option_args[CONNECT_OPT_COMMITTED_RATE]) {
@@ -1948,6 +2968,13 @@ static int cmd_dprc_connect(void)
 		return -EINVAL;
 	}
 
+	if (links_file != NULL) {
+		error = apply_link_list(parent_dprc_id, dprc_handle,
+					links_file, &dprc_connection_cfg,
+					true);
+		goto out;
+	}
+
 	error = dprc_connect(&restool.mc_io, 0,
 			     dprc_handle,
 			     &endpoint1,
@@ -1981,11 +3008,16 @@ static int cmd_dprc_disconnect(void)
 	static const char usage_msg[] =
 		"\n"
 		"Usage: restool dprc disconnect <parent-container> --endpoint=<object>\n"
+		"       restool dprc disconnect <parent-container> --links=<file>\n"
 		"\n"
 		"  <parent-container>\n"
 		"    Specifies the parent-container.\n"
 		"  --endpoint=<object>\n"
 		"    Specifies either endpoint of a connection.\n"
+		"  --links=<file>\n"
+		"    Disconnects all links listed in <file>, or read from stdin if\n"
+		"    <file> is '-'. Uses the same format as 'dprc connect --links',\n"
+		"    the first <object> of each line is disconnected.\n"
 		"\n"
 		"NOTES:\n"
 		"  -<parent-container> must be an ancestor of the <object>\n"
@@ -1994,6 +3026,8 @@ static int cmd_dprc_disconnect(void)
 		"EXAMPLE:\n"
 		"To disconnect dpni.8:\n"
 		"   $ restool dprc disconnect dprc.1 --endpoint=dpni.8\n"
+		"To disconnect all links listed in links.txt:\n"
+		"   $ restool dprc disconnect dprc.1 --links=links.txt\n"
 		"\n";
 
 	uint16_t dprc_handle;
@@ -2031,6 +3065,25 @@ static int cmd_dprc_disconnect(void)
 		dprc_handle = restool.root_dprc_handle;
 	}
 
+	if (restool.cmd_option_mask & ONE_BIT_MASK(DISCONNECT_OPT_LINKS)) {
+		struct dprc_connection_cfg dprc_connection_cfg = { 0 };
+
+		restool.cmd_option_mask &= ~ONE_BIT_MASK(DISCONNECT_OPT_LINKS);
+		assert(restool.cmd_option_args[DISCONNECT_OPT_LINKS] != NULL);
+		if (restool.cmd_option_mask &
+		    ONE_BIT_MASK(DISCONNECT_OPT_ENDPOINT)) {
+			ERROR_PRINTF("--links cannot be used with --endpoint\n");
+			puts(usage_msg);
+			error = -EINVAL;
+			goto out;
+		}
+
+		error = apply_link_list(parent_dprc_id, dprc_handle,
+				restool.cmd_option_args[DISCONNECT_OPT_LINKS],
+				&dprc_connection_cfg, false);
+		goto out;
+	}
+
 	if (!(restool.cmd_option_mask &
 	    ONE_BIT_MASK(DISCONNECT_OPT_ENDPOINT))) {
 		ERROR_PRINTF("--endpoint option missing\n");
@@ -2077,13 +3130,18 @@ out:
 
 static int cmd_dpl_generate(void)
 {
+	const char *output_file = NULL;
 	int error;
 
 	static const char usage_msg[] =
 		"\n"
-		"Usage: restool dprc generate-dpl <container>\n"
+		"Usage: restool dprc generate-dpl <container> [OPTIONS]\n"
 		"   <container> specifies the name of the container\n"
 		"\n"
+		"OPTIONS:\n"
+		"--output=<file>\n"
+		"   Writes the DPL to <file> instead of stdout.\n"
+		"\n"
 		"NOTES:\n"
 		"Generates the DPL syntax for the specified container to stdout,\n"
 		"including all child and decendant containers.\n"
@@ -2091,6 +3149,8 @@ static int cmd_dpl_generate(void)
 		"EXAMPLE:\n"
 		"Generate a DPL for dprc.1:\n"
 		"   $ restool dprc generate-dpl dprc.1\n"
+		"Write the DPL of dprc.1 to dpl.dts:\n"
+		"   $ restool dprc generate-dpl dprc.1 --output=dpl.dts\n"
 		"\n";
 
 	if (restool.cmd_option_mask & ONE_BIT_MASK(GENERATE_OPT_HELP)) {
@@ -2099,11 +3159,231 @@ static int cmd_dpl_generate(void)
 		return 0;
 	}
 
-	error = dpl_generate();
+	if (restool.cmd_option_mask & ONE_BIT_MASK(GENERATE_OPT_OUTPUT)) {
+		restool.cmd_option_mask &= ~ONE_BIT_MASK(GENERATE_OPT_OUTPUT);
+		output_file = restool.cmd_option_args[GENERATE_OPT_OUTPUT];
+	}
+
+	error = dpl_generate(output_file);
 
 	return error;
 }
 
+static int cmd_dprc_clone(void)
+{
+	static const char usage_msg[] =
+		"\n"
+		"Usage: restool dprc clone <container> [OPTIONS]\n"
+		"   <container> specifies the name of the container to copy\n"
+		"\n"
+		"OPTIONS:\n"
+		"--count=<number>\n"
+		"   Number of copies to create, 1 to 256. Default is 1.\n"
+		"--parent=<container>\n"
+		"   Container the copies are created in. Default is the parent\n"
+		"   of <container>.\n"
+		"\n"
+		"NOTES:\n"
+		" -<container> cannot be the root container\n"
+		" -Nested containers, objects, labels and the links between\n"
+		"  them are copied. Links to objects outside of <container>\n"
+		"  are not.\n"
+		" -DPMAC and DPAIOP objects cannot be copied.\n"
+		"\n"
+		"EXAMPLE:\n"
+		"Create 4 copies of dprc.2 in dprc.1:\n"
+		"   $ restool dprc clone dprc.2 --count=4 --parent=dprc.1\n"
+		"\n";
+
+	uint32_t src_dprc_id;
+	uint32_t parent_dprc_id;
+	long count = 1;
+	int error;
+
+	if (restool.cmd_option_mask & ONE_BIT_MASK(CLONE_OPT_HELP)) {
+		puts(usage_msg);
+		restool.cmd_option_mask &= ~ONE_BIT_MASK(CLONE_OPT_HELP);
+		return 0;
+	}
+
+	if (restool.obj_name == NULL) {
+		ERROR_PRINTF("<container> argument missing\n");
+		puts(usage_msg);
+		return -EINVAL;
+	}
+
+	error = parse_object_name(restool.obj_name, "dprc", &src_dprc_id);
+	if (error < 0)
+		return error;
+
+	if (src_dprc_id == restool.root_dprc_id) {
+		ERROR_PRINTF("The root DPRC (%s) cannot be cloned\n",
+			     restool.obj_name);
+		return -EINVAL;
+	}
+
+	if (restool.cmd_option_mask & ONE_BIT_MASK(CLONE_OPT_COUNT)) {
+		restool.cmd_option_mask &= ~ONE_BIT_MASK(CLONE_OPT_COUNT);
+		error = get_option_value(CLONE_OPT_COUNT, &count,
+					 "Invalid count value\n", 1, 256);
+		if (error)
+			return error;
+	}
+
+	if (restool.cmd_option_mask & ONE_BIT_MASK(CLONE_OPT_PARENT)) {
+		restool.cmd_option_mask &= ~ONE_BIT_MASK(CLONE_OPT_PARENT);
+		error = parse_object_name(restool.cmd_option_args[CLONE_OPT_PARENT],
+					  "dprc", &parent_dprc_id);
+		if (error < 0)
+			return error;
+
+		if (!find_obj("dprc", parent_dprc_id))
+			return -EINVAL;
+	} else {
+		error = get_parent_dprc_id(src_dprc_id, "dprc",
+					   &parent_dprc_id);
+		if (error < 0) {
+			ERROR_PRINTF("%s does not exist\n", restool.obj_name);
+			return error;
+		}
+	}
+
+	return dprc_clone(src_dprc_id, parent_dprc_id, count);
+}
+
+static int cmd_dprc_apply_dpl(void)
+{
+	static const char usage_msg[] =
+		"\n"
+		"Usage: restool dprc apply-dpl <dpl-file> [OPTIONS]\n"
+		"   <dpl-file> is a DPL in DTS source format, as written by\n"
+		"   'restool dprc generate-dpl'\n"
+		"\n"
+		"OPTIONS:\n"
+		"--container=<container>\n"
+		"   Container standing for the DPL containers whose parent is\n"
+		"   \"none\". Default is the root container.\n"
+		"--dry-run\n"
+		"   Only check the DPL against the live system and the free\n"
+		"   resources, do not create anything.\n"
+		"\n"
+		"NOTES:\n"
+		" -The other containers of the DPL are created under their parent,\n"
+		"  then the objects listed in each of them, with their labels,\n"
+		"  then the connections.\n"
+		" -New objects are plugged, unless their obj or obj_set node\n"
+		"  has plugged = <0>.\n"
+		" -DPMAC, DPAIOP and other objects that cannot be created refer\n"
+		"  to the existing object with the same id.\n"
+		" -The whole DPL is checked before anything is created.\n"
+		"\n"
+		"EXAMPLE:\n"
+		"   $ restool dprc apply-dpl dynamic-dpl.dts\n"
+		"\n";
+
+	uint32_t dprc_id = restool.root_dprc_id;
+	bool dry_run = false;
+	int error;
+
+	if (restool.cmd_option_mask & ONE_BIT_MASK(APPLY_DPL_OPT_HELP)) {
+		puts(usage_msg);
+		restool.cmd_option_mask &= ~ONE_BIT_MASK(APPLY_DPL_OPT_HELP);
+		return 0;
+	}
+
+	if (restool.obj_name == NULL) {
+		ERROR_PRINTF("<dpl-file> argument missing\n");
+		puts(usage_msg);
+		return -EINVAL;
+	}
+
+	if (restool.cmd_option_mask & ONE_BIT_MASK(APPLY_DPL_OPT_CONTAINER)) {
+		restool.cmd_option_mask &=
+			~ONE_BIT_MASK(APPLY_DPL_OPT_CONTAINER);
+		error = parse_object_name(
+				restool.cmd_option_args[APPLY_DPL_OPT_CONTAINER],
+				"dprc", &dprc_id);
+		if (error < 0)
+			return error;
+
+		if (!find_obj("dprc", dprc_id))
+			return -EINVAL;
+	}
+
+	if (restool.cmd_option_mask & ONE_BIT_MASK(APPLY_DPL_OPT_DRY_RUN)) {
+		restool.cmd_option_mask &= ~ONE_BIT_MASK(APPLY_DPL_OPT_DRY_RUN);
+		dry_run = true;
+	}
+
+	return dpl_apply(restool.obj_name, dprc_id, dry_run);
+}
+
+static int cmd_dprc_reconcile(void)
+{
+	static const char usage_msg[] =
+		"\n"
+		"Usage: restool dprc reconcile <dpl-file> [OPTIONS]\n"
+		"   <dpl-file> is a DPL in DTS source format, as written by\n"
+		"   'restool dprc generate-dpl'\n"
+		"\n"
+		"OPTIONS:\n"
+		"--container=<container>\n"
+		"   Container standing for the DPL containers whose parent is\n"
+		"   \"none\". Default is the root container.\n"
+		"--dry-run\n"
+		"   Only print the changes, do not make them.\n"
+		"\n"
+		"NOTES:\n"
+		" -DPL containers and objects are matched with the live ones of\n"
+		"  the same id, in the same parent container.\n"
+		" -Live objects that are not in the DPL are destroyed; objects whose\n"
+		"  creation attributes differ are destroyed and created again.\n"
+		"  Objects bound to a driver are never destroyed.\n"
+		" -Labels are updated, links that are not in the DPL are removed\n"
+		"  and the missing ones are made.\n"
+		" -Live containers that are not in the DPL are left in place.\n"
+		"\n"
+		"EXAMPLE:\n"
+		"   $ restool dprc reconcile --dry-run dynamic-dpl.dts\n"
+		"\n";
+
+	uint32_t dprc_id = restool.root_dprc_id;
+	bool dry_run = false;
+	int error;
+
+	if (restool.cmd_option_mask & ONE_BIT_MASK(APPLY_DPL_OPT_HELP)) {
+		puts(usage_msg);
+		restool.cmd_option_mask &= ~ONE_BIT_MASK(APPLY_DPL_OPT_HELP);
+		return 0;
+	}
+
+	if (restool.obj_name == NULL) {
+		ERROR_PRINTF("<dpl-file> argument missing\n");
+		puts(usage_msg);
+		return -EINVAL;
+	}
+
+	if (restool.cmd_option_mask & ONE_BIT_MASK(APPLY_DPL_OPT_CONTAINER)) {
+		restool.cmd_option_mask &=
+			~ONE_BIT_MASK(APPLY_DPL_OPT_CONTAINER);
+		error = parse_object_name(
+				restool.cmd_option_args[APPLY_DPL_OPT_CONTAINER],
+				"dprc", &dprc_id);
+		if (error < 0)
+			return error;
+
+		if (!find_obj("dprc", dprc_id))
+			return -EINVAL;
+	}
+
+	if (restool.cmd_option_mask & ONE_BIT_MASK(APPLY_DPL_OPT_DRY_RUN)) {
+		restool.cmd_option_mask &= ~ONE_BIT_MASK(APPLY_DPL_OPT_DRY_RUN);
+		dry_run = true;
+	}
+
+	return dpl_reconcile(restool.obj_name, dprc_id, dry_run);
+}
+
 /**
  * DPRC command table
  */
@@ -2161,6 +3441,18 @@ struct object_command dprc_commands[] = {
 	  .options = dpl_generate_options,
 	  .cmd_func = cmd_dpl_generate },
 
+	{ .cmd_name = "clone",
+	  .options = dprc_clone_options,
+	  .cmd_func = cmd_dprc_clone },
+
+	{ .cmd_name = "apply-dpl",
+	  .options = dprc_apply_dpl_options,
+	  .cmd_func = cmd_dprc_apply_dpl },
+
+	{ .cmd_name = "reconcile",
+	  .options = dprc_apply_dpl_options,
+	  .cmd_func = cmd_dprc_reconcile },
+
 	{ .cmd_name = NULL },
 };
 
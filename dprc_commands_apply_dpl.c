@@ -0,0 +1,2672 @@
+/* Copyright 2026 NXP
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * * Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ * * Neither the name of the above-listed copyright holders nor the
+ * names of any contributors may be used to endorse or promote products
+ * derived from this software without specific prior written permission.
+ *
+ *
+ * ALTERNATIVELY, this software may be distributed under the terms of the
+ * GNU General Public License ("GPL") as published by the Free Software
+ * Foundation, either version 2 of that License or (at your option) any
+ * later version.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDERS OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <errno.h>
+#include <assert.h>
+#include <ctype.h>
+#include "restool.h"
+#include "utils.h"
+#include "mc_v9/fsl_dpdcei.h"
+#include "mc_v9/fsl_dpdmux.h"
+#include "mc_v9/fsl_dpio.h"
+#include "mc_v9/fsl_dpsw.h"
+#include "dprc_commands_clone.h"
+#include "dprc_commands_apply_dpl.h"
+
+enum mc_cmd_status mc_status;
+
+/**
+ * Property of a DTS node. Values are kept as written: the strings and the
+ * cells of the property, in order.
+ */
+struct dts_prop {
+	char *name;
+	char **strs;
+	int num_strs;
+	uint32_t *cells;
+	int num_cells;
+	int line;
+	struct dts_prop *next;
+};
+
+struct dts_node {
+	char *name;
+	int line;
+	struct dts_prop *props;
+	struct dts_node *children;
+	struct dts_node *next;
+};
+
+struct dts_parser {
+	const char *file;
+	const char *pos;
+	int line;
+};
+
+/**
+ * Container of the layout. Containers whose parent is "none" stand for
+ * the target container and are not created.
+ */
+struct dpl_container {
+	struct dts_node *node;
+	uint32_t dpl_id;
+	const char *parent_name;
+	int parent;
+	uint32_t parent_id;
+	bool existing;
+	union obj_create_cfg cfg;
+	uint32_t id;
+	uint16_t handle;
+	bool opened;
+	bool relabel;
+};
+
+/**
+ * Object of the layout. Objects that cannot be created (dpmac, dpaiop, ...)
+ * refer to the live object with the same id.
+ */
+struct dpl_obj {
+	char type[OBJ_TYPE_MAX_LENGTH + 1];
+	uint32_t dpl_id;
+	int container;
+	bool existing;
+	char label[MC_OBJ_LABEL_MAX_LENGTH + 1];
+	union obj_create_cfg cfg;
+	uint32_t id;
+	bool relabel;
+	bool plugged;
+};
+
+struct dpl_link {
+	int obj1;
+	int obj2;
+	uint16_t if_id1;
+	uint16_t if_id2;
+	bool connected;
+};
+
+struct dpl_layout {
+	struct dpl_container *containers;
+	int num_containers;
+	int max_containers;
+	struct dpl_obj *objs;
+	int num_objs;
+	int max_objs;
+	struct dpl_link *links;
+	int num_links;
+	int max_links;
+};
+
+enum dpl_prop_kind {
+	DPL_PROP_NUM,
+	DPL_PROP_LIST,
+	DPL_PROP_OPTIONS,
+	DPL_PROP_ENUM,
+	DPL_PROP_IGNORED,
+};
+
+/**
+ * Maps a DPL property of an object type to its field in the creation
+ * parameters of the object
+ */
+struct dpl_prop_desc {
+	const char *obj_type;
+	const char *name;
+	enum dpl_prop_kind kind;
+	size_t offset;
+	size_t size;
+	struct option_entry *map;
+	unsigned int map_len;
+};
+
+#define DPL_CFG_FIELD(_type, _field) \
+	offsetof(union obj_create_cfg, _type._field), \
+	sizeof(((union obj_create_cfg *)0)->_type._field)
+
+#define DPL_PROP(_type, _name, _kind, _field) \
+	{ #_type, _name, _kind, DPL_CFG_FIELD(_type, _field), NULL, 0 }
+
+#define DPL_PROP_MAP(_type, _name, _kind, _field, _map) \
+	{ #_type, _name, _kind, DPL_CFG_FIELD(_type, _field), \
+	  _map, ARRAY_SIZE(_map) }
+
+static struct option_entry dprc_options_map[] = {
+	OPTION_MAP_ENTRY(DPRC_CFG_OPT_SPAWN_ALLOWED),
+	OPTION_MAP_ENTRY(DPRC_CFG_OPT_ALLOC_ALLOWED),
+	OPTION_MAP_ENTRY(DPRC_CFG_OPT_OBJ_CREATE_ALLOWED),
+	OPTION_MAP_ENTRY(DPRC_CFG_OPT_TOPOLOGY_CHANGES_ALLOWED),
+	OPTION_MAP_ENTRY(DPRC_CFG_OPT_AIOP),
+	OPTION_MAP_ENTRY(DPRC_CFG_OPT_IRQ_CFG_ALLOWED),
+};
+
+static struct option_entry dpni_options_map[] = {
+	OPTION_MAP_ENTRY(DPNI_OPT_TX_FRM_RELEASE),
+	OPTION_MAP_ENTRY(DPNI_OPT_NO_MAC_FILTER),
+	OPTION_MAP_ENTRY(DPNI_OPT_HAS_POLICING),
+	OPTION_MAP_ENTRY(DPNI_OPT_SHARED_CONGESTION),
+	OPTION_MAP_ENTRY(DPNI_OPT_HAS_KEY_MASKING),
+	OPTION_MAP_ENTRY(DPNI_OPT_NO_FS),
+	OPTION_MAP_ENTRY(DPNI_OPT_HAS_OPR),
+	OPTION_MAP_ENTRY(DPNI_OPT_OPR_PER_TC),
+	OPTION_MAP_ENTRY(DPNI_OPT_SINGLE_SENDER),
+};
+
+static struct option_entry dpci_options_map[] = {
+	OPTION_MAP_ENTRY(DPCI_OPT_HAS_OPR),
+	OPTION_MAP_ENTRY(DPCI_OPT_OPR_SHARED),
+};
+
+static struct option_entry dpseci_options_map[] = {
+	OPTION_MAP_ENTRY(DPSECI_OPT_HAS_CG),
+	OPTION_MAP_ENTRY(DPSECI_OPT_HAS_OPR),
+	OPTION_MAP_ENTRY(DPSECI_OPT_OPR_SHARED),
+};
+
+static struct option_entry dpdmux_options_map[] = {
+	OPTION_MAP_ENTRY(DPDMUX_OPT_BRIDGE_EN),
+	OPTION_MAP_ENTRY(DPDMUX_OPT_CLS_MASK_SUPPORT),
+};
+
+static struct option_entry dpsw_options_map[] = {
+	OPTION_MAP_ENTRY(DPSW_OPT_FLOODING_DIS),
+	OPTION_MAP_ENTRY(DPSW_OPT_MULTICAST_DIS),
+	OPTION_MAP_ENTRY(DPSW_OPT_CTRL_IF_DIS),
+	OPTION_MAP_ENTRY(DPSW_OPT_FLOODING_METERING_DIS),
+	OPTION_MAP_ENTRY(DPSW_OPT_METERING_EN),
+};
+
+static struct option_entry dpio_channel_map[] = {
+	OPTION_MAP_ENTRY(DPIO_NO_CHANNEL),
+	OPTION_MAP_ENTRY(DPIO_LOCAL_CHANNEL),
+};
+
+static struct option_entry dpdcei_engine_map[] = {
+	OPTION_MAP_ENTRY(DPDCEI_ENGINE_COMPRESSION),
+	OPTION_MAP_ENTRY(DPDCEI_ENGINE_DECOMPRESSION),
+};
+
+static struct option_entry dpdmux_method_map[] = {
+	OPTION_MAP_ENTRY(DPDMUX_METHOD_NONE),
+	OPTION_MAP_ENTRY(DPDMUX_METHOD_C_VLAN_MAC),
+	OPTION_MAP_ENTRY(DPDMUX_METHOD_MAC),
+	OPTION_MAP_ENTRY(DPDMUX_METHOD_C_VLAN),
+	OPTION_MAP_ENTRY(DPDMUX_METHOD_CUSTOM),
+};
+
+static struct option_entry dpdmux_manip_map[] = {
+	OPTION_MAP_ENTRY(DPDMUX_MANIP_NONE),
+};
+
+/*
+ * Property names are the ones written by "dprc generate-dpl"
+ */
+static const struct dpl_prop_desc dpl_props[] = {
+	DPL_PROP_MAP(dprc, "options", DPL_PROP_OPTIONS, options,
+		     dprc_options_map),
+
+	DPL_PROP(dpni, "type", DPL_PROP_IGNORED, options),
+	DPL_PROP_MAP(dpni, "options", DPL_PROP_OPTIONS, options,
+		     dpni_options_map),
+	DPL_PROP(dpni, "num_queues", DPL_PROP_NUM, num_queues),
+	DPL_PROP(dpni, "num_tcs", DPL_PROP_NUM, num_tcs),
+	DPL_PROP(dpni, "mac_filter_entries", DPL_PROP_NUM, mac_filter_entries),
+	DPL_PROP(dpni, "vlan_filter_entries", DPL_PROP_NUM,
+		 vlan_filter_entries),
+	DPL_PROP(dpni, "fs_entries", DPL_PROP_NUM, fs_entries),
+	DPL_PROP(dpni, "qos_entries", DPL_PROP_NUM, qos_entries),
+
+	DPL_PROP_MAP(dpci, "options", DPL_PROP_OPTIONS, options,
+		     dpci_options_map),
+	DPL_PROP(dpci, "num_of_priorities", DPL_PROP_NUM, num_of_priorities),
+
+	DPL_PROP(dpcon, "num_priorities", DPL_PROP_NUM, num_priorities),
+
+	DPL_PROP_MAP(dpdcei, "engine", DPL_PROP_ENUM, engine,
+		     dpdcei_engine_map),
+	DPL_PROP(dpdcei, "priority", DPL_PROP_NUM, priority),
+
+	DPL_PROP(dpdmai, "priorities", DPL_PROP_LIST, priorities),
+
+	DPL_PROP_MAP(dpio, "channel_mode", DPL_PROP_ENUM, channel_mode,
+		     dpio_channel_map),
+	DPL_PROP(dpio, "num_priorities", DPL_PROP_NUM, num_priorities),
+
+	DPL_PROP_MAP(dpseci, "options", DPL_PROP_OPTIONS, options,
+		     dpseci_options_map),
+	DPL_PROP(dpseci, "priorities", DPL_PROP_LIST, priorities),
+
+	DPL_PROP_MAP(dpdmux, "options", DPL_PROP_OPTIONS, adv.options,
+		     dpdmux_options_map),
+	DPL_PROP_MAP(dpdmux, "method", DPL_PROP_ENUM, method,
+		     dpdmux_method_map),
+	DPL_PROP_MAP(dpdmux, "manip", DPL_PROP_ENUM, manip, dpdmux_manip_map),
+	DPL_PROP(dpdmux, "num_ifs", DPL_PROP_NUM, num_ifs),
+	DPL_PROP(dpdmux, "max_dmat_entries", DPL_PROP_NUM,
+		 adv.max_dmat_entries),
+	DPL_PROP(dpdmux, "max_mc_groups", DPL_PROP_NUM, adv.max_mc_groups),
+	DPL_PROP(dpdmux, "max_vlan_ids", DPL_PROP_NUM, adv.max_vlan_ids),
+
+	DPL_PROP_MAP(dpsw, "options", DPL_PROP_OPTIONS, adv.options,
+		     dpsw_options_map),
+	DPL_PROP(dpsw, "num_ifs", DPL_PROP_NUM, num_ifs),
+	DPL_PROP(dpsw, "max_vlans", DPL_PROP_NUM, adv.max_vlans),
+	DPL_PROP(dpsw, "max_fdbs", DPL_PROP_NUM, adv.max_fdbs),
+	DPL_PROP(dpsw, "num_fdb_entries", DPL_PROP_NUM, adv.max_fdb_entries),
+	DPL_PROP(dpsw, "fdb_aging_time", DPL_PROP_NUM, adv.fdb_aging_time),
+	DPL_PROP(dpsw, "max_fdb_mc_groups", DPL_PROP_NUM,
+		 adv.max_fdb_mc_groups),
+	DPL_PROP(dpsw, "max_meters_per_if", DPL_PROP_NUM,
+		 adv.max_meters_per_if),
+};
+
+/**
+ * Resources taken from the pools of the target container, besides one
+ * object of the object's own type
+ */
+static const struct {
+	const char *obj_type;
+	const char *res_type;
+} dpl_res_needs[] = {
+	{ "dprc", "mcp" },
+	{ "dpmcp", "mcp" },
+	{ "dpio", "swp" },
+	{ "dpbp", "bp" },
+};
+
+static void dts_free(struct dts_node *node)
+{
+	struct dts_node *child, *next_child;
+	struct dts_prop *prop, *next_prop;
+
+	for (prop = node->props; prop != NULL; prop = next_prop) {
+		next_prop = prop->next;
+		for (int i = 0; i < prop->num_strs; i++)
+			free(prop->strs[i]);
+		free(prop->strs);
+		free(prop->cells);
+		free(prop->name);
+		free(prop);
+	}
+
+	for (child = node->children; child != NULL; child = next_child) {
+		next_child = child->next;
+		dts_free(child);
+	}
+
+	free(node->name);
+	free(node);
+}
+
+static struct dts_node *dts_find_child(const struct dts_node *node,
+				       const char *name)
+{
+	struct dts_node *child;
+
+	for (child = node->children; child != NULL; child = child->next) {
+		if (strcmp(child->name, name) == 0)
+			return child;
+	}
+
+	return NULL;
+}
+
+static struct dts_prop *dts_find_prop(const struct dts_node *node,
+				      const char *name)
+{
+	struct dts_prop *prop;
+
+	for (prop = node->props; prop != NULL; prop = prop->next) {
+		if (strcmp(prop->name, name) == 0)
+			return prop;
+	}
+
+	return NULL;
+}
+
+static void dts_skip_blanks(struct dts_parser *p)
+{
+	for (;;) {
+		if (*p->pos == '\n') {
+			p->line++;
+			p->pos++;
+		} else if (isspace((unsigned char)*p->pos)) {
+			p->pos++;
+		} else if (p->pos[0] == '/' && p->pos[1] == '*') {
+			p->pos += 2;
+			while (*p->pos != '\0' &&
+			       !(p->pos[0] == '*' && p->pos[1] == '/')) {
+				if (*p->pos == '\n')
+					p->line++;
+				p->pos++;
+			}
+			if (*p->pos != '\0')
+				p->pos += 2;
+		} else if (p->pos[0] == '/' && p->pos[1] == '/') {
+			while (*p->pos != '\0' && *p->pos != '\n')
+				p->pos++;
+		} else {
+			break;
+		}
+	}
+}
+
+static int dts_expect(struct dts_parser *p, char c)
+{
+	dts_skip_blanks(p);
+	if (*p->pos != c) {
+		ERROR_PRINTF("%s:%d: expected '%c'\n", p->file, p->line, c);
+		return -EINVAL;
+	}
+
+	p->pos++;
+	return 0;
+}
+
+static bool dts_is_name_char(char c)
+{
+	return isalnum((unsigned char)c) || strchr(",._+*#?@-", c) != NULL;
+}
+
+static int dts_read_name(struct dts_parser *p, char **name)
+{
+	const char *start = p->pos;
+
+	while (*p->pos != '\0' && dts_is_name_char(*p->pos))
+		p->pos++;
+
+	if (p->pos == start) {
+		ERROR_PRINTF("%s:%d: expected a node or property name\n",
+			     p->file, p->line);
+		return -EINVAL;
+	}
+
+	*name = strndup(start, p->pos - start);
+	if (*name == NULL) {
+		ERROR_PRINTF("Could not alloc memory!\n");
+		return -ENOMEM;
+	}
+
+	return 0;
+}
+
+static int dts_add_cell(struct dts_prop *prop, uint32_t cell)
+{
+	uint32_t *cells;
+
+	cells = realloc(prop->cells, (prop->num_cells + 1) * sizeof(*cells));
+	if (cells == NULL) {
+		ERROR_PRINTF("Could not alloc memory!\n");
+		return -ENOMEM;
+	}
+
+	cells[prop->num_cells++] = cell;
+	prop->cells = cells;
+	return 0;
+}
+
+static int dts_read_string(struct dts_parser *p, struct dts_prop *prop)
+{
+	const char *start = ++p->pos;
+	char **strs;
+	char *str;
+	int len = 0;
+
+	while (*p->pos != '"') {
+		if (*p->pos == '\0' || *p->pos == '\n') {
+			ERROR_PRINTF("%s:%d: unterminated string\n",
+				     p->file, p->line);
+			return -EINVAL;
+		}
+		if (*p->pos == '\\' && p->pos[1] != '\0')
+			p->pos++;
+		p->pos++;
+	}
+
+	str = malloc(p->pos - start + 1);
+	if (str == NULL) {
+		ERROR_PRINTF("Could not alloc memory!\n");
+		return -ENOMEM;
+	}
+
+	for (const char *c = start; c < p->pos; c++) {
+		if (*c == '\\')
+			c++;
+		str[len++] = *c;
+	}
+	str[len] = '\0';
+	p->pos++;
+
+	strs = realloc(prop->strs, (prop->num_strs + 1) * sizeof(*strs));
+	if (strs == NULL) {
+		ERROR_PRINTF("Could not alloc memory!\n");
+		free(str);
+		return -ENOMEM;
+	}
+
+	strs[prop->num_strs++] = str;
+	prop->strs = strs;
+	return 0;
+}
+
+static int dts_read_cells(struct dts_parser *p, struct dts_prop *prop,
+			  char end_char, int base)
+{
+	unsigned long cell;
+	char *end;
+	int error;
+
+	p->pos++;
+	for (;;) {
+		dts_skip_blanks(p);
+		if (*p->pos == end_char)
+			break;
+
+		errno = 0;
+		cell = strtoul(p->pos, &end, base);
+		if (end == p->pos || errno != 0 || cell > UINT32_MAX) {
+			ERROR_PRINTF("%s:%d: invalid number\n",
+				     p->file, p->line);
+			return -EINVAL;
+		}
+
+		p->pos = end;
+		error = dts_add_cell(prop, cell);
+		if (error < 0)
+			return error;
+	}
+
+	p->pos++;
+	return 0;
+}
+
+static int dts_read_value(struct dts_parser *p, struct dts_prop *prop)
+{
+	dts_skip_blanks(p);
+	switch (*p->pos) {
+	case '"':
+		return dts_read_string(p, prop);
+	case '<':
+		return dts_read_cells(p, prop, '>', 0);
+	case '[':
+		return dts_read_cells(p, prop, ']', 16);
+	default:
+		ERROR_PRINTF("%s:%d: expected a string, <cells> or [bytes]\n",
+			     p->file, p->line);
+		return -EINVAL;
+	}
+}
+
+static int dts_parse_node(struct dts_parser *p, struct dts_node *node);
+
+static int dts_add_prop(struct dts_parser *p, struct dts_node *node,
+			char *name)
+{
+	struct dts_prop *prop, **tail;
+	int error;
+
+	prop = calloc(1, sizeof(*prop));
+	if (prop == NULL) {
+		ERROR_PRINTF("Could not alloc memory!\n");
+		free(name);
+		return -ENOMEM;
+	}
+
+	prop->name = name;
+	prop->line = p->line;
+	for (tail = &node->props; *tail != NULL; tail = &(*tail)->next)
+		;
+	*tail = prop;
+
+	dts_skip_blanks(p);
+	if (*p->pos == ';') {
+		p->pos++;
+		return 0;
+	}
+
+	error = dts_expect(p, '=');
+	while (error == 0) {
+		error = dts_read_value(p, prop);
+		if (error < 0)
+			break;
+
+		dts_skip_blanks(p);
+		if (*p->pos != ',')
+			return dts_expect(p, ';');
+		p->pos++;
+	}
+
+	return error;
+}
+
+static int dts_add_node(struct dts_parser *p, struct dts_node *node,
+			char *name)
+{
+	struct dts_node *child, **tail;
+
+	child = calloc(1, sizeof(*child));
+	if (child == NULL) {
+		ERROR_PRINTF("Could not alloc memory!\n");
+		free(name);
+		return -ENOMEM;
+	}
+
+	child->name = name;
+	child->line = p->line;
+	for (tail = &node->children; *tail != NULL; tail = &(*tail)->next)
+		;
+	*tail = child;
+
+	p->pos++;
+	return dts_parse_node(p, child);
+}
+
+/**
+ * Parses the contents of a node, up to and including its closing "};"
+ */
+static int dts_parse_node(struct dts_parser *p, struct dts_node *node)
+{
+	char *name;
+	int error;
+
+	for (;;) {
+		dts_skip_blanks(p);
+		if (*p->pos == '}') {
+			p->pos++;
+			return dts_expect(p, ';');
+		}
+
+		if (*p->pos == '\0') {
+			ERROR_PRINTF("%s:%d: unexpected end of file in node %s\n",
+				     p->file, p->line, node->name);
+			return -EINVAL;
+		}
+
+		error = dts_read_name(p, &name);
+		if (error < 0)
+			return error;
+
+		dts_skip_blanks(p);
+		if (*p->pos == ':') {
+			/* node labels are not used */
+			free(name);
+			p->pos++;
+			continue;
+		}
+
+		if (*p->pos == '{')
+			error = dts_add_node(p, node, name);
+		else
+			error = dts_add_prop(p, node, name);
+		if (error < 0)
+			return error;
+	}
+}
+
+/**
+ * Parses a DTS source into a tree. Root nodes given more than once are
+ * merged; node labels, includes and phandle references are not supported.
+ */
+static int dts_parse(const char *file, const char *buf, struct dts_node *root)
+{
+	struct dts_parser p = { .file = file, .pos = buf, .line = 1 };
+	int error;
+
+	for (;;) {
+		dts_skip_blanks(&p);
+		if (*p.pos == '\0')
+			return 0;
+
+		if (strncmp(p.pos, "/dts-v1/", 8) == 0) {
+			p.pos += 8;
+			error = dts_expect(&p, ';');
+		} else if (*p.pos == '/') {
+			p.pos++;
+			error = dts_expect(&p, '{');
+			if (error == 0)
+				error = dts_parse_node(&p, root);
+		} else {
+			ERROR_PRINTF("%s:%d: expected the root node\n",
+				     p.file, p.line);
+			error = -EINVAL;
+		}
+
+		if (error < 0)
+			return error;
+	}
+}
+
+static int read_dpl_file(const char *dpl_file, struct dts_node **root_out)
+{
+	struct dts_node *root;
+	char *buf = NULL;
+	size_t len = 0;
+	size_t n;
+	FILE *fp;
+	int error;
+
+	fp = fopen(dpl_file, "r");
+	if (fp == NULL) {
+		error = -errno;
+		ERROR_PRINTF("Could not open %s: %s\n", dpl_file,
+			     strerror(errno));
+		return error;
+	}
+
+	do {
+		char *new_buf = realloc(buf, len + 4096 + 1);
+
+		if (new_buf == NULL) {
+			ERROR_PRINTF("Could not alloc memory!\n");
+			free(buf);
+			fclose(fp);
+			return -ENOMEM;
+		}
+		buf = new_buf;
+		n = fread(buf + len, 1, 4096, fp);
+		len += n;
+	} while (n == 4096);
+
+	error = ferror(fp) ? -EIO : 0;
+	fclose(fp);
+	if (error < 0) {
+		ERROR_PRINTF("Could not read %s\n", dpl_file);
+		free(buf);
+		return error;
+	}
+	buf[len] = '\0';
+
+	root = calloc(1, sizeof(*root));
+	if (root == NULL) {
+		ERROR_PRINTF("Could not alloc memory!\n");
+		free(buf);
+		return -ENOMEM;
+	}
+
+	error = dts_parse(dpl_file, buf, root);
+	free(buf);
+	if (error < 0) {
+		dts_free(root);
+		return error;
+	}
+
+	*root_out = root;
+	return 0;
+}
+
+/**
+ * Splits "<type>@<id>", or the "<type>.<id>" restool syntax
+ */
+static int parse_dpl_obj_name(const char *name, char *type, uint32_t *id)
+{
+	const char *sep = strpbrk(name, "@.");
+	unsigned long obj_id;
+	char *end;
+
+	if (sep == NULL || sep == name || sep - name > OBJ_TYPE_MAX_LENGTH)
+		return -EINVAL;
+
+	errno = 0;
+	obj_id = strtoul(sep + 1, &end, 10);
+	if (end == sep + 1 || *end != '\0' || errno != 0 ||
+	    obj_id > INT32_MAX)
+		return -EINVAL;
+
+	memcpy(type, name, sep - name);
+	type[sep - name] = '\0';
+	*id = obj_id;
+	return 0;
+}
+
+static const char *get_prop_string(const struct dts_node *node,
+				   const struct dts_prop *prop)
+{
+	if (prop->num_strs != 1 || prop->num_cells != 0) {
+		ERROR_PRINTF("line %d: %s of %s must be a single string\n",
+			     prop->line, prop->name, node->name);
+		return NULL;
+	}
+
+	return prop->strs[0];
+}
+
+static const struct dpl_prop_desc *find_prop_desc(const char *obj_type,
+						  const char *name)
+{
+	for (unsigned int i = 0; i < ARRAY_SIZE(dpl_props); i++) {
+		if (strcmp(dpl_props[i].obj_type, obj_type) == 0 &&
+		    strcmp(dpl_props[i].name, name) == 0)
+			return &dpl_props[i];
+	}
+
+	return NULL;
+}
+
+static int lookup_map(const struct dpl_prop_desc *desc, const char *str,
+		      uint64_t *value)
+{
+	for (unsigned int i = 0; i < desc->map_len; i++) {
+		if (strcmp(desc->map[i].str, str) == 0) {
+			*value = desc->map[i].value;
+			return 0;
+		}
+	}
+
+	return -EINVAL;
+}
+
+static int set_cfg_field(const struct dpl_prop_desc *desc, size_t index,
+			 uint64_t value, union obj_create_cfg *cfg)
+{
+	uint8_t *field = (uint8_t *)cfg + desc->offset;
+	size_t size = desc->kind == DPL_PROP_LIST ? 1 : desc->size;
+	uint64_t max = size >= sizeof(uint64_t) ? UINT64_MAX :
+		       (UINT64_C(1) << (size * 8)) - 1;
+	uint8_t u8 = value;
+	uint16_t u16 = value;
+	uint32_t u32 = value;
+
+	if (value > max)
+		return -ERANGE;
+
+	field += index * size;
+	switch (size) {
+	case sizeof(uint8_t):
+		memcpy(field, &u8, size);
+		break;
+	case sizeof(uint16_t):
+		memcpy(field, &u16, size);
+		break;
+	case sizeof(uint32_t):
+		memcpy(field, &u32, size);
+		break;
+	default:
+		memcpy(field, &value, sizeof(value));
+		break;
+	}
+
+	return 0;
+}
+
+/**
+ * Stores the value of a property of the object node in the creation
+ * parameters of the object
+ */
+static int read_dpl_prop(const struct dts_node *node,
+			 const struct dts_prop *prop,
+			 const struct dpl_prop_desc *desc,
+			 union obj_create_cfg *cfg)
+{
+	uint64_t value = 0;
+	uint64_t option;
+	int error = 0;
+
+	switch (desc->kind) {
+	case DPL_PROP_IGNORED:
+		return 0;
+
+	case DPL_PROP_NUM:
+		if (prop->num_cells != 1 || prop->num_strs != 0)
+			goto invalid;
+		error = set_cfg_field(desc, 0, prop->cells[0], cfg);
+		break;
+
+	case DPL_PROP_LIST:
+		if (prop->num_strs != 0 || (size_t)prop->num_cells > desc->size)
+			goto invalid;
+		for (int i = 0; i < prop->num_cells && error == 0; i++)
+			error = set_cfg_field(desc, i, prop->cells[i], cfg);
+		break;
+
+	case DPL_PROP_OPTIONS:
+		if (prop->num_cells != 0)
+			goto invalid;
+		for (int i = 0; i < prop->num_strs; i++) {
+			if (lookup_map(desc, prop->strs[i], &option) < 0) {
+				ERROR_PRINTF("line %d: invalid option '%s' for %s\n",
+					     prop->line, prop->strs[i],
+					     node->name);
+				return -EINVAL;
+			}
+			value |= option;
+		}
+		error = set_cfg_field(desc, 0, value, cfg);
+		break;
+
+	case DPL_PROP_ENUM:
+		if (prop->num_strs != 1 || prop->num_cells != 0 ||
+		    lookup_map(desc, prop->strs[0], &value) < 0)
+			goto invalid;
+		assert(desc->size == sizeof(int));
+		error = set_cfg_field(desc, 0, value, cfg);
+		break;
+	}
+
+	if (error == 0)
+		return 0;
+invalid:
+	ERROR_PRINTF("line %d: invalid value for %s of %s\n",
+		     prop->line, prop->name, node->name);
+	return -EINVAL;
+}
+
+static void set_default_cfg(const char *obj_type, union obj_create_cfg *cfg)
+{
+	memset(cfg, 0, sizeof(*cfg));
+	if (strcmp(obj_type, "dprc") == 0) {
+		cfg->dprc.icid = DPRC_GET_ICID_FROM_POOL;
+		cfg->dprc.portal_id = DPRC_GET_PORTAL_ID_FROM_POOL;
+	} else if (strcmp(obj_type, "dpci") == 0) {
+		cfg->dpci.num_of_priorities = 1;
+	} else if (strcmp(obj_type, "dpcon") == 0) {
+		cfg->dpcon.num_priorities = 1;
+	} else if (strcmp(obj_type, "dpdcei") == 0) {
+		cfg->dpdcei.priority = 1;
+	} else if (strcmp(obj_type, "dpdmai") == 0) {
+		cfg->dpdmai.priorities[0] = 1;
+		cfg->dpdmai.priorities[1] = 2;
+	} else if (strcmp(obj_type, "dpdmux") == 0) {
+		cfg->dpdmux.method = DPDMUX_METHOD_C_VLAN_MAC;
+		cfg->dpdmux.manip = DPDMUX_MANIP_NONE;
+	} else if (strcmp(obj_type, "dpio") == 0) {
+		cfg->dpio.channel_mode = DPIO_LOCAL_CHANNEL;
+		cfg->dpio.num_priorities = 8;
+	} else if (strcmp(obj_type, "dpsw") == 0) {
+		cfg->dpsw.num_ifs = 4;
+	}
+}
+
+static void finish_cfg(const char *obj_type, union obj_create_cfg *cfg)
+{
+	int num_prios = 0;
+
+	if (strcmp(obj_type, "dpdmux") == 0) {
+		/* num_ifs counts the uplink interface in the DPL */
+		if (cfg->dpdmux.num_ifs > 0)
+			cfg->dpdmux.num_ifs--;
+	} else if (strcmp(obj_type, "dpseci") == 0) {
+		while (num_prios < DPSECI_PRIO_NUM &&
+		       cfg->dpseci.priorities[num_prios] != 0)
+			num_prios++;
+		cfg->dpseci.num_tx_queues = num_prios ? num_prios : 1;
+		cfg->dpseci.num_rx_queues = cfg->dpseci.num_tx_queues;
+		if (num_prios == 0)
+			cfg->dpseci.priorities[0] = 1;
+	}
+}
+
+/**
+ * Reads the properties of a container or object node, other than the
+ * ones in skip_props
+ */
+static int read_dpl_props(const struct dts_node *node, const char *obj_type,
+			  const char *const skip_props[],
+			  char *label, union obj_create_cfg *cfg)
+{
+	const struct dpl_prop_desc *desc;
+	const struct dts_prop *prop;
+	char compatible[OBJ_TYPE_MAX_LENGTH + 6];
+	const char *str;
+	int error;
+
+	set_default_cfg(obj_type, cfg);
+	snprintf(compatible, sizeof(compatible), "fsl,%s", obj_type);
+
+	for (prop = node->props; prop != NULL; prop = prop->next) {
+		bool skip = false;
+
+		for (int i = 0; skip_props[i] != NULL; i++)
+			skip = skip || strcmp(prop->name, skip_props[i]) == 0;
+		if (skip)
+			continue;
+
+		if (strcmp(prop->name, "compatible") == 0) {
+			str = get_prop_string(node, prop);
+			if (str == NULL)
+				return -EINVAL;
+			if (strcmp(str, compatible) != 0) {
+				ERROR_PRINTF("line %d: unknown compatible %s for node %s\n",
+					     prop->line, str, node->name);
+				return -EINVAL;
+			}
+			continue;
+		}
+
+		if (strcmp(prop->name, "label") == 0) {
+			str = get_prop_string(node, prop);
+			if (str == NULL)
+				return -EINVAL;
+			if (strlen(str) > MC_OBJ_LABEL_MAX_LENGTH) {
+				ERROR_PRINTF("line %d: label of %s longer than %d characters\n",
+					     prop->line, node->name,
+					     MC_OBJ_LABEL_MAX_LENGTH);
+				return -EINVAL;
+			}
+			strcpy(label, str);
+			continue;
+		}
+
+		desc = find_prop_desc(obj_type, prop->name);
+		if (desc == NULL) {
+			ERROR_PRINTF("line %d: unknown property %s for node %s\n",
+				     prop->line, prop->name, node->name);
+			return -EINVAL;
+		}
+
+		error = read_dpl_prop(node, prop, desc, cfg);
+		if (error < 0)
+			return error;
+	}
+
+	finish_cfg(obj_type, cfg);
+	return 0;
+}
+
+static void *grow_array(void *array, int num, int *max, size_t elem_size)
+{
+	void *new_array;
+
+	if (num < *max)
+		return array;
+
+	new_array = realloc(array, (*max ? *max * 2 : 16) * elem_size);
+	if (new_array == NULL) {
+		ERROR_PRINTF("Could not alloc memory!\n");
+		return NULL;
+	}
+
+	*max = *max ? *max * 2 : 16;
+	return new_array;
+}
+
+static int find_dpl_obj(const struct dpl_layout *layout, const char *type,
+			uint32_t id)
+{
+	for (int i = 0; i < layout->num_objs; i++) {
+		if (layout->objs[i].dpl_id == id &&
+		    strcmp(layout->objs[i].type, type) == 0)
+			return i;
+	}
+
+	return -1;
+}
+
+static int find_dpl_container(const struct dpl_layout *layout, uint32_t id)
+{
+	for (int i = 0; i < layout->num_containers; i++) {
+		if (layout->containers[i].dpl_id == id)
+			return i;
+	}
+
+	return -1;
+}
+
+/**
+ * Adds an object to the layout. Objects outside of any container of the
+ * layout (container -1) are live objects referenced by a connection.
+ */
+static int add_dpl_obj(struct dpl_layout *layout, const struct dts_node *root,
+		       const char *type, uint32_t id, int container,
+		       const char *label)
+{
+	static const char *const skip_props[] = { NULL };
+	const struct dts_node *objects;
+	const struct dts_node *node;
+	struct dpl_obj *obj;
+	char name[32];
+	int index;
+	int error;
+
+	if (strcmp(type, "dprc") == 0) {
+		ERROR_PRINTF("dprc@%u must be listed under /containers\n", id);
+		return -EINVAL;
+	}
+
+	index = find_dpl_obj(layout, type, id);
+	if (index >= 0) {
+		if (container < 0)
+			return index;
+		ERROR_PRINTF("%s@%u is listed more than once\n", type, id);
+		return -EINVAL;
+	}
+
+	obj = grow_array(layout->objs, layout->num_objs, &layout->max_objs,
+			 sizeof(*layout->objs));
+	if (obj == NULL)
+		return -ENOMEM;
+	layout->objs = obj;
+
+	obj = &layout->objs[layout->num_objs];
+	memset(obj, 0, sizeof(*obj));
+	strcpy(obj->type, type);
+	obj->dpl_id = id;
+	obj->id = id;
+	obj->container = container;
+	obj->existing = container < 0 || !can_create_obj_v10(type);
+	obj->plugged = true;
+
+	snprintf(name, sizeof(name), "%s@%u", type, id);
+	objects = dts_find_child(root, "objects");
+	node = objects ? dts_find_child(objects, name) : NULL;
+	if (node == NULL && !obj->existing) {
+		ERROR_PRINTF("%s was not defined in /objects\n", name);
+		return -EINVAL;
+	}
+
+	if (node != NULL && !obj->existing) {
+		error = read_dpl_props(node, type, skip_props, obj->label,
+				       &obj->cfg);
+		if (error < 0)
+			return error;
+	}
+
+	if (label != NULL)
+		strcpy(obj->label, label);
+
+	return layout->num_objs++;
+}
+
+/**
+ * Objects are plugged once created, unless their node has plugged = <0>
+ */
+static int read_plugged_prop(const struct dts_node *node,
+			     const struct dts_prop *prop, bool *plugged)
+{
+	*plugged = true;
+	if (prop == NULL)
+		return 0;
+
+	if (prop->num_cells != 1 || prop->num_strs != 0 ||
+	    prop->cells[0] > 1) {
+		ERROR_PRINTF("line %d: plugged of %s must be <0> or <1>\n",
+			     prop->line, node->name);
+		return -EINVAL;
+	}
+
+	*plugged = prop->cells[0] == 1;
+	return 0;
+}
+
+static int read_obj_set(struct dpl_layout *layout, const struct dts_node *root,
+			const struct dts_node *set, int container)
+{
+	const struct dts_prop *type_prop = dts_find_prop(set, "type");
+	const struct dts_prop *ids_prop = dts_find_prop(set, "ids");
+	const struct dts_prop *plugged_prop = dts_find_prop(set, "plugged");
+	const char *type;
+	bool plugged;
+	int error;
+
+	for (const struct dts_prop *prop = set->props; prop; prop = prop->next) {
+		if (prop != type_prop && prop != ids_prop &&
+		    prop != plugged_prop) {
+			ERROR_PRINTF("line %d: unknown property %s in node %s\n",
+				     prop->line, prop->name, set->name);
+			return -EINVAL;
+		}
+	}
+
+	if (type_prop == NULL || ids_prop == NULL) {
+		ERROR_PRINTF("line %d: %s needs both type and ids\n",
+			     set->line, set->name);
+		return -EINVAL;
+	}
+
+	type = get_prop_string(set, type_prop);
+	if (type == NULL)
+		return -EINVAL;
+	if (strlen(type) > OBJ_TYPE_MAX_LENGTH) {
+		ERROR_PRINTF("line %d: invalid object type %s\n",
+			     type_prop->line, type);
+		return -EINVAL;
+	}
+
+	error = read_plugged_prop(set, plugged_prop, &plugged);
+	if (error < 0)
+		return error;
+
+	for (int i = 0; i < ids_prop->num_cells; i++) {
+		error = add_dpl_obj(layout, root, type, ids_prop->cells[i],
+				    container, NULL);
+		if (error < 0)
+			return error;
+		layout->objs[error].plugged = plugged;
+	}
+
+	return 0;
+}
+
+/**
+ * obj@<n> nodes are written for MC firmware v9 layouts
+ */
+static int read_obj_node(struct dpl_layout *layout, const struct dts_node *root,
+			 const struct dts_node *node, int container)
+{
+	const struct dts_prop *name_prop = dts_find_prop(node, "obj_name");
+	const struct dts_prop *label_prop = dts_find_prop(node, "label");
+	const struct dts_prop *plugged_prop = dts_find_prop(node, "plugged");
+	char type[OBJ_TYPE_MAX_LENGTH + 1];
+	const char *label = NULL;
+	const char *name;
+	bool plugged;
+	uint32_t id;
+	int error;
+
+	if (name_prop == NULL) {
+		ERROR_PRINTF("line %d: %s has no obj_name\n",
+			     node->line, node->name);
+		return -EINVAL;
+	}
+
+	name = get_prop_string(node, name_prop);
+	if (name == NULL)
+		return -EINVAL;
+	if (parse_dpl_obj_name(name, type, &id) < 0) {
+		ERROR_PRINTF("line %d: invalid object name %s\n",
+			     name_prop->line, name);
+		return -EINVAL;
+	}
+
+	if (label_prop != NULL) {
+		label = get_prop_string(node, label_prop);
+		if (label == NULL)
+			return -EINVAL;
+		if (strlen(label) > MC_OBJ_LABEL_MAX_LENGTH) {
+			ERROR_PRINTF("line %d: label of %s longer than %d characters\n",
+				     label_prop->line, name,
+				     MC_OBJ_LABEL_MAX_LENGTH);
+			return -EINVAL;
+		}
+	}
+
+	error = read_plugged_prop(node, plugged_prop, &plugged);
+	if (error < 0)
+		return error;
+
+	error = add_dpl_obj(layout, root, type, id, container, label);
+	if (error < 0)
+		return error;
+
+	layout->objs[error].plugged = plugged;
+	return 0;
+}
+
+static int read_containers(struct dpl_layout *layout,
+			   const struct dts_node *root)
+{
+	static const char *const skip_props[] = { "parent", NULL };
+	const struct dts_node *containers = dts_find_child(root, "containers");
+	const struct dts_node *node, *objects, *child;
+	struct dpl_container *cont;
+	const struct dts_prop *prop;
+	char type[OBJ_TYPE_MAX_LENGTH + 1];
+	int error;
+
+	if (containers == NULL) {
+		ERROR_PRINTF("The DPL does not have a /containers node\n");
+		return -EINVAL;
+	}
+
+	for (node = containers->children; node != NULL; node = node->next) {
+		cont = grow_array(layout->containers, layout->num_containers,
+				  &layout->max_containers,
+				  sizeof(*layout->containers));
+		if (cont == NULL)
+			return -ENOMEM;
+		layout->containers = cont;
+
+		cont = &layout->containers[layout->num_containers];
+		memset(cont, 0, sizeof(*cont));
+		cont->node = (struct dts_node *)node;
+		cont->parent = -1;
+		if (parse_dpl_obj_name(node->name, type, &cont->dpl_id) < 0 ||
+		    strcmp(type, "dprc") != 0) {
+			ERROR_PRINTF("line %d: unknown container node %s\n",
+				     node->line, node->name);
+			return -EINVAL;
+		}
+
+		if (find_dpl_container(layout, cont->dpl_id) >= 0) {
+			ERROR_PRINTF("line %d: %s is defined more than once\n",
+				     node->line, node->name);
+			return -EINVAL;
+		}
+
+		prop = dts_find_prop(node, "parent");
+		if (prop == NULL) {
+			ERROR_PRINTF("line %d: %s has no parent\n",
+				     node->line, node->name);
+			return -EINVAL;
+		}
+
+		cont->parent_name = get_prop_string(node, prop);
+		if (cont->parent_name == NULL)
+			return -EINVAL;
+
+		error = read_dpl_props(node, "dprc", skip_props,
+				       cont->cfg.dprc.label, &cont->cfg);
+		if (error < 0)
+			return error;
+
+		layout->num_containers++;
+	}
+
+	for (int i = 0; i < layout->num_containers; i++) {
+		cont = &layout->containers[i];
+		if (strcmp(cont->parent_name, "none") == 0) {
+			cont->existing = true;
+			continue;
+		}
+
+		if (parse_dpl_obj_name(cont->parent_name, type,
+				       &cont->parent_id) < 0 ||
+		    strcmp(type, "dprc") != 0) {
+			ERROR_PRINTF("line %d: invalid parent %s\n",
+				     cont->node->line, cont->parent_name);
+			return -EINVAL;
+		}
+
+		/* a parent outside the layout is a live container */
+		cont->parent = find_dpl_container(layout, cont->parent_id);
+	}
+
+	for (int i = 0; i < layout->num_containers; i++) {
+		objects = dts_find_child(layout->containers[i].node, "objects");
+		if (objects == NULL)
+			continue;
+
+		for (child = objects->children; child; child = child->next) {
+			if (strncmp(child->name, "obj_set@", 8) == 0)
+				error = read_obj_set(layout, root, child, i);
+			else if (strncmp(child->name, "obj@", 4) == 0)
+				error = read_obj_node(layout, root, child, i);
+			else {
+				ERROR_PRINTF("line %d: unknown object node %s\n",
+					     child->line, child->name);
+				error = -EINVAL;
+			}
+			if (error < 0)
+				return error;
+		}
+	}
+
+	return 0;
+}
+
+static int read_endpoint(struct dpl_layout *layout,
+			 const struct dts_node *root,
+			 const struct dts_node *node, const char *prop_name,
+			 int *obj, uint16_t *if_id)
+{
+	const struct dts_prop *prop = dts_find_prop(node, prop_name);
+	char type[OBJ_TYPE_MAX_LENGTH + 1];
+	char name[32];
+	const char *str;
+	const char *sep;
+	uint32_t id;
+	uint32_t if_num = 0;
+
+	if (prop == NULL) {
+		ERROR_PRINTF("line %d: %s has no %s\n",
+			     node->line, node->name, prop_name);
+		return -EINVAL;
+	}
+
+	str = get_prop_string(node, prop);
+	if (str == NULL)
+		return -EINVAL;
+
+	sep = strchr(str, '/');
+	if (sep == NULL)
+		sep = str + strlen(str);
+	if ((size_t)(sep - str) >= sizeof(name))
+		goto invalid;
+
+	memcpy(name, str, sep - str);
+	name[sep - str] = '\0';
+	if (parse_dpl_obj_name(name, type, &id) < 0)
+		goto invalid;
+
+	if (*sep != '\0' &&
+	    (parse_dpl_obj_name(sep + 1, name, &if_num) < 0 ||
+	     strcmp(name, "if") != 0 || if_num > UINT16_MAX))
+		goto invalid;
+
+	*obj = add_dpl_obj(layout, root, type, id, -1, NULL);
+	if (*obj < 0)
+		return *obj;
+
+	*if_id = if_num;
+	return 0;
+invalid:
+	ERROR_PRINTF("line %d: invalid endpoint %s\n", prop->line, str);
+	return -EINVAL;
+}
+
+static int read_connections(struct dpl_layout *layout,
+			    const struct dts_node *root)
+{
+	const struct dts_node *connections;
+	const struct dts_node *node;
+	struct dpl_link *link;
+	int error;
+
+	connections = dts_find_child(root, "connections");
+	if (connections == NULL)
+		return 0;
+
+	for (node = connections->children; node != NULL; node = node->next) {
+		link = grow_array(layout->links, layout->num_links,
+				  &layout->max_links, sizeof(*layout->links));
+		if (link == NULL)
+			return -ENOMEM;
+		layout->links = link;
+
+		link = &layout->links[layout->num_links];
+		memset(link, 0, sizeof(*link));
+		error = read_endpoint(layout, root, node, "endpoint1",
+				      &link->obj1, &link->if_id1);
+		if (error < 0)
+			return error;
+
+		error = read_endpoint(layout, root, node, "endpoint2",
+				      &link->obj2, &link->if_id2);
+		if (error < 0)
+			return error;
+
+		layout->num_links++;
+	}
+
+	return 0;
+}
+
+static void free_dpl_layout(struct dpl_layout *layout)
+{
+	free(layout->containers);
+	free(layout->objs);
+	free(layout->links);
+}
+
+/**
+ * Returns in order[] the indices of the containers, every container after
+ * its parent
+ */
+static int sort_containers(const struct dpl_layout *layout, int *order)
+{
+	bool *placed;
+	int num_placed = 0;
+	bool progress = true;
+
+	placed = calloc(layout->num_containers + 1, sizeof(*placed));
+	if (placed == NULL) {
+		ERROR_PRINTF("Could not alloc memory!\n");
+		return -ENOMEM;
+	}
+
+	while (num_placed < layout->num_containers && progress) {
+		progress = false;
+		for (int i = 0; i < layout->num_containers; i++) {
+			int parent = layout->containers[i].parent;
+
+			if (placed[i] || (parent >= 0 && !placed[parent]))
+				continue;
+
+			placed[i] = true;
+			order[num_placed++] = i;
+			progress = true;
+		}
+	}
+
+	free(placed);
+	if (num_placed < layout->num_containers) {
+		ERROR_PRINTF("The parents of the DPL containers form a loop\n");
+		return -EINVAL;
+	}
+
+	return 0;
+}
+
+static int get_free_resources(uint16_t dprc_handle, char *res_type,
+			      int *res_count)
+{
+	int error;
+
+	error = dprc_get_res_count(&restool.mc_io, 0, dprc_handle, res_type,
+				   res_count);
+	if (error < 0) {
+		mc_status = flib_error_to_mc_status(error);
+		ERROR_PRINTF("MC error: %s (status %#x)\n",
+			     mc_status_to_string(mc_status), mc_status);
+	}
+
+	return error;
+}
+
+static int count_res_needs(const char *obj_type, const char *res_type)
+{
+	int needed = strcmp(obj_type, res_type) == 0;
+
+	for (unsigned int i = 0; i < ARRAY_SIZE(dpl_res_needs); i++) {
+		if (strcmp(dpl_res_needs[i].obj_type, obj_type) == 0 &&
+		    strcmp(dpl_res_needs[i].res_type, res_type) == 0)
+			needed++;
+	}
+
+	return needed;
+}
+
+/**
+ * Counts what the layout takes from each resource pool of the target
+ * container. Only the pools reported by the MC firmware are checked.
+ * The live objects flagged in destroy, if any, are destroyed first and
+ * their resources are counted as free.
+ */
+static int check_dpl_resources(const struct dpl_layout *layout,
+			       const struct topology *live,
+			       const bool *destroy,
+			       uint16_t dprc_handle, const char *dprc_name)
+{
+	char res_type[RES_TYPE_MAX_LENGTH + 1];
+	int pool_count;
+	int res_count;
+	int needed;
+	int error;
+	int ret_error = 0;
+
+	error = dprc_get_pool_count(&restool.mc_io, 0, dprc_handle,
+				    &pool_count);
+	if (error < 0) {
+		mc_status = flib_error_to_mc_status(error);
+		ERROR_PRINTF("MC error: %s (status %#x)\n",
+			     mc_status_to_string(mc_status), mc_status);
+		return error;
+	}
+
+	for (int i = 0; i < pool_count; i++) {
+		memset(res_type, 0, sizeof(res_type));
+		error = dprc_get_pool(&restool.mc_io, 0, dprc_handle, i,
+				      res_type);
+		if (error < 0) {
+			mc_status = flib_error_to_mc_status(error);
+			ERROR_PRINTF("MC error: %s (status %#x)\n",
+				     mc_status_to_string(mc_status), mc_status);
+			return error;
+		}
+
+		needed = 0;
+		for (int j = 0; j < layout->num_objs; j++) {
+			if (!layout->objs[j].existing)
+				needed += count_res_needs(layout->objs[j].type,
+							  res_type);
+		}
+
+		for (int j = 0; j < layout->num_containers; j++) {
+			if (!layout->containers[j].existing)
+				needed += count_res_needs("dprc", res_type);
+		}
+
+		for (int j = 0; destroy != NULL && j < live->num_objs; j++) {
+			if (destroy[j])
+				needed -= count_res_needs(
+						live->objs[j].desc.type,
+						res_type);
+		}
+
+		if (needed <= 0)
+			continue;
+
+		error = get_free_resources(dprc_handle, res_type, &res_count);
+		if (error < 0)
+			return error;
+
+		if (res_count < needed) {
+			ERROR_PRINTF("Not enough %s resources in %s: %d needed, %d free\n",
+				     res_type, dprc_name, needed, res_count);
+			ret_error = -ENOSPC;
+		}
+	}
+
+	return ret_error;
+}
+
+/**
+ * Checks the layout against the live system before anything is created:
+ * live parents and live objects must exist, and the pools of the target
+ * container must hold enough resources, counting those of the live
+ * objects flagged in destroy.
+ */
+static int check_dpl_layout(const struct dpl_layout *layout,
+			    const struct topology *live, const bool *destroy,
+			    uint32_t dprc_id, uint16_t dprc_handle)
+{
+	struct topology topology = { 0 };
+	const struct dpl_container *cont;
+	const struct dpl_obj *obj;
+	char dprc_name[32];
+	int error;
+
+	error = get_topology(restool.root_dprc_id, restool.root_dprc_handle,
+			     1, &topology);
+	if (error < 0)
+		goto out;
+
+	for (int i = 0; i < layout->num_containers; i++) {
+		cont = &layout->containers[i];
+		if (cont->existing || cont->parent >= 0)
+			continue;
+
+		if (cont->parent_id != restool.root_dprc_id &&
+		    topology_find(&topology, "dprc", cont->parent_id) == NULL) {
+			ERROR_PRINTF("%s: parent dprc.%u does not exist\n",
+				     cont->node->name, cont->parent_id);
+			error = -ENOENT;
+		}
+	}
+
+	for (int i = 0; i < layout->num_objs; i++) {
+		obj = &layout->objs[i];
+		if (!obj->existing)
+			continue;
+
+		if (topology_find(&topology, obj->type, obj->dpl_id) == NULL) {
+			ERROR_PRINTF("%s.%u does not exist and cannot be created\n",
+				     obj->type, obj->dpl_id);
+			error = -ENOENT;
+		}
+	}
+
+	if (error < 0)
+		goto out;
+
+	sprintf(dprc_name, "dprc.%u", dprc_id);
+	error = check_dpl_resources(layout, live, destroy, dprc_handle,
+				    dprc_name);
+out:
+	free_topology(&topology);
+	return error;
+}
+
+static void close_dpl_containers(struct dpl_layout *layout,
+				 uint16_t dprc_handle)
+{
+	struct dpl_container *cont;
+	int error;
+
+	for (int i = 0; i < layout->num_containers; i++) {
+		cont = &layout->containers[i];
+		if (!cont->opened || cont->handle == dprc_handle)
+			continue;
+
+		error = dprc_close(&restool.mc_io, 0, cont->handle);
+		if (error < 0) {
+			mc_status = flib_error_to_mc_status(error);
+			ERROR_PRINTF("MC error: %s (status %#x)\n",
+				     mc_status_to_string(mc_status), mc_status);
+		}
+		cont->opened = false;
+	}
+}
+
+/**
+ * Containers whose parent is "none" stand for the target container
+ */
+static void set_target_container(struct dpl_layout *layout, uint32_t dprc_id,
+				 uint16_t dprc_handle)
+{
+	struct dpl_container *cont;
+
+	for (int i = 0; i < layout->num_containers; i++) {
+		cont = &layout->containers[i];
+		if (strcmp(cont->parent_name, "none") != 0)
+			continue;
+
+		cont->id = dprc_id;
+		cont->handle = dprc_handle;
+		cont->opened = true;
+	}
+}
+
+static int create_dpl_container(struct dpl_container *cont,
+				const struct dpl_layout *layout)
+{
+	uint64_t mc_portal_offset;
+	uint16_t parent_handle;
+	uint32_t parent_id;
+	char parent_name[32];
+	int child_id;
+	int error, error2;
+
+	if (cont->parent >= 0) {
+		parent_handle = layout->containers[cont->parent].handle;
+		parent_id = layout->containers[cont->parent].id;
+	} else if (cont->parent_id == restool.root_dprc_id) {
+		parent_handle = restool.root_dprc_handle;
+		parent_id = restool.root_dprc_id;
+	} else {
+		parent_id = cont->parent_id;
+		error = open_dprc(parent_id, &parent_handle);
+		if (error < 0)
+			return error;
+	}
+
+	error = dprc_create_container(&restool.mc_io, 0, parent_handle,
+				      &cont->cfg.dprc, &child_id,
+				      &mc_portal_offset);
+	if (error < 0) {
+		mc_status = flib_error_to_mc_status(error);
+		ERROR_PRINTF("%s: MC error: %s (status %#x)\n",
+			     cont->node->name,
+			     mc_status_to_string(mc_status), mc_status);
+	} else {
+		cont->id = child_id;
+		sprintf(parent_name, "dprc.%u", parent_id);
+		print_new_obj("dprc", child_id, parent_name);
+		error = open_dprc(cont->id, &cont->handle);
+		cont->opened = error == 0;
+	}
+
+	if (cont->parent < 0 && parent_id != restool.root_dprc_id) {
+		error2 = dprc_close(&restool.mc_io, 0, parent_handle);
+		if (error2 < 0 && error == 0)
+			error = error2;
+	}
+
+	return error;
+}
+
+static int plug_dpl_obj(const struct dpl_container *cont,
+			const struct dpl_obj *obj)
+{
+	struct dprc_res_req res_req;
+
+	memset(&res_req, 0, sizeof(res_req));
+	strcpy(res_req.type, obj->type);
+	res_req.num = 1;
+	res_req.options = DPRC_RES_REQ_OPT_EXPLICIT | DPRC_RES_REQ_OPT_PLUGGED;
+	res_req.id_base_align = obj->id;
+
+	return dprc_assign(&restool.mc_io, 0, cont->handle, cont->id,
+			   &res_req);
+}
+
+/**
+ * Creates the containers, then the objects in place with their labels,
+ * plugging those the DPL does not leave unplugged, then the links, all
+ * over the already open container handles. Existing containers must
+ * already have their id and handle set.
+ */
+static int apply_dpl_layout(struct dpl_layout *layout, const int *order,
+			    uint16_t dprc_handle)
+{
+	struct dprc_connection_cfg connection_cfg = { 0 };
+	struct dprc_endpoint endpoint1;
+	struct dprc_endpoint endpoint2;
+	struct dpl_container *cont;
+	struct dpl_obj *obj;
+	char parent_name[32];
+	int error = 0;
+
+	for (int i = 0; i < layout->num_containers; i++) {
+		cont = &layout->containers[order[i]];
+		if (cont->existing)
+			continue;
+
+		error = create_dpl_container(cont, layout);
+		if (error < 0)
+			goto out;
+	}
+
+	for (int i = 0; i < layout->num_objs; i++) {
+		obj = &layout->objs[i];
+		if (obj->existing)
+			continue;
+
+		cont = &layout->containers[obj->container];
+		error = create_obj_v10(cont->handle, obj->type, &obj->cfg,
+				       &obj->id);
+		if (error < 0) {
+			mc_status = flib_error_to_mc_status(error);
+			ERROR_PRINTF("%s@%u: MC error: %s (status %#x)\n",
+				     obj->type, obj->dpl_id,
+				     mc_status_to_string(mc_status), mc_status);
+			goto out;
+		}
+
+		sprintf(parent_name, "dprc.%u", cont->id);
+		print_new_obj(obj->type, obj->id, parent_name);
+
+		if (obj->label[0] != '\0') {
+			error = dprc_set_obj_label(&restool.mc_io, 0,
+						   cont->handle, obj->type,
+						   obj->id, obj->label);
+			if (error < 0)
+				goto mc_error;
+		}
+
+		if (obj->plugged) {
+			error = plug_dpl_obj(cont, obj);
+			if (error < 0)
+				goto mc_error;
+		}
+	}
+
+	for (int i = 0; i < layout->num_links; i++) {
+		if (layout->links[i].connected)
+			continue;
+
+		memset(&endpoint1, 0, sizeof(endpoint1));
+		memset(&endpoint2, 0, sizeof(endpoint2));
+		obj = &layout->objs[layout->links[i].obj1];
+		strcpy(endpoint1.type, obj->type);
+		endpoint1.id = obj->id;
+		endpoint1.if_id = layout->links[i].if_id1;
+		obj = &layout->objs[layout->links[i].obj2];
+		strcpy(endpoint2.type, obj->type);
+		endpoint2.id = obj->id;
+		endpoint2.if_id = layout->links[i].if_id2;
+
+		error = dprc_connect(&restool.mc_io, 0,
+				     restool.root_dprc_handle,
+				     &endpoint1, &endpoint2, &connection_cfg);
+		if (error < 0) {
+			obj = &layout->objs[layout->links[i].obj1];
+			goto mc_error;
+		}
+	}
+
+	goto out;
+
+mc_error:
+	mc_status = flib_error_to_mc_status(error);
+	ERROR_PRINTF("%s.%u: MC error: %s (status %#x)\n",
+		     obj->type, obj->id,
+		     mc_status_to_string(mc_status), mc_status);
+out:
+	if (error < 0)
+		ERROR_PRINTF("The layout was partially applied, the objects created are listed above\n");
+	close_dpl_containers(layout, dprc_handle);
+	return error;
+}
+
+/**
+ * Parses the DPL file into the layout model and orders its containers
+ */
+static int load_dpl_layout(const char *dpl_file, struct dts_node **root,
+			   struct dpl_layout *layout, int **order)
+{
+	int error;
+
+	error = read_dpl_file(dpl_file, root);
+	if (error < 0)
+		return error;
+
+	error = read_containers(layout, *root);
+	if (error == 0)
+		error = read_connections(layout, *root);
+	if (error < 0)
+		return error;
+
+	*order = malloc((layout->num_containers + 1) * sizeof(**order));
+	if (*order == NULL) {
+		ERROR_PRINTF("Could not alloc memory!\n");
+		return -ENOMEM;
+	}
+
+	return sort_containers(layout, *order);
+}
+
+int dpl_apply(const char *dpl_file, uint32_t dprc_id, bool dry_run)
+{
+	struct dpl_layout layout = { 0 };
+	struct dts_node *root = NULL;
+	int *order = NULL;
+	uint16_t dprc_handle;
+	int num_new = 0;
+	int error, error2;
+
+	if (restool.mc_fw_version.major == MC_FW_VERSION_9) {
+		ERROR_PRINTF("dprc apply-dpl requires MC firmware v10\n");
+		return -ENOTSUP;
+	}
+
+	error = load_dpl_layout(dpl_file, &root, &layout, &order);
+	if (error < 0)
+		goto out;
+
+	if (dprc_id == restool.root_dprc_id) {
+		dprc_handle = restool.root_dprc_handle;
+	} else {
+		error = open_dprc(dprc_id, &dprc_handle);
+		if (error < 0)
+			goto out;
+	}
+
+	error = check_dpl_layout(&layout, NULL, NULL, dprc_id, dprc_handle);
+	if (error == 0 && dry_run) {
+		for (int i = 0; i < layout.num_containers; i++)
+			num_new += !layout.containers[i].existing;
+		for (int i = 0; i < layout.num_objs; i++)
+			num_new += !layout.objs[i].existing;
+		printf("%s: %d objects and %d links to create, resources available\n",
+		       dpl_file, num_new, layout.num_links);
+	} else if (error == 0) {
+		set_target_container(&layout, dprc_id, dprc_handle);
+		error = apply_dpl_layout(&layout, order, dprc_handle);
+	}
+
+	if (dprc_id != restool.root_dprc_id) {
+		error2 = dprc_close(&restool.mc_io, 0, dprc_handle);
+		if (error2 < 0 && error == 0)
+			error = error2;
+	}
+out:
+	free(order);
+	free_dpl_layout(&layout);
+	if (root != NULL)
+		dts_free(root);
+	return error;
+}
+
+/**
+ * Creation parameters the MC firmware does not report back, and that
+ * cannot be compared against the live objects
+ */
+static const struct {
+	const char *obj_type;
+	const char *name;
+} dpl_unreported_props[] = {
+	{ "dpci", "options" },
+	{ "dpdcei", "priority" },
+	{ "dpdmux", "max_dmat_entries" },
+	{ "dpdmux", "max_mc_groups" },
+	{ "dpdmux", "max_vlan_ids" },
+};
+
+/**
+ * Link of the live system, seen from an object of the reconciled
+ * containers
+ */
+struct dpl_live_link {
+	struct dprc_endpoint endpoint1;
+	struct dprc_endpoint endpoint2;
+	bool keep;
+};
+
+/**
+ * Live state of the reconciled containers and the changes that bring it
+ * to the layout. The per object arrays are indexed as topology.objs.
+ */
+struct dpl_diff {
+	struct topology topology;
+	bool *in_scope;
+	bool *matched;
+	bool *destroy;
+	int *num_ifs;
+	struct dpl_live_link *links;
+	int num_links;
+	int max_links;
+	int num_changes;
+};
+
+static bool is_prop_reported(const struct dpl_prop_desc *desc)
+{
+	for (unsigned int i = 0; i < ARRAY_SIZE(dpl_unreported_props); i++) {
+		if (strcmp(dpl_unreported_props[i].obj_type,
+			   desc->obj_type) == 0 &&
+		    strcmp(dpl_unreported_props[i].name, desc->name) == 0)
+			return false;
+	}
+
+	return desc->kind != DPL_PROP_IGNORED;
+}
+
+static int count_list_entries(const struct dpl_prop_desc *desc,
+			      const union obj_create_cfg *cfg)
+{
+	const uint8_t *field = (const uint8_t *)cfg + desc->offset;
+	int count = 0;
+
+	while ((size_t)count < desc->size && field[count] != 0)
+		count++;
+
+	return count;
+}
+
+/**
+ * Returns the first property of the layout object whose value differs
+ * from the live object, or NULL. A numeric property left to 0 in the DPL
+ * takes the firmware default and matches any live value. Only the number
+ * of DPDMAI priorities is reported back.
+ */
+static const struct dpl_prop_desc *
+find_cfg_diff(const char *obj_type, const union obj_create_cfg *dpl_cfg,
+	      const union obj_create_cfg *live_cfg)
+{
+	const struct dpl_prop_desc *desc;
+	const uint8_t *dpl_field;
+	const uint8_t *live_field;
+	bool is_zero;
+
+	for (unsigned int i = 0; i < ARRAY_SIZE(dpl_props); i++) {
+		desc = &dpl_props[i];
+		if (strcmp(desc->obj_type, obj_type) != 0 ||
+		    !is_prop_reported(desc))
+			continue;
+
+		if (strcmp(obj_type, "dpdmai") == 0 &&
+		    desc->kind == DPL_PROP_LIST) {
+			if (count_list_entries(desc, dpl_cfg) !=
+			    count_list_entries(desc, live_cfg))
+				return desc;
+			continue;
+		}
+
+		dpl_field = (const uint8_t *)dpl_cfg + desc->offset;
+		live_field = (const uint8_t *)live_cfg + desc->offset;
+		is_zero = true;
+		for (size_t j = 0; j < desc->size; j++)
+			is_zero = is_zero && dpl_field[j] == 0;
+		if (desc->kind == DPL_PROP_NUM && is_zero)
+			continue;
+
+		if (memcmp(dpl_field, live_field, desc->size) != 0)
+			return desc;
+	}
+
+	return NULL;
+}
+
+static void free_dpl_diff(struct dpl_diff *diff)
+{
+	free_topology(&diff->topology);
+	free(diff->in_scope);
+	free(diff->matched);
+	free(diff->destroy);
+	free(diff->num_ifs);
+	free(diff->links);
+}
+
+static int find_live_obj(const struct dpl_diff *diff, const char *type,
+			 uint32_t id, uint32_t parent_id)
+{
+	const struct topology_obj *obj;
+
+	for (int i = 0; i < diff->topology.num_objs; i++) {
+		obj = &diff->topology.objs[i];
+		if (obj->desc.id == (int)id && obj->parent_dprc_id == parent_id &&
+		    strcmp(obj->desc.type, type) == 0)
+			return i;
+	}
+
+	return -1;
+}
+
+/**
+ * Returns the open handle of a container of the layout that stands for
+ * the live container dprc_id, or -ENOENT
+ */
+static int get_dpl_container_handle(const struct dpl_layout *layout,
+				    uint32_t dprc_id, uint16_t *handle)
+{
+	const struct dpl_container *cont;
+
+	if (dprc_id == restool.root_dprc_id) {
+		*handle = restool.root_dprc_handle;
+		return 0;
+	}
+
+	for (int i = 0; i < layout->num_containers; i++) {
+		cont = &layout->containers[i];
+		if (cont->existing && cont->opened && cont->id == dprc_id) {
+			*handle = cont->handle;
+			return 0;
+		}
+	}
+
+	return -ENOENT;
+}
+
+/**
+ * Matches the containers of the layout with the live containers of the
+ * same id under the same parent. Matched containers are opened and are
+ * not created again; their options cannot change without losing what
+ * they hold and are only reported.
+ */
+static int match_dpl_containers(struct dpl_layout *layout, const int *order,
+				struct dpl_diff *diff)
+{
+	struct dprc_attributes dprc_attr;
+	struct dpl_container *cont;
+	struct topology_obj *live;
+	uint32_t parent_id;
+	int index;
+	int error;
+
+	for (int i = 0; i < layout->num_containers; i++) {
+		cont = &layout->containers[order[i]];
+		if (cont->existing)
+			continue;
+
+		if (cont->parent >= 0) {
+			if (!layout->containers[cont->parent].existing)
+				continue;
+			parent_id = layout->containers[cont->parent].id;
+		} else {
+			parent_id = cont->parent_id;
+		}
+
+		index = find_live_obj(diff, "dprc", cont->dpl_id, parent_id);
+		if (index < 0)
+			continue;
+
+		live = &diff->topology.objs[index];
+		error = open_dprc(cont->dpl_id, &cont->handle);
+		if (error < 0)
+			return error;
+
+		diff->matched[index] = true;
+		cont->existing = true;
+		cont->opened = true;
+		cont->id = cont->dpl_id;
+
+		memset(&dprc_attr, 0, sizeof(dprc_attr));
+		error = dprc_get_attributes(&restool.mc_io, 0, cont->handle,
+					    &dprc_attr);
+		if (error < 0) {
+			mc_status = flib_error_to_mc_status(error);
+			ERROR_PRINTF("MC error: %s (status %#x)\n",
+				     mc_status_to_string(mc_status), mc_status);
+			return error;
+		}
+
+		if (dprc_attr.options != cont->cfg.dprc.options)
+			printf("warning: options of dprc.%u differ from the DPL, destroy it to re-create it\n",
+			       cont->id);
+
+		if (strcmp(live->desc.label, cont->cfg.dprc.label) != 0) {
+			cont->relabel = true;
+			diff->num_changes++;
+		}
+	}
+
+	return 0;
+}
+
+/**
+ * Matches the objects of the layout with the live objects of the same id
+ * in the matched containers. A live object whose creation parameters
+ * differ is destroyed and created again; live objects that are not in
+ * the layout are destroyed.
+ */
+static int match_dpl_objs(struct dpl_layout *layout, struct dpl_diff *diff,
+			  bool dry_run)
+{
+	const struct dpl_prop_desc *desc;
+	const struct dpl_container *cont;
+	const struct topology_obj *live;
+	union obj_create_cfg live_cfg;
+	struct dpl_obj *obj;
+	uint16_t num_ifs;
+	int index;
+	int error;
+
+	for (int i = 0; i < diff->topology.num_objs; i++) {
+		live = &diff->topology.objs[i];
+		for (int j = 0; j < layout->num_containers; j++) {
+			cont = &layout->containers[j];
+			if (cont->existing && cont->id == live->parent_dprc_id)
+				diff->in_scope[i] = true;
+		}
+	}
+
+	for (int i = 0; i < layout->num_objs; i++) {
+		obj = &layout->objs[i];
+		if (obj->container < 0) {
+			/* live object at the other end of a connection */
+			for (int j = 0; j < diff->topology.num_objs; j++) {
+				live = &diff->topology.objs[j];
+				if (live->desc.id == (int)obj->dpl_id &&
+				    strcmp(live->desc.type, obj->type) == 0)
+					diff->matched[j] = true;
+			}
+			continue;
+		}
+
+		cont = &layout->containers[obj->container];
+		if (!cont->existing)
+			continue;
+
+		index = find_live_obj(diff, obj->type, obj->dpl_id, cont->id);
+		if (index < 0)
+			continue;
+
+		live = &diff->topology.objs[index];
+		diff->matched[index] = true;
+		if (obj->existing)
+			goto check_label;
+
+		error = read_obj_create_cfg_v10(obj->type, obj->dpl_id,
+						&live_cfg, &num_ifs);
+		if (error < 0)
+			return error;
+
+		diff->num_ifs[index] = num_ifs;
+		desc = find_cfg_diff(obj->type, &obj->cfg, &live_cfg);
+		if (desc != NULL) {
+			if (dry_run)
+				printf("re-create %s.%u: %s differs\n",
+				       obj->type, obj->dpl_id, desc->name);
+			diff->destroy[index] = true;
+			diff->num_changes++;
+			continue;
+		}
+
+		obj->existing = true;
+check_label:
+		if (strcmp(live->desc.label, obj->label) != 0) {
+			obj->relabel = true;
+			diff->num_changes++;
+		}
+	}
+
+	for (int i = 0; i < diff->topology.num_objs; i++) {
+		live = &diff->topology.objs[i];
+		if (!diff->in_scope[i] || diff->matched[i])
+			continue;
+
+		if (strcmp(live->desc.type, "dprc") == 0) {
+			printf("warning: dprc.%d is not in the DPL and is left in place\n",
+			       live->desc.id);
+		} else if (can_create_obj_v10(live->desc.type)) {
+			if (dry_run)
+				printf("destroy %s.%d\n",
+				       live->desc.type, live->desc.id);
+			diff->destroy[i] = true;
+			diff->num_changes++;
+		}
+	}
+
+	return 0;
+}
+
+static bool same_endpoint(const struct dprc_endpoint *endpoint,
+			  const struct dpl_obj *obj, uint16_t if_id)
+{
+	return obj->existing && endpoint->id == (int)obj->id &&
+	       endpoint->if_id == if_id &&
+	       strcmp(endpoint->type, obj->type) == 0;
+}
+
+static int add_live_link(struct dpl_diff *diff,
+			 const struct dprc_endpoint *endpoint1,
+			 const struct dprc_endpoint *endpoint2)
+{
+	const struct dpl_live_link *link;
+	struct dpl_live_link *links;
+
+	/* a link between two reconciled objects is seen from both ends */
+	for (int i = 0; i < diff->num_links; i++) {
+		link = &diff->links[i];
+		if (link->endpoint1.id == endpoint2->id &&
+		    link->endpoint1.if_id == endpoint2->if_id &&
+		    strcmp(link->endpoint1.type, endpoint2->type) == 0)
+			return 0;
+	}
+
+	links = grow_array(diff->links, diff->num_links, &diff->max_links,
+			   sizeof(*diff->links));
+	if (links == NULL)
+		return -ENOMEM;
+	diff->links = links;
+
+	diff->links[diff->num_links].endpoint1 = *endpoint1;
+	diff->links[diff->num_links].endpoint2 = *endpoint2;
+	diff->links[diff->num_links].keep = false;
+	diff->num_links++;
+	return 0;
+}
+
+/**
+ * Reads the live links of the objects of the matched containers. The
+ * layout describes all links of these objects: the ones it lists are
+ * kept, the other ones are removed.
+ */
+static int read_live_links(struct dpl_layout *layout, struct dpl_diff *diff)
+{
+	struct dprc_endpoint endpoint1;
+	struct dprc_endpoint endpoint2;
+	const struct topology_obj *live;
+	union obj_create_cfg live_cfg;
+	struct dpl_link *link;
+	uint16_t num_ifs;
+	int state;
+	int error;
+
+	for (int i = 0; i < diff->topology.num_objs; i++) {
+		live = &diff->topology.objs[i];
+		if (!diff->in_scope[i])
+			continue;
+
+		if (strcmp(live->desc.type, "dpmac") == 0) {
+			diff->num_ifs[i] = 1;
+		} else if (diff->num_ifs[i] < 0 &&
+			   can_create_obj_v10(live->desc.type)) {
+			error = read_obj_create_cfg_v10(live->desc.type,
+							live->desc.id,
+							&live_cfg, &num_ifs);
+			if (error < 0)
+				return error;
+			diff->num_ifs[i] = num_ifs;
+		}
+
+		for (int if_id = 0; if_id < diff->num_ifs[i]; if_id++) {
+			memset(&endpoint1, 0, sizeof(endpoint1));
+			memset(&endpoint2, 0, sizeof(endpoint2));
+			strcpy(endpoint1.type, live->desc.type);
+			endpoint1.id = live->desc.id;
+			endpoint1.if_id = if_id;
+
+			error = dprc_get_connection(&restool.mc_io, 0,
+						    restool.root_dprc_handle,
+						    &endpoint1, &endpoint2,
+						    &state);
+			if (error < 0 || state == -1)
+				continue;
+
+			error = add_live_link(diff, &endpoint1, &endpoint2);
+			if (error < 0)
+				return error;
+		}
+	}
+
+	for (int i = 0; i < layout->num_links; i++) {
+		link = &layout->links[i];
+		link->connected = false;
+		for (int j = 0; j < diff->num_links; j++) {
+			struct dpl_live_link *live_link = &diff->links[j];
+			const struct dpl_obj *obj1 = &layout->objs[link->obj1];
+			const struct dpl_obj *obj2 = &layout->objs[link->obj2];
+
+			if ((same_endpoint(&live_link->endpoint1, obj1,
+					   link->if_id1) &&
+			     same_endpoint(&live_link->endpoint2, obj2,
+					   link->if_id2)) ||
+			    (same_endpoint(&live_link->endpoint1, obj2,
+					   link->if_id2) &&
+			     same_endpoint(&live_link->endpoint2, obj1,
+					   link->if_id1))) {
+				live_link->keep = true;
+				link->connected = true;
+			}
+		}
+	}
+
+	/* links between two objects outside of the matched containers */
+	for (int i = 0; i < layout->num_links; i++) {
+		link = &layout->links[i];
+		if (link->connected || !layout->objs[link->obj1].existing ||
+		    !layout->objs[link->obj2].existing)
+			continue;
+
+		memset(&endpoint1, 0, sizeof(endpoint1));
+		memset(&endpoint2, 0, sizeof(endpoint2));
+		strcpy(endpoint1.type, layout->objs[link->obj1].type);
+		endpoint1.id = layout->objs[link->obj1].id;
+		endpoint1.if_id = link->if_id1;
+		error = dprc_get_connection(&restool.mc_io, 0,
+					    restool.root_dprc_handle,
+					    &endpoint1, &endpoint2, &state);
+		if (error == 0 && state != -1 &&
+		    same_endpoint(&endpoint2, &layout->objs[link->obj2],
+				  link->if_id2))
+			link->connected = true;
+	}
+
+	for (int i = 0; i < diff->num_links; i++)
+		diff->num_changes += !diff->links[i].keep;
+	for (int i = 0; i < layout->num_links; i++)
+		diff->num_changes += !layout->links[i].connected;
+
+	return 0;
+}
+
+static void print_dpl_obj_name(const struct dpl_obj *obj, char *name,
+			       size_t size)
+{
+	snprintf(name, size, "%s%s%u", obj->type, obj->existing ? "." : "@",
+		 obj->existing ? obj->id : obj->dpl_id);
+}
+
+/**
+ * Prints what --dry-run would change, other than the objects destroyed
+ * or re-created already listed by match_dpl_objs()
+ */
+static void print_dpl_diff(const struct dpl_layout *layout,
+			   const struct dpl_diff *diff)
+{
+	const struct dpl_container *cont;
+	const struct dpl_live_link *live_link;
+	const struct dpl_obj *obj;
+	const struct dpl_link *link;
+	char name1[32];
+	char name2[32];
+
+	for (int i = 0; i < diff->num_links; i++) {
+		live_link = &diff->links[i];
+		if (!live_link->keep)
+			printf("disconnect %s.%d.%u from %s.%d.%u\n",
+			       live_link->endpoint1.type,
+			       live_link->endpoint1.id,
+			       live_link->endpoint1.if_id,
+			       live_link->endpoint2.type,
+			       live_link->endpoint2.id,
+			       live_link->endpoint2.if_id);
+	}
+
+	for (int i = 0; i < layout->num_containers; i++) {
+		cont = &layout->containers[i];
+		if (!cont->existing)
+			printf("create %s\n", cont->node->name);
+		else if (cont->relabel)
+			printf("label dprc.%u \"%s\"\n", cont->id,
+			       cont->cfg.dprc.label);
+	}
+
+	for (int i = 0; i < layout->num_objs; i++) {
+		obj = &layout->objs[i];
+		if (!obj->existing)
+			printf("create %s@%u in %s\n", obj->type, obj->dpl_id,
+			       layout->containers[obj->container].node->name);
+		else if (obj->relabel)
+			printf("label %s.%u \"%s\"\n", obj->type, obj->id,
+			       obj->label);
+	}
+
+	for (int i = 0; i < layout->num_links; i++) {
+		link = &layout->links[i];
+		if (link->connected)
+			continue;
+
+		print_dpl_obj_name(&layout->objs[link->obj1], name1,
+				   sizeof(name1));
+		print_dpl_obj_name(&layout->objs[link->obj2], name2,
+				   sizeof(name2));
+		printf("connect %s.%u to %s.%u\n",
+		       name1, link->if_id1, name2, link->if_id2);
+	}
+}
+
+/**
+ * Refuses to destroy objects bound to a driver, before anything changes
+ */
+static int check_dpl_diff_in_use(const struct dpl_diff *diff)
+{
+	const struct topology_obj *live;
+	char obj_name[32];
+	int num_in_use = 0;
+
+	for (int i = 0; i < diff->topology.num_objs; i++) {
+		live = &diff->topology.objs[i];
+		if (!diff->destroy[i])
+			continue;
+
+		sprintf(obj_name, "%.15s.%d", live->desc.type, live->desc.id);
+		if (in_use(obj_name, "destroyed"))
+			num_in_use++;
+	}
+
+	return num_in_use == 0 ? 0 : -EBUSY;
+}
+
+static int set_dpl_label(uint16_t dprc_handle, const char *obj_type,
+			 uint32_t obj_id, const char *label)
+{
+	char label_buf[MC_OBJ_LABEL_MAX_LENGTH + 1];
+	char type_buf[OBJ_TYPE_MAX_LENGTH + 1];
+	int error;
+
+	strcpy(type_buf, obj_type);
+	strcpy(label_buf, label);
+	error = dprc_set_obj_label(&restool.mc_io, 0, dprc_handle,
+				   type_buf, obj_id, label_buf);
+	if (error < 0) {
+		mc_status = flib_error_to_mc_status(error);
+		ERROR_PRINTF("%s.%u: MC error: %s (status %#x)\n",
+			     obj_type, obj_id,
+			     mc_status_to_string(mc_status), mc_status);
+	}
+
+	return error;
+}
+
+/**
+ * Removes the links, then the objects that are not in the layout, and
+ * relabels the objects that are kept. What is left to create is then
+ * done by apply_dpl_layout().
+ */
+static int remove_dpl_diff(struct dpl_layout *layout, struct dpl_diff *diff)
+{
+	const struct dpl_container *cont;
+	const struct topology_obj *live;
+	const struct dpl_obj *obj;
+	uint16_t dprc_handle;
+	int error;
+
+	for (int i = 0; i < diff->num_links; i++) {
+		if (diff->links[i].keep)
+			continue;
+
+		error = dprc_disconnect(&restool.mc_io, 0,
+					restool.root_dprc_handle,
+					&diff->links[i].endpoint1);
+		if (error < 0) {
+			mc_status = flib_error_to_mc_status(error);
+			ERROR_PRINTF("%s.%d.%u: MC error: %s (status %#x)\n",
+				     diff->links[i].endpoint1.type,
+				     diff->links[i].endpoint1.id,
+				     diff->links[i].endpoint1.if_id,
+				     mc_status_to_string(mc_status), mc_status);
+			return error;
+		}
+	}
+
+	for (int i = 0; i < diff->topology.num_objs; i++) {
+		live = &diff->topology.objs[i];
+		if (!diff->destroy[i])
+			continue;
+
+		error = get_dpl_container_handle(layout, live->parent_dprc_id,
+						 &dprc_handle);
+		if (error < 0) {
+			ERROR_PRINTF("%s.%d: dprc.%u is not open\n",
+				     live->desc.type, live->desc.id,
+				     live->parent_dprc_id);
+			return error;
+		}
+
+		error = destroy_obj_v10(dprc_handle, live->desc.type,
+					live->desc.id);
+		if (error < 0) {
+			mc_status = flib_error_to_mc_status(error);
+			ERROR_PRINTF("%s.%d: MC error: %s (status %#x)\n",
+				     live->desc.type, live->desc.id,
+				     mc_status_to_string(mc_status), mc_status);
+			return error;
+		}
+
+		printf("%s.%d is destroyed\n", live->desc.type, live->desc.id);
+	}
+
+	for (int i = 0; i < layout->num_containers; i++) {
+		cont = &layout->containers[i];
+		if (!cont->relabel)
+			continue;
+
+		if (cont->parent >= 0)
+			dprc_handle = layout->containers[cont->parent].handle;
+		else if (get_dpl_container_handle(layout, cont->parent_id,
+						  &dprc_handle) < 0) {
+			printf("warning: the label of dprc.%u is set from its parent dprc.%u, left unchanged\n",
+			       cont->id, cont->parent_id);
+			continue;
+		}
+
+		error = set_dpl_label(dprc_handle, "dprc", cont->id,
+				      cont->cfg.dprc.label);
+		if (error < 0)
+			return error;
+	}
+
+	for (int i = 0; i < layout->num_objs; i++) {
+		obj = &layout->objs[i];
+		if (!obj->relabel)
+			continue;
+
+		cont = &layout->containers[obj->container];
+		error = set_dpl_label(cont->handle, obj->type, obj->id,
+				      obj->label);
+		if (error < 0)
+			return error;
+	}
+
+	return 0;
+}
+
+/**
+ * Reads the live state of the containers of the layout and computes the
+ * changes that bring it to the layout
+ */
+static int diff_dpl_layout(struct dpl_layout *layout, const int *order,
+			   struct dpl_diff *diff, bool dry_run)
+{
+	int num_objs;
+	int error;
+
+	error = get_topology(restool.root_dprc_id, restool.root_dprc_handle,
+			     1, &diff->topology);
+	if (error < 0)
+		return error;
+
+	num_objs = diff->topology.num_objs + 1;
+	diff->in_scope = calloc(num_objs, sizeof(*diff->in_scope));
+	diff->matched = calloc(num_objs, sizeof(*diff->matched));
+	diff->destroy = calloc(num_objs, sizeof(*diff->destroy));
+	diff->num_ifs = malloc(num_objs * sizeof(*diff->num_ifs));
+	if (diff->in_scope == NULL || diff->matched == NULL ||
+	    diff->destroy == NULL || diff->num_ifs == NULL) {
+		ERROR_PRINTF("Could not alloc memory!\n");
+		return -ENOMEM;
+	}
+
+	for (int i = 0; i < num_objs; i++)
+		diff->num_ifs[i] = -1;
+
+	error = match_dpl_containers(layout, order, diff);
+	if (error == 0)
+		error = match_dpl_objs(layout, diff, dry_run);
+	if (error == 0)
+		error = read_live_links(layout, diff);
+	if (error < 0)
+		return error;
+
+	for (int i = 0; i < layout->num_containers; i++)
+		diff->num_changes += !layout->containers[i].existing;
+	for (int i = 0; i < layout->num_objs; i++)
+		diff->num_changes += !layout->objs[i].existing;
+
+	return 0;
+}
+
+int dpl_reconcile(const char *dpl_file, uint32_t dprc_id, bool dry_run)
+{
+	struct dpl_layout layout = { 0 };
+	struct dpl_diff diff = { 0 };
+	struct dts_node *root = NULL;
+	int *order = NULL;
+	uint16_t dprc_handle;
+	int error, error2;
+
+	if (restool.mc_fw_version.major == MC_FW_VERSION_9) {
+		ERROR_PRINTF("dprc reconcile requires MC firmware v10\n");
+		return -ENOTSUP;
+	}
+
+	error = load_dpl_layout(dpl_file, &root, &layout, &order);
+	if (error < 0)
+		goto out;
+
+	if (dprc_id == restool.root_dprc_id) {
+		dprc_handle = restool.root_dprc_handle;
+	} else {
+		error = open_dprc(dprc_id, &dprc_handle);
+		if (error < 0)
+			goto out;
+	}
+
+	set_target_container(&layout, dprc_id, dprc_handle);
+	error = diff_dpl_layout(&layout, order, &diff, dry_run);
+	if (error == 0)
+		error = check_dpl_diff_in_use(&diff);
+	if (error == 0)
+		error = check_dpl_layout(&layout, &diff.topology,
+					 diff.destroy, dprc_id, dprc_handle);
+
+	if (error == 0 && diff.num_changes == 0) {
+		printf("dprc.%u already matches %s\n", dprc_id, dpl_file);
+	} else if (error == 0 && dry_run) {
+		print_dpl_diff(&layout, &diff);
+		printf("%s: %d changes\n", dpl_file, diff.num_changes);
+	} else if (error == 0) {
+		error = remove_dpl_diff(&layout, &diff);
+		if (error == 0)
+			error = apply_dpl_layout(&layout, order, dprc_handle);
+		else
+			ERROR_PRINTF("The layout was partially reconciled, the objects destroyed are listed above\n");
+	}
+
+	close_dpl_containers(&layout, dprc_handle);
+	if (dprc_id != restool.root_dprc_id) {
+		error2 = dprc_close(&restool.mc_io, 0, dprc_handle);
+		if (error2 < 0 && error == 0)
+			error = error2;
+	}
+out:
+	free(order);
+	free_dpl_diff(&diff);
+	free_dpl_layout(&layout);
+	if (root != NULL)
+		dts_free(root);
+	return error;
+}
@@ -0,0 +1,787 @@
+/* Copyright 2026 NXP
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * * Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ * * Neither the name of the above-listed copyright holders nor the
+ * names of any contributors may be used to endorse or promote products
+ * derived from this software without specific prior written permission.
+ *
+ *
+ * ALTERNATIVELY, this software may be distributed under the terms of the
+ * GNU General Public License ("GPL") as published by the Free Software
+ * Foundation, either version 2 of that License or (at your option) any
+ * later version.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDERS OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <errno.h>
+#include <assert.h>
+#include "restool.h"
+#include "utils.h"
+#include "dprc_commands_clone.h"
+
+enum mc_cmd_status mc_status;
+
+/**
+ * Creation parameters of one object of the source container, and the id
+ * of its copy in the clone being built
+ */
+struct clone_obj {
+	struct topology_obj *obj;
+	uint16_t num_ifs;
+	union obj_create_cfg cfg;
+	uint32_t new_id;
+	uint16_t new_dprc_handle;
+};
+
+/**
+ * Link between two objects of the source container
+ */
+struct clone_link {
+	struct clone_obj *obj1;
+	struct clone_obj *obj2;
+	uint16_t if_id1;
+	uint16_t if_id2;
+};
+
+typedef int clone_read_cfg_t(uint16_t obj_handle, union obj_create_cfg *cfg,
+			     uint16_t *num_ifs);
+typedef int clone_create_t(uint16_t dprc_handle, union obj_create_cfg *cfg,
+			   uint32_t *obj_id);
+typedef int clone_destroy_t(struct fsl_mc_io *mc_io, uint16_t dprc_token,
+			    uint32_t cmd_flags, uint32_t obj_id);
+
+/**
+ * Per object type operations: read the creation parameters of a source
+ * object, then create a copy of it
+ */
+struct clone_ops {
+	const char *obj_type;
+	flib_obj_open_t *obj_open;
+	flib_obj_close_t *obj_close;
+	clone_read_cfg_t *read_cfg;
+	clone_create_t *create;
+	clone_destroy_t *destroy;
+};
+
+static int read_dpci_cfg(uint16_t obj_handle, union obj_create_cfg *cfg,
+			 uint16_t *num_ifs)
+{
+	struct dpci_attr_v10 attr;
+	int error;
+
+	error = dpci_get_attributes_v10(&restool.mc_io, 0, obj_handle, &attr);
+	cfg->dpci.num_of_priorities = attr.num_of_priorities;
+	*num_ifs = 1;
+	return error;
+}
+
+static int read_dpcon_cfg(uint16_t obj_handle, union obj_create_cfg *cfg,
+			  uint16_t *num_ifs)
+{
+	struct dpcon_attr_v10 attr;
+	int error;
+
+	(void)num_ifs;
+
+	error = dpcon_get_attributes_v10(&restool.mc_io, 0, obj_handle, &attr);
+	cfg->dpcon.num_priorities = attr.num_priorities;
+	return error;
+}
+
+static int read_dpdcei_cfg(uint16_t obj_handle, union obj_create_cfg *cfg,
+			   uint16_t *num_ifs)
+{
+	struct dpdcei_attr_v10 attr;
+	int error;
+
+	(void)num_ifs;
+
+	error = dpdcei_get_attributes_v10(&restool.mc_io, 0, obj_handle,
+					  &attr);
+	cfg->dpdcei.engine = attr.engine;
+	/* the priority is not reported back, use the create default */
+	cfg->dpdcei.priority = 1;
+	return error;
+}
+
+static int read_dpdmai_cfg(uint16_t obj_handle, union obj_create_cfg *cfg,
+			   uint16_t *num_ifs)
+{
+	struct dpdmai_attr_v10 attr;
+	int error;
+
+	(void)num_ifs;
+
+	error = dpdmai_get_attributes_v10(&restool.mc_io, 0, obj_handle,
+					  &attr);
+	/* only the number of priorities is reported back */
+	for (int i = 0; i < attr.num_of_priorities && i < DPDMAI_PRIO_NUM; i++)
+		cfg->dpdmai.priorities[i] = i + 1;
+	return error;
+}
+
+static int read_dpdmux_cfg(uint16_t obj_handle, union obj_create_cfg *cfg,
+			   uint16_t *num_ifs)
+{
+	struct dpdmux_attr_v10 attr;
+	int error;
+
+	error = dpdmux_get_attributes_v10(&restool.mc_io, 0, obj_handle,
+					  &attr);
+	cfg->dpdmux.method = attr.method;
+	cfg->dpdmux.manip = attr.manip;
+	cfg->dpdmux.num_ifs = attr.num_ifs;
+	cfg->dpdmux.adv.options = attr.options;
+	/* the uplink interface 0 is not counted in num_ifs */
+	*num_ifs = attr.num_ifs + 1;
+	return error;
+}
+
+static int read_dpio_cfg(uint16_t obj_handle, union obj_create_cfg *cfg,
+			 uint16_t *num_ifs)
+{
+	struct dpio_attr_v10 attr;
+	int error;
+
+	(void)num_ifs;
+
+	error = dpio_get_attributes_v10(&restool.mc_io, 0, obj_handle, &attr);
+	cfg->dpio.channel_mode = attr.channel_mode;
+	cfg->dpio.num_priorities = attr.num_priorities;
+	return error;
+}
+
+static int read_dpni_cfg(uint16_t obj_handle, union obj_create_cfg *cfg,
+			 uint16_t *num_ifs)
+{
+	struct dpni_attr_v10 attr;
+	int error;
+
+	error = dpni_get_attributes_v10(&restool.mc_io, 0, obj_handle, &attr);
+	cfg->dpni.options = attr.options;
+	cfg->dpni.fs_entries = attr.fs_entries;
+	cfg->dpni.vlan_filter_entries = attr.vlan_filter_entries;
+	cfg->dpni.mac_filter_entries = attr.mac_filter_entries;
+	cfg->dpni.num_queues = attr.num_queues;
+	cfg->dpni.num_tcs = attr.num_rx_tcs;
+	cfg->dpni.qos_entries = attr.qos_entries;
+	*num_ifs = 1;
+	return error;
+}
+
+static int read_dpseci_cfg(uint16_t obj_handle, union obj_create_cfg *cfg,
+			   uint16_t *num_ifs)
+{
+	struct dpseci_tx_queue_attr_v10 tx_attr;
+	struct dpseci_attr_v10 attr;
+	int error;
+
+	(void)num_ifs;
+
+	error = dpseci_get_attributes_v10(&restool.mc_io, 0, obj_handle,
+					  &attr);
+	if (error < 0)
+		return error;
+
+	cfg->dpseci.options = attr.options;
+	cfg->dpseci.num_tx_queues = attr.num_tx_queues;
+	cfg->dpseci.num_rx_queues = attr.num_rx_queues;
+	for (int i = 0; i < attr.num_tx_queues && i < DPSECI_PRIO_NUM; i++) {
+		error = dpseci_get_tx_queue_v10(&restool.mc_io, 0, obj_handle,
+						i, &tx_attr);
+		if (error < 0)
+			return error;
+		cfg->dpseci.priorities[i] = tx_attr.priority;
+	}
+
+	return 0;
+}
+
+static int read_dpsw_cfg(uint16_t obj_handle, union obj_create_cfg *cfg,
+			 uint16_t *num_ifs)
+{
+	struct dpsw_attr_v10 attr;
+	int error;
+
+	error = dpsw_get_attributes_v10(&restool.mc_io, 0, obj_handle, &attr);
+	cfg->dpsw.num_ifs = attr.num_ifs;
+	cfg->dpsw.adv.options = attr.options;
+	cfg->dpsw.adv.max_vlans = attr.max_vlans;
+	cfg->dpsw.adv.max_meters_per_if = attr.max_meters_per_if;
+	cfg->dpsw.adv.max_fdbs = attr.max_fdbs;
+	cfg->dpsw.adv.max_fdb_entries = attr.max_fdb_entries;
+	cfg->dpsw.adv.fdb_aging_time = attr.fdb_aging_time;
+	cfg->dpsw.adv.max_fdb_mc_groups = attr.max_fdb_mc_groups;
+	cfg->dpsw.adv.component_type = attr.component_type;
+	*num_ifs = attr.num_ifs;
+	return error;
+}
+
+static int create_dpbp(uint16_t dprc_handle, union obj_create_cfg *cfg,
+		       uint32_t *obj_id)
+{
+	return dpbp_create_v10(&restool.mc_io, dprc_handle, 0,
+			       &cfg->dpbp, obj_id);
+}
+
+static int create_dpci(uint16_t dprc_handle, union obj_create_cfg *cfg,
+		       uint32_t *obj_id)
+{
+	return dpci_create_v10(&restool.mc_io, dprc_handle, 0,
+			       &cfg->dpci, obj_id);
+}
+
+static int create_dpcon(uint16_t dprc_handle, union obj_create_cfg *cfg,
+			uint32_t *obj_id)
+{
+	return dpcon_create_v10(&restool.mc_io, dprc_handle, 0,
+				&cfg->dpcon, obj_id);
+}
+
+static int create_dpdcei(uint16_t dprc_handle, union obj_create_cfg *cfg,
+			 uint32_t *obj_id)
+{
+	return dpdcei_create_v10(&restool.mc_io, dprc_handle, 0,
+				 &cfg->dpdcei, obj_id);
+}
+
+static int create_dpdmai(uint16_t dprc_handle, union obj_create_cfg *cfg,
+			 uint32_t *obj_id)
+{
+	return dpdmai_create_v10(&restool.mc_io, dprc_handle, 0,
+				 &cfg->dpdmai, obj_id);
+}
+
+static int create_dpdmux(uint16_t dprc_handle, union obj_create_cfg *cfg,
+			 uint32_t *obj_id)
+{
+	return dpdmux_create_v10(&restool.mc_io, dprc_handle, 0,
+				 &cfg->dpdmux, obj_id);
+}
+
+static int create_dpio(uint16_t dprc_handle, union obj_create_cfg *cfg,
+		       uint32_t *obj_id)
+{
+	return dpio_create_v10(&restool.mc_io, dprc_handle, 0,
+			       &cfg->dpio, obj_id);
+}
+
+static int create_dpmcp(uint16_t dprc_handle, union obj_create_cfg *cfg,
+			uint32_t *obj_id)
+{
+	cfg->dpmcp.portal_id = DPMCP_GET_PORTAL_ID_FROM_POOL;
+	return dpmcp_create_v10(&restool.mc_io, dprc_handle, 0,
+				&cfg->dpmcp, obj_id);
+}
+
+static int create_dpni(uint16_t dprc_handle, union obj_create_cfg *cfg,
+		       uint32_t *obj_id)
+{
+	return dpni_create_v10(&restool.mc_io, dprc_handle, 0,
+			       &cfg->dpni, obj_id);
+}
+
+static int create_dprtc(uint16_t dprc_handle, union obj_create_cfg *cfg,
+			uint32_t *obj_id)
+{
+	return dprtc_create_v10(&restool.mc_io, dprc_handle, 0,
+				&cfg->dprtc, obj_id);
+}
+
+static int create_dpseci(uint16_t dprc_handle, union obj_create_cfg *cfg,
+			 uint32_t *obj_id)
+{
+	return dpseci_create_v10(&restool.mc_io, dprc_handle, 0,
+				 &cfg->dpseci, obj_id);
+}
+
+static int create_dpsw(uint16_t dprc_handle, union obj_create_cfg *cfg,
+		       uint32_t *obj_id)
+{
+	return dpsw_create_v10(&restool.mc_io, dprc_handle, 0,
+			       &cfg->dpsw, obj_id);
+}
+
+/*
+ * DPMACs stand for physical ports and DPAIOPs are bound to the AIOP
+ * hardware, so neither can be duplicated.
+ */
+static const struct clone_ops clone_ops[] = {
+	{ "dpbp", NULL, NULL, NULL, create_dpbp, dpbp_destroy_v10 },
+	{ "dpci", dpci_open_v10, dpci_close_v10, read_dpci_cfg, create_dpci,
+	  dpci_destroy_v10 },
+	{ "dpcon", dpcon_open_v10, dpcon_close_v10, read_dpcon_cfg,
+	  create_dpcon, dpcon_destroy_v10 },
+	{ "dpdcei", dpdcei_open_v10, dpdcei_close_v10, read_dpdcei_cfg,
+	  create_dpdcei, dpdcei_destroy_v10 },
+	{ "dpdmai", dpdmai_open_v10, dpdmai_close_v10, read_dpdmai_cfg,
+	  create_dpdmai, dpdmai_destroy_v10 },
+	{ "dpdmux", dpdmux_open_v10, dpdmux_close_v10, read_dpdmux_cfg,
+	  create_dpdmux, dpdmux_destroy_v10 },
+	{ "dpio", dpio_open_v10, dpio_close_v10, read_dpio_cfg, create_dpio,
+	  dpio_destroy_v10 },
+	{ "dpmcp", NULL, NULL, NULL, create_dpmcp, dpmcp_destroy_v10 },
+	{ "dpni", dpni_open_v10, dpni_close_v10, read_dpni_cfg, create_dpni,
+	  dpni_destroy_v10 },
+	{ "dprtc", NULL, NULL, NULL, create_dprtc, dprtc_destroy_v10 },
+	{ "dpseci", dpseci_open_v10, dpseci_close_v10, read_dpseci_cfg,
+	  create_dpseci, dpseci_destroy_v10 },
+	{ "dpsw", dpsw_open_v10, dpsw_close_v10, read_dpsw_cfg, create_dpsw,
+	  dpsw_destroy_v10 },
+};
+
+static const struct clone_ops *get_clone_ops(const char *obj_type)
+{
+	for (unsigned int i = 0; i < ARRAY_SIZE(clone_ops); i++) {
+		if (strcmp(clone_ops[i].obj_type, obj_type) == 0)
+			return &clone_ops[i];
+	}
+
+	return NULL;
+}
+
+int create_obj_v10(uint16_t dprc_handle, const char *obj_type,
+		   union obj_create_cfg *cfg, uint32_t *obj_id)
+{
+	const struct clone_ops *ops = get_clone_ops(obj_type);
+
+	if (ops == NULL)
+		return -ENOTSUP;
+
+	return ops->create(dprc_handle, cfg, obj_id);
+}
+
+bool can_create_obj_v10(const char *obj_type)
+{
+	return get_clone_ops(obj_type) != NULL;
+}
+
+int destroy_obj_v10(uint16_t dprc_handle, const char *obj_type,
+		    uint32_t obj_id)
+{
+	const struct clone_ops *ops = get_clone_ops(obj_type);
+
+	if (ops == NULL)
+		return -ENOTSUP;
+
+	return ops->destroy(&restool.mc_io, dprc_handle, 0, obj_id);
+}
+
+int read_obj_create_cfg_v10(const char *obj_type, uint32_t obj_id,
+			    union obj_create_cfg *cfg, uint16_t *num_ifs)
+{
+	const struct clone_ops *ops = get_clone_ops(obj_type);
+	uint16_t obj_handle;
+	int error, error2;
+
+	if (ops == NULL)
+		return -ENOTSUP;
+
+	memset(cfg, 0, sizeof(*cfg));
+	*num_ifs = 0;
+	if (ops->read_cfg == NULL)
+		return 0;
+
+	error = ops->obj_open(&restool.mc_io, 0, obj_id, &obj_handle);
+	if (error < 0)
+		goto out;
+
+	error = ops->read_cfg(obj_handle, cfg, num_ifs);
+	error2 = ops->obj_close(&restool.mc_io, 0, obj_handle);
+	if (error == 0)
+		error = error2;
+out:
+	if (error < 0) {
+		mc_status = flib_error_to_mc_status(error);
+		ERROR_PRINTF("%s.%u: MC error: %s (status %#x)\n",
+			     obj_type, obj_id,
+			     mc_status_to_string(mc_status), mc_status);
+	}
+
+	return error;
+}
+
+static int read_dprc_cfg(uint32_t dprc_id, const char *label,
+			 struct dprc_cfg *cfg)
+{
+	struct dprc_attributes dprc_attr;
+	uint16_t dprc_handle;
+	int error, error2;
+
+	error = open_dprc(dprc_id, &dprc_handle);
+	if (error < 0)
+		return error;
+
+	memset(&dprc_attr, 0, sizeof(dprc_attr));
+	error = dprc_get_attributes(&restool.mc_io, 0, dprc_handle,
+				    &dprc_attr);
+	error2 = dprc_close(&restool.mc_io, 0, dprc_handle);
+	if (error == 0)
+		error = error2;
+	if (error < 0)
+		return error;
+
+	memset(cfg, 0, sizeof(*cfg));
+	cfg->icid = DPRC_GET_ICID_FROM_POOL;
+	cfg->portal_id = DPRC_GET_PORTAL_ID_FROM_POOL;
+	cfg->options = dprc_attr.options;
+	strncpy(cfg->label, label, MC_OBJ_LABEL_MAX_LENGTH);
+	cfg->label[MC_OBJ_LABEL_MAX_LENGTH] = '\0';
+
+	return 0;
+}
+
+static int read_obj_cfg(struct clone_obj *clone)
+{
+	const struct dprc_obj_desc *desc = &clone->obj->desc;
+
+	if (strcmp(desc->type, "dprc") == 0)
+		return read_dprc_cfg(desc->id, desc->label, &clone->cfg.dprc);
+
+	if (!can_create_obj_v10(desc->type)) {
+		ERROR_PRINTF("%s.%d cannot be cloned\n", desc->type, desc->id);
+		return -EINVAL;
+	}
+
+	return read_obj_create_cfg_v10(desc->type, desc->id, &clone->cfg,
+				       &clone->num_ifs);
+}
+
+/**
+ * Collects the links between objects of the source container. Each link
+ * is seen from both of its ends and is recorded once. Links that leave
+ * the source container cannot be duplicated and are reported.
+ */
+static int read_links(struct topology *topology, struct clone_obj *clones,
+		      struct clone_link **links_out, int *num_links_out)
+{
+	struct clone_link *links = NULL;
+	struct dprc_endpoint endpoint1;
+	struct dprc_endpoint endpoint2;
+	struct topology_obj *peer;
+	int num_links = 0;
+	int max_links = 0;
+	int state;
+	int error;
+
+	for (int i = 0; i < topology->num_objs; i++) {
+		for (uint16_t k = 0; k < clones[i].num_ifs; k++) {
+			memset(&endpoint1, 0, sizeof(endpoint1));
+			memset(&endpoint2, 0, sizeof(endpoint2));
+			strcpy(endpoint1.type, topology->objs[i].desc.type);
+			endpoint1.id = topology->objs[i].desc.id;
+			endpoint1.if_id = k;
+
+			error = get_connection(&endpoint1, &endpoint2, &state);
+			if (error < 0 || state == -1)
+				continue;
+
+			peer = topology_find(topology, endpoint2.type,
+					     endpoint2.id);
+			if (peer == NULL) {
+				printf("link %s.%d.%u <-> %s.%d.%u leaves the container, not cloned\n",
+				       endpoint1.type, endpoint1.id,
+				       endpoint1.if_id, endpoint2.type,
+				       endpoint2.id, endpoint2.if_id);
+				continue;
+			}
+
+			if (peer - topology->objs < i ||
+			    (peer - topology->objs == i &&
+			     endpoint2.if_id < k))
+				continue;
+
+			if (num_links == max_links) {
+				struct clone_link *new_links;
+
+				max_links = max_links ? max_links * 2 : 16;
+				new_links = realloc(links,
+						    max_links * sizeof(*links));
+				if (new_links == NULL) {
+					ERROR_PRINTF("Could not alloc memory for links!\n");
+					free(links);
+					return -ENOMEM;
+				}
+				links = new_links;
+			}
+
+			links[num_links].obj1 = &clones[i];
+			links[num_links].obj2 = &clones[peer - topology->objs];
+			links[num_links].if_id1 = k;
+			links[num_links].if_id2 = endpoint2.if_id;
+			num_links++;
+		}
+	}
+
+	*links_out = links;
+	*num_links_out = num_links;
+	return 0;
+}
+
+/**
+ * Returns the handle of the copy of a source container
+ */
+static uint16_t get_new_dprc_handle(struct topology *topology,
+				    struct clone_obj *clones,
+				    uint32_t src_dprc_id,
+				    uint16_t new_dprc_handle,
+				    uint32_t dprc_id)
+{
+	struct topology_obj *obj;
+
+	if (dprc_id == src_dprc_id)
+		return new_dprc_handle;
+
+	obj = topology_find(topology, "dprc", dprc_id);
+	assert(obj != NULL);
+	return clones[obj - topology->objs].new_dprc_handle;
+}
+
+/**
+ * Builds one copy of the source container under the parent container:
+ * creates the nested containers and the objects in place, sets their
+ * labels and recreates the links between them.
+ */
+static int clone_one(struct topology *topology, struct clone_obj *clones,
+		     struct clone_link *links, int num_links,
+		     uint32_t src_dprc_id, struct dprc_cfg *src_cfg,
+		     uint32_t parent_dprc_id, uint16_t parent_dprc_handle)
+{
+	struct dprc_endpoint endpoint1;
+	struct dprc_endpoint endpoint2;
+	struct dprc_connection_cfg connection_cfg = { 0 };
+	struct clone_obj *clone;
+	uint64_t mc_portal_offset;
+	uint16_t new_dprc_handle;
+	uint16_t dprc_handle;
+	char parent_name[32];
+	bool new_dprc_opened = false;
+	int new_dprc_id = -1;
+	int num_opened = 0;
+	int child_id;
+	int error = 0;
+	int error2;
+	int i;
+
+	error = dprc_create_container(&restool.mc_io, 0, parent_dprc_handle,
+				      src_cfg, &new_dprc_id,
+				      &mc_portal_offset);
+	if (error < 0)
+		goto mc_error;
+
+	error = open_dprc(new_dprc_id, &new_dprc_handle);
+	if (error < 0)
+		goto partial;
+
+	new_dprc_opened = true;
+
+	for (i = 0; i < topology->num_objs; i++) {
+		clone = &clones[i];
+		dprc_handle = get_new_dprc_handle(topology, clones,
+						  src_dprc_id,
+						  new_dprc_handle,
+						  clone->obj->parent_dprc_id);
+
+		if (strcmp(clone->obj->desc.type, "dprc") == 0) {
+			error = dprc_create_container(&restool.mc_io, 0,
+						      dprc_handle,
+						      &clone->cfg.dprc,
+						      &child_id,
+						      &mc_portal_offset);
+			if (error < 0)
+				goto mc_error;
+
+			clone->new_id = child_id;
+			error = open_dprc(clone->new_id,
+					  &clone->new_dprc_handle);
+			if (error < 0)
+				goto partial;
+
+			num_opened = i + 1;
+			continue;
+		}
+
+		error = create_obj_v10(dprc_handle, clone->obj->desc.type,
+				       &clone->cfg, &clone->new_id);
+		if (error < 0)
+			goto mc_error;
+
+		if (clone->obj->desc.label[0] != '\0') {
+			error = dprc_set_obj_label(&restool.mc_io, 0,
+						   dprc_handle,
+						   clone->obj->desc.type,
+						   clone->new_id,
+						   clone->obj->desc.label);
+			if (error < 0)
+				goto mc_error;
+		}
+	}
+
+	for (i = 0; i < num_links; i++) {
+		memset(&endpoint1, 0, sizeof(endpoint1));
+		memset(&endpoint2, 0, sizeof(endpoint2));
+		strcpy(endpoint1.type, links[i].obj1->obj->desc.type);
+		endpoint1.id = links[i].obj1->new_id;
+		endpoint1.if_id = links[i].if_id1;
+		strcpy(endpoint2.type, links[i].obj2->obj->desc.type);
+		endpoint2.id = links[i].obj2->new_id;
+		endpoint2.if_id = links[i].if_id2;
+
+		error = dprc_connect(&restool.mc_io, 0, new_dprc_handle,
+				     &endpoint1, &endpoint2,
+				     &connection_cfg);
+		if (error < 0)
+			goto mc_error;
+	}
+
+	sprintf(parent_name, "dprc.%u", parent_dprc_id);
+	print_new_obj("dprc", new_dprc_id, parent_name);
+	goto out;
+
+mc_error:
+	mc_status = flib_error_to_mc_status(error);
+	ERROR_PRINTF("MC error: %s (status %#x)\n",
+		     mc_status_to_string(mc_status), mc_status);
+partial:
+	if (new_dprc_id >= 0)
+		ERROR_PRINTF("Incomplete copy left in dprc.%d, remove it with:\n"
+			     "   restool dprc destroy dprc.%d --recursive\n",
+			     new_dprc_id, new_dprc_id);
+out:
+	for (i = num_opened - 1; i >= 0; i--) {
+		if (strcmp(clones[i].obj->desc.type, "dprc") != 0)
+			continue;
+
+		error2 = dprc_close(&restool.mc_io, 0,
+				    clones[i].new_dprc_handle);
+		if (error2 < 0 && error == 0)
+			error = error2;
+	}
+
+	if (new_dprc_opened) {
+		error2 = dprc_close(&restool.mc_io, 0, new_dprc_handle);
+		if (error2 < 0 && error == 0)
+			error = error2;
+	}
+
+	return error;
+}
+
+int dprc_clone(uint32_t src_dprc_id, uint32_t parent_dprc_id, int count)
+{
+	struct topology topology = { 0 };
+	struct dprc_obj_desc src_desc;
+	struct clone_obj *clones = NULL;
+	struct clone_link *links = NULL;
+	struct dprc_cfg src_cfg;
+	uint16_t parent_dprc_handle;
+	uint16_t src_dprc_handle;
+	uint32_t src_parent_id;
+	bool found = false;
+	int num_links = 0;
+	int error, error2;
+
+	if (restool.mc_fw_version.major == MC_FW_VERSION_9) {
+		ERROR_PRINTF("dprc clone requires MC firmware v10\n");
+		return -ENOTSUP;
+	}
+
+	memset(&src_desc, 0, sizeof(src_desc));
+	error = find_target_obj_desc(restool.root_dprc_id,
+				     restool.root_dprc_handle, 0, src_dprc_id,
+				     "dprc", &src_desc, &src_parent_id,
+				     &found);
+	if (error < 0)
+		return error;
+
+	if (!found) {
+		ERROR_PRINTF("dprc.%u does not exist\n", src_dprc_id);
+		return -ENOENT;
+	}
+
+	error = read_dprc_cfg(src_dprc_id, src_desc.label, &src_cfg);
+	if (error < 0)
+		return error;
+
+	error = open_dprc(src_dprc_id, &src_dprc_handle);
+	if (error < 0)
+		return error;
+
+	error = get_topology(src_dprc_id, src_dprc_handle, 1, &topology);
+	error2 = dprc_close(&restool.mc_io, 0, src_dprc_handle);
+	if (error == 0)
+		error = error2;
+	if (error < 0)
+		goto out;
+
+	if (topology.num_objs > 0) {
+		clones = calloc(topology.num_objs, sizeof(*clones));
+		if (clones == NULL) {
+			ERROR_PRINTF("Could not alloc memory for objects!\n");
+			error = -ENOMEM;
+			goto out;
+		}
+	}
+
+	/*
+	 * Read every object before creating anything, so that a container
+	 * holding an object which cannot be cloned is left untouched
+	 */
+	for (int i = 0; i < topology.num_objs; i++) {
+		clones[i].obj = &topology.objs[i];
+		error = read_obj_cfg(&clones[i]);
+		if (error < 0)
+			goto out;
+	}
+
+	error = read_links(&topology, clones, &links, &num_links);
+	if (error < 0)
+		goto out;
+
+	if (parent_dprc_id == restool.root_dprc_id) {
+		parent_dprc_handle = restool.root_dprc_handle;
+	} else {
+		error = open_dprc(parent_dprc_id, &parent_dprc_handle);
+		if (error < 0)
+			goto out;
+	}
+
+	for (int i = 0; i < count; i++) {
+		error = clone_one(&topology, clones, links, num_links,
+				  src_dprc_id, &src_cfg, parent_dprc_id,
+				  parent_dprc_handle);
+		if (error < 0)
+			break;
+	}
+
+	if (parent_dprc_id != restool.root_dprc_id) {
+		error2 = dprc_close(&restool.mc_io, 0, parent_dprc_handle);
+		if (error2 < 0 && error == 0)
+			error = error2;
+	}
+out:
+	free(links);
+	free(clones);
+	free_topology(&topology);
+	return error;
+}
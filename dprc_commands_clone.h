@@ -0,0 +1,94 @@
+/* Copyright 2026 NXP
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * * Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ * * Neither the name of the above-listed copyright holders nor the
+ * names of any contributors may be used to endorse or promote products
+ * derived from this software without specific prior written permission.
+ *
+ *
+ * ALTERNATIVELY, this software may be distributed under the terms of the
+ * GNU General Public License ("GPL") as published by the Free Software
+ * Foundation, either version 2 of that License or (at your option) any
+ * later version.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDERS OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "mc_v10/fsl_dpbp.h"
+#include "mc_v10/fsl_dpci.h"
+#include "mc_v10/fsl_dpcon.h"
+#include "mc_v10/fsl_dpdcei.h"
+#include "mc_v10/fsl_dpdmai.h"
+#include "mc_v10/fsl_dpdmux.h"
+#include "mc_v10/fsl_dpio.h"
+#include "mc_v10/fsl_dpmcp.h"
+#include "mc_v10/fsl_dpni.h"
+#include "mc_v10/fsl_dprtc.h"
+#include "mc_v10/fsl_dpseci.h"
+#include "mc_v10/fsl_dpsw.h"
+
+/**
+ * Creation parameters of an object, by object type
+ */
+union obj_create_cfg {
+	struct dprc_cfg dprc;
+	struct dpbp_cfg_v10 dpbp;
+	struct dpci_cfg_v10 dpci;
+	struct dpcon_cfg_v10 dpcon;
+	struct dpdcei_cfg_v10 dpdcei;
+	struct dpdmai_cfg_v10 dpdmai;
+	struct dpdmux_cfg_v10 dpdmux;
+	struct dpio_cfg_v10 dpio;
+	struct dpmcp_cfg dpmcp;
+	struct dpni_cfg_v10 dpni;
+	struct dprtc_cfg dprtc;
+	struct dpseci_cfg_v10 dpseci;
+	struct dpsw_cfg_v10 dpsw;
+};
+
+/**
+ * dprc clone command
+ */
+
+int dprc_clone(uint32_t src_dprc_id, uint32_t parent_dprc_id, int count);
+
+/**
+ * Creates an object in place in the container opened as dprc_handle.
+ * Returns -ENOTSUP for types that cannot be created this way (dprc, dpmac,
+ * dpaiop, ...).
+ */
+int create_obj_v10(uint16_t dprc_handle, const char *obj_type,
+		   union obj_create_cfg *cfg, uint32_t *obj_id);
+
+bool can_create_obj_v10(const char *obj_type);
+
+/**
+ * Destroys an object created by create_obj_v10() in the container opened
+ * as dprc_handle
+ */
+int destroy_obj_v10(uint16_t dprc_handle, const char *obj_type,
+		    uint32_t obj_id);
+
+/**
+ * Reads back the creation parameters of an existing object, as far as
+ * the MC reports them. num_ifs is the number of interfaces of the object
+ * that can be connected, 0 for most types.
+ */
+int read_obj_create_cfg_v10(const char *obj_type, uint32_t obj_id,
+			    union obj_create_cfg *cfg, uint16_t *num_ifs);
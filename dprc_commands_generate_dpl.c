@@ -38,6 +38,7 @@
 #include <assert.h>
 #include <getopt.h>
 #include <ctype.h>
+#include <unistd.h>
 #include "restool.h"
 #include "utils.h"
 #include "dprc_commands_generate_dpl.h"
@@ -127,22 +128,19 @@ struct dpni_config {
 #define RESTOOL_DYNAMIC_DPL "./dynamic-dpl.dts"
 
 /**
- * struct obj_list - linked list node of all objects
- * @next: tracks next objects, the objects are sorted
+ * struct dpl_obj - object of the container being written
  * @type: object type
  * @id: object id
  * @label: object label
  */
-struct obj_list {
-	struct obj_list *next;
+struct dpl_obj {
 	char type[16];
 	int id;
 	char label[16];
 };
 
 /**
- * struct conn_list - linked list node of 2 connected endpoints
- * @next: tracks next connection, the connections are not sorted.
+ * struct dpl_conn - link between 2 endpoints
  * @type1: endpoint1's object type
  * @type2: endpoint2's object type
  * @id1: endpoint1's id
@@ -150,8 +148,7 @@ struct obj_list {
  * @if_id1: endpoint1's interface id, initialized as -1 if no interface
  * @if_id2: endpoint2's interface id, initialized as -1 if no interface
  */
-struct conn_list {
-	struct conn_list *next;
+struct dpl_conn {
 	char type1[16];
 	char type2[16];
 	int id1;
@@ -161,294 +158,318 @@ struct conn_list {
 };
 
 /**
- * struct container_list - linked list node of all containers
- * @next: tracks next container
- * @obj_list: tracks the objects in current container, sorted list
- * @id: current container's id
- * @parent_id: current container's parent id. 0 means no parent.
- * @options: configuration options of current container
+ * dpl_container_fn - visitor of the container walk
+ * @fp: output stream
+ * @dprc_id: id of the visited container
+ * @dprc_handle: open handle of the visited container
+ * @parent_id: id of its parent, 0 for the walked container
+ * @objs: objects of the container, sorted by type and id
+ * @num_objs: number of entries in @objs
  */
-struct container_list {
-	struct container_list *next;
-	struct obj_list *obj;
-	int id;
-	int parent_id;
-	uint64_t options;
+typedef int dpl_container_fn(FILE *fp, uint32_t dprc_id,
+			     uint16_t dprc_handle, uint32_t parent_id,
+			     struct dpl_obj *objs, int num_objs);
+
+/**
+ * struct dpl_container_sum - what the containers section saw of a
+ *			      container, checked by the objects section
+ * @dprc_id: container id
+ * @num_objs: number of objects of the container
+ * @hash: hash of the types and ids of these objects
+ */
+struct dpl_container_sum {
+	uint32_t dprc_id;
+	int num_objs;
+	uint32_t hash;
+};
+
+/**
+ * struct dpl_arena_block - memory block the connections and container
+ *			    sums are carved from, they are all released
+ *			    at once
+ * @next: previously filled block
+ * @size: size of @data
+ * @used: bytes of @data handed out
+ */
+struct dpl_arena_block {
+	struct dpl_arena_block *next;
+	size_t size;
+	size_t used;
+	char data[];
 };
 
-static int container_count;
-static struct container_list *container_head;
-static struct obj_list *obj_head;
-static struct conn_list *conn_head;
+#define DPL_ARENA_BLOCK_SIZE	(64 * 1024)
+
+/* stdio buffer of the generated DPL */
+#define DPL_OUTPUT_BUFFER_SIZE	(1024 * 1024)
+
+static struct dpl_arena_block *dpl_arena;
+
+/*
+ * Connections are the only part of the layout kept in memory: they are
+ * found while the objects are written and go last in the DPL. conn_set
+ * indexes both endpoints of each of them.
+ */
+static struct dpl_conn *conns;
+static int num_conns;
+static int max_conns;
+static int *conn_set;
+static unsigned int conn_set_size;
+
+/*
+ * One entry per container, in walk order: the objects walk fails rather
+ * than write objects the containers section did not list
+ */
+static struct dpl_container_sum *container_sums;
+static int num_container_sums;
+static int max_container_sums;
+static int next_container_sum;
 
 enum mc_cmd_status mc_status;
 
+static void *dpl_alloc(size_t size)
+{
+	struct dpl_arena_block *block = dpl_arena;
+	size_t block_size;
+	void *ptr;
+
+	size = (size + 15) & ~(size_t)15;
+	if (block == NULL || block->size - block->used < size) {
+		block_size = size > DPL_ARENA_BLOCK_SIZE ?
+			     size : DPL_ARENA_BLOCK_SIZE;
+		block = malloc(sizeof(*block) + block_size);
+		if (block == NULL) {
+			ERROR_PRINTF("Could not alloc memory!\n");
+			return NULL;
+		}
+		block->size = block_size;
+		block->used = 0;
+		block->next = dpl_arena;
+		dpl_arena = block;
+	}
+
+	ptr = block->data + block->used;
+	block->used += size;
+	return ptr;
+}
+
 /**
- * compare_insert_obj - compare the newly added object node with existing ones,
- *			insert in sorted order
- * @head: head of the object list
- * @target: the object node to be inserted
+ * dpl_grow - double the capacity of an array allocated from the arena
+ * @array: current array
+ * @num: number of used entries of @array
+ * @max: capacity of @array, updated on success
+ * @elem_size: size of one entry
  *
- * Returns 0 on success, negative otherwise
+ * Returns the new array, NULL on failure
  */
-static int compare_insert_obj(struct obj_list **head, struct obj_list *target)
+static void *dpl_grow(void *array, int num, int *max, size_t elem_size)
 {
-	int error;
-	struct obj_list *prev;
-	struct obj_list *curr;
-
-	if (*head == NULL) {
-		*head = target;
-		target->next = NULL;
-		return 0;
-	}
+	int new_max = *max ? *max * 2 : 64;
+	void *new_array;
 
-	curr = prev = *head;
-	while (curr) {
-		error = strcmp(target->type, curr->type);
-
-		if (error < 0) {
-			if (curr == prev) {
-				*head = target;
-				target->next = curr;
-				return 0;
-			}
+	new_array = dpl_alloc(new_max * elem_size);
+	if (new_array == NULL)
+		return NULL;
 
-			prev->next = target;
-			target->next = curr;
-			return 0;
-		}
+	if (num > 0)
+		memcpy(new_array, array, num * elem_size);
+	*max = new_max;
+	return new_array;
+}
 
-		if (error == 0) {
-			if (target->id < curr->id) {
-				if (curr == prev) {
-					*head = target;
-					target->next = curr;
-					return 0;
-				}
+static void dpl_free(void)
+{
+	struct dpl_arena_block *block;
+
+	while (dpl_arena) {
+		block = dpl_arena;
+		dpl_arena = block->next;
+		free(block);
+	}
+
+	conns = NULL;
+	num_conns = 0;
+	max_conns = 0;
+	conn_set = NULL;
+	conn_set_size = 0;
+	container_sums = NULL;
+	num_container_sums = 0;
+	max_container_sums = 0;
+	next_container_sum = 0;
+}
 
+static uint32_t hash_container_objs(const struct dpl_obj *objs, int num_objs)
+{
+	uint32_t hash = 0;
 
-				prev->next = target;
-				target->next = curr;
-				return 0;
-			}
+	for (int i = 0; i < num_objs; i++)
+		hash = hash * 31 + hash_endpoint(objs[i].type, objs[i].id, 0);
 
-			if (target->id == curr->id) {
-				ERROR_PRINTF("Two objects the same: %s.%d\n",
-						curr->type, curr->id);
-				return -EINVAL;
-			}
+	return hash;
+}
 
-			if (target->id > curr->id) {
-				prev = curr;
-				curr = curr->next;
-			}
-		}
+static int add_container_sum(uint32_t dprc_id, const struct dpl_obj *objs,
+			     int num_objs)
+{
+	struct dpl_container_sum *sums;
 
-		if (error > 0) {
-			prev = curr;
-			curr = curr->next;
-		}
+	if (num_container_sums == max_container_sums) {
+		sums = dpl_grow(container_sums, num_container_sums,
+				&max_container_sums, sizeof(*sums));
+		if (sums == NULL)
+			return -ENOMEM;
+		container_sums = sums;
 	}
 
-	prev->next = target;
-	target->next = NULL;
+	container_sums[num_container_sums].dprc_id = dprc_id;
+	container_sums[num_container_sums].num_objs = num_objs;
+	container_sums[num_container_sums].hash =
+		hash_container_objs(objs, num_objs);
+	num_container_sums++;
 	return 0;
 }
 
-static int find_all_obj_desc(uint32_t dprc_id,
-			     uint16_t dprc_handle,
-			     int nesting_level,
-			     struct container_list **prev,
-			     uint32_t parent_id)
+static int check_container_sum(uint32_t dprc_id, const struct dpl_obj *objs,
+			       int num_objs)
 {
+	const struct dpl_container_sum *sum;
 
-	int num_child_devices;
-	int error = 0;
-	enum mc_cmd_status mc_status;
-	struct container_list *prev_cont;
-	struct container_list *curr_cont;
-	struct dprc_attributes dprc_attr;
+	if (next_container_sum == num_container_sums)
+		goto changed;
 
-	if (prev)
-		prev_cont = *prev;
-	curr_cont = malloc(sizeof(struct container_list));
-	if (curr_cont == NULL) {
-		ERROR_PRINTF("malloc failed\n");
-		error = -errno;
-		goto out;
-	}
+	sum = &container_sums[next_container_sum++];
+	if (sum->dprc_id == dprc_id && sum->num_objs == num_objs &&
+	    sum->hash == hash_container_objs(objs, num_objs))
+		return 0;
 
-	assert(nesting_level <= MAX_DPRC_NESTING);
-	if (parent_id == 0) {
-		DEBUG_PRINTF("This is the main dprc.\n");
-		container_head = curr_cont;
-	} else {
-		DEBUG_PRINTF("This is child dprc.\n");
-		prev_cont->next = curr_cont;
-	}
+changed:
+	ERROR_PRINTF("dprc.%u changed while the DPL was written\n", dprc_id);
+	return -EAGAIN;
+}
 
-	curr_cont->id = dprc_id;
-	curr_cont->parent_id = parent_id;
-	curr_cont->obj = NULL;
-	curr_cont->next = NULL;
-	if (prev)
-		*prev = curr_cont;
-	prev_cont = curr_cont;
+static int compare_obj(const void *a, const void *b)
+{
+	const struct dpl_obj *obj1 = a;
+	const struct dpl_obj *obj2 = b;
+	int diff;
 
-	memset(&dprc_attr, 0, sizeof(dprc_attr));
-	error = dprc_get_attributes(&restool.mc_io, 0,
-				dprc_handle, &dprc_attr);
-	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
-		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
-		goto out;
-	}
-	curr_cont->options = dprc_attr.options;
-	container_count++;
-	error = dprc_get_obj_count(&restool.mc_io, 0,
-				   dprc_handle,
+	diff = strcmp(obj1->type, obj2->type);
+	if (diff)
+		return diff;
+
+	return obj1->id - obj2->id;
+}
+
+/**
+ * read_container_objs - list the objects of one container
+ * @dprc_handle: open handle of the container
+ * @objs_out: objects sorted by type and id, to be freed by the caller
+ * @num_out: number of entries in @objs_out
+ *
+ * Returns 0 on success, negative otherwise
+ */
+static int read_container_objs(uint16_t dprc_handle, struct dpl_obj **objs_out,
+			       int *num_out)
+{
+	struct dprc_obj_desc obj_desc;
+	struct dpl_obj *objs;
+	int num_child_devices;
+	int error;
+
+	*objs_out = NULL;
+	*num_out = 0;
+	error = dprc_get_obj_count(&restool.mc_io, 0, dprc_handle,
 				   &num_child_devices);
 	if (error < 0) {
 		mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
 			     mc_status_to_string(mc_status), mc_status);
-		goto out;
+		return error;
+	}
+
+	objs = calloc(num_child_devices + 1, sizeof(*objs));
+	if (objs == NULL) {
+		ERROR_PRINTF("Could not alloc memory!\n");
+		return -ENOMEM;
 	}
 
 	for (int i = 0; i < num_child_devices; i++) {
-		struct dprc_obj_desc obj_desc;
-		uint16_t child_dprc_handle;
-		int error2;
-
-		error = dprc_get_obj(
-				&restool.mc_io, 0,
-				dprc_handle,
-				i,
-				&obj_desc);
+		error = dprc_get_obj(&restool.mc_io, 0, dprc_handle, i,
+				     &obj_desc);
 		if (error < 0) {
 			DEBUG_PRINTF(
 				"dprc_get_object(%u) failed with error %d\n",
 				i, error);
-			goto out;
+			free(objs);
+			return error;
 		}
 
 		DEBUG_PRINTF("it is %s.%u\n", obj_desc.type, obj_desc.id);
-
-		if (strcmp(obj_desc.type, "dprc") == 0) {
-
-			error = open_dprc(obj_desc.id, &child_dprc_handle);
-			if (error < 0)
-				goto out;
-
-			DEBUG_PRINTF("entering %s.%u\n", obj_desc.type,
-					obj_desc.id);
-			error = find_all_obj_desc(obj_desc.id,
-					child_dprc_handle,
-					nesting_level + 1,
-					&prev_cont,
-					dprc_id);
-			if (prev)
-				*prev = prev_cont;
-
-			error2 = dprc_close(&restool.mc_io, 0,
-						child_dprc_handle);
-			if (error2 < 0) {
-				mc_status = flib_error_to_mc_status(error2);
-				ERROR_PRINTF("MC error: %s (status %#x)\n",
-				mc_status_to_string(mc_status), mc_status);
-				if (error == 0)
-					error = error2;
-
-				goto out;
-			}
-
-			DEBUG_PRINTF("exiting %s.%u\n", obj_desc.type,
-					obj_desc.id);
-		} else {
-			struct obj_list *curr_obj =
-				malloc(sizeof(struct obj_list));
-			if (curr_obj == NULL) {
-				ERROR_PRINTF("malloc failed\n");
-				error = -errno;
-				goto out;
-			}
-
-			curr_obj->next = NULL;
-			strncpy(curr_obj->type, obj_desc.type, 16);
-			curr_obj->id = obj_desc.id;
-			strncpy(curr_obj->label, obj_desc.label, 16);
-
-			struct obj_list *curr_obj2 =
-				malloc(sizeof(struct obj_list));
-			if (curr_obj2 == NULL) {
-				ERROR_PRINTF("malloc failed\n");
-				error = -errno;
-				goto out;
-			}
-
-			curr_obj2->next = NULL;
-			strncpy(curr_obj2->type, obj_desc.type, 16);
-			curr_obj2->id = obj_desc.id;
-			strncpy(curr_obj2->label, obj_desc.label, 16);
-
-			error = compare_insert_obj(&obj_head, curr_obj);
-			if (error)
-				goto out;
-			error = compare_insert_obj(&curr_cont->obj, curr_obj2);
-			if (error)
-				goto out;
-		}
+		strncpy(objs[i].type, obj_desc.type, 15);
+		objs[i].id = obj_desc.id;
+		strncpy(objs[i].label, obj_desc.label, 15);
 	}
 
-out:
-	return error;
+	qsort(objs, num_child_devices, sizeof(*objs), compare_obj);
+	*objs_out = objs;
+	*num_out = num_child_devices;
+	return 0;
 }
 
-static int parse_layout(uint32_t dprc_id)
+/**
+ * walk_containers - visit a container, then its child containers
+ * @fp: output stream handed to @visit
+ * @dprc_id: container to visit
+ * @dprc_handle: open handle of @dprc_id
+ * @nesting_level: depth of @dprc_id in the walk
+ * @parent_id: parent of @dprc_id, 0 for the walked container
+ * @visit: called once per container, before its children
+ *
+ * Only the objects of the containers between the walked container and
+ * the visited one are held in memory.
+ *
+ * Returns 0 on success, negative otherwise
+ */
+static int walk_containers(FILE *fp, uint32_t dprc_id, uint16_t dprc_handle,
+			   int nesting_level, uint32_t parent_id,
+			   dpl_container_fn *visit)
 {
-	int error;
+	uint16_t child_dprc_handle;
+	struct dpl_obj *objs;
+	int num_objs;
+	int error, error2;
 
-	bool opened = false;
+	assert(nesting_level <= MAX_DPRC_NESTING);
+	error = read_container_objs(dprc_handle, &objs, &num_objs);
+	if (error < 0)
+		return error;
 
-	uint16_t dprc_handle;
+	error = visit(fp, dprc_id, dprc_handle, parent_id, objs, num_objs);
+	for (int i = 0; i < num_objs && error == 0; i++) {
+		if (strcmp(objs[i].type, "dprc") != 0)
+			continue;
 
-	/* if no dprc specified, use root dprc */
-	if (restool.obj_name == NULL || dprc_id == restool.root_dprc_id) {
-		dprc_id = restool.root_dprc_id;
-		dprc_handle = restool.root_dprc_handle;
-	} else {
-		error = dprc_open(&restool.mc_io, 0, dprc_id, &dprc_handle);
-		if (error < 0) {
-			mc_status = flib_error_to_mc_status(error);
-			ERROR_PRINTF("MC error: %s (status %#x)\n",
-				     mc_status_to_string(mc_status), mc_status);
-			goto out;
-		}
-		opened = true;
-	}
+		error = open_dprc(objs[i].id, &child_dprc_handle);
+		if (error < 0)
+			break;
 
-	error = find_all_obj_desc(dprc_id, dprc_handle, 0, NULL, 0);
+		DEBUG_PRINTF("entering dprc.%d\n", objs[i].id);
+		error = walk_containers(fp, objs[i].id, child_dprc_handle,
+					nesting_level + 1, dprc_id, visit);
 
-	if (opened == true) {
-		error = dprc_close(&restool.mc_io, 0, dprc_handle);
-		if (error < 0) {
-			mc_status = flib_error_to_mc_status(error);
+		error2 = dprc_close(&restool.mc_io, 0, child_dprc_handle);
+		if (error2 < 0) {
+			mc_status = flib_error_to_mc_status(error2);
 			ERROR_PRINTF("MC error: %s (status %#x)\n",
 				     mc_status_to_string(mc_status), mc_status);
-			goto out;
+			if (error == 0)
+				error = error2;
 		}
-
-	}
-
-	if (error) {
-		ERROR_PRINTF("Parsing Data Path Layout failed\n");
-		return error;
+		DEBUG_PRINTF("exiting dprc.%d\n", objs[i].id);
 	}
 
-out:
-	return 0;
+	free(objs);
+	return error;
 }
 
 static void parse_dprc_options(FILE *fp, uint64_t options)
@@ -515,7 +536,7 @@ static char *to_upper(char *string)
 	char *upper_string;
 
 	length = strlen(string);
-	upper_string = malloc(length * sizeof(char));
+	upper_string = malloc((length + 1) * sizeof(char));
 	if (!upper_string) {
 		ERROR_PRINTF("Could not alloc memory!");
 		return NULL;
@@ -528,24 +549,24 @@ static char *to_upper(char *string)
 	return upper_string;
 }
 
-static int write_obj_set(char *obj_type, int start_index, int end_index)
+static int write_obj_set(FILE *fp, const struct dpl_obj *objs,
+			 int start_index, int end_index)
 {
 	char *obj_type_upper;
-	FILE *fp = stdout;
 	int i;
 
-	obj_type_upper = to_upper(obj_type);
+	obj_type_upper = to_upper((char *)objs[start_index].type);
 	if (!obj_type_upper)
 		return -ENOMEM;
 
 	fprintf(fp, "\n");
 	fprintf(fp, "\t\t\t\t/* -------------- %ss --------------*/\n", obj_type_upper);
-	fprintf(fp, "\t\t\t\tobj_set@%s {\n", obj_type);
-	fprintf(fp, "\t\t\t\t\ttype = \"%s\";\n", obj_type);
+	fprintf(fp, "\t\t\t\tobj_set@%s {\n", objs[start_index].type);
+	fprintf(fp, "\t\t\t\t\ttype = \"%s\";\n", objs[start_index].type);
 	fprintf(fp, "\t\t\t\t\tids = <");
 
 	for (i = start_index; i <= end_index; i++)
-		fprintf(fp, "%d ", i);
+		fprintf(fp, "%d ", objs[i].id);
 
 	fprintf(fp, ">;\n");
 	fprintf(fp, "\t\t\t\t};\n");
@@ -554,232 +575,216 @@ static int write_obj_set(char *obj_type, int start_index, int end_index)
 	return 0;
 }
 
-static int write_containers(void)
+/**
+ * write_container - container walk visitor writing the node of the
+ *		     container in the containers section
+ */
+static int write_container(FILE *fp, uint32_t dprc_id, uint16_t dprc_handle,
+			   uint32_t parent_id, struct dpl_obj *objs,
+			   int num_objs)
 {
-	struct container_list *curr_cont;
-	struct obj_list *curr_obj;
-	struct obj_list *prev_obj;
-	char curr_obj_type[OBJ_TYPE_MAX_LENGTH];
-	int remain, obj_set_start, error;
-	int curr_obj_id;
+	struct dprc_attributes dprc_attr;
+	const struct dpl_obj *curr_obj;
+	int obj_set_start = -1;
+	int remain, error;
 	int obj_num = 99;
 	int base = 100;
-	FILE *fp = stdout;
-
-	fprintf(fp,
-		"\t/*****************************************************************\n");
-	fprintf(fp, "\t * Containers\n");
-	fprintf(fp,
-		"\t *****************************************************************/\n");
 
-	fprintf(fp, "\tcontainers {\n");
+	error = add_container_sum(dprc_id, objs, num_objs);
+	if (error < 0)
+		return error;
 
-	curr_cont = container_head;
-	while (curr_cont) {
-		obj_num = 99;
-		prev_obj = NULL;
-		curr_obj = curr_cont->obj;
-		memset(curr_obj_type, 0, OBJ_TYPE_MAX_LENGTH);
+	memset(&dprc_attr, 0, sizeof(dprc_attr));
+	error = dprc_get_attributes(&restool.mc_io, 0, dprc_handle,
+				    &dprc_attr);
+	if (error < 0) {
+		mc_status = flib_error_to_mc_status(error);
+		ERROR_PRINTF("MC error: %s (status %#x)\n",
+			     mc_status_to_string(mc_status), mc_status);
+		return error;
+	}
 
-		fprintf(fp, "\n");
-		fprintf(fp, "\t\tdprc@%d {\n", curr_cont->id);
-		fprintf(fp, "\t\t\tcompatible = \"fsl,dprc\";\n");
-		if (curr_cont->parent_id == 0)
-			fprintf(fp, "\t\t\tparent = \"none\";\n");
-		else
-			fprintf(fp, "\t\t\tparent = \"dprc@%d\";\n",
-				curr_cont->parent_id);
-		parse_dprc_options(fp, curr_cont->options);
+	fprintf(fp, "\n");
+	fprintf(fp, "\t\tdprc@%u {\n", dprc_id);
+	fprintf(fp, "\t\t\tcompatible = \"fsl,dprc\";\n");
+	if (parent_id == 0)
+		fprintf(fp, "\t\t\tparent = \"none\";\n");
+	else
+		fprintf(fp, "\t\t\tparent = \"dprc@%u\";\n", parent_id);
+	parse_dprc_options(fp, dprc_attr.options);
 
+	fprintf(fp, "\n");
+	fprintf(fp, "\t\t\tobjects {\n");
 
-		fprintf(fp, "\n");
-		fprintf(fp, "\t\t\tobjects {\n");
+	for (int j = 0; j < num_objs; j++) {
+		curr_obj = &objs[j];
+		if (strcmp(curr_obj->type, "dprc") == 0 ||
+		    (strcmp(curr_obj->type, "dpmcp") == 0 &&
+		     0 == curr_obj->id))
+			continue;
 
-		while (curr_obj) {
-			if (strcmp(curr_obj->type, "dpmcp") == 0 &&
-			    0 == curr_obj->id) {
-				curr_obj = curr_obj->next;
-				continue;
-			}
-			if (prev_obj == NULL ||
-			    strcmp(curr_obj->type, prev_obj->type) > 0) {
+		if (restool.mc_fw_version.major <= MC_FW_VERSION_9) {
+			if (j == 0 ||
+			    strcmp(curr_obj->type, objs[j - 1].type) > 0) {
 				remain = obj_num % base;
 				obj_num = obj_num + base - remain;
 			}
 
-			if (restool.mc_fw_version.major <= MC_FW_VERSION_9) {
-				fprintf(fp, "\n");
-				fprintf(fp, "\t\t\t\tobj@%d {\n", obj_num);
-				fprintf(fp, "\t\t\t\t\tobj_name = \"%s@%d\";\n",
-					curr_obj->type, curr_obj->id);
-				parse_obj_label(fp, curr_obj->label);
-				fprintf(fp, "\t\t\t\t};\n");
-			} else if (restool.mc_fw_version.major == MC_FW_VERSION_10) {
-				if (curr_obj_type[0] == '\0') {
-					memcpy(curr_obj_type, curr_obj->type, OBJ_TYPE_MAX_LENGTH);
-					curr_obj_id = curr_obj->id;
-					obj_set_start = curr_obj->id;
-				} else if (strcmp(curr_obj_type, curr_obj->type)) {
-					error = write_obj_set(curr_obj_type, obj_set_start, curr_obj_id);
-					if (error) {
-						ERROR_PRINTF("write_obj_set() failed with error = %d\n", error);
-						return error;
-					}
-
-					obj_set_start = curr_obj->id;
-					memcpy(curr_obj_type, curr_obj->type, OBJ_TYPE_MAX_LENGTH);
-					curr_obj_id = curr_obj->id;
-				} else {
-					curr_obj_id = curr_obj->id;
-				}
-			}
-
+			fprintf(fp, "\n");
+			fprintf(fp, "\t\t\t\tobj@%d {\n", obj_num);
+			fprintf(fp, "\t\t\t\t\tobj_name = \"%s@%d\";\n",
+				curr_obj->type, curr_obj->id);
+			parse_obj_label(fp, (char *)curr_obj->label);
+			fprintf(fp, "\t\t\t\t};\n");
 			obj_num++;
-			prev_obj = curr_obj;
-			curr_obj = curr_obj->next;
-		}
+		} else if (restool.mc_fw_version.major == MC_FW_VERSION_10) {
+			if (obj_set_start < 0)
+				obj_set_start = j;
 
-		error = write_obj_set(curr_obj_type, obj_set_start, curr_obj_id);
-		if (error) {
-			ERROR_PRINTF("write_obj_set() failed with error = %d\n", error);
-			return error;
-		}
+			/* one set per type, objects are sorted by type */
+			if (j + 1 < num_objs &&
+			    strcmp(curr_obj->type, objs[j + 1].type) == 0)
+				continue;
 
-		fprintf(fp, "\t\t\t};\n");
-		fprintf(fp, "\t\t};\n");
-		curr_cont = curr_cont->next;
+			error = write_obj_set(fp, objs, obj_set_start, j);
+			if (error) {
+				ERROR_PRINTF("write_obj_set() failed with error = %d\n", error);
+				return error;
+			}
+			obj_set_start = -1;
+		}
 	}
 
-	fprintf(fp, "\t};\n");
+	fprintf(fp, "\t\t\t};\n");
+	fprintf(fp, "\t\t};\n");
 
 	return 0;
 }
 
 /**
- * compare_insert_connection - Just insert target into conn_list.
- *				The conn_list is unsorted.
- *				Algorithm is used to avoid adding duplication
- *				connection node from 2 objects
- * @head: conn_list head
- * @target: the one to be inserted
- *
- * Return 0 on success, negative otherwise
+ * conn_set entries hold conn index * 2 + endpoint + 1, 0 is a free slot
  */
-static int compare_insert_connection(struct conn_list **head,
-				     struct conn_list *target)
+static void get_conn_endpoint(int entry, const char **type, int *id,
+			      int *if_id)
 {
-	struct conn_list *prev;
-	struct conn_list *curr;
+	const struct dpl_conn *conn = &conns[(entry - 1) / 2];
 
-	if (*head == NULL) {
-		*head = target;
-		target->next = NULL;
-		return 0;
+	if ((entry - 1) % 2 == 0) {
+		*type = conn->type1;
+		*id = conn->id1;
+		*if_id = conn->if_id1;
+	} else {
+		*type = conn->type2;
+		*id = conn->id2;
+		*if_id = conn->if_id2;
 	}
+}
 
-	curr = prev = *head;
-	while (curr) {
-		if (strcmp(target->type1, curr->type1) == 0 &&
-		    target->id1 == curr->id1 &&
-		    target->if_id1 == curr->if_id1) {
-
-			if (strcmp(target->type2, curr->type2) == 0 &&
-			    target->id2 == curr->id2 &&
-			    target->if_id2 == curr->if_id2)
-				return 0;
-
-			return -EINVAL;
-		}
-
-		if (strcmp(target->type1, curr->type2) == 0 &&
-		    target->id1 == curr->id2 &&
-		    target->if_id1 == curr->if_id2) {
+static void conn_set_insert(int entry)
+{
+	const char *type;
+	unsigned int i;
+	int id, if_id;
+
+	get_conn_endpoint(entry, &type, &id, &if_id);
+	i = hash_endpoint(type, id, if_id) & (conn_set_size - 1);
+	while (conn_set[i] != 0)
+		i = (i + 1) & (conn_set_size - 1);
+	conn_set[i] = entry;
+}
 
-			if (strcmp(target->type2, curr->type1) == 0 &&
-			    target->id2 == curr->id1 &&
-			    target->if_id2 == curr->if_id1)
-				return 0;
+static int conn_set_lookup(const char *type, int id, int if_id)
+{
+	const char *entry_type;
+	int entry_id, entry_if_id;
+	unsigned int i;
 
-			return -EINVAL;
-		}
+	if (conn_set_size == 0)
+		return 0;
 
-		prev = curr;
-		curr = curr->next;
+	i = hash_endpoint(type, id, if_id) & (conn_set_size - 1);
+	while (conn_set[i] != 0) {
+		get_conn_endpoint(conn_set[i], &entry_type, &entry_id,
+				  &entry_if_id);
+		if (entry_id == id && entry_if_id == if_id &&
+		    strcmp(entry_type, type) == 0)
+			return conn_set[i];
+		i = (i + 1) & (conn_set_size - 1);
 	}
 
-	prev->next = target;
-	target->next = NULL;
-
 	return 0;
 }
 
-/* objects don't Need to be parse and get attributes for now */
-static int parse_dpbp(FILE *fp, struct obj_list *curr)
+static int conn_set_grow(void)
 {
-	(void)fp;
-	(void)curr;
-	return 0;
-}
+	unsigned int new_size = conn_set_size ? conn_set_size * 2 : 256;
 
-static int parse_dpdbg(FILE *fp, struct obj_list *curr)
-{
-	(void)fp;
-	(void)curr;
-	return 0;
-}
+	conn_set = dpl_alloc(new_size * sizeof(*conn_set));
+	if (conn_set == NULL)
+		return -ENOMEM;
 
-static int parse_dpmcp(FILE *fp, struct obj_list *curr)
-{
-	(void)fp;
-	(void)curr;
-	return 0;
-}
+	memset(conn_set, 0, new_size * sizeof(*conn_set));
+	conn_set_size = new_size;
+	for (int i = 0; i < num_conns; i++) {
+		conn_set_insert(i * 2 + 1);
+		conn_set_insert(i * 2 + 2);
+	}
 
-static int parse_dprc(FILE *fp, struct obj_list *curr)
-{
-	(void)fp;
-	(void)curr;
 	return 0;
 }
 
-static int parse_dprtc(FILE *fp, struct obj_list *curr)
+/**
+ * add_connection - add target to the connections, unless the same link
+ *		    was already added from its other endpoint
+ * @target: the one to be added
+ *
+ * Return 0 on success, negative otherwise
+ */
+static int add_connection(const struct dpl_conn *target)
 {
-	(void)fp;
-	(void)curr;
-	return 0;
-}
+	const char *type;
+	int id, if_id;
+	int entry;
+	int error;
+
+	entry = conn_set_lookup(target->type1, target->id1, target->if_id1);
+	if (entry != 0) {
+		/* same link seen from the other side, check the peer */
+		get_conn_endpoint(entry % 2 ? entry + 1 : entry - 1,
+				  &type, &id, &if_id);
+		if (strcmp(type, target->type2) == 0 &&
+		    id == target->id2 && if_id == target->if_id2)
+			return 0;
+
+		return -EINVAL;
+	}
+
+	if (num_conns == max_conns) {
+		conns = dpl_grow(conns, num_conns, &max_conns, sizeof(*conns));
+		if (conns == NULL)
+			return -ENOMEM;
+	}
+
+	conns[num_conns++] = *target;
+
+	/* keep the set at most half full */
+	if ((unsigned int)num_conns * 4 > conn_set_size) {
+		error = conn_set_grow();
+		if (error)
+			return error;
+	} else {
+		conn_set_insert(num_conns * 2 - 1);
+		conn_set_insert(num_conns * 2);
+	}
 
-/* objects Need to be parsed and get attributes*/
-static int parse_dpaiop(FILE *fp, struct obj_list *curr)
-{
-	/* dpaiop_attr{} does not have field called aiop_container_id */
-	(void)fp;
-	(void)curr;
 	return 0;
 }
 
-static int parse_dpcon(FILE *fp, struct obj_list *curr)
+static int write_dpcon_attr(FILE *fp, uint16_t dpcon_handle,
+			    struct dpl_obj *curr)
 {
-	uint16_t dpcon_handle;
 	int error;
 	struct dpcon_attr dpcon_attr;
-	bool dpcon_opened = false;
-
-	error = dpcon_open(&restool.mc_io, 0, curr->id, &dpcon_handle);
-	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
-		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
-		goto out;
-	}
-	dpcon_opened = true;
-	if (0 == dpcon_handle) {
-		DEBUG_PRINTF(
-			"dpcon_open() returned invalid handle (auth 0) for dpcon.%u\n",
-			curr->id);
-		error = -ENOENT;
-		goto out;
-	}
 
 	memset(&dpcon_attr, 0, sizeof(dpcon_attr));
 	error = dpcon_get_attributes(&restool.mc_io, 0, dpcon_handle,
@@ -788,55 +793,22 @@ static int parse_dpcon(FILE *fp, struct obj_list *curr)
 		mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
 			     mc_status_to_string(mc_status), mc_status);
-		goto out;
+		return error;
 	}
 	assert(curr->id == dpcon_attr.id);
 
 	fprintf(fp, "\t\t\tnum_priorities = <%#x>;\n",
 		dpcon_attr.num_priorities);
 
-	error = 0;
-
-out:
-	if (dpcon_opened) {
-		int error2;
-
-		error2 = dpcon_close(&restool.mc_io, 0, dpcon_handle);
-		if (error2 < 0) {
-			mc_status = flib_error_to_mc_status(error2);
-			ERROR_PRINTF("MC error: %s (status %#x)\n",
-				     mc_status_to_string(mc_status), mc_status);
-			if (error == 0)
-				error = error2;
-		}
-	}
-
-	return error;
+	return 0;
 }
 
-static int parse_dpdcei(FILE *fp, struct obj_list *curr)
+static int write_dpdcei_attr(FILE *fp, uint16_t dpdcei_handle,
+			     struct dpl_obj *curr)
 {
 	/* dpdcei_attr{} does not have a field called priority */
-	uint16_t dpdcei_handle;
 	int error;
 	struct dpdcei_attr dpdcei_attr;
-	bool dpdcei_opened = false;
-
-	error = dpdcei_open(&restool.mc_io, 0, curr->id, &dpdcei_handle);
-	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
-		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
-		goto out;
-	}
-	dpdcei_opened = true;
-	if (0 == dpdcei_handle) {
-		DEBUG_PRINTF(
-			"dpdcei_open() returned invalid handle (auth 0) for dpdcei.%u\n",
-			curr->id);
-		error = -ENOENT;
-		goto out;
-	}
 
 	memset(&dpdcei_attr, 0, sizeof(dpdcei_attr));
 	error = dpdcei_get_attributes(&restool.mc_io, 0, dpdcei_handle,
@@ -845,7 +817,7 @@ static int parse_dpdcei(FILE *fp, struct obj_list *curr)
 		mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
 			     mc_status_to_string(mc_status), mc_status);
-		goto out;
+		return error;
 	}
 	assert(curr->id == dpdcei_attr.id);
 
@@ -861,47 +833,14 @@ static int parse_dpdcei(FILE *fp, struct obj_list *curr)
 		break;
 	}
 
-	error = 0;
-
-out:
-	if (dpdcei_opened) {
-		int error2;
-
-		error2 = dpdcei_close(&restool.mc_io, 0, dpdcei_handle);
-		if (error2 < 0) {
-			mc_status = flib_error_to_mc_status(error2);
-			ERROR_PRINTF("MC error: %s (status %#x)\n",
-				     mc_status_to_string(mc_status), mc_status);
-			if (error == 0)
-				error = error2;
-		}
-	}
-
-	return error;
+	return 0;
 }
 
-static int parse_dpdmai(FILE *fp, struct obj_list *curr)
+static int write_dpdmai_attr(FILE *fp, uint16_t dpdmai_handle,
+			     struct dpl_obj *curr)
 {
-	uint16_t dpdmai_handle;
 	int error;
 	struct dpdmai_attr dpdmai_attr;
-	bool dpdmai_opened = false;
-
-	error = dpdmai_open(&restool.mc_io, 0, curr->id, &dpdmai_handle);
-	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
-		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
-		goto out;
-	}
-	dpdmai_opened = true;
-	if (0 == dpdmai_handle) {
-		DEBUG_PRINTF(
-			"dpdmai_open() returned invalid handle (auth 0) for dpdmai.%u\n",
-			curr->id);
-		error = -ENOENT;
-		goto out;
-	}
 
 	memset(&dpdmai_attr, 0, sizeof(dpdmai_attr));
 	error = dpdmai_get_attributes(&restool.mc_io, 0, dpdmai_handle,
@@ -910,54 +849,21 @@ static int parse_dpdmai(FILE *fp, struct obj_list *curr)
 		mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
 			     mc_status_to_string(mc_status), mc_status);
-		goto out;
+		return error;
 	}
 	assert(curr->id == dpdmai_attr.id);
 
 	fprintf(fp, "\t\t\tpriorities = <%#x>;\n",
 		dpdmai_attr.num_of_priorities);
 
-	error = 0;
-
-out:
-	if (dpdmai_opened) {
-		int error2;
-
-		error2 = dpdmai_close(&restool.mc_io, 0, dpdmai_handle);
-		if (error2 < 0) {
-			mc_status = flib_error_to_mc_status(error2);
-			ERROR_PRINTF("MC error: %s (status %#x)\n",
-				     mc_status_to_string(mc_status), mc_status);
-			if (error == 0)
-				error = error2;
-		}
-	}
-
-	return error;
+	return 0;
 }
 
-static int parse_dpio(FILE *fp, struct obj_list *curr)
+static int write_dpio_attr(FILE *fp, uint16_t dpio_handle,
+			   struct dpl_obj *curr)
 {
-	uint16_t dpio_handle;
 	int error;
 	struct dpio_attr dpio_attr;
-	bool dpio_opened = false;
-
-	error = dpio_open(&restool.mc_io, 0, curr->id, &dpio_handle);
-	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
-		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
-		goto out;
-	}
-	dpio_opened = true;
-	if (0 == dpio_handle) {
-		DEBUG_PRINTF(
-			"dpio_open() returned invalid handle (auth 0) for dpio.%u\n",
-			curr->id);
-		error = -ENOENT;
-		goto out;
-	}
 
 	memset(&dpio_attr, 0, sizeof(dpio_attr));
 	error = dpio_get_attributes(&restool.mc_io, 0, dpio_handle, &dpio_attr);
@@ -965,7 +871,7 @@ static int parse_dpio(FILE *fp, struct obj_list *curr)
 		mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
 			     mc_status_to_string(mc_status), mc_status);
-		goto out;
+		return error;
 	}
 	assert(curr->id == dpio_attr.id);
 
@@ -976,49 +882,17 @@ static int parse_dpio(FILE *fp, struct obj_list *curr)
 	fprintf(fp, "\t\t\tnum_priorities = <%#x>;\n",
 	       (unsigned int)dpio_attr.num_priorities);
 
-	error = 0;
-
-out:
-	if (dpio_opened) {
-		int error2;
-
-		error2 = dpio_close(&restool.mc_io, 0, dpio_handle);
-		if (error2 < 0) {
-			mc_status = flib_error_to_mc_status(error2);
-			ERROR_PRINTF("MC error: %s (status %#x)\n",
-				     mc_status_to_string(mc_status), mc_status);
-			if (error == 0)
-				error = error2;
-		}
-	}
-
-	return error;
+	return 0;
 }
 
-static int parse_dpseci(FILE *fp, struct obj_list *curr)
+static int write_dpseci_attr(FILE *fp, uint16_t dpseci_handle,
+			     struct dpl_obj *curr)
 {
 	int error;
-	uint16_t dpseci_handle;
-	bool dpseci_opened = false;
 	struct dpseci_attr dpseci_attr;
 	struct dpseci_tx_queue_attr tx_attr;
 	char *priorities;
 
-	error = dpseci_open(&restool.mc_io, 0, curr->id, &dpseci_handle);
-	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
-		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
-		goto out;
-	}
-	dpseci_opened = true;
-	if (0 == dpseci_handle) {
-		DEBUG_PRINTF(
-			"dpseci_open() returned invalid handle (auth 0) for dpseci.%u\n",
-			curr->id);
-		error = -ENOENT;
-		goto out;
-	}
 	memset(&tx_attr, 0, sizeof(tx_attr));
 	memset(&dpseci_attr, 0, sizeof(dpseci_attr));
 
@@ -1028,14 +902,14 @@ static int parse_dpseci(FILE *fp, struct obj_list *curr)
 		mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
 			     mc_status_to_string(mc_status), mc_status);
-		goto out;
+		return error;
 	}
+	assert(curr->id == dpseci_attr.id);
 
 	priorities = malloc(dpseci_attr.num_tx_queues * sizeof(*priorities));
 	if (priorities == NULL) {
 		ERROR_PRINTF("malloc failed\n");
-		error = -errno;
-		goto out;
+		return -ENOMEM;
 	}
 
 	for (int i = 0; i < dpseci_attr.num_tx_queues; i++) {
@@ -1047,7 +921,7 @@ static int parse_dpseci(FILE *fp, struct obj_list *curr)
 			ERROR_PRINTF("MC error: %s (status %#x)\n",
 				     mc_status_to_string(mc_status), mc_status);
 			free(priorities);
-			goto out;
+			return error;
 		}
 
 		priorities[i] = tx_attr.priority;
@@ -1058,51 +932,20 @@ static int parse_dpseci(FILE *fp, struct obj_list *curr)
 
 	fprintf(fp, "%d>;\n", priorities[dpseci_attr.num_tx_queues-1]);
 
-	free(priorities);
-
-
-out:
-	if (dpseci_opened) {
-		int error2;
+	free(priorities);
 
-		error2 = dpseci_close(&restool.mc_io, 0, dpseci_handle);
-		if (error2 < 0) {
-			mc_status = flib_error_to_mc_status(error2);
-			ERROR_PRINTF("MC error: %s (status %#x)\n",
-				mc_status_to_string(mc_status), mc_status);
-			if (error == 0)
-				error = error2;
-		}
-	}
 	return 0;
 }
 
 /* following objects have possible connections*/
-static int parse_dpci(FILE *fp, struct obj_list *curr)
+static int write_dpci_attr(FILE *fp, uint16_t dpci_handle,
+			   struct dpl_obj *curr)
 {
-	uint16_t dpci_handle;
 	int error;
 	struct dpci_attr dpci_attr;
 	struct dpci_peer_attr dpci_peer_attr;
-	bool dpci_opened = false;
-	struct conn_list *curr_conn;
-
+	struct dpl_conn curr_conn;
 
-	error = dpci_open(&restool.mc_io, 0, curr->id, &dpci_handle);
-	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
-		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
-		goto out;
-	}
-	dpci_opened = true;
-	if (0 == dpci_handle) {
-		DEBUG_PRINTF(
-			"dpci_open() returned invalid handle (auth 0) for dpci.%u\n",
-			curr->id);
-		error = -ENOENT;
-		goto out;
-	}
 
 	memset(&dpci_attr, 0, sizeof(dpci_attr));
 	error = dpci_get_attributes(&restool.mc_io, 0, dpci_handle, &dpci_attr);
@@ -1110,7 +953,7 @@ static int parse_dpci(FILE *fp, struct obj_list *curr)
 		mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
 			     mc_status_to_string(mc_status), mc_status);
-		goto out;
+		return error;
 	}
 	assert(curr->id == dpci_attr.id);
 
@@ -1120,7 +963,7 @@ static int parse_dpci(FILE *fp, struct obj_list *curr)
 		mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
 			     mc_status_to_string(mc_status), mc_status);
-		goto out;
+		return error;
 	}
 
 	fprintf(fp, "\t\t\tnum_of_priorities = <%#x>;\n",
@@ -1130,49 +973,18 @@ static int parse_dpci(FILE *fp, struct obj_list *curr)
 		DEBUG_PRINTF("no peer\n");
 	} else {
 		/* dpci has connection */
-		curr_conn = malloc(sizeof(struct conn_list));
-		if (curr_conn == NULL) {
-			ERROR_PRINTF("malloc failed\n");
-			error = -errno;
-			goto out;
-		}
-		curr_conn->next = NULL;
-		strcpy(curr_conn->type1, "dpci");
-		strcpy(curr_conn->type2, "dpci");
-		curr_conn->id1 = dpci_attr.id;
-		curr_conn->id2 = dpci_peer_attr.peer_id;
-		curr_conn->if_id1 = -1;	/* -1 means no interface */
-		curr_conn->if_id2 = -1;
-
-		error = compare_insert_connection(&conn_head, curr_conn);
+		strcpy(curr_conn.type1, "dpci");
+		strcpy(curr_conn.type2, "dpci");
+		curr_conn.id1 = dpci_attr.id;
+		curr_conn.id2 = dpci_peer_attr.peer_id;
+		curr_conn.if_id1 = -1;	/* -1 means no interface */
+		curr_conn.if_id2 = -1;
+
+		error = add_connection(&curr_conn);
 		if (error)
-			goto out;
-	}
-
-	error = 0;
-
-out:
-	if (dpci_opened) {
-		int error2;
-
-		error2 = dpci_close(&restool.mc_io, 0, dpci_handle);
-		if (error2 < 0) {
-			mc_status = flib_error_to_mc_status(error2);
-			ERROR_PRINTF("MC error: %s (status %#x)\n",
-				     mc_status_to_string(mc_status), mc_status);
-			if (error == 0)
-				error = error2;
-		}
+			return error;
 	}
 
-	return error;
-}
-
-static int parse_dpmac(FILE *fp, struct obj_list *curr)
-{
-	/* don't have anything in the dpl-example.dts */
-	(void)fp;
-	(void)curr;
 	return 0;
 }
 
@@ -1306,14 +1118,14 @@ static void parse_dpni_options_v10(FILE *fp, uint32_t options)
 	fprintf(fp, "%s\n", buf);
 }
 
-static int parse_endpoint_dpl(struct obj_list *curr_obj, uint16_t num_ifs)
+static int parse_endpoint_dpl(struct dpl_obj *curr_obj, uint16_t num_ifs)
 {
 	struct dprc_endpoint endpoint1;
 	struct dprc_endpoint endpoint2;
 	int state;
 	int error = 0;
 	int k;
-	struct conn_list *curr_conn;
+	struct dpl_conn curr_conn;
 
 	/* dpni though not have interfaces,
 	 * need to have num_ifs > 0,
@@ -1328,11 +1140,7 @@ static int parse_endpoint_dpl(struct obj_list *curr_obj, uint16_t num_ifs)
 		endpoint1.id = curr_obj->id;
 		endpoint1.if_id = k;
 
-		error = dprc_get_connection(&restool.mc_io, 0,
-					restool.root_dprc_handle,
-					&endpoint1,
-					&endpoint2,
-					&state);
+		error = get_connection(&endpoint1, &endpoint2, &state);
 		DEBUG_PRINTF("endpoint state: %d\n", state);
 
 		if (error == 0 && state == -1) {
@@ -1345,62 +1153,46 @@ static int parse_endpoint_dpl(struct obj_list *curr_obj, uint16_t num_ifs)
 					k, endpoint2.type, endpoint2.id,
 					endpoint2.if_id);
 
-				curr_conn = malloc(sizeof(struct conn_list));
-				if (curr_conn == NULL) {
-					ERROR_PRINTF("malloc failed\n");
-					error = -errno;
-					return error;
-				}
-				curr_conn->next = NULL;
-				strncpy(curr_conn->type1, endpoint1.type,
+				strncpy(curr_conn.type1, endpoint1.type,
 					EP_OBJ_TYPE_MAX_LEN);
-				strncpy(curr_conn->type2, endpoint2.type,
+				strncpy(curr_conn.type2, endpoint2.type,
 					EP_OBJ_TYPE_MAX_LEN);
-				curr_conn->type1[EP_OBJ_TYPE_MAX_LEN] = '\0';
-				curr_conn->type2[EP_OBJ_TYPE_MAX_LEN] = '\0';
-				curr_conn->id1 = endpoint1.id;
-				curr_conn->id2 = endpoint2.id;
+				curr_conn.type1[EP_OBJ_TYPE_MAX_LEN] = '\0';
+				curr_conn.type2[EP_OBJ_TYPE_MAX_LEN] = '\0';
+				curr_conn.id1 = endpoint1.id;
+				curr_conn.id2 = endpoint2.id;
 				if (strcmp(curr_obj->type, "dpni") == 0)
-					curr_conn->if_id1 = -1;
+					curr_conn.if_id1 = -1;
 					/* -1 means no interface */
 				else
-					curr_conn->if_id1 = endpoint1.if_id;
+					curr_conn.if_id1 = endpoint1.if_id;
 
-				curr_conn->if_id2 = endpoint2.if_id;
+				curr_conn.if_id2 = endpoint2.if_id;
 
-				error = compare_insert_connection(&conn_head,
-								  curr_conn);
+				error = add_connection(&curr_conn);
 				if (error)
 					return error;
 			} else if (endpoint2.if_id == 0) {
 				DEBUG_PRINTF("\tinterface %d: %s.%d",
 					k, endpoint2.type, endpoint2.id);
 
-				curr_conn = malloc(sizeof(struct conn_list));
-				if (curr_conn == NULL) {
-					ERROR_PRINTF("malloc failed\n");
-					error = -errno;
-					return error;
-				}
-				curr_conn->next = NULL;
-				strncpy(curr_conn->type1, endpoint1.type,
+				strncpy(curr_conn.type1, endpoint1.type,
 					EP_OBJ_TYPE_MAX_LEN);
-				strncpy(curr_conn->type2, endpoint2.type,
+				strncpy(curr_conn.type2, endpoint2.type,
 					EP_OBJ_TYPE_MAX_LEN);
-				curr_conn->type1[EP_OBJ_TYPE_MAX_LEN] = '\0';
-				curr_conn->type2[EP_OBJ_TYPE_MAX_LEN] = '\0';
-				curr_conn->id1 = endpoint1.id;
-				curr_conn->id2 = endpoint2.id;
+				curr_conn.type1[EP_OBJ_TYPE_MAX_LEN] = '\0';
+				curr_conn.type2[EP_OBJ_TYPE_MAX_LEN] = '\0';
+				curr_conn.id1 = endpoint1.id;
+				curr_conn.id2 = endpoint2.id;
 				if (strcmp(curr_obj->type, "dpni") == 0)
-					curr_conn->if_id1 = -1;
+					curr_conn.if_id1 = -1;
 					/* -1 means no interface */
 				else
-					curr_conn->if_id1 = endpoint1.if_id;
+					curr_conn.if_id1 = endpoint1.if_id;
 
-				curr_conn->if_id2 = -1;
+				curr_conn.if_id2 = -1;
 
-				error = compare_insert_connection(&conn_head,
-								  curr_conn);
+				error = add_connection(&curr_conn);
 				if (error)
 					return error;
 			}
@@ -1426,34 +1218,17 @@ static int parse_endpoint_dpl(struct obj_list *curr_obj, uint16_t num_ifs)
 	return 0;
 }
 
-static int parse_dpni_v9(FILE *fp, struct obj_list *curr)
+static int write_dpni_v9_attr(FILE *fp, uint16_t dpni_handle,
+			      struct dpl_obj *curr)
 {
-	uint16_t dpni_handle;
 	int error;
 	struct dpni_attr_v9 dpni_attr;
 	uint8_t mac_addr[6];
-	bool dpni_opened = false;
 	struct dpni_extended_cfg dpni_extended_cfg;
 
 	memset(&dpni_extended_cfg, 0, sizeof(dpni_extended_cfg));
 	memset(&dpni_attr, 0, sizeof(dpni_attr));
 
-	error = dpni_open(&restool.mc_io, 0, curr->id, &dpni_handle);
-	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
-		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
-		goto out;
-	}
-	dpni_opened = true;
-	if (0 == dpni_handle) {
-		DEBUG_PRINTF(
-			"dpni_open() returned invalid handle (auth 0) for dpni.%u\n",
-			curr->id);
-		error = -ENOENT;
-		goto out;
-	}
-
 	error = dpni_get_attributes_v9(&restool.mc_io, 0, dpni_handle,
 				       &dpni_attr, &dpni_extended_cfg);
 
@@ -1461,7 +1236,7 @@ static int parse_dpni_v9(FILE *fp, struct obj_list *curr)
 		mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
 			     mc_status_to_string(mc_status), mc_status);
-		goto out;
+		return error;
 	}
 
 	assert(curr->id == dpni_attr.id);
@@ -1473,7 +1248,7 @@ static int parse_dpni_v9(FILE *fp, struct obj_list *curr)
 		mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
 			     mc_status_to_string(mc_status), mc_status);
-		goto out;
+		return error;
 	}
 
 	parse_endpoint_dpl(curr, 1000);
@@ -1545,48 +1320,14 @@ static int parse_dpni_v9(FILE *fp, struct obj_list *curr)
 	fprintf(fp, "\t\t\tmax_open_frames_ipv6 = <%#x>;\n",
 		(uint32_t)dpni_extended_cfg.ipr_cfg.max_open_frames_ipv6);
 
-	error = 0;
-
-out:
-	if (dpni_opened) {
-		int error2;
-
-		error2 = dpni_close(&restool.mc_io, 0, dpni_handle);
-		if (error2 < 0) {
-			mc_status = flib_error_to_mc_status(error2);
-			ERROR_PRINTF("MC error: %s (status %#x)\n",
-				     mc_status_to_string(mc_status), mc_status);
-			if (error == 0)
-				error = error2;
-		}
-	}
-
-	return error;
+	return 0;
 }
 
-static int parse_dpni_v10(FILE *fp, struct obj_list *curr)
+static int write_dpni_v10_attr(FILE *fp, uint16_t dpni_handle,
+			       struct dpl_obj *curr)
 {
 	struct dpni_attr_v10 dpni_attr;
-	uint16_t dpni_handle;
-	bool dpni_opened = false;
-	int error = 0;
-	int error2;
-
-	error = dpni_open(&restool.mc_io, 0, curr->id, &dpni_handle);
-	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
-		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
-		goto out;
-	}
-	dpni_opened = true;
-	if (0 == dpni_handle) {
-		DEBUG_PRINTF(
-			"dpni_open() returned invalid handle (auth 0) for dpni.%u\n",
-			curr->id);
-		error = -ENOENT;
-		goto out;
-	}
+	int error;
 
 	memset(&dpni_attr, 0, sizeof(dpni_attr));
 	error = dpni_get_attributes_v10(&restool.mc_io, 0,
@@ -1595,7 +1336,7 @@ static int parse_dpni_v10(FILE *fp, struct obj_list *curr)
 		mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
 			     mc_status_to_string(mc_status), mc_status);
-		goto out;
+		return error;
 	}
 
 	parse_endpoint_dpl(curr, 1000);
@@ -1611,20 +1352,7 @@ static int parse_dpni_v10(FILE *fp, struct obj_list *curr)
 	fprintf(fp, "\t\t\tfs_entries = <%u>;\n", dpni_attr.fs_entries);
 	fprintf(fp, "\t\t\tqos_entries = <%u>;\n", dpni_attr.qos_entries);
 
-out:
-	if (dpni_opened) {
-
-		error2 = dpni_close(&restool.mc_io, 0, dpni_handle);
-		if (error2 < 0) {
-			mc_status = flib_error_to_mc_status(error2);
-			ERROR_PRINTF("MC error: %s (status %#x)\n",
-				     mc_status_to_string(mc_status), mc_status);
-			if (error == 0)
-				error = error2;
-		}
-	}
-
-	return error;
+	return 0;
 }
 
 static void parse_dpdmux_options(FILE *fp, uint64_t options)
@@ -1701,28 +1429,11 @@ static void parse_dpdmux_manip(FILE *fp, enum dpdmux_manip manip)
 	}
 }
 
-static int parse_dpdmux_v9(FILE *fp, struct obj_list *curr)
+static int write_dpdmux_v9_attr(FILE *fp, uint16_t dpdmux_handle,
+				struct dpl_obj *curr)
 {
-	uint16_t dpdmux_handle;
 	int error;
 	struct dpdmux_attr_v9 dpdmux_attr;
-	bool dpdmux_opened = false;
-
-	error = dpdmux_open(&restool.mc_io, 0, curr->id, &dpdmux_handle);
-	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
-		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
-		goto out;
-	}
-	dpdmux_opened = true;
-	if (0 == dpdmux_handle) {
-		DEBUG_PRINTF(
-			"dpdmux_open() returned invalid handle (auth 0) for dpdmux.%u\n",
-			curr->id);
-		error = -ENOENT;
-		goto out;
-	}
 
 	memset(&dpdmux_attr, 0, sizeof(dpdmux_attr));
 	error = dpdmux_get_attributes_v9(&restool.mc_io, 0, dpdmux_handle,
@@ -1731,7 +1442,7 @@ static int parse_dpdmux_v9(FILE *fp, struct obj_list *curr)
 		mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
 			     mc_status_to_string(mc_status), mc_status);
-		goto out;
+		return error;
 	}
 	assert(curr->id == dpdmux_attr.id);
 
@@ -1742,24 +1453,7 @@ static int parse_dpdmux_v9(FILE *fp, struct obj_list *curr)
 	fprintf(fp, "\t\t\tnum_ifs = <%#x>;\n",
 		(uint32_t)dpdmux_attr.num_ifs + 1);
 
-	error = 0;
-
-out:
-	if (dpdmux_opened) {
-		int error2;
-
-		error2 = dpdmux_close(&restool.mc_io, 0, dpdmux_handle);
-		if (error2 < 0) {
-			mc_status = flib_error_to_mc_status(error2);
-			ERROR_PRINTF("MC error: %s (status %#x)\n",
-				     mc_status_to_string(mc_status), mc_status);
-			if (error == 0)
-				error = error2;
-		}
-	}
-
-	return error;
-
+	return 0;
 }
 
 static void parse_dpsw_options(FILE *fp, uint64_t options)
@@ -1807,28 +1501,11 @@ static void parse_dpsw_options(FILE *fp, uint64_t options)
 
 }
 
-static int parse_dpsw_v9(FILE *fp, struct obj_list *curr)
+static int write_dpsw_v9_attr(FILE *fp, uint16_t dpsw_handle,
+			      struct dpl_obj *curr)
 {
-	uint16_t dpsw_handle;
 	int error;
 	struct dpsw_attr_v9 dpsw_attr;
-	bool dpsw_opened = false;
-
-	error = dpsw_open(&restool.mc_io, 0, curr->id, &dpsw_handle);
-	if (error < 0) {
-		mc_status = flib_error_to_mc_status(error);
-		ERROR_PRINTF("MC error: %s (status %#x)\n",
-			     mc_status_to_string(mc_status), mc_status);
-		goto out;
-	}
-	dpsw_opened = true;
-	if (0 == dpsw_handle) {
-		DEBUG_PRINTF(
-			"dpsw_open() returned invalid handle (auth 0) for dpsw.%u\n",
-			curr->id);
-		error = -ENOENT;
-		goto out;
-	}
 
 	memset(&dpsw_attr, 0, sizeof(dpsw_attr));
 	error = dpsw_get_attributes_v9(&restool.mc_io, 0, dpsw_handle,
@@ -1837,7 +1514,7 @@ static int parse_dpsw_v9(FILE *fp, struct obj_list *curr)
 		mc_status = flib_error_to_mc_status(error);
 		ERROR_PRINTF("MC error: %s (status %#x)\n",
 			     mc_status_to_string(mc_status), mc_status);
-		goto out;
+		return error;
 	}
 	assert(curr->id == dpsw_attr.id);
 
@@ -1859,123 +1536,126 @@ static int parse_dpsw_v9(FILE *fp, struct obj_list *curr)
 	fprintf(fp, "\t\t\tmax_meters_per_if = <%#x>;\n",
 		(uint32_t)dpsw_attr.max_meters_per_if);
 
-	error = 0;
+	return 0;
+}
 
-out:
-	if (dpsw_opened) {
-		int error2;
+typedef int dpl_write_attr_t(FILE *fp, uint16_t obj_handle,
+			     struct dpl_obj *curr);
 
-		error2 = dpsw_close(&restool.mc_io, 0, dpsw_handle);
-		if (error2 < 0) {
-			mc_status = flib_error_to_mc_status(error2);
-			ERROR_PRINTF("MC error: %s (status %#x)\n",
-				     mc_status_to_string(mc_status), mc_status);
-			if (error == 0)
-				error = error2;
-		}
-	}
+/**
+ * struct dpl_obj_writer - writes the properties of one object type
+ * @write_v9: writer used with MC firmware 9
+ * @write_v10: writer used with MC firmware 10
+ *
+ * Types without a writer only get their compatible property: dpaiop_attr{}
+ * does not have the aiop_container_id field and dpbp, dpdbg, dpmac, dpmcp,
+ * dprc and dprtc have nothing to describe in a DPL.
+ */
+struct dpl_obj_writer {
+	dpl_write_attr_t *write_v9;
+	dpl_write_attr_t *write_v10;
+};
 
-	return error;
+static const struct dpl_obj_writer dpl_obj_writers[NUM_OBJ_TYPES] = {
+	[OBJ_TYPE_DPCI] = { write_dpci_attr, write_dpci_attr },
+	[OBJ_TYPE_DPCON] = { write_dpcon_attr, write_dpcon_attr },
+	[OBJ_TYPE_DPDCEI] = { write_dpdcei_attr, write_dpdcei_attr },
+	[OBJ_TYPE_DPDMAI] = { write_dpdmai_attr, write_dpdmai_attr },
+	[OBJ_TYPE_DPDMUX] = { write_dpdmux_v9_attr, write_dpdmux_v9_attr },
+	[OBJ_TYPE_DPIO] = { write_dpio_attr, write_dpio_attr },
+	[OBJ_TYPE_DPNI] = { write_dpni_v9_attr, write_dpni_v10_attr },
+	[OBJ_TYPE_DPSECI] = { write_dpseci_attr, write_dpseci_attr },
+	[OBJ_TYPE_DPSW] = { write_dpsw_v9_attr, write_dpsw_v9_attr },
+};
+
+static dpl_write_attr_t *get_obj_writer(int type_id)
+{
+	if (type_id < 0)
+		return NULL;
+
+	if (restool.mc_fw_version.major == MC_FW_VERSION_9)
+		return dpl_obj_writers[type_id].write_v9;
+	if (restool.mc_fw_version.major == MC_FW_VERSION_10)
+		return dpl_obj_writers[type_id].write_v10;
+
+	return NULL;
 }
 
-static int write_objects(void)
+static int write_object(FILE *fp, int type_id, dpl_write_attr_t *write_attr,
+			struct dpl_obj *curr_obj)
 {
-	struct obj_list *curr_obj;
-	FILE *fp = stdout;
+	uint16_t obj_handle;
+	int error = 0;
+	int error2;
 
 	fprintf(fp, "\n");
-	fprintf(fp,
-		"\t/*****************************************************************\n");
-	fprintf(fp, "\t * Objects\n");
-	fprintf(fp,
-		"\t *****************************************************************/\n");
+	fprintf(fp, "\t\t%s@%d {\n", curr_obj->type, curr_obj->id);
+	fprintf(fp, "\t\t\tcompatible = \"fsl,%s\";\n", curr_obj->type);
 
+	if (write_attr != NULL) {
+		error = open_obj(type_id, curr_obj->id, &obj_handle);
+		if (error < 0)
+			return error;
 
-	fprintf(fp, "\tobjects {\n");
-	curr_obj = obj_head;
-	while (curr_obj) {
-		if (strcmp(curr_obj->type, "dpmcp") == 0 && 0 == curr_obj->id) {
-			curr_obj = curr_obj->next;
-			continue;
-		}
+		error = write_attr(fp, obj_handle, curr_obj);
+		error2 = close_obj(type_id, obj_handle);
+		if (error == 0)
+			error = error2;
+		if (error < 0)
+			return error;
+	}
 
-		fprintf(fp, "\n");
-		fprintf(fp, "\t\t%s@%d {\n", curr_obj->type, curr_obj->id);
-		fprintf(fp, "\t\t\tcompatible = \"fsl,%s\";\n", curr_obj->type);
-
-		/* objects don't need to be parsed and get attributes for now */
-		if (strcmp(curr_obj->type, "dpbp") == 0)
-			parse_dpbp(fp, curr_obj);
-		if (strcmp(curr_obj->type, "dpdbg") == 0)
-			parse_dpdbg(fp, curr_obj);
-		if (strcmp(curr_obj->type, "dpmcp") == 0)
-			parse_dpmcp(fp, curr_obj);
-		if (strcmp(curr_obj->type, "dprc") == 0)
-			parse_dprc(fp, curr_obj);
-		if (strcmp(curr_obj->type, "dprtc") == 0)
-			parse_dprtc(fp, curr_obj);
-
-		/* objects need to be parsed and get attributes */
-		if (strcmp(curr_obj->type, "dpaiop") == 0)
-			parse_dpaiop(fp, curr_obj);
-
-		if (strcmp(curr_obj->type, "dpcon") == 0)
-			parse_dpcon(fp, curr_obj);
-
-		if (strcmp(curr_obj->type, "dpdcei") == 0)
-			parse_dpdcei(fp, curr_obj);
-
-		if (strcmp(curr_obj->type, "dpdmai") == 0)
-			parse_dpdmai(fp, curr_obj);
-
-		if (strcmp(curr_obj->type, "dpio") == 0)
-			parse_dpio(fp, curr_obj);
-
-		if (strcmp(curr_obj->type, "dpseci") == 0)
-			parse_dpseci(fp, curr_obj);
-
-		/* following objects have possible connections */
-		if (strcmp(curr_obj->type, "dpci") == 0)
-			parse_dpci(fp, curr_obj);
-
-		if (strcmp(curr_obj->type, "dpmac") == 0)
-			parse_dpmac(fp, curr_obj);
-			/* dpmac do not need to be parsed now */
-
-		if (strcmp(curr_obj->type, "dpni") == 0) {
-			if (restool.mc_fw_version.major == 9)
-				parse_dpni_v9(fp, curr_obj);
-			else if (restool.mc_fw_version.major == 10)
-				parse_dpni_v10(fp, curr_obj);
-		}
+	fprintf(fp, "\t\t};\n");
+	return 0;
+}
+
+/**
+ * write_container_objects - container walk visitor writing the nodes of
+ *			     the objects of the container in the objects
+ *			     section, the connections found on the way are
+ *			     kept for the connections section. Fails if the
+ *			     container changed since the containers section.
+ */
+static int write_container_objects(FILE *fp, uint32_t dprc_id,
+				   uint16_t dprc_handle, uint32_t parent_id,
+				   struct dpl_obj *objs, int num_objs)
+{
+	dpl_write_attr_t *write_attr = NULL;
+	int type_id = -EINVAL;
+	int error;
 
+	(void)dprc_handle;
+	(void)parent_id;
 
-		/* following objects have possible connections and interface*/
-		if (strcmp(curr_obj->type, "dpdmux") == 0) {
-			if (restool.mc_fw_version.major == 9 ||
-			    restool.mc_fw_version.major == 10)
-				parse_dpdmux_v9(fp, curr_obj);
-		}
+	error = check_container_sum(dprc_id, objs, num_objs);
+	if (error < 0)
+		return error;
 
-		if (strcmp(curr_obj->type, "dpsw") == 0) {
-			if (restool.mc_fw_version.major == 9 ||
-			    restool.mc_fw_version.major == 10)
-				parse_dpsw_v9(fp, curr_obj);
+	for (int i = 0; i < num_objs; i++) {
+		/* objects are sorted by type, look the writer up once per type */
+		if (i == 0 || strcmp(objs[i].type, objs[i - 1].type) != 0) {
+			type_id = get_obj_type_id(objs[i].type);
+			write_attr = get_obj_writer(type_id);
 		}
 
-		fprintf(fp, "\t\t};\n");
-		curr_obj = curr_obj->next;
+		if (strcmp(objs[i].type, "dpmcp") == 0 && 0 == objs[i].id)
+			continue;
+
+		error = write_object(fp, type_id, write_attr, &objs[i]);
+		if (error < 0) {
+			ERROR_PRINTF("writing %s.%d failed, error=%d\n",
+				     objs[i].type, objs[i].id, error);
+			return error;
+		}
 	}
-	fprintf(fp, "\t};\n");
 
 	return 0;
 }
 
-static int write_connections(void)
+static int write_connections(FILE *fp)
 {
-	struct conn_list *curr_conn;
+	struct dpl_conn *curr_conn;
 	int conn_num = 1;
-	FILE *fp = stdout;
 
 	fprintf(fp, "\n");
 	fprintf(fp,
@@ -1985,8 +1665,8 @@ static int write_connections(void)
 		"\t *****************************************************************/\n");
 
 	fprintf(fp, "\tconnections {\n");
-	curr_conn = conn_head;
-	while (curr_conn) {
+	for (int i = 0; i < num_conns; i++) {
+		curr_conn = &conns[i];
 		fprintf(fp, "\n");
 		fprintf(fp, "\t\tconnection@%d{\n", conn_num);
 		if (curr_conn->if_id1 < 0)
@@ -2005,7 +1685,6 @@ static int write_connections(void)
 				curr_conn->if_id2);
 
 		fprintf(fp, "\t\t};\n");
-		curr_conn = curr_conn->next;
 		conn_num++;
 	}
 	fprintf(fp, "\t};\n");
@@ -2013,90 +1692,59 @@ static int write_connections(void)
 	return 0;
 }
 
-static void delete_all_list(void)
-{
-	struct container_list *curr_cont;
-	struct container_list *tmp_cont;
-	struct obj_list *curr_obj;
-	struct obj_list *tmp_obj;
-	struct conn_list *curr_conn;
-	struct conn_list *tmp_conn;
-
-	curr_cont = container_head;
-	curr_obj = obj_head;
-	curr_conn = conn_head;
-
-	/* delete global object lists */
-	while (curr_obj) {
-		tmp_obj = curr_obj;
-		curr_obj = curr_obj->next;
-		free(tmp_obj);
-	}
-	obj_head = NULL;
-
-	/* delete global connection lists */
-	while (curr_conn) {
-		tmp_conn = curr_conn;
-		curr_conn = curr_conn->next;
-		free(tmp_conn);
-	}
-	conn_head = NULL;
-
-	/* delete global container lists */
-	while (curr_cont) {
-		tmp_cont = curr_cont;
-		curr_cont = curr_cont->next;
-
-		/* delete the associated object lists whithin each container */
-		curr_obj = tmp_cont->obj;
-		while (curr_obj) {
-			tmp_obj = curr_obj;
-			curr_obj = curr_obj->next;
-			free(tmp_obj);
-		}
-		tmp_cont->obj = NULL;
-
-		free(tmp_cont);
-	}
-	container_head = NULL;
-}
-
-int dpl_generate(void)
+/**
+ * write_layout - write the DPL of a container and of its descendants
+ * @fp: output stream
+ * @dprc_id: container to describe
+ * @dprc_handle: open handle of @dprc_id
+ *
+ * The DPL lists every container before any object, so the containers are
+ * walked once per section rather than keeping the objects in memory. The
+ * objects walk checks each container against what the containers walk
+ * saw of it, so that the two sections cannot disagree.
+ */
+static int write_layout(FILE *fp, uint32_t dprc_id, uint16_t dprc_handle)
 {
 	int error;
-	uint32_t dprc_id = 0;
-
-	if (restool.obj_name != NULL) {
-		error = parse_object_name(restool.obj_name, "dprc", &dprc_id);
-		if (error < 0)
-			return error;
-	}
-
-	FILE *fp = stdout;
 
 	fprintf(fp, "/dts-v1/;\n");
 	fprintf(fp, "/ {\n");
 	fprintf(fp, "\tdpl-version = <%d>;\n", restool.mc_fw_version.major);
 
-	error = parse_layout(dprc_id);
-	if (error) {
-		ERROR_PRINTF("parse_layout() failed, error=%d\n", error);
-		return error;
-	}
+	fprintf(fp,
+		"\t/*****************************************************************\n");
+	fprintf(fp, "\t * Containers\n");
+	fprintf(fp,
+		"\t *****************************************************************/\n");
 
-	error = write_containers();
+	fprintf(fp, "\tcontainers {\n");
+	error = walk_containers(fp, dprc_id, dprc_handle, 0, 0,
+				write_container);
 	if (error) {
-		ERROR_PRINTF("write_containers() failed, error=%d\n", error);
+		ERROR_PRINTF("write_container() failed, error=%d\n", error);
 		return error;
 	}
+	fprintf(fp, "\t};\n");
+
+	fprintf(fp, "\n");
+	fprintf(fp,
+		"\t/*****************************************************************\n");
+	fprintf(fp, "\t * Objects\n");
+	fprintf(fp,
+		"\t *****************************************************************/\n");
 
-	error = write_objects();
+
+	fprintf(fp, "\tobjects {\n");
+	error = walk_containers(fp, dprc_id, dprc_handle, 0, 0,
+				write_container_objects);
 	if (error) {
-		ERROR_PRINTF("write_objects() failed, error=%d\n", error);
+		ERROR_PRINTF("write_container_objects() failed, error=%d\n",
+			     error);
 		return error;
 	}
+	fprintf(fp, "\t};\n");
 
-	error = write_connections();
+	error = write_connections(fp);
 	if (error) {
 		ERROR_PRINTF("write_connections() failed, error=%d\n", error);
 		return error;
@@ -2104,7 +1752,77 @@ int dpl_generate(void)
 
 	fprintf(fp, "};\n");
 
-	delete_all_list();
-
 	return 0;
 }
+
+int dpl_generate(const char *output_file)
+{
+	uint16_t dprc_handle;
+	uint32_t dprc_id = 0;
+	bool opened = false;
+	FILE *fp = stdout;
+	int error, error2;
+
+	if (restool.obj_name != NULL) {
+		error = parse_object_name(restool.obj_name, "dprc", &dprc_id);
+		if (error < 0)
+			return error;
+	}
+
+	/* if no dprc specified, use root dprc */
+	if (dprc_id == 0 || dprc_id == restool.root_dprc_id) {
+		dprc_id = restool.root_dprc_id;
+		dprc_handle = restool.root_dprc_handle;
+	} else {
+		error = open_dprc(dprc_id, &dprc_handle);
+		if (error < 0)
+			return error;
+		opened = true;
+	}
+
+	if (output_file != NULL) {
+		fp = fopen(output_file, "w");
+		if (fp == NULL) {
+			error = -errno;
+			ERROR_PRINTF("fopen(%s) failed: %s\n", output_file,
+				     strerror(errno));
+			goto close_dprc;
+		}
+	}
+
+	/* the layout is written in small pieces, flush it in large ones */
+	setvbuf(fp, NULL, _IOFBF, DPL_OUTPUT_BUFFER_SIZE);
+
+	error = write_layout(fp, dprc_id, dprc_handle);
+	if (error == 0 && ferror(fp)) {
+		ERROR_PRINTF("writing the DPL failed\n");
+		error = -EIO;
+	}
+
+	if (fp != stdout) {
+		if (fclose(fp) != 0 && error == 0) {
+			error = -errno;
+			ERROR_PRINTF("fclose(%s) failed: %s\n", output_file,
+				     strerror(errno));
+		}
+		if (error)
+			(void)unlink(output_file);
+	} else {
+		fflush(fp);
+	}
+
+	dpl_free();
+close_dprc:
+	if (opened) {
+		error2 = dprc_close(&restool.mc_io, 0, dprc_handle);
+		if (error2 < 0) {
+			mc_status = flib_error_to_mc_status(error2);
+			ERROR_PRINTF("MC error: %s (status %#x)\n",
+				     mc_status_to_string(mc_status), mc_status);
+			if (error == 0)
+				error = error2;
+		}
+	}
+
+	return error;
+}
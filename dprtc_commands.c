@@ -120,7 +120,7 @@ static struct option dprtc_destroy_options[] = {
 
 C_ASSERT(ARRAY_SIZE(dprtc_destroy_options) <= MAX_NUM_CMD_LINE_OPTIONS + 1);
 
-static const struct flib_ops dprtc_ops = {
+const struct flib_ops dprtc_ops = {
 	.obj_open = dprtc_open,
 	.obj_close = dprtc_close,
 	.obj_get_irq_mask = dprtc_get_irq_mask,
@@ -302,7 +302,7 @@ static int print_dprtc_info(uint32_t dprtc_id, int mc_fw_version)
 
 	if (restool.cmd_option_mask & ONE_BIT_MASK(INFO_OPT_VERBOSE)) {
 		restool.cmd_option_mask &= ~ONE_BIT_MASK(INFO_OPT_VERBOSE);
-		error = print_obj_verbose(&target_obj_desc, &dprtc_ops);
+		error = print_obj_verbose(&target_obj_desc);
 	}
 
 out:
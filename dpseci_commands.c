@@ -145,7 +145,7 @@ static struct option dpseci_destroy_options[] = {
 
 C_ASSERT(ARRAY_SIZE(dpseci_destroy_options) <= MAX_NUM_CMD_LINE_OPTIONS + 1);
 
-static const struct flib_ops dpseci_ops = {
+const struct flib_ops dpseci_ops = {
 	.obj_open = dpseci_open,
 	.obj_close = dpseci_close,
 	.obj_get_irq_mask = dpseci_get_irq_mask,
@@ -404,7 +404,7 @@ static int print_dpseci_info(uint32_t dpseci_id, int mc_fw_version)
 
 	if (restool.cmd_option_mask & ONE_BIT_MASK(INFO_OPT_VERBOSE)) {
 		restool.cmd_option_mask &= ~ONE_BIT_MASK(INFO_OPT_VERBOSE);
-		error = print_obj_verbose(&target_obj_desc, &dpseci_ops);
+		error = print_obj_verbose(&target_obj_desc);
 	}
 
 out:
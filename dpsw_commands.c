@@ -37,6 +37,7 @@
 #include <errno.h>
 #include <assert.h>
 #include <getopt.h>
+#include <unistd.h>
 #include <sys/ioctl.h>
 #include "restool.h"
 #include "utils.h"
@@ -184,7 +185,111 @@ static struct option dpsw_destroy_options[] = {
 
 C_ASSERT(ARRAY_SIZE(dpsw_destroy_options) <= MAX_NUM_CMD_LINE_OPTIONS + 1);
 
-static const struct flib_ops dpsw_ops = {
+/**
+ * dpsw fdb-dump, fdb-add, fdb-del and fdb-load command options
+ */
+enum dpsw_fdb_options {
+	FDB_OPT_HELP = 0,
+	FDB_OPT_FDB_ID,
+	FDB_OPT_MAC_ADDR,
+	FDB_OPT_IF,
+	FDB_OPT_FILE,
+};
+
+static struct option dpsw_fdb_options[] = {
+	[FDB_OPT_HELP] = {
+		.name = "help",
+		.has_arg = 0,
+		.flag = NULL,
+		.val = 0,
+	},
+
+	[FDB_OPT_FDB_ID] = {
+		.name = "fdb",
+		.has_arg = 1,
+		.flag = NULL,
+		.val = 0,
+	},
+
+	[FDB_OPT_MAC_ADDR] = {
+		.name = "mac-addr",
+		.has_arg = 1,
+		.flag = NULL,
+		.val = 0,
+	},
+
+	[FDB_OPT_IF] = {
+		.name = "if",
+		.has_arg = 1,
+		.flag = NULL,
+		.val = 0,
+	},
+
+	[FDB_OPT_FILE] = {
+		.name = "file",
+		.has_arg = 1,
+		.flag = NULL,
+		.val = 0,
+	},
+
+	{ 0 },
+};
+
+C_ASSERT(ARRAY_SIZE(dpsw_fdb_options) <= MAX_NUM_CMD_LINE_OPTIONS + 1);
+
+/**
+ * dpsw vlan-add, vlan-del and vlan-show command options
+ */
+enum dpsw_vlan_options {
+	VLAN_OPT_HELP = 0,
+	VLAN_OPT_VLANS,
+	VLAN_OPT_IF,
+	VLAN_OPT_UNTAGGED,
+	VLAN_OPT_FDB_ID,
+};
+
+static struct option dpsw_vlan_options[] = {
+	[VLAN_OPT_HELP] = {
+		.name = "help",
+		.has_arg = 0,
+		.flag = NULL,
+		.val = 0,
+	},
+
+	[VLAN_OPT_VLANS] = {
+		.name = "vlans",
+		.has_arg = 1,
+		.flag = NULL,
+		.val = 0,
+	},
+
+	[VLAN_OPT_IF] = {
+		.name = "if",
+		.has_arg = 1,
+		.flag = NULL,
+		.val = 0,
+	},
+
+	[VLAN_OPT_UNTAGGED] = {
+		.name = "untagged",
+		.has_arg = 0,
+		.flag = NULL,
+		.val = 0,
+	},
+
+	[VLAN_OPT_FDB_ID] = {
+		.name = "fdb",
+		.has_arg = 1,
+		.flag = NULL,
+		.val = 0,
+	},
+
+	{ 0 },
+};
+
+C_ASSERT(ARRAY_SIZE(dpsw_vlan_options) <= MAX_NUM_CMD_LINE_OPTIONS + 1);
+
+const struct flib_ops dpsw_ops = {
 	.obj_open = dpsw_open,
 	.obj_close = dpsw_close,
 	.obj_get_irq_mask = dpsw_get_irq_mask,
@@ -209,6 +314,14 @@ static int cmd_dpsw_help(void)
 		"   info - displays detailed information about a DPSW object.\n"
 		"   create - creates a new child DPSW under the root DPRC.\n"
 		"   destroy - destroys a child DPSW under the root DPRC.\n"
+		"   fdb-dump - displays the entries of a DPSW FDB.\n"
+		"   fdb-add - adds a static entry to a DPSW FDB.\n"
+		"   fdb-del - removes a static entry from a DPSW FDB.\n"
+		"   fdb-load - adds the static entries listed in a file to a DPSW FDB.\n"
+		"   vlan-add - adds VLANs and/or interfaces to VLANs of a DPSW.\n"
+		"   vlan-del - removes VLANs and/or interfaces from VLANs of a DPSW.\n"
+		"   vlan-show - displays the VLAN membership of the DPSW interfaces.\n"
+		"   The fdb-* and vlan-* commands need MC 10.x.\n"
 		"\n"
 		"For command-specific help, use the --help option of each command.\n"
 		"\n";
@@ -257,11 +370,7 @@ static int print_dpsw_endpoint(uint32_t target_id, uint16_t num_ifs)
 		endpoint1.id = target_id;
 		endpoint1.if_id = k;
 
-		error = dprc_get_connection(&restool.mc_io, 0,
-					restool.root_dprc_handle,
-					&endpoint1,
-					&endpoint2,
-					&state);
+		error = get_connection(&endpoint1, &endpoint2, &state);
 		printf("interface %d:\n", k);
 		if (error == 0 && state == -1) {
 			printf("\tconnection: none\n");
@@ -474,7 +583,7 @@ static int print_dpsw_info(uint32_t dpsw_id, int mc_fw_version)
 
 	if (restool.cmd_option_mask & ONE_BIT_MASK(INFO_OPT_VERBOSE)) {
 		restool.cmd_option_mask &= ~ONE_BIT_MASK(INFO_OPT_VERBOSE);
-		error = print_obj_verbose(&target_obj_desc, &dpsw_ops);
+		error = print_obj_verbose(&target_obj_desc);
 	}
 
 out:
@@ -1047,42 +1156,1177 @@ static int cmd_dpsw_destroy_v10(void)
 	return destroy_dpsw(MC_FW_VERSION_10);
 }
 
-struct object_command dpsw_commands_v9[] = {
-	{ .cmd_name = "help",
-	  .options = NULL,
-	  .cmd_func = cmd_dpsw_help },
+/**
+ * Static FDB entry of dpsw fdb-add/fdb-del/fdb-load: a unicast MAC
+ * address goes out of exactly one interface, a multicast one out of a
+ * set of interfaces
+ */
+struct dpsw_fdb_entry {
+	int line;
+	uint8_t mac_addr[6];
+	uint16_t num_ifs;
+	uint16_t if_id[DPSW_MAX_IF];
+};
 
-	{ .cmd_name = "info",
-	  .options = dpsw_info_options,
-	  .cmd_func = cmd_dpsw_info_v9 },
+static bool is_multicast_mac_addr(const uint8_t *mac_addr)
+{
+	return mac_addr[0] & 0x01;
+}
 
-	{ .cmd_name = "create",
-	  .options = dpsw_create_options,
-	  .cmd_func = cmd_dpsw_create_v9 },
+static int parse_dpsw_mac_addr(const char *mac_addr_str, uint8_t *mac_addr)
+{
+	unsigned int bytes[6];
+	char end;
 
-	{ .cmd_name = "destroy",
-	  .options = dpsw_destroy_options,
-	  .cmd_func = cmd_dpsw_destroy_v9 },
+	if (sscanf(mac_addr_str, "%2x:%2x:%2x:%2x:%2x:%2x%c", &bytes[0],
+		   &bytes[1], &bytes[2], &bytes[3], &bytes[4], &bytes[5],
+		   &end) != 6) {
+		ERROR_PRINTF("Invalid MAC address: %s\n", mac_addr_str);
+		return -EINVAL;
+	}
 
-	{ .cmd_name = NULL },
-};
+	for (int i = 0; i < 6; i++)
+		mac_addr[i] = bytes[i];
 
-struct object_command dpsw_commands_v10[] = {
-	{ .cmd_name = "help",
-	  .options = NULL,
-	  .cmd_func = cmd_dpsw_help },
+	return 0;
+}
 
-	{ .cmd_name = "info",
-	  .options = dpsw_info_options,
-	  .cmd_func = cmd_dpsw_info_v10 },
+/*
+ * Comma separated interfaces of the dpsw fdb-* and vlan-* commands
+ */
+static int parse_dpsw_if_list(const char *if_str, uint16_t *if_id,
+			      uint16_t *num_ifs)
+{
+	char *if_list, *if_num, *saveptr, *endptr;
+	int error = 0;
+	long val;
 
-	{ .cmd_name = "create",
-	  .options = dpsw_create_options,
-	  .cmd_func = cmd_dpsw_create_v10 },
+	if_list = strdup(if_str);
+	if (if_list == NULL) {
+		ERROR_PRINTF("strdup() failed\n");
+		return -ENOMEM;
+	}
 
-	{ .cmd_name = "destroy",
-	  .options = dpsw_destroy_options,
-	  .cmd_func = cmd_dpsw_destroy_v10 },
+	*num_ifs = 0;
+	for (if_num = strtok_r(if_list, ",", &saveptr); if_num != NULL;
+	     if_num = strtok_r(NULL, ",", &saveptr)) {
+		errno = 0;
+		val = strtol(if_num, &endptr, 0);
+		if (STRTOL_ERROR(if_num, endptr, val, errno) ||
+		    val < 0 || val >= DPSW_MAX_IF || *num_ifs == DPSW_MAX_IF) {
+			ERROR_PRINTF("Invalid interface: %s\n", if_num);
+			error = -EINVAL;
+			break;
+		}
+		if_id[(*num_ifs)++] = val;
+	}
+
+	free(if_list);
+	if (error == 0 && *num_ifs == 0) {
+		ERROR_PRINTF("Empty interface list\n");
+		error = -EINVAL;
+	}
+
+	return error;
+}
+
+static int parse_dpsw_fdb_entry(const char *mac_addr_str, const char *if_str,
+				struct dpsw_fdb_entry *entry)
+{
+	int error;
+
+	error = parse_dpsw_mac_addr(mac_addr_str, entry->mac_addr);
+	if (error)
+		return error;
+
+	error = parse_dpsw_if_list(if_str, entry->if_id, &entry->num_ifs);
+	if (error)
+		return error;
+
+	if (entry->num_ifs > 1 && !is_multicast_mac_addr(entry->mac_addr)) {
+		ERROR_PRINTF("A unicast MAC address takes exactly one interface\n");
+		return -EINVAL;
+	}
+
+	return 0;
+}
+
+/*
+ * FDB file: one entry per line, "<mac-addr> <if>[,<if>...]"; blank lines
+ * and lines starting with '#' are skipped
+ */
+static int read_fdb_file(const char *fdb_file,
+			 struct dpsw_fdb_entry **entries_out,
+			 int *num_entries_out)
+{
+	struct dpsw_fdb_entry *entries = NULL;
+	struct dpsw_fdb_entry *new_entries;
+	char *mac_addr, *ifs, *saveptr;
+	int num_entries = 0;
+	int max_entries = 0;
+	char line[512];
+	int line_num = 0;
+	int error = 0;
+	FILE *fp;
+
+	fp = fopen(fdb_file, "r");
+	if (fp == NULL) {
+		error = -errno;
+		ERROR_PRINTF("fopen(%s) failed: %s\n", fdb_file,
+			     strerror(errno));
+		return error;
+	}
+
+	while (fgets(line, sizeof(line), fp) != NULL) {
+		line_num++;
+		mac_addr = strtok_r(line, " \t\r\n", &saveptr);
+		if (mac_addr == NULL || mac_addr[0] == '#')
+			continue;
+
+		if (num_entries == max_entries) {
+			max_entries = max_entries ? max_entries * 2 : 64;
+			new_entries = realloc(entries,
+					      max_entries * sizeof(*entries));
+			if (new_entries == NULL) {
+				ERROR_PRINTF("Could not alloc memory!\n");
+				error = -ENOMEM;
+				break;
+			}
+			entries = new_entries;
+		}
+
+		ifs = strtok_r(NULL, " \t\r\n", &saveptr);
+		error = ifs == NULL ? -EINVAL :
+			parse_dpsw_fdb_entry(mac_addr, ifs,
+					     &entries[num_entries]);
+		if (error) {
+			ERROR_PRINTF("%s:%d: invalid FDB entry\n", fdb_file,
+				     line_num);
+			break;
+		}
+		entries[num_entries].line = line_num;
+		num_entries++;
+	}
+
+	fclose(fp);
+	if (error) {
+		free(entries);
+		return error;
+	}
+
+	*entries_out = entries;
+	*num_entries_out = num_entries;
+	return 0;
+}
+
+/*
+ * Opens dpsw.<dpsw_id> for the fdb-* and vlan-* commands, returning its
+ * attributes for the checks of the command arguments
+ */
+static int open_dpsw_v10(uint32_t dpsw_id, uint16_t *dpsw_handle,
+			 struct dpsw_attr_v10 *dpsw_attr)
+{
+	int error;
+
+	error = dpsw_open_v10(&restool.mc_io, 0, dpsw_id, dpsw_handle);
+	if (error < 0) {
+		mc_status = flib_error_to_mc_status(error);
+		ERROR_PRINTF("MC error: %s (status %#x)\n",
+			     mc_status_to_string(mc_status), mc_status);
+		return error;
+	}
+
+	memset(dpsw_attr, 0, sizeof(*dpsw_attr));
+	error = dpsw_get_attributes_v10(&restool.mc_io, 0, *dpsw_handle,
+					dpsw_attr);
+	if (error < 0) {
+		mc_status = flib_error_to_mc_status(error);
+		ERROR_PRINTF("MC error: %s (status %#x)\n",
+			     mc_status_to_string(mc_status), mc_status);
+		dpsw_close_v10(&restool.mc_io, 0, *dpsw_handle);
+	}
+
+	return error;
+}
+
+static int check_dpsw_fdb_id(uint32_t dpsw_id,
+			     const struct dpsw_attr_v10 *dpsw_attr,
+			     uint16_t fdb_id)
+{
+	if (fdb_id < dpsw_attr->max_fdbs)
+		return 0;
+
+	ERROR_PRINTF("dpsw.%u has %u FDBs\n", dpsw_id,
+		     (uint32_t)dpsw_attr->max_fdbs);
+	return -EINVAL;
+}
+
+static int check_dpsw_ifs(uint32_t dpsw_id,
+			  const struct dpsw_attr_v10 *dpsw_attr,
+			  const uint16_t *if_id, uint16_t num_ifs)
+{
+	for (int i = 0; i < num_ifs; i++) {
+		if (if_id[i] < dpsw_attr->num_ifs)
+			continue;
+
+		ERROR_PRINTF("Interface %u is out of range, dpsw.%u has %u\n",
+			     (uint32_t)if_id[i], dpsw_id,
+			     (uint32_t)dpsw_attr->num_ifs);
+		return -EINVAL;
+	}
+
+	return 0;
+}
+
+static int close_dpsw_v10(uint16_t dpsw_handle, int error)
+{
+	int error2;
+
+	error2 = dpsw_close_v10(&restool.mc_io, 0, dpsw_handle);
+	if (error2 < 0) {
+		mc_status = flib_error_to_mc_status(error2);
+		ERROR_PRINTF("MC error: %s (status %#x)\n",
+			     mc_status_to_string(mc_status), mc_status);
+		if (error == 0)
+			error = error2;
+	}
+
+	return error;
+}
+
+static int apply_fdb_entry(uint16_t dpsw_handle, uint16_t fdb_id,
+			   const struct dpsw_fdb_entry *entry, bool add)
+{
+	struct dpsw_fdb_multicast_cfg multicast_cfg;
+	struct dpsw_fdb_unicast_cfg unicast_cfg;
+
+	if (is_multicast_mac_addr(entry->mac_addr)) {
+		memset(&multicast_cfg, 0, sizeof(multicast_cfg));
+		multicast_cfg.type = DPSW_FDB_ENTRY_STATIC;
+		memcpy(multicast_cfg.mac_addr, entry->mac_addr, 6);
+		multicast_cfg.num_ifs = entry->num_ifs;
+		memcpy(multicast_cfg.if_id, entry->if_id,
+		       entry->num_ifs * sizeof(entry->if_id[0]));
+		if (add)
+			return dpsw_fdb_add_multicast_v10(&restool.mc_io, 0,
+							  dpsw_handle, fdb_id,
+							  &multicast_cfg);
+		return dpsw_fdb_remove_multicast_v10(&restool.mc_io, 0,
+						     dpsw_handle, fdb_id,
+						     &multicast_cfg);
+	}
+
+	memset(&unicast_cfg, 0, sizeof(unicast_cfg));
+	unicast_cfg.type = DPSW_FDB_ENTRY_STATIC;
+	memcpy(unicast_cfg.mac_addr, entry->mac_addr, 6);
+	unicast_cfg.if_egress = entry->if_id[0];
+	if (add)
+		return dpsw_fdb_add_unicast_v10(&restool.mc_io, 0, dpsw_handle,
+						fdb_id, &unicast_cfg);
+	return dpsw_fdb_remove_unicast_v10(&restool.mc_io, 0, dpsw_handle,
+					   fdb_id, &unicast_cfg);
+}
+
+/*
+ * Adds or removes a batch of static entries, all of them checked against
+ * the DPSW interfaces first and then issued in a single control session
+ */
+static int update_dpsw_fdb(uint32_t dpsw_id, uint16_t fdb_id,
+			   const struct dpsw_fdb_entry *entries,
+			   int num_entries, const char *fdb_file, bool add)
+{
+	struct dpsw_attr_v10 dpsw_attr;
+	uint16_t dpsw_handle;
+	int error;
+	int done;
+
+	error = open_dpsw_v10(dpsw_id, &dpsw_handle, &dpsw_attr);
+	if (error)
+		return error;
+
+	error = check_dpsw_fdb_id(dpsw_id, &dpsw_attr, fdb_id);
+	if (error)
+		return close_dpsw_v10(dpsw_handle, error);
+
+	for (int i = 0; i < num_entries; i++) {
+		error = check_dpsw_ifs(dpsw_id, &dpsw_attr, entries[i].if_id,
+				       entries[i].num_ifs);
+		if (error) {
+			if (fdb_file != NULL)
+				ERROR_PRINTF("%s:%d: invalid FDB entry\n",
+					     fdb_file, entries[i].line);
+			return close_dpsw_v10(dpsw_handle, error);
+		}
+	}
+
+	for (done = 0; done < num_entries; done++) {
+		error = apply_fdb_entry(dpsw_handle, fdb_id, &entries[done],
+					add);
+		if (error < 0) {
+			mc_status = flib_error_to_mc_status(error);
+			if (fdb_file != NULL)
+				ERROR_PRINTF("%s:%d: MC error: %s (status %#x)\n",
+					     fdb_file, entries[done].line,
+					     mc_status_to_string(mc_status),
+					     mc_status);
+			else
+				ERROR_PRINTF("MC error: %s (status %#x)\n",
+					     mc_status_to_string(mc_status),
+					     mc_status);
+			break;
+		}
+	}
+
+	if (fdb_file != NULL)
+		printf("%d of %d entries added\n", done, num_entries);
+
+	return close_dpsw_v10(dpsw_handle, error);
+}
+
+static void print_fdb_dump_entry(const struct dpsw_fdb_dump_entry *entry)
+{
+	bool first = true;
+
+	printf("%02x:%02x:%02x:%02x:%02x:%02x  %-7s  ",
+	       entry->mac_addr[0], entry->mac_addr[1], entry->mac_addr[2],
+	       entry->mac_addr[3], entry->mac_addr[4], entry->mac_addr[5],
+	       entry->type & DPSW_FDB_ENTRY_TYPE_DYNAMIC ? "dynamic" : "static");
+
+	if (entry->type & DPSW_FDB_ENTRY_TYPE_UNICAST) {
+		printf("%u\n", (uint32_t)entry->if_info);
+		return;
+	}
+
+	for (int i = 0; i < DPSW_MAX_IF; i++) {
+		if (!(entry->if_mask[i / 8] & (1 << (i % 8))))
+			continue;
+		printf(first ? "%d" : ",%d", i);
+		first = false;
+	}
+	printf("\n");
+}
+
+static int dump_dpsw_fdb(uint32_t dpsw_id, uint16_t fdb_id)
+{
+	struct dpsw_fdb_dump_entry *entries;
+	struct dpsw_attr_v10 dpsw_attr;
+	uint16_t dpsw_handle;
+	uint16_t num_entries;
+	uint32_t max_entries;
+	uint64_t dump_iova;
+	void *dump_buf;
+	int error;
+
+	error = open_dpsw_v10(dpsw_id, &dpsw_handle, &dpsw_attr);
+	if (error)
+		return error;
+
+	error = check_dpsw_fdb_id(dpsw_id, &dpsw_attr, fdb_id);
+	if (error)
+		return close_dpsw_v10(dpsw_handle, error);
+
+	/* the dump buffer is a single page, MC stops once it is full */
+	max_entries = sysconf(_SC_PAGESIZE) / sizeof(*entries);
+	if (dpsw_attr.max_fdb_entries < max_entries)
+		max_entries = dpsw_attr.max_fdb_entries;
+
+	error = alloc_dma_buf(max_entries * sizeof(*entries), &dump_buf,
+			      &dump_iova);
+	if (error)
+		return close_dpsw_v10(dpsw_handle, error);
+
+	error = dpsw_fdb_dump_v10(&restool.mc_io, 0, dpsw_handle, fdb_id,
+				  dump_iova, max_entries * sizeof(*entries),
+				  &num_entries);
+	if (error < 0) {
+		mc_status = flib_error_to_mc_status(error);
+		ERROR_PRINTF("MC error: %s (status %#x)\n",
+			     mc_status_to_string(mc_status), mc_status);
+		goto out;
+	}
+
+	printf("dpsw.%u FDB %u: %u entries\n", dpsw_id, (uint32_t)fdb_id,
+	       (uint32_t)num_entries);
+	if (num_entries > max_entries) {
+		printf("(only the first %u are shown)\n", max_entries);
+		num_entries = max_entries;
+	}
+
+	if (num_entries)
+		printf("MAC address        type     interfaces\n");
+
+	entries = dump_buf;
+	for (int i = 0; i < num_entries; i++)
+		print_fdb_dump_entry(&entries[i]);
+
+out:
+	free_dma_buf(dump_buf);
+	return close_dpsw_v10(dpsw_handle, error);
+}
+
+/*
+ * <dpsw-object> and --fdb of the dpsw fdb-* commands
+ */
+static int get_dpsw_fdb_target(const char *usage_msg, uint32_t *dpsw_id,
+			       uint16_t *fdb_id)
+{
+	int error;
+	long val;
+
+	if (restool.obj_name == NULL) {
+		ERROR_PRINTF("<object> argument missing\n");
+		puts(usage_msg);
+		return -EINVAL;
+	}
+
+	error = parse_object_name(restool.obj_name, "dpsw", dpsw_id);
+	if (error < 0)
+		return error;
+
+	*fdb_id = 0;
+	if (restool.cmd_option_mask & ONE_BIT_MASK(FDB_OPT_FDB_ID)) {
+		restool.cmd_option_mask &= ~ONE_BIT_MASK(FDB_OPT_FDB_ID);
+		error = get_option_value(FDB_OPT_FDB_ID, &val,
+					 "Invalid fdb value", 0, UINT16_MAX);
+		if (error)
+			return error;
+		*fdb_id = val;
+	}
+
+	return 0;
+}
+
+static int cmd_dpsw_fdb_dump(void)
+{
+	static const char usage_msg[] =
+		"\n"
+		"Usage: restool dpsw fdb-dump <dpsw-object> [--fdb=<number>]\n"
+		"\n"
+		"OPTIONS:\n"
+		"--fdb=<number>\n"
+		"   FDB to display. Default is 0.\n"
+		"\n"
+		"Shows the MAC address, the static or dynamic (learned) type and\n"
+		"the egress interfaces of every entry.\n"
+		"\n"
+		"EXAMPLE:\n"
+		"Display the default FDB of dpsw.0:\n"
+		"   $ restool dpsw fdb-dump dpsw.0\n"
+		"\n";
+
+	uint32_t dpsw_id;
+	uint16_t fdb_id;
+	int error;
+
+	if (restool.cmd_option_mask & ONE_BIT_MASK(FDB_OPT_HELP)) {
+		puts(usage_msg);
+		restool.cmd_option_mask &= ~ONE_BIT_MASK(FDB_OPT_HELP);
+		return 0;
+	}
+
+	error = get_dpsw_fdb_target(usage_msg, &dpsw_id, &fdb_id);
+	if (error)
+		return error;
+
+	return dump_dpsw_fdb(dpsw_id, fdb_id);
+}
+
+static int fdb_entry_dpsw(const char *usage_msg, bool add)
+{
+	struct dpsw_fdb_entry entry;
+	uint32_t dpsw_id;
+	uint16_t fdb_id;
+	int error;
+
+	if (restool.cmd_option_mask & ONE_BIT_MASK(FDB_OPT_HELP)) {
+		puts(usage_msg);
+		restool.cmd_option_mask &= ~ONE_BIT_MASK(FDB_OPT_HELP);
+		return 0;
+	}
+
+	error = get_dpsw_fdb_target(usage_msg, &dpsw_id, &fdb_id);
+	if (error)
+		return error;
+
+	if (!(restool.cmd_option_mask & ONE_BIT_MASK(FDB_OPT_MAC_ADDR)) ||
+	    !(restool.cmd_option_mask & ONE_BIT_MASK(FDB_OPT_IF))) {
+		ERROR_PRINTF("--mac-addr and --if must be specified\n");
+		puts(usage_msg);
+		return -EINVAL;
+	}
+
+	restool.cmd_option_mask &= ~ONE_BIT_MASK(FDB_OPT_MAC_ADDR);
+	restool.cmd_option_mask &= ~ONE_BIT_MASK(FDB_OPT_IF);
+	memset(&entry, 0, sizeof(entry));
+	error = parse_dpsw_fdb_entry(restool.cmd_option_args[FDB_OPT_MAC_ADDR],
+				     restool.cmd_option_args[FDB_OPT_IF],
+				     &entry);
+	if (error)
+		return error;
+
+	return update_dpsw_fdb(dpsw_id, fdb_id, &entry, 1, NULL, add);
+}
+
+static int cmd_dpsw_fdb_add(void)
+{
+	static const char usage_msg[] =
+		"\n"
+		"Usage: restool dpsw fdb-add <dpsw-object> --mac-addr=<addr>\n"
+		"		--if=<number>[,<number>...] [--fdb=<number>]\n"
+		"\n"
+		"--mac-addr=<addr>\n"
+		"   MAC address of the entry (e.g. 00:00:05:00:00:05).\n"
+		"--if=<number>[,<number>...]\n"
+		"   Egress interface. A multicast MAC address takes a comma\n"
+		"   separated list of interfaces, added to its group.\n"
+		"\n"
+		"OPTIONS:\n"
+		"--fdb=<number>\n"
+		"   FDB to add the entry to. Default is 0.\n"
+		"\n"
+		"EXAMPLE:\n"
+		"Forward 00:00:05:00:00:05 out of interface 2 of dpsw.0:\n"
+		"   $ restool dpsw fdb-add dpsw.0 --mac-addr=00:00:05:00:00:05 --if=2\n"
+		"\n";
+
+	return fdb_entry_dpsw(usage_msg, true);
+}
+
+static int cmd_dpsw_fdb_del(void)
+{
+	static const char usage_msg[] =
+		"\n"
+		"Usage: restool dpsw fdb-del <dpsw-object> --mac-addr=<addr>\n"
+		"		--if=<number>[,<number>...] [--fdb=<number>]\n"
+		"\n"
+		"--mac-addr=<addr>\n"
+		"   MAC address of the entry (e.g. 00:00:05:00:00:05).\n"
+		"--if=<number>[,<number>...]\n"
+		"   Egress interface of the entry. For a multicast MAC address,\n"
+		"   the interfaces to remove from its group; the group goes away\n"
+		"   with its last interface.\n"
+		"\n"
+		"OPTIONS:\n"
+		"--fdb=<number>\n"
+		"   FDB to remove the entry from. Default is 0.\n"
+		"\n"
+		"EXAMPLE:\n"
+		"   $ restool dpsw fdb-del dpsw.0 --mac-addr=00:00:05:00:00:05 --if=2\n"
+		"\n";
+
+	return fdb_entry_dpsw(usage_msg, false);
+}
+
+static int cmd_dpsw_fdb_load(void)
+{
+	static const char usage_msg[] =
+		"\n"
+		"Usage: restool dpsw fdb-load <dpsw-object> --file=<path>\n"
+		"		[--fdb=<number>]\n"
+		"\n"
+		"--file=<path>\n"
+		"   File of static entries, one per line:\n"
+		"	<mac-addr> <if>[,<if>...]\n"
+		"   Blank lines and lines starting with '#' are skipped.\n"
+		"\n"
+		"OPTIONS:\n"
+		"--fdb=<number>\n"
+		"   FDB to add the entries to. Default is 0.\n"
+		"\n"
+		"The whole file is checked before the first entry is added, the\n"
+		"entries are then added in a single DPSW session. Loading stops\n"
+		"at the first entry rejected by MC.\n"
+		"\n"
+		"EXAMPLE:\n"
+		"   $ cat vms.fdb\n"
+		"   00:00:05:00:00:05 1\n"
+		"   00:00:05:00:00:06 2\n"
+		"   01:00:5e:00:00:fb 1,2,3\n"
+		"   $ restool dpsw fdb-load dpsw.0 --file=vms.fdb\n"
+		"\n";
+
+	struct dpsw_fdb_entry *entries;
+	const char *fdb_file;
+	int num_entries;
+	uint32_t dpsw_id;
+	uint16_t fdb_id;
+	int error;
+
+	if (restool.cmd_option_mask & ONE_BIT_MASK(FDB_OPT_HELP)) {
+		puts(usage_msg);
+		restool.cmd_option_mask &= ~ONE_BIT_MASK(FDB_OPT_HELP);
+		return 0;
+	}
+
+	error = get_dpsw_fdb_target(usage_msg, &dpsw_id, &fdb_id);
+	if (error)
+		return error;
+
+	if (!(restool.cmd_option_mask & ONE_BIT_MASK(FDB_OPT_FILE))) {
+		ERROR_PRINTF("--file option missing\n");
+		puts(usage_msg);
+		return -EINVAL;
+	}
+
+	restool.cmd_option_mask &= ~ONE_BIT_MASK(FDB_OPT_FILE);
+	fdb_file = restool.cmd_option_args[FDB_OPT_FILE];
+	error = read_fdb_file(fdb_file, &entries, &num_entries);
+	if (error)
+		return error;
+
+	error = update_dpsw_fdb(dpsw_id, fdb_id, entries, num_entries,
+				fdb_file, true);
+	free(entries);
+	return error;
+}
+
+/**
+ * 12 bit VLAN IDs, 0 and 4095 being reserved
+ */
+#define DPSW_MIN_VLAN_ID	1
+#define DPSW_MAX_VLAN_ID	4094
+
+/*
+ * VLAN set of the dpsw vlan-* commands: comma separated VLAN IDs and
+ * <first>-<last> ranges
+ */
+static int parse_vlan_ranges(const char *vlans_str, bool *vlans)
+{
+	char *ranges, *range, *saveptr, *endptr;
+	long first, last;
+	int error = 0;
+
+	ranges = strdup(vlans_str);
+	if (ranges == NULL) {
+		ERROR_PRINTF("strdup() failed\n");
+		return -ENOMEM;
+	}
+
+	memset(vlans, 0, (DPSW_MAX_VLAN_ID + 1) * sizeof(*vlans));
+	for (range = strtok_r(ranges, ",", &saveptr); range != NULL;
+	     range = strtok_r(NULL, ",", &saveptr)) {
+		errno = 0;
+		first = strtol(range, &endptr, 0);
+		last = first;
+		if (errno == 0 && endptr != range && *endptr == '-') {
+			const char *last_str = endptr + 1;
+
+			last = strtol(last_str, &endptr, 0);
+			if (endptr == last_str)
+				errno = EINVAL;
+		}
+
+		if (errno || endptr == range || *endptr != '\0' ||
+		    first < DPSW_MIN_VLAN_ID || last > DPSW_MAX_VLAN_ID ||
+		    first > last) {
+			ERROR_PRINTF("Invalid VLAN range: %s (VLAN IDs go from %d to %d)\n",
+				     range, DPSW_MIN_VLAN_ID, DPSW_MAX_VLAN_ID);
+			error = -EINVAL;
+			break;
+		}
+
+		for (long vlan_id = first; vlan_id <= last; vlan_id++)
+			vlans[vlan_id] = true;
+	}
+
+	free(ranges);
+	return error;
+}
+
+/*
+ * Interfaces of <ifs> that are (in == true) or are not members of <set>
+ */
+static void filter_vlan_ifs(const struct dpsw_vlan_if_cfg *ifs,
+			    const struct dpsw_vlan_if_cfg *set, bool in,
+			    struct dpsw_vlan_if_cfg *out)
+{
+	bool member[DPSW_MAX_IF] = { false };
+
+	for (int i = 0; i < set->num_ifs; i++)
+		member[set->if_id[i]] = true;
+
+	out->num_ifs = 0;
+	for (int i = 0; i < ifs->num_ifs; i++) {
+		if (member[ifs->if_id[i]] == in)
+			out->if_id[out->num_ifs++] = ifs->if_id[i];
+	}
+}
+
+/*
+ * Creates <vlan_id> unless it exists and makes the interfaces members of
+ * it, untagged ones if asked; interfaces already set up are skipped so
+ * that the command can be repeated
+ */
+static int add_dpsw_vlan(uint16_t dpsw_handle, uint16_t vlan_id,
+			 uint16_t fdb_id, const struct dpsw_vlan_if_cfg *ifs,
+			 bool untagged)
+{
+	struct dpsw_vlan_if_cfg current, delta;
+	struct dpsw_vlan_attr vlan_attr;
+	struct dpsw_vlan_cfg vlan_cfg;
+	int error;
+
+	error = dpsw_vlan_get_attributes_v10(&restool.mc_io, 0, dpsw_handle,
+					     vlan_id, &vlan_attr);
+	if (error < 0) {
+		vlan_cfg.fdb_id = fdb_id;
+		error = dpsw_vlan_add_v10(&restool.mc_io, 0, dpsw_handle,
+					  vlan_id, &vlan_cfg);
+		if (error < 0)
+			return error;
+	}
+
+	if (ifs->num_ifs == 0)
+		return 0;
+
+	error = dpsw_vlan_get_if_v10(&restool.mc_io, 0, dpsw_handle, vlan_id,
+				     &current);
+	if (error < 0)
+		return error;
+
+	filter_vlan_ifs(ifs, &current, false, &delta);
+	if (delta.num_ifs) {
+		error = dpsw_vlan_add_if_v10(&restool.mc_io, 0, dpsw_handle,
+					     vlan_id, &delta);
+		if (error < 0)
+			return error;
+	}
+
+	if (!untagged)
+		return 0;
+
+	error = dpsw_vlan_get_if_untagged_v10(&restool.mc_io, 0, dpsw_handle,
+					      vlan_id, &current);
+	if (error < 0)
+		return error;
+
+	filter_vlan_ifs(ifs, &current, false, &delta);
+	if (delta.num_ifs == 0)
+		return 0;
+
+	return dpsw_vlan_add_if_untagged_v10(&restool.mc_io, 0, dpsw_handle,
+					     vlan_id, &delta);
+}
+
+/*
+ * Removes <vlan_id> altogether when no interface is given, otherwise
+ * takes the interfaces out of it (or only makes them tagged again)
+ */
+static int del_dpsw_vlan(uint16_t dpsw_handle, uint16_t vlan_id,
+			 const struct dpsw_vlan_if_cfg *ifs, bool untagged)
+{
+	struct dpsw_vlan_if_cfg current, delta;
+	int error;
+
+	if (ifs->num_ifs == 0)
+		return dpsw_vlan_remove_v10(&restool.mc_io, 0, dpsw_handle,
+					    vlan_id);
+
+	error = dpsw_vlan_get_if_untagged_v10(&restool.mc_io, 0, dpsw_handle,
+					      vlan_id, &current);
+	if (error < 0)
+		return error;
+
+	filter_vlan_ifs(ifs, &current, true, &delta);
+	if (delta.num_ifs) {
+		error = dpsw_vlan_remove_if_untagged_v10(&restool.mc_io, 0,
+							 dpsw_handle, vlan_id,
+							 &delta);
+		if (error < 0)
+			return error;
+	}
+
+	if (untagged)
+		return 0;
+
+	error = dpsw_vlan_get_if_v10(&restool.mc_io, 0, dpsw_handle, vlan_id,
+				     &current);
+	if (error < 0)
+		return error;
+
+	filter_vlan_ifs(ifs, &current, true, &delta);
+	if (delta.num_ifs == 0)
+		return 0;
+
+	return dpsw_vlan_remove_if_v10(&restool.mc_io, 0, dpsw_handle,
+				       vlan_id, &delta);
+}
+
+/*
+ * Applies a vlan-add or vlan-del to every VLAN of the set in a single
+ * DPSW session, stopping at the first VLAN MC rejects
+ */
+static int update_dpsw_vlans(uint32_t dpsw_id, const bool *vlans,
+			     uint16_t fdb_id,
+			     const struct dpsw_vlan_if_cfg *ifs,
+			     bool untagged, bool add)
+{
+	struct dpsw_attr_v10 dpsw_attr;
+	int num_vlans = 0;
+	uint16_t dpsw_handle;
+	int done = 0;
+	int error;
+
+	error = open_dpsw_v10(dpsw_id, &dpsw_handle, &dpsw_attr);
+	if (error)
+		return error;
+
+	if (add)
+		error = check_dpsw_fdb_id(dpsw_id, &dpsw_attr, fdb_id);
+	if (error == 0)
+		error = check_dpsw_ifs(dpsw_id, &dpsw_attr, ifs->if_id,
+				       ifs->num_ifs);
+	if (error)
+		return close_dpsw_v10(dpsw_handle, error);
+
+	for (int vlan_id = DPSW_MIN_VLAN_ID; vlan_id <= DPSW_MAX_VLAN_ID;
+	     vlan_id++) {
+		if (!vlans[vlan_id])
+			continue;
+
+		num_vlans++;
+		if (error)
+			continue;
+
+		if (add)
+			error = add_dpsw_vlan(dpsw_handle, vlan_id, fdb_id,
+					      ifs, untagged);
+		else
+			error = del_dpsw_vlan(dpsw_handle, vlan_id, ifs,
+					      untagged);
+		if (error < 0) {
+			mc_status = flib_error_to_mc_status(error);
+			ERROR_PRINTF("VLAN %d: MC error: %s (status %#x)\n",
+				     vlan_id, mc_status_to_string(mc_status),
+				     mc_status);
+			continue;
+		}
+		done++;
+	}
+
+	printf("%d of %d VLANs updated\n", done, num_vlans);
+
+	return close_dpsw_v10(dpsw_handle, error);
+}
+
+static int print_dpsw_vlans(uint32_t dpsw_id, const bool *vlans,
+			    bool all_vlans)
+{
+	struct dpsw_vlan_if_cfg members, untagged;
+	struct dpsw_attr_v10 dpsw_attr;
+	struct dpsw_vlan_attr vlan_attr;
+	bool is_untagged[DPSW_MAX_IF];
+	bool is_member[DPSW_MAX_IF];
+	uint16_t dpsw_handle;
+	int found = 0;
+	int error;
+
+	error = open_dpsw_v10(dpsw_id, &dpsw_handle, &dpsw_attr);
+	if (error)
+		return error;
+
+	printf("VLAN  FDB  interfaces\n");
+	printf("          ");
+	for (int i = 0; i < dpsw_attr.num_ifs; i++)
+		printf("%3d", i);
+	printf("\n");
+
+	/*
+	 * MC has no VLAN list: probe the IDs, all of them stopping once
+	 * num_vlans were found
+	 */
+	for (int vlan_id = DPSW_MIN_VLAN_ID; vlan_id <= DPSW_MAX_VLAN_ID;
+	     vlan_id++) {
+		if (!vlans[vlan_id])
+			continue;
+		if (all_vlans && found == dpsw_attr.num_vlans)
+			break;
+
+		error = dpsw_vlan_get_attributes_v10(&restool.mc_io, 0,
+						     dpsw_handle, vlan_id,
+						     &vlan_attr);
+		if (error < 0) {
+			error = 0;
+			continue;
+		}
+		found++;
+
+		error = dpsw_vlan_get_if_v10(&restool.mc_io, 0, dpsw_handle,
+					     vlan_id, &members);
+		if (error == 0)
+			error = dpsw_vlan_get_if_untagged_v10(&restool.mc_io,
+							      0, dpsw_handle,
+							      vlan_id,
+							      &untagged);
+		if (error < 0) {
+			mc_status = flib_error_to_mc_status(error);
+			ERROR_PRINTF("VLAN %d: MC error: %s (status %#x)\n",
+				     vlan_id, mc_status_to_string(mc_status),
+				     mc_status);
+			break;
+		}
+
+		memset(is_member, 0, sizeof(is_member));
+		memset(is_untagged, 0, sizeof(is_untagged));
+		for (int i = 0; i < members.num_ifs; i++)
+			is_member[members.if_id[i]] = true;
+		for (int i = 0; i < untagged.num_ifs; i++)
+			is_untagged[untagged.if_id[i]] = true;
+
+		printf("%4d  %3u ", vlan_id, (uint32_t)vlan_attr.fdb_id);
+		for (int i = 0; i < dpsw_attr.num_ifs && i < DPSW_MAX_IF; i++)
+			printf("  %c", is_untagged[i] ? 'U' :
+			       is_member[i] ? 'T' : '.');
+		printf("\n");
+	}
+
+	printf("%d VLANs (T: tagged member, U: untagged member)\n", found);
+
+	return close_dpsw_v10(dpsw_handle, error);
+}
+
+static int vlan_dpsw(const char *usage_msg, bool add)
+{
+	bool vlans[DPSW_MAX_VLAN_ID + 1];
+	struct dpsw_vlan_if_cfg ifs;
+	bool untagged = false;
+	uint16_t fdb_id = 0;
+	uint32_t dpsw_id;
+	int error;
+	long val;
+
+	if (restool.cmd_option_mask & ONE_BIT_MASK(VLAN_OPT_HELP)) {
+		puts(usage_msg);
+		restool.cmd_option_mask &= ~ONE_BIT_MASK(VLAN_OPT_HELP);
+		return 0;
+	}
+
+	if (restool.obj_name == NULL) {
+		ERROR_PRINTF("<object> argument missing\n");
+		puts(usage_msg);
+		return -EINVAL;
+	}
+
+	error = parse_object_name(restool.obj_name, "dpsw", &dpsw_id);
+	if (error < 0)
+		return error;
+
+	if (!(restool.cmd_option_mask & ONE_BIT_MASK(VLAN_OPT_VLANS))) {
+		ERROR_PRINTF("--vlans option missing\n");
+		puts(usage_msg);
+		return -EINVAL;
+	}
+
+	restool.cmd_option_mask &= ~ONE_BIT_MASK(VLAN_OPT_VLANS);
+	error = parse_vlan_ranges(restool.cmd_option_args[VLAN_OPT_VLANS],
+				  vlans);
+	if (error)
+		return error;
+
+	memset(&ifs, 0, sizeof(ifs));
+	if (restool.cmd_option_mask & ONE_BIT_MASK(VLAN_OPT_IF)) {
+		restool.cmd_option_mask &= ~ONE_BIT_MASK(VLAN_OPT_IF);
+		error = parse_dpsw_if_list(restool.cmd_option_args[VLAN_OPT_IF],
+					   ifs.if_id, &ifs.num_ifs);
+		if (error)
+			return error;
+	}
+
+	if (restool.cmd_option_mask & ONE_BIT_MASK(VLAN_OPT_UNTAGGED)) {
+		restool.cmd_option_mask &= ~ONE_BIT_MASK(VLAN_OPT_UNTAGGED);
+		if (ifs.num_ifs == 0) {
+			ERROR_PRINTF("--untagged needs --if\n");
+			puts(usage_msg);
+			return -EINVAL;
+		}
+		untagged = true;
+	}
+
+	if (add && restool.cmd_option_mask & ONE_BIT_MASK(VLAN_OPT_FDB_ID)) {
+		restool.cmd_option_mask &= ~ONE_BIT_MASK(VLAN_OPT_FDB_ID);
+		error = get_option_value(VLAN_OPT_FDB_ID, &val,
+					 "Invalid fdb value", 0, UINT16_MAX);
+		if (error)
+			return error;
+		fdb_id = val;
+	}
+
+	return update_dpsw_vlans(dpsw_id, vlans, fdb_id, &ifs, untagged, add);
+}
+
+static int cmd_dpsw_vlan_add(void)
+{
+	static const char usage_msg[] =
+		"\n"
+		"Usage: restool dpsw vlan-add <dpsw-object> --vlans=<vlan-ranges>\n"
+		"		[--if=<number>[,<number>...] [--untagged]] [--fdb=<number>]\n"
+		"\n"
+		"--vlans=<vlan-ranges>\n"
+		"   Comma separated VLAN IDs and <first>-<last> ranges (1-4094).\n"
+		"   VLANs that do not exist yet are created.\n"
+		"\n"
+		"OPTIONS:\n"
+		"--if=<number>[,<number>...]\n"
+		"   Interfaces to make members of every VLAN of the set.\n"
+		"--untagged\n"
+		"   The interfaces transmit the frames of these VLANs untagged.\n"
+		"--fdb=<number>\n"
+		"   FDB of the VLANs created. Default is 0, shared learning.\n"
+		"\n"
+		"Interfaces that already are (untagged) members are skipped. All\n"
+		"the VLANs are updated in a single DPSW session.\n"
+		"\n"
+		"EXAMPLE:\n"
+		"Trunk VLANs 100 to 199 on interfaces 0 and 1 of dpsw.0:\n"
+		"   $ restool dpsw vlan-add dpsw.0 --vlans=100-199 --if=0,1\n"
+		"\n";
+
+	return vlan_dpsw(usage_msg, true);
+}
+
+static int cmd_dpsw_vlan_del(void)
+{
+	static const char usage_msg[] =
+		"\n"
+		"Usage: restool dpsw vlan-del <dpsw-object> --vlans=<vlan-ranges>\n"
+		"		[--if=<number>[,<number>...] [--untagged]]\n"
+		"\n"
+		"--vlans=<vlan-ranges>\n"
+		"   Comma separated VLAN IDs and <first>-<last> ranges (1-4094).\n"
+		"\n"
+		"OPTIONS:\n"
+		"--if=<number>[,<number>...]\n"
+		"   Interfaces to remove from every VLAN of the set. Without it,\n"
+		"   the VLANs themselves are removed.\n"
+		"--untagged\n"
+		"   Only make the interfaces transmit the frames tagged again.\n"
+		"\n"
+		"EXAMPLE:\n"
+		"Take interface 1 of dpsw.0 out of VLANs 100 to 199:\n"
+		"   $ restool dpsw vlan-del dpsw.0 --vlans=100-199 --if=1\n"
+		"\n";
+
+	return vlan_dpsw(usage_msg, false);
+}
+
+static int cmd_dpsw_vlan_show(void)
+{
+	static const char usage_msg[] =
+		"\n"
+		"Usage: restool dpsw vlan-show <dpsw-object> [--vlans=<vlan-ranges>]\n"
+		"\n"
+		"OPTIONS:\n"
+		"--vlans=<vlan-ranges>\n"
+		"   Comma separated VLAN IDs and <first>-<last> ranges (1-4094)\n"
+		"   to display. Default is all the VLANs of the DPSW.\n"
+		"\n"
+		"Displays a VLAN x interface matrix: T for a tagged member, U\n"
+		"for an untagged one.\n"
+		"\n"
+		"EXAMPLE:\n"
+		"   $ restool dpsw vlan-show dpsw.0\n"
+		"\n";
+
+	bool vlans[DPSW_MAX_VLAN_ID + 1];
+	bool all_vlans = true;
+	uint32_t dpsw_id;
+	int error;
+
+	if (restool.cmd_option_mask & ONE_BIT_MASK(VLAN_OPT_HELP)) {
+		puts(usage_msg);
+		restool.cmd_option_mask &= ~ONE_BIT_MASK(VLAN_OPT_HELP);
+		return 0;
+	}
+
+	if (restool.obj_name == NULL) {
+		ERROR_PRINTF("<object> argument missing\n");
+		puts(usage_msg);
+		return -EINVAL;
+	}
+
+	error = parse_object_name(restool.obj_name, "dpsw", &dpsw_id);
+	if (error < 0)
+		return error;
+
+	if (restool.cmd_option_mask & ONE_BIT_MASK(VLAN_OPT_VLANS)) {
+		restool.cmd_option_mask &= ~ONE_BIT_MASK(VLAN_OPT_VLANS);
+		error = parse_vlan_ranges(
+				restool.cmd_option_args[VLAN_OPT_VLANS], vlans);
+		if (error)
+			return error;
+		all_vlans = false;
+	} else {
+		for (int i = 0; i <= DPSW_MAX_VLAN_ID; i++)
+			vlans[i] = true;
+	}
+
+	return print_dpsw_vlans(dpsw_id, vlans, all_vlans);
+}
+
+struct object_command dpsw_commands_v9[] = {
+	{ .cmd_name = "help",
+	  .options = NULL,
+	  .cmd_func = cmd_dpsw_help },
+
+	{ .cmd_name = "info",
+	  .options = dpsw_info_options,
+	  .cmd_func = cmd_dpsw_info_v9 },
+
+	{ .cmd_name = "create",
+	  .options = dpsw_create_options,
+	  .cmd_func = cmd_dpsw_create_v9 },
+
+	{ .cmd_name = "destroy",
+	  .options = dpsw_destroy_options,
+	  .cmd_func = cmd_dpsw_destroy_v9 },
+
+	{ .cmd_name = NULL },
+};
+
+struct object_command dpsw_commands_v10[] = {
+	{ .cmd_name = "help",
+	  .options = NULL,
+	  .cmd_func = cmd_dpsw_help },
+
+	{ .cmd_name = "info",
+	  .options = dpsw_info_options,
+	  .cmd_func = cmd_dpsw_info_v10 },
+
+	{ .cmd_name = "create",
+	  .options = dpsw_create_options,
+	  .cmd_func = cmd_dpsw_create_v10 },
+
+	{ .cmd_name = "destroy",
+	  .options = dpsw_destroy_options,
+	  .cmd_func = cmd_dpsw_destroy_v10 },
+
+	{ .cmd_name = "fdb-dump",
+	  .options = dpsw_fdb_options,
+	  .cmd_func = cmd_dpsw_fdb_dump },
+
+	{ .cmd_name = "fdb-add",
+	  .options = dpsw_fdb_options,
+	  .cmd_func = cmd_dpsw_fdb_add },
+
+	{ .cmd_name = "fdb-del",
+	  .options = dpsw_fdb_options,
+	  .cmd_func = cmd_dpsw_fdb_del },
+
+	{ .cmd_name = "fdb-load",
+	  .options = dpsw_fdb_options,
+	  .cmd_func = cmd_dpsw_fdb_load },
+
+	{ .cmd_name = "vlan-add",
+	  .options = dpsw_vlan_options,
+	  .cmd_func = cmd_dpsw_vlan_add },
+
+	{ .cmd_name = "vlan-del",
+	  .options = dpsw_vlan_options,
+	  .cmd_func = cmd_dpsw_vlan_del },
+
+	{ .cmd_name = "vlan-show",
+	  .options = dpsw_vlan_options,
+	  .cmd_func = cmd_dpsw_vlan_show },
 
 	{ .cmd_name = NULL },
 };
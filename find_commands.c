@@ -0,0 +1,483 @@
+/* Copyright 2026 NXP
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * * Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ * * Neither the name of the above-listed copyright holders nor the
+ * names of any contributors may be used to endorse or promote products
+ * derived from this software without specific prior written permission.
+ *
+ *
+ * ALTERNATIVELY, this software may be distributed under the terms of the
+ * GNU General Public License ("GPL") as published by the Free Software
+ * Foundation, either version 2 of that License or (at your option) any
+ * later version.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDERS OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <errno.h>
+#include <assert.h>
+#include <getopt.h>
+#include <fnmatch.h>
+#include "restool.h"
+#include "utils.h"
+
+/* a glob may be longer than the labels it matches */
+#define FIND_LABEL_GLOB_MAX_LENGTH	63
+
+enum mc_cmd_status mc_status;
+
+/**
+ * Object search criteria. Unset criteria match every object.
+ */
+struct find_query {
+	char label[FIND_LABEL_GLOB_MAX_LENGTH + 1];
+	char type[OBJ_TYPE_MAX_LENGTH + 1];
+	int plugged;
+	uint32_t container_id;
+	bool has_label;
+	bool has_container;
+};
+
+/**
+ * find command options
+ */
+enum find_options {
+	FIND_OPT_HELP = 0,
+	FIND_OPT_LABEL,
+	FIND_OPT_TYPE,
+	FIND_OPT_PLUGGED,
+	FIND_OPT_CONTAINER,
+	FIND_OPT_QUERIES,
+	FIND_OPT_JSON,
+};
+
+static struct option find_options[] = {
+	[FIND_OPT_HELP] = {
+		.name = "help",
+	},
+
+	[FIND_OPT_LABEL] = {
+		.name = "label",
+		.has_arg = 1,
+	},
+
+	[FIND_OPT_TYPE] = {
+		.name = "type",
+		.has_arg = 1,
+	},
+
+	[FIND_OPT_PLUGGED] = {
+		.name = "plugged",
+		.has_arg = 1,
+	},
+
+	[FIND_OPT_CONTAINER] = {
+		.name = "container",
+		.has_arg = 1,
+	},
+
+	[FIND_OPT_QUERIES] = {
+		.name = "queries",
+		.has_arg = 1,
+	},
+
+	[FIND_OPT_JSON] = {
+		.name = "json",
+	},
+
+	{ 0 },
+};
+
+C_ASSERT(ARRAY_SIZE(find_options) <= MAX_NUM_CMD_LINE_OPTIONS + 1);
+
+/**
+ * Sets one search criterion of a query from its option name and value
+ */
+static int set_query_arg(struct find_query *query, int option,
+			 const char *value)
+{
+	char *endptr;
+	long plugged;
+
+	switch (option) {
+	case FIND_OPT_LABEL:
+		if (strlen(value) > FIND_LABEL_GLOB_MAX_LENGTH) {
+			ERROR_PRINTF("Invalid --label arg: '%s'\n", value);
+			return -EINVAL;
+		}
+		strcpy(query->label, value);
+		query->has_label = true;
+		break;
+	case FIND_OPT_TYPE:
+		if (strlen(value) > OBJ_TYPE_MAX_LENGTH) {
+			ERROR_PRINTF("Invalid --type arg: '%s'\n", value);
+			return -EINVAL;
+		}
+		strcpy(query->type, value);
+		break;
+	case FIND_OPT_PLUGGED:
+		plugged = strtol(value, &endptr, 0);
+		if (*endptr != '\0' || endptr == value ||
+		    plugged < 0 || plugged > 1) {
+			ERROR_PRINTF("Invalid --plugged arg: '%s'\n", value);
+			return -EINVAL;
+		}
+		query->plugged = plugged;
+		break;
+	case FIND_OPT_CONTAINER:
+		if (parse_object_name(value, "dprc",
+				      &query->container_id) < 0)
+			return -EINVAL;
+		query->has_container = true;
+		break;
+	default:
+		assert(false);
+		return -EINVAL;
+	}
+
+	return 0;
+}
+
+/**
+ * Parses a query line of a --queries file, holding the same options as
+ * the command line: --label=, --type=, --plugged= and --container=
+ */
+static int parse_query_line(char *line, int line_num,
+			    struct find_query *query)
+{
+	static const int query_options[] = {
+		FIND_OPT_LABEL, FIND_OPT_TYPE,
+		FIND_OPT_PLUGGED, FIND_OPT_CONTAINER,
+	};
+	char *saveptr = NULL;
+	char *token;
+	int error;
+
+	memset(query, 0, sizeof(*query));
+	query->plugged = -1;
+
+	for (token = strtok_r(line, " \t\r\n", &saveptr);
+	     token != NULL;
+	     token = strtok_r(NULL, " \t\r\n", &saveptr)) {
+		const char *name;
+		size_t len;
+		unsigned int i;
+
+		for (i = 0; i < ARRAY_SIZE(query_options); i++) {
+			name = find_options[query_options[i]].name;
+			len = strlen(name);
+			if (strncmp(token, "--", 2) == 0 &&
+			    strncmp(token + 2, name, len) == 0 &&
+			    token[len + 2] == '=')
+				break;
+		}
+
+		if (i == ARRAY_SIZE(query_options)) {
+			ERROR_PRINTF("line %d: invalid argument '%s'\n",
+				     line_num, token);
+			return -EINVAL;
+		}
+
+		error = set_query_arg(query, query_options[i],
+				      token + len + 3);
+		if (error < 0) {
+			ERROR_PRINTF("line %d: invalid argument '%s'\n",
+				     line_num, token);
+			return error;
+		}
+	}
+
+	return 0;
+}
+
+/**
+ * Tells whether an object sits in a container, directly or in one of
+ * its nested containers
+ */
+static bool obj_in_container(const struct topology *index,
+			     const struct topology_obj *obj,
+			     uint32_t container_id)
+{
+	uint32_t parent_id = obj->parent_dprc_id;
+	struct topology_obj *parent;
+
+	for (;;) {
+		if (parent_id == container_id)
+			return true;
+		if (parent_id == restool.root_dprc_id)
+			return false;
+
+		parent = topology_find(index, "dprc", parent_id);
+		if (parent == NULL)
+			return false;
+		parent_id = parent->parent_dprc_id;
+	}
+}
+
+static bool query_match(const struct topology *index,
+			const struct find_query *query,
+			const struct topology_obj *obj)
+{
+	if (query->type[0] != '\0' && strcmp(query->type, obj->desc.type))
+		return false;
+
+	if (query->plugged != -1 &&
+	    query->plugged != !!(obj->desc.state & DPRC_OBJ_STATE_PLUGGED))
+		return false;
+
+	if (query->has_label && fnmatch(query->label, obj->desc.label, 0))
+		return false;
+
+	if (query->has_container &&
+	    !obj_in_container(index, obj, query->container_id))
+		return false;
+
+	return true;
+}
+
+static void print_json_string(const char *str)
+{
+	putchar('"');
+	for (; *str != '\0'; str++) {
+		if (*str == '"' || *str == '\\')
+			printf("\\%c", *str);
+		else if ((unsigned char)*str < 0x20)
+			printf("\\u%04x", *str);
+		else
+			putchar(*str);
+	}
+	putchar('"');
+}
+
+/**
+ * Runs one query against the index. In JSON mode the matching objects
+ * are printed as one array per query, on a single line.
+ */
+static int run_query(const struct topology *index,
+		     const struct find_query *query, bool json)
+{
+	const struct topology_obj *obj;
+	int num_found = 0;
+	char name[32];
+
+	if (json)
+		putchar('[');
+
+	for (int i = 0; i < index->num_objs; i++) {
+		obj = &index->objs[i];
+		if (!query_match(index, query, obj))
+			continue;
+
+		if (json) {
+			printf("%s{\"object\":\"%s.%d\",\"container\":\"dprc.%u\","
+			       "\"plugged\":%s,\"label\":",
+			       num_found ? "," : "",
+			       obj->desc.type, obj->desc.id,
+			       obj->parent_dprc_id,
+			       obj->desc.state & DPRC_OBJ_STATE_PLUGGED ?
+					"true" : "false");
+			print_json_string(obj->desc.label);
+			putchar('}');
+		} else {
+			snprintf(name, sizeof(name), "%s.%d", obj->desc.type,
+				 obj->desc.id);
+			printf("%-12s dprc.%-5u %-9s %s\n", name,
+			       obj->parent_dprc_id,
+			       obj->desc.state & DPRC_OBJ_STATE_PLUGGED ?
+					"plugged" : "unplugged",
+			       obj->desc.label);
+		}
+		num_found++;
+	}
+
+	if (json)
+		printf("]\n");
+
+	return num_found;
+}
+
+static int run_query_file(const struct topology *index,
+			  const char *file_name, bool json)
+{
+	struct find_query query;
+	size_t line_size = 0;
+	char *line = NULL;
+	int line_num = 0;
+	int error = 0;
+	FILE *fp;
+
+	if (strcmp(file_name, "-") == 0) {
+		fp = stdin;
+	} else {
+		fp = fopen(file_name, "r");
+		if (fp == NULL) {
+			error = -errno;
+			ERROR_PRINTF("Could not open query list '%s': %s\n",
+				     file_name, strerror(errno));
+			return error;
+		}
+	}
+
+	while (getline(&line, &line_size, fp) != -1) {
+		char *comment;
+
+		line_num++;
+		comment = strchr(line, '#');
+		if (comment != NULL)
+			*comment = '\0';
+
+		if (line[strspn(line, " \t\r\n")] == '\0')
+			continue;
+
+		if (!json)
+			printf("# %s", line);
+
+		error = parse_query_line(line, line_num, &query);
+		if (error < 0)
+			break;
+
+		(void)run_query(index, &query, json);
+	}
+
+	free(line);
+	if (fp != stdin)
+		fclose(fp);
+
+	return error;
+}
+
+static int cmd_find(void)
+{
+	static const char usage_msg[] =
+		"\n"
+		"Usage: restool find [--label=<glob>] [--type=<object-type>]\n"
+		"                    [--plugged=<state>] [--container=<container>]\n"
+		"                    [--queries=<file>] [--json]\n"
+		"\n"
+		"OPTIONS:\n"
+		"--label=<glob>\n"
+		"   Objects whose label matches the shell wildcard pattern.\n"
+		"--type=<object-type>\n"
+		"   Objects of the given type, e.g. dpni.\n"
+		"--plugged=<state>\n"
+		"   Objects in the given plugged state, 0 or 1.\n"
+		"--container=<container>\n"
+		"   Objects held by the container or one of its nested containers.\n"
+		"--queries=<file>\n"
+		"   Runs the queries listed in <file>, one per line, with the\n"
+		"   options above. Use - to read the queries from stdin.\n"
+		"--json\n"
+		"   Prints the objects found by each query as a JSON array,\n"
+		"   one line per query.\n"
+		"\n"
+		"NOTES:\n"
+		" -The container tree is walked once, all queries are run\n"
+		"  against that snapshot.\n"
+		" -Each found object is printed with its container, plugged\n"
+		"  state and label.\n"
+		"\n"
+		"EXAMPLES:\n"
+		"Find the network interfaces of tenant1:\n"
+		"   $ restool find --label='tenant1*' --type=dpni\n"
+		"Run several queries:\n"
+		"   $ printf -- '--type=dpni\\n--type=dpmac --plugged=0\\n' | restool find --queries=-\n"
+		"\n";
+
+	static const int query_options[] = {
+		FIND_OPT_LABEL, FIND_OPT_TYPE,
+		FIND_OPT_PLUGGED, FIND_OPT_CONTAINER,
+	};
+	struct topology index = { 0 };
+	struct find_query query;
+	const char *queries_file = NULL;
+	bool has_query = false;
+	bool json = false;
+	int error;
+
+	if (restool.cmd_option_mask & ONE_BIT_MASK(FIND_OPT_HELP)) {
+		puts(usage_msg);
+		restool.cmd_option_mask &= ~ONE_BIT_MASK(FIND_OPT_HELP);
+		return 0;
+	}
+
+	if (restool.obj_name != NULL) {
+		ERROR_PRINTF("Unexpected argument: \'%s\'\n\n",
+			     restool.obj_name);
+		puts(usage_msg);
+		return -EINVAL;
+	}
+
+	memset(&query, 0, sizeof(query));
+	query.plugged = -1;
+	for (unsigned int i = 0; i < ARRAY_SIZE(query_options); i++) {
+		int option = query_options[i];
+
+		if (!(restool.cmd_option_mask & ONE_BIT_MASK(option)))
+			continue;
+
+		restool.cmd_option_mask &= ~ONE_BIT_MASK(option);
+		error = set_query_arg(&query, option,
+				      restool.cmd_option_args[option]);
+		if (error < 0)
+			return error;
+		has_query = true;
+	}
+
+	if (restool.cmd_option_mask & ONE_BIT_MASK(FIND_OPT_QUERIES)) {
+		restool.cmd_option_mask &= ~ONE_BIT_MASK(FIND_OPT_QUERIES);
+		if (has_query) {
+			ERROR_PRINTF("--queries cannot be combined with other query options\n");
+			puts(usage_msg);
+			return -EINVAL;
+		}
+		queries_file = restool.cmd_option_args[FIND_OPT_QUERIES];
+	}
+
+	if (restool.cmd_option_mask & ONE_BIT_MASK(FIND_OPT_JSON)) {
+		restool.cmd_option_mask &= ~ONE_BIT_MASK(FIND_OPT_JSON);
+		json = true;
+	}
+
+	error = get_topology(restool.root_dprc_id, restool.root_dprc_handle,
+			     0, &index);
+	if (error < 0)
+		goto out;
+
+	if (queries_file != NULL)
+		error = run_query_file(&index, queries_file, json);
+	else
+		(void)run_query(&index, &query, json);
+out:
+	free_topology(&index);
+	return error;
+}
+
+/**
+ * find command table
+ */
+struct object_command find_commands[] = {
+	{ .cmd_name = "find",
+	  .options = find_options,
+	  .cmd_func = cmd_find },
+
+	{ .cmd_name = NULL },
+};
@@ -0,0 +1,2100 @@
+/* Copyright 2026 NXP
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * * Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ * * Neither the name of the above-listed copyright holders nor the
+ * names of any contributors may be used to endorse or promote products
+ * derived from this software without specific prior written permission.
+ *
+ *
+ * ALTERNATIVELY, this software may be distributed under the terms of the
+ * GNU General Public License ("GPL") as published by the Free Software
+ * Foundation, either version 2 of that License or (at your option) any
+ * later version.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDERS OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <errno.h>
+#include <assert.h>
+#include <getopt.h>
+#include <dirent.h>
+#include "restool.h"
+#include "utils.h"
+#include "mc_v9/fsl_dpio.h"
+#include "mc_v9/fsl_dpsw.h"
+#include "mc_v9/fsl_dpdmux.h"
+#include "mc_v10/fsl_dpbp.h"
+#include "mc_v10/fsl_dpcon.h"
+#include "mc_v10/fsl_dpio.h"
+#include "mc_v10/fsl_dpmcp.h"
+#include "mc_v10/fsl_dpni.h"
+#include "mc_v10/fsl_dpsw.h"
+#include "mc_v10/fsl_dpdmux.h"
+
+#define SYSFS_FSL_MC_DIR	"/sys/bus/fsl-mc"
+
+/**
+ * Most objects a composite command creates in one session
+ */
+#define LS_MAX_OBJS		32
+
+/**
+ * Most links a composite command makes in one session: one per switch
+ * interface
+ */
+#define LS_MAX_LINKS		DPSW_MAX_IF
+
+/**
+ * DPIOs the container of a new interface is topped up to, and DPCONs
+ * created for the interface, as the ls-addni script does
+ */
+#define NI_NUM_DPIOS		8
+#define NI_NUM_DPCONS		8
+
+/**
+ * How long ni add waits for the kernel to bind the new DPNI, in steps
+ * of 100ms
+ */
+#define NETDEV_WAIT_STEPS	50
+
+enum mc_cmd_status mc_status;
+
+/**
+ * Objects a composite command created in its container and links it
+ * made, in creation order, so that a failure can undo all of them
+ */
+struct ls_session {
+	uint32_t dprc_id;
+	uint16_t dprc_handle;
+	struct {
+		const char *type;
+		uint32_t id;
+	} objs[LS_MAX_OBJS];
+	int num_objs;
+	struct dprc_endpoint links[LS_MAX_LINKS];
+	int num_links;
+};
+
+/**
+ * Numeric option of a composite command and its valid range
+ */
+struct ls_option_range {
+	int option;
+	const char *name;
+	long min;
+	long max;
+};
+
+/**
+ * ni add command options
+ */
+enum ni_add_options {
+	NI_ADD_OPT_HELP = 0,
+	NI_ADD_OPT_CONTAINER,
+	NI_ADD_OPT_LABEL,
+	NI_ADD_OPT_MAC_ADDR,
+	NI_ADD_OPT_NO_LINK,
+	NI_ADD_OPT_LOOPBACK,
+	NI_ADD_OPT_OPTIONS,
+	NI_ADD_OPT_NUM_QUEUES,
+	NI_ADD_OPT_NUM_TCS,
+	NI_ADD_OPT_MAC_ENTRIES,
+	NI_ADD_OPT_VLAN_ENTRIES,
+	NI_ADD_OPT_QOS_ENTRIES,
+	NI_ADD_OPT_FS_ENTRIES,
+};
+
+static struct option ni_add_options[] = {
+	[NI_ADD_OPT_HELP] = {
+		.name = "help",
+	},
+
+	[NI_ADD_OPT_CONTAINER] = {
+		.name = "container",
+		.has_arg = 1,
+	},
+
+	[NI_ADD_OPT_LABEL] = {
+		.name = "label",
+		.has_arg = 1,
+	},
+
+	[NI_ADD_OPT_MAC_ADDR] = {
+		.name = "mac-addr",
+		.has_arg = 1,
+	},
+
+	[NI_ADD_OPT_NO_LINK] = {
+		.name = "no-link",
+	},
+
+	[NI_ADD_OPT_LOOPBACK] = {
+		.name = "loopback",
+	},
+
+	[NI_ADD_OPT_OPTIONS] = {
+		.name = "options",
+		.has_arg = 1,
+	},
+
+	[NI_ADD_OPT_NUM_QUEUES] = {
+		.name = "num-queues",
+		.has_arg = 1,
+	},
+
+	[NI_ADD_OPT_NUM_TCS] = {
+		.name = "num-tcs",
+		.has_arg = 1,
+	},
+
+	[NI_ADD_OPT_MAC_ENTRIES] = {
+		.name = "mac-entries",
+		.has_arg = 1,
+	},
+
+	[NI_ADD_OPT_VLAN_ENTRIES] = {
+		.name = "vlan-entries",
+		.has_arg = 1,
+	},
+
+	[NI_ADD_OPT_QOS_ENTRIES] = {
+		.name = "qos-entries",
+		.has_arg = 1,
+	},
+
+	[NI_ADD_OPT_FS_ENTRIES] = {
+		.name = "fs-entries",
+		.has_arg = 1,
+	},
+
+	{ 0 },
+};
+
+C_ASSERT(ARRAY_SIZE(ni_add_options) <= MAX_NUM_CMD_LINE_OPTIONS + 1);
+
+/**
+ * sw add command options
+ */
+enum sw_add_options {
+	SW_ADD_OPT_HELP = 0,
+	SW_ADD_OPT_CONTAINER,
+	SW_ADD_OPT_LABEL,
+	SW_ADD_OPT_ENDPOINTS,
+	SW_ADD_OPT_OPTIONS,
+	SW_ADD_OPT_NUM_IFS,
+	SW_ADD_OPT_MAX_VLANS,
+	SW_ADD_OPT_MAX_FDBS,
+	SW_ADD_OPT_MAX_FDB_ENTRIES,
+	SW_ADD_OPT_FDB_AGING_TIME,
+	SW_ADD_OPT_MAX_FDB_MC_GROUPS,
+};
+
+static struct option sw_add_options[] = {
+	[SW_ADD_OPT_HELP] = {
+		.name = "help",
+	},
+
+	[SW_ADD_OPT_CONTAINER] = {
+		.name = "container",
+		.has_arg = 1,
+	},
+
+	[SW_ADD_OPT_LABEL] = {
+		.name = "label",
+		.has_arg = 1,
+	},
+
+	[SW_ADD_OPT_ENDPOINTS] = {
+		.name = "endpoints",
+		.has_arg = 1,
+	},
+
+	[SW_ADD_OPT_OPTIONS] = {
+		.name = "options",
+		.has_arg = 1,
+	},
+
+	[SW_ADD_OPT_NUM_IFS] = {
+		.name = "num-ifs",
+		.has_arg = 1,
+	},
+
+	[SW_ADD_OPT_MAX_VLANS] = {
+		.name = "max-vlans",
+		.has_arg = 1,
+	},
+
+	[SW_ADD_OPT_MAX_FDBS] = {
+		.name = "max-fdbs",
+		.has_arg = 1,
+	},
+
+	[SW_ADD_OPT_MAX_FDB_ENTRIES] = {
+		.name = "max-fdb-entries",
+		.has_arg = 1,
+	},
+
+	[SW_ADD_OPT_FDB_AGING_TIME] = {
+		.name = "fdb-aging-time",
+		.has_arg = 1,
+	},
+
+	[SW_ADD_OPT_MAX_FDB_MC_GROUPS] = {
+		.name = "max-fdb-mc-groups",
+		.has_arg = 1,
+	},
+
+	{ 0 },
+};
+
+C_ASSERT(ARRAY_SIZE(sw_add_options) <= MAX_NUM_CMD_LINE_OPTIONS + 1);
+
+/**
+ * mux add command options
+ */
+enum mux_add_options {
+	MUX_ADD_OPT_HELP = 0,
+	MUX_ADD_OPT_CONTAINER,
+	MUX_ADD_OPT_LABEL,
+	MUX_ADD_OPT_DOWNLINKS,
+	MUX_ADD_OPT_VEPA,
+	MUX_ADD_OPT_OPTIONS,
+	MUX_ADD_OPT_METHOD,
+	MUX_ADD_OPT_NUM_IFS,
+	MUX_ADD_OPT_MAX_DMAT_ENTRIES,
+	MUX_ADD_OPT_MAX_MC_GROUPS,
+};
+
+static struct option mux_add_options[] = {
+	[MUX_ADD_OPT_HELP] = {
+		.name = "help",
+	},
+
+	[MUX_ADD_OPT_CONTAINER] = {
+		.name = "container",
+		.has_arg = 1,
+	},
+
+	[MUX_ADD_OPT_LABEL] = {
+		.name = "label",
+		.has_arg = 1,
+	},
+
+	[MUX_ADD_OPT_DOWNLINKS] = {
+		.name = "downlinks",
+		.has_arg = 1,
+	},
+
+	[MUX_ADD_OPT_VEPA] = {
+		.name = "vepa",
+	},
+
+	[MUX_ADD_OPT_OPTIONS] = {
+		.name = "options",
+		.has_arg = 1,
+	},
+
+	[MUX_ADD_OPT_METHOD] = {
+		.name = "method",
+		.has_arg = 1,
+	},
+
+	[MUX_ADD_OPT_NUM_IFS] = {
+		.name = "num-ifs",
+		.has_arg = 1,
+	},
+
+	[MUX_ADD_OPT_MAX_DMAT_ENTRIES] = {
+		.name = "max-dmat-entries",
+		.has_arg = 1,
+	},
+
+	[MUX_ADD_OPT_MAX_MC_GROUPS] = {
+		.name = "max-mc-groups",
+		.has_arg = 1,
+	},
+
+	{ 0 },
+};
+
+C_ASSERT(ARRAY_SIZE(mux_add_options) <= MAX_NUM_CMD_LINE_OPTIONS + 1);
+
+/**
+ * ni list and mac list command options
+ */
+enum ls_list_options {
+	LS_LIST_OPT_HELP = 0,
+};
+
+static struct option ls_list_options[] = {
+	[LS_LIST_OPT_HELP] = {
+		.name = "help",
+	},
+
+	{ 0 },
+};
+
+C_ASSERT(ARRAY_SIZE(ls_list_options) <= MAX_NUM_CMD_LINE_OPTIONS + 1);
+
+static struct option_entry ni_options_map[] = {
+	OPTION_MAP_ENTRY(DPNI_OPT_TX_FRM_RELEASE),
+	OPTION_MAP_ENTRY(DPNI_OPT_NO_MAC_FILTER),
+	OPTION_MAP_ENTRY(DPNI_OPT_HAS_POLICING),
+	OPTION_MAP_ENTRY(DPNI_OPT_SHARED_CONGESTION),
+	OPTION_MAP_ENTRY(DPNI_OPT_HAS_KEY_MASKING),
+	OPTION_MAP_ENTRY(DPNI_OPT_NO_FS),
+};
+
+static struct option_entry sw_options_map[] = {
+	OPTION_MAP_ENTRY(DPSW_OPT_FLOODING_DIS),
+	OPTION_MAP_ENTRY(DPSW_OPT_MULTICAST_DIS),
+	OPTION_MAP_ENTRY(DPSW_OPT_CTRL_IF_DIS),
+	OPTION_MAP_ENTRY(DPSW_OPT_FLOODING_METERING_DIS),
+	OPTION_MAP_ENTRY(DPSW_OPT_METERING_EN),
+};
+
+static struct option_entry mux_options_map[] = {
+	OPTION_MAP_ENTRY(DPDMUX_OPT_CLS_MASK_SUPPORT),
+};
+
+static const struct {
+	const char *name;
+	enum dpdmux_method method;
+} mux_methods[] = {
+	{ "DPDMUX_METHOD_NONE", DPDMUX_METHOD_NONE },
+	{ "DPDMUX_METHOD_C_VLAN_MAC", DPDMUX_METHOD_C_VLAN_MAC },
+	{ "DPDMUX_METHOD_MAC", DPDMUX_METHOD_MAC },
+	{ "DPDMUX_METHOD_C_VLAN", DPDMUX_METHOD_C_VLAN },
+	{ "DPDMUX_METHOD_CUSTOM", DPDMUX_METHOD_CUSTOM },
+};
+
+static int cmd_ni_help(void)
+{
+	static const char help_msg[] =
+		"\n"
+		"Usage: restool ni <command> [--help] [ARGS...]\n"
+		"Where <command> can be:\n"
+		"   add - creates a network interface: a DPNI with the objects\n"
+		"         its driver needs, linked to an endpoint.\n"
+		"   list - lists the DPNIs of all containers with their network\n"
+		"          interface, endpoint and label.\n"
+		"\n"
+		"For command-specific help, use the --help option of each command.\n"
+		"\n";
+
+	printf(help_msg);
+	return 0;
+}
+
+static int cmd_sw_help(void)
+{
+	static const char help_msg[] =
+		"\n"
+		"Usage: restool sw <command> [--help] [ARGS...]\n"
+		"Where <command> can be:\n"
+		"   add - creates a switch: a DPSW with the objects its driver\n"
+		"         needs, its interfaces linked to endpoints.\n"
+		"\n"
+		"For command-specific help, use the --help option of each command.\n"
+		"\n";
+
+	printf(help_msg);
+	return 0;
+}
+
+static int cmd_mux_help(void)
+{
+	static const char help_msg[] =
+		"\n"
+		"Usage: restool mux <command> [--help] [ARGS...]\n"
+		"Where <command> can be:\n"
+		"   add - creates an EVB: a DPDMUX with the objects its driver\n"
+		"         needs, its uplink and downlinks linked to endpoints.\n"
+		"\n"
+		"For command-specific help, use the --help option of each command.\n"
+		"\n";
+
+	printf(help_msg);
+	return 0;
+}
+
+static int cmd_mac_help(void)
+{
+	static const char help_msg[] =
+		"\n"
+		"Usage: restool mac <command> [--help] [ARGS...]\n"
+		"Where <command> can be:\n"
+		"   list - lists the DPMACs of all containers with their endpoint\n"
+		"          and label.\n"
+		"\n"
+		"For command-specific help, use the --help option of each command.\n"
+		"\n";
+
+	printf(help_msg);
+	return 0;
+}
+
+static void print_ls_mc_error(const char *obj_type, int obj_id,
+			      const char *op, int error)
+{
+	mc_status = flib_error_to_mc_status(error);
+	if (obj_id < 0)
+		ERROR_PRINTF("%s %s: MC error: %s (status %#x)\n",
+			     obj_type, op, mc_status_to_string(mc_status),
+			     mc_status);
+	else
+		ERROR_PRINTF("%s.%d %s: MC error: %s (status %#x)\n",
+			     obj_type, obj_id, op,
+			     mc_status_to_string(mc_status), mc_status);
+}
+
+static void format_endpoint(const struct dprc_endpoint *endpoint,
+			    char *name, size_t size)
+{
+	if (strcmp(endpoint->type, "dpsw") == 0 ||
+	    strcmp(endpoint->type, "dpdmux") == 0)
+		snprintf(name, size, "%s.%d.%u", endpoint->type,
+			 endpoint->id, (uint32_t)endpoint->if_id);
+	else
+		snprintf(name, size, "%s.%d", endpoint->type, endpoint->id);
+}
+
+/*
+ * Endpoints may be given with their container path, as printed by
+ * 'dprc list --full-path'. DPSW and DPDMUX endpoints need an interface.
+ */
+static int parse_ls_endpoint(const char *endpoint_str,
+			     struct dprc_endpoint *endpoint)
+{
+	const char *name = strrchr(endpoint_str, '/');
+	bool has_ifs;
+	int if_id = 0;
+	int n;
+
+	name = name != NULL ? name + 1 : endpoint_str;
+	memset(endpoint, 0, sizeof(*endpoint));
+	n = sscanf(name, "%" STRINGIFY(OBJ_TYPE_MAX_LENGTH) "[a-z].%d.%d",
+		   endpoint->type, &endpoint->id, &if_id);
+
+	has_ifs = strcmp(endpoint->type, "dpsw") == 0 ||
+		  strcmp(endpoint->type, "dpdmux") == 0;
+	if (n < 2 || endpoint->id < 0 || if_id < 0 ||
+	    n != (has_ifs ? 3 : 2) ||
+	    (!has_ifs && strcmp(endpoint->type, "dpmac") != 0 &&
+	     strcmp(endpoint->type, "dpni") != 0)) {
+		ERROR_PRINTF("Invalid endpoint: %s\n", endpoint_str);
+		return -EINVAL;
+	}
+
+	endpoint->if_id = if_id;
+	return 0;
+}
+
+/*
+ * An endpoint can take a new link if it exists in the topology snapshot
+ * and has no link yet
+ */
+static int check_ls_endpoint(const struct topology *topology,
+			     const struct dprc_endpoint *endpoint)
+{
+	char name[OBJ_TYPE_MAX_LENGTH + 24];
+	char peer_name[OBJ_TYPE_MAX_LENGTH + 24];
+	struct dprc_endpoint peer;
+	int state;
+	int error;
+
+	format_endpoint(endpoint, name, sizeof(name));
+	if (topology_find(topology, endpoint->type, endpoint->id) == NULL) {
+		ERROR_PRINTF("Endpoint %s does not exist\n", name);
+		return -ENOENT;
+	}
+
+	memset(&peer, 0, sizeof(peer));
+	error = get_connection(endpoint, &peer, &state);
+	if (error < 0) {
+		print_ls_mc_error(endpoint->type, endpoint->id,
+				  "get connection", error);
+		return error;
+	}
+
+	if (state != -1) {
+		format_endpoint(&peer, peer_name, sizeof(peer_name));
+		ERROR_PRINTF("%s is already linked to %s\n", name, peer_name);
+		return -EBUSY;
+	}
+
+	return 0;
+}
+
+static int count_ls_objs(const struct topology *topology, uint32_t dprc_id,
+			 const char *obj_type)
+{
+	int count = 0;
+
+	for (int i = 0; i < topology->num_objs; i++) {
+		if (topology->objs[i].parent_dprc_id == dprc_id &&
+		    strcmp(topology->objs[i].desc.type, obj_type) == 0)
+			count++;
+	}
+
+	return count;
+}
+
+static int open_ls_session(uint32_t dprc_id, struct ls_session *session)
+{
+	memset(session, 0, sizeof(*session));
+	session->dprc_id = dprc_id;
+	session->dprc_handle = restool.root_dprc_handle;
+	if (dprc_id == restool.root_dprc_id)
+		return 0;
+
+	return open_dprc(dprc_id, &session->dprc_handle);
+}
+
+static void close_ls_session(const struct ls_session *session)
+{
+	if (session->dprc_id != restool.root_dprc_id)
+		(void)dprc_close(&restool.mc_io, 0, session->dprc_handle);
+}
+
+static int plug_ls_obj(const struct ls_session *session,
+		       const char *obj_type, uint32_t obj_id)
+{
+	struct dprc_res_req res_req;
+
+	memset(&res_req, 0, sizeof(res_req));
+	strcpy(res_req.type, obj_type);
+	res_req.num = 1;
+	res_req.options = DPRC_RES_REQ_OPT_EXPLICIT | DPRC_RES_REQ_OPT_PLUGGED;
+	res_req.id_base_align = obj_id;
+
+	return dprc_assign(&restool.mc_io, 0, session->dprc_handle,
+			   session->dprc_id, &res_req);
+}
+
+/*
+ * Creates an object in the container of the session and records it. The
+ * object is plugged right away unless the caller has more to configure.
+ */
+static int create_ls_obj(struct ls_session *session, const char *obj_type,
+			 const void *cfg, bool plug, uint32_t *obj_id)
+{
+	uint16_t dprc_handle = session->dprc_handle;
+	int error;
+
+	assert(session->num_objs < LS_MAX_OBJS);
+	if (strcmp(obj_type, "dpni") == 0)
+		error = dpni_create_v10(&restool.mc_io, dprc_handle, 0,
+					cfg, obj_id);
+	else if (strcmp(obj_type, "dpbp") == 0)
+		error = dpbp_create_v10(&restool.mc_io, dprc_handle, 0,
+					cfg, obj_id);
+	else if (strcmp(obj_type, "dpio") == 0)
+		error = dpio_create_v10(&restool.mc_io, dprc_handle, 0,
+					cfg, obj_id);
+	else if (strcmp(obj_type, "dpcon") == 0)
+		error = dpcon_create_v10(&restool.mc_io, dprc_handle, 0,
+					 cfg, obj_id);
+	else if (strcmp(obj_type, "dpmcp") == 0)
+		error = dpmcp_create_v10(&restool.mc_io, dprc_handle, 0,
+					 cfg, obj_id);
+	else if (strcmp(obj_type, "dpsw") == 0)
+		error = dpsw_create_v10(&restool.mc_io, dprc_handle, 0,
+					cfg, obj_id);
+	else if (strcmp(obj_type, "dpdmux") == 0)
+		error = dpdmux_create_v10(&restool.mc_io, dprc_handle, 0,
+					  cfg, obj_id);
+	else {
+		assert(false);
+		error = -EINVAL;
+	}
+
+	if (error) {
+		print_ls_mc_error(obj_type, -1, "create", error);
+		return error;
+	}
+
+	session->objs[session->num_objs].type = obj_type;
+	session->objs[session->num_objs].id = *obj_id;
+	session->num_objs++;
+
+	if (!plug)
+		return 0;
+
+	error = plug_ls_obj(session, obj_type, *obj_id);
+	if (error)
+		print_ls_mc_error(obj_type, *obj_id, "plug", error);
+
+	return error;
+}
+
+static int destroy_ls_obj(uint16_t dprc_handle, const char *obj_type,
+			  uint32_t obj_id)
+{
+	if (strcmp(obj_type, "dpni") == 0)
+		return dpni_destroy_v10(&restool.mc_io, dprc_handle, 0,
+					obj_id);
+	else if (strcmp(obj_type, "dpbp") == 0)
+		return dpbp_destroy_v10(&restool.mc_io, dprc_handle, 0,
+					obj_id);
+	else if (strcmp(obj_type, "dpio") == 0)
+		return dpio_destroy_v10(&restool.mc_io, dprc_handle, 0,
+					obj_id);
+	else if (strcmp(obj_type, "dpcon") == 0)
+		return dpcon_destroy_v10(&restool.mc_io, dprc_handle, 0,
+					 obj_id);
+	else if (strcmp(obj_type, "dpmcp") == 0)
+		return dpmcp_destroy_v10(&restool.mc_io, dprc_handle, 0,
+					 obj_id);
+	else if (strcmp(obj_type, "dpsw") == 0)
+		return dpsw_destroy_v10(&restool.mc_io, dprc_handle, 0,
+					obj_id);
+	else if (strcmp(obj_type, "dpdmux") == 0)
+		return dpdmux_destroy_v10(&restool.mc_io, dprc_handle, 0,
+					  obj_id);
+
+	assert(false);
+	return -EINVAL;
+}
+
+static int label_ls_obj(const struct ls_session *session,
+			const char *obj_type, uint32_t obj_id,
+			const char *label)
+{
+	char label_str[MC_OBJ_LABEL_MAX_LENGTH + 1];
+	char type_str[OBJ_TYPE_MAX_LENGTH + 1];
+	int error;
+
+	if (label == NULL)
+		return 0;
+
+	snprintf(type_str, sizeof(type_str), "%s", obj_type);
+	snprintf(label_str, sizeof(label_str), "%s", label);
+	error = dprc_set_obj_label(&restool.mc_io, 0, session->dprc_handle,
+				   type_str, obj_id, label_str);
+	if (error)
+		print_ls_mc_error(obj_type, obj_id, "set label", error);
+
+	return error;
+}
+
+/*
+ * Links two endpoints and records the link. Links are made from the root
+ * container, which sees the endpoints of all containers.
+ */
+static int connect_ls_link(struct ls_session *session,
+			   const struct dprc_endpoint *endpoint1,
+			   const struct dprc_endpoint *endpoint2)
+{
+	char name1[OBJ_TYPE_MAX_LENGTH + 24];
+	char name2[OBJ_TYPE_MAX_LENGTH + 24];
+	struct dprc_connection_cfg cfg = { 0 };
+	int error;
+
+	assert(session->num_links < LS_MAX_LINKS);
+	error = dprc_connect(&restool.mc_io, 0, restool.root_dprc_handle,
+			     endpoint1, endpoint2, &cfg);
+	if (error) {
+		format_endpoint(endpoint1, name1, sizeof(name1));
+		format_endpoint(endpoint2, name2, sizeof(name2));
+		mc_status = flib_error_to_mc_status(error);
+		ERROR_PRINTF("%s to %s connect: MC error: %s (status %#x)\n",
+			     name1, name2, mc_status_to_string(mc_status),
+			     mc_status);
+		return error;
+	}
+
+	session->links[session->num_links++] = *endpoint1;
+	return 0;
+}
+
+/*
+ * Removes the links of the session, then destroys its objects, newest
+ * first. The kernel has not seen any of them yet: the bus is only
+ * rescanned once a command succeeds.
+ */
+static void undo_ls_session(struct ls_session *session)
+{
+	char name[OBJ_TYPE_MAX_LENGTH + 24];
+	int error;
+
+	for (int i = session->num_links - 1; i >= 0; i--) {
+		error = dprc_disconnect(&restool.mc_io, 0,
+					restool.root_dprc_handle,
+					&session->links[i]);
+		if (error) {
+			format_endpoint(&session->links[i], name,
+					sizeof(name));
+			mc_status = flib_error_to_mc_status(error);
+			ERROR_PRINTF("%s disconnect: MC error: %s (status %#x)\n",
+				     name, mc_status_to_string(mc_status),
+				     mc_status);
+		}
+	}
+
+	session->num_links = 0;
+
+	for (int i = session->num_objs - 1; i >= 0; i--) {
+		error = destroy_ls_obj(session->dprc_handle,
+				       session->objs[i].type,
+				       session->objs[i].id);
+		if (error)
+			print_ls_mc_error(session->objs[i].type,
+					  session->objs[i].id, "destroy",
+					  error);
+	}
+
+	session->num_objs = 0;
+}
+
+/*
+ * Rescans only the container the objects were added to when the kernel
+ * has a rescan attribute per container, the whole fsl-mc bus otherwise
+ */
+static int rescan_ls_container(uint32_t dprc_id)
+{
+	char path[PATH_MAX];
+	FILE *fp;
+	int error = 0;
+
+	snprintf(path, sizeof(path), SYSFS_FSL_MC_DIR "/devices/dprc.%u/rescan",
+		 dprc_id);
+	fp = fopen(path, "w");
+	if (fp == NULL)
+		fp = fopen(SYSFS_FSL_MC_DIR "/rescan", "w");
+	if (fp == NULL)
+		return -errno;
+
+	if (fputs("1", fp) == EOF)
+		error = -EIO;
+	if (fclose(fp) != 0 && error == 0)
+		error = -errno;
+
+	if (error == 0)
+		restool.rescan_done = true;
+
+	return error;
+}
+
+/*
+ * Network interface of an object. Objects with ports, like a DPDMUX,
+ * also list the netdevs of their ports, named after their own.
+ */
+static bool get_netdev_name(const char *obj_name, char *netdev, size_t size)
+{
+	char path[PATH_MAX];
+	struct dirent *entry;
+	bool found = false;
+	DIR *dir;
+
+	snprintf(path, sizeof(path), SYSFS_FSL_MC_DIR "/devices/%s/net",
+		 obj_name);
+	dir = opendir(path);
+	if (dir == NULL)
+		return false;
+
+	while ((entry = readdir(dir)) != NULL) {
+		if (entry->d_name[0] == '.' ||
+		    (found && strlen(entry->d_name) >= strlen(netdev)))
+			continue;
+
+		snprintf(netdev, size, "%s", entry->d_name);
+		found = true;
+	}
+
+	closedir(dir);
+	return found;
+}
+
+static bool wait_for_netdev(const char *obj_name, char *netdev, size_t size)
+{
+	for (int i = 0; i < NETDEV_WAIT_STEPS; i++) {
+		if (get_netdev_name(obj_name, netdev, size))
+			return true;
+		usleep(100000);
+	}
+
+	return false;
+}
+
+/*
+ * Path of a container from the root container, as printed by
+ * 'dprc list --full-path'
+ */
+static void format_dprc_path(const struct topology *topology,
+			     uint32_t dprc_id, char *path, size_t size)
+{
+	struct topology_obj *obj = topology_find(topology, "dprc", dprc_id);
+	size_t len;
+
+	if (obj == NULL) {
+		snprintf(path, size, "dprc.%u", dprc_id);
+		return;
+	}
+
+	format_dprc_path(topology, obj->parent_dprc_id, path, size);
+	len = strlen(path);
+	snprintf(path + len, size - len, "/dprc.%u", dprc_id);
+}
+
+static void add_ls_detail(char *details, size_t size, const char *name,
+			  const char *value)
+{
+	size_t len = strlen(details);
+
+	snprintf(details + len, size - len, "%s%s: %s",
+		 len == 0 ? "(" : ", ", name, value);
+}
+
+static int print_ls_obj(const char *path, const struct dprc_obj_desc *desc)
+{
+	char peer_name[OBJ_TYPE_MAX_LENGTH + 24];
+	char obj_name[OBJ_TYPE_MAX_LENGTH + 12];
+	struct dprc_endpoint endpoint;
+	struct dprc_endpoint peer;
+	char details[PATH_MAX];
+	char netdev[PATH_MAX];
+	int state;
+	int error;
+
+	snprintf(obj_name, sizeof(obj_name), "%s.%d", desc->type, desc->id);
+	details[0] = '\0';
+
+	if (strcmp(desc->type, "dpni") == 0 &&
+	    get_netdev_name(obj_name, netdev, sizeof(netdev)))
+		add_ls_detail(details, sizeof(details), "interface", netdev);
+
+	memset(&endpoint, 0, sizeof(endpoint));
+	memset(&peer, 0, sizeof(peer));
+	strcpy(endpoint.type, desc->type);
+	endpoint.id = desc->id;
+	error = get_connection(&endpoint, &peer, &state);
+	if (error < 0) {
+		print_ls_mc_error(desc->type, desc->id, "get connection",
+				  error);
+		return error;
+	}
+
+	if (state != -1) {
+		format_endpoint(&peer, peer_name, sizeof(peer_name));
+		add_ls_detail(details, sizeof(details), "end point",
+			      peer_name);
+	}
+
+	if (desc->label[0] != '\0')
+		add_ls_detail(details, sizeof(details), "label", desc->label);
+
+	if (details[0] != '\0')
+		printf("%s/%s %s)\n", path, obj_name, details);
+	else
+		printf("%s/%s\n", path, obj_name);
+
+	return 0;
+}
+
+static int print_ls_container(const struct topology *topology,
+			      uint32_t dprc_id, const char *obj_type)
+{
+	char path[PATH_MAX];
+	int error;
+
+	format_dprc_path(topology, dprc_id, path, sizeof(path));
+	for (int i = 0; i < topology->num_objs; i++) {
+		const struct topology_obj *obj = &topology->objs[i];
+
+		if (obj->parent_dprc_id != dprc_id ||
+		    strcmp(obj->desc.type, obj_type) != 0)
+			continue;
+
+		error = print_ls_obj(path, &obj->desc);
+		if (error)
+			return error;
+	}
+
+	return 0;
+}
+
+/*
+ * Lists the objects of a type container by container, in the order of
+ * 'dprc list', from one walk of the container tree. Each link is queried
+ * once: the connection cache answers for the peer.
+ */
+static int list_ls_objs(const char *obj_type)
+{
+	struct topology topology;
+	int error;
+
+	memset(&topology, 0, sizeof(topology));
+	error = get_topology(restool.root_dprc_id, restool.root_dprc_handle,
+			     0, &topology);
+	if (error)
+		goto out;
+
+	error = print_ls_container(&topology, restool.root_dprc_id, obj_type);
+	for (int i = 0; i < topology.num_objs && error == 0; i++) {
+		if (strcmp(topology.objs[i].desc.type, "dprc") == 0)
+			error = print_ls_container(&topology,
+						   topology.objs[i].desc.id,
+						   obj_type);
+	}
+out:
+	free_topology(&topology);
+	return error;
+}
+
+static int get_ls_option_values(const struct ls_option_range *ranges,
+				unsigned int num_ranges, long *values)
+{
+	char error_msg[64];
+	int error;
+
+	for (unsigned int i = 0; i < num_ranges; i++) {
+		if (!(restool.cmd_option_mask &
+		      ONE_BIT_MASK(ranges[i].option)))
+			continue;
+
+		restool.cmd_option_mask &= ~ONE_BIT_MASK(ranges[i].option);
+		snprintf(error_msg, sizeof(error_msg), "Invalid %s value\n",
+			 ranges[i].name);
+		error = get_option_value(ranges[i].option, &values[i],
+					 error_msg, ranges[i].min,
+					 ranges[i].max);
+		if (error)
+			return error;
+	}
+
+	return 0;
+}
+
+static int get_ls_container(int option, uint32_t *dprc_id)
+{
+	*dprc_id = restool.root_dprc_id;
+	if (!(restool.cmd_option_mask & ONE_BIT_MASK(option)))
+		return 0;
+
+	restool.cmd_option_mask &= ~ONE_BIT_MASK(option);
+	return parse_object_name(restool.cmd_option_args[option], "dprc",
+				 dprc_id);
+}
+
+static int get_ls_label(int option, const char **label)
+{
+	*label = NULL;
+	if (!(restool.cmd_option_mask & ONE_BIT_MASK(option)))
+		return 0;
+
+	restool.cmd_option_mask &= ~ONE_BIT_MASK(option);
+	*label = restool.cmd_option_args[option];
+	if (strlen(*label) == 0 || strlen(*label) > MC_OBJ_LABEL_MAX_LENGTH) {
+		ERROR_PRINTF("label length must be 1 to %d characters\n",
+			     MC_OBJ_LABEL_MAX_LENGTH);
+		return -EINVAL;
+	}
+
+	return 0;
+}
+
+/*
+ * Comma separated list of endpoints, appended to those already in the
+ * array
+ */
+static int parse_ls_endpoint_list(const char *list_str,
+				  struct dprc_endpoint *endpoints,
+				  int max_endpoints, int *num_endpoints)
+{
+	char *list, *endpoint_str, *saveptr;
+	int error = 0;
+
+	list = strdup(list_str);
+	if (list == NULL) {
+		ERROR_PRINTF("strdup() failed\n");
+		return -ENOMEM;
+	}
+
+	for (endpoint_str = strtok_r(list, ",", &saveptr);
+	     endpoint_str != NULL;
+	     endpoint_str = strtok_r(NULL, ",", &saveptr)) {
+		if (*num_endpoints == max_endpoints) {
+			ERROR_PRINTF("More endpoints than interfaces: %s\n",
+				     list_str);
+			error = -EINVAL;
+			break;
+		}
+
+		error = parse_ls_endpoint(endpoint_str,
+					  &endpoints[*num_endpoints]);
+		if (error)
+			break;
+		(*num_endpoints)++;
+	}
+
+	free(list);
+	return error;
+}
+
+static int check_ls_container(const struct topology *topology,
+			      uint32_t dprc_id)
+{
+	if (dprc_id != restool.root_dprc_id &&
+	    topology_find(topology, "dprc", dprc_id) == NULL) {
+		ERROR_PRINTF("dprc.%u does not exist\n", dprc_id);
+		return -ENOENT;
+	}
+
+	return 0;
+}
+
+/*
+ * All the endpoints must exist and be free, and none may be given twice
+ */
+static int check_ls_endpoints(const struct topology *topology,
+			      const struct dprc_endpoint *endpoints,
+			      int num_endpoints)
+{
+	char name[OBJ_TYPE_MAX_LENGTH + 24];
+	int error;
+
+	for (int i = 0; i < num_endpoints; i++) {
+		for (int j = 0; j < i; j++) {
+			if (endpoints[j].id == endpoints[i].id &&
+			    endpoints[j].if_id == endpoints[i].if_id &&
+			    strcmp(endpoints[j].type,
+				   endpoints[i].type) == 0) {
+				format_endpoint(&endpoints[i], name,
+						sizeof(name));
+				ERROR_PRINTF("Endpoint %s is given twice\n",
+					     name);
+				return -EINVAL;
+			}
+		}
+
+		error = check_ls_endpoint(topology, &endpoints[i]);
+		if (error)
+			return error;
+	}
+
+	return 0;
+}
+
+/**
+ * Everything ni add needs to know before it creates anything
+ */
+struct ni_add_cfg {
+	struct dpni_cfg_v10 dpni_cfg;
+	uint32_t dprc_id;
+	const char *label;
+	bool set_mac_addr;
+	uint8_t mac_addr[6];
+	bool link;
+	bool loopback;
+	struct dprc_endpoint endpoint;
+	int num_dpios;
+};
+
+static int parse_ni_mac_addr(const char *mac_addr_str, uint8_t *mac_addr)
+{
+	int len = 0;
+
+	if (sscanf(mac_addr_str, "%2hhx:%2hhx:%2hhx:%2hhx:%2hhx:%2hhx%n",
+		   &mac_addr[0], &mac_addr[1], &mac_addr[2],
+		   &mac_addr[3], &mac_addr[4], &mac_addr[5], &len) != 6 ||
+	    mac_addr_str[len] != '\0') {
+		ERROR_PRINTF("Invalid MAC address: %s\n", mac_addr_str);
+		ERROR_PRINTF(
+			"Please enter 48 bits MAC address, eg. 00:0e:0c:55:12:03\n");
+		return -EINVAL;
+	}
+
+	return 0;
+}
+
+static int get_ni_dpni_cfg(struct dpni_cfg_v10 *cfg)
+{
+	static const struct ls_option_range ranges[] = {
+		{ NI_ADD_OPT_NUM_QUEUES, "num-queues", 1, 8 },
+		{ NI_ADD_OPT_NUM_TCS, "num-tcs", 1, 8 },
+		{ NI_ADD_OPT_MAC_ENTRIES, "mac-entries", 1, 80 },
+		{ NI_ADD_OPT_VLAN_ENTRIES, "vlan-entries", 1, 16 },
+		{ NI_ADD_OPT_QOS_ENTRIES, "qos-entries", 1, 64 },
+		{ NI_ADD_OPT_FS_ENTRIES, "fs-entries", 1, 1024 },
+	};
+	long values[ARRAY_SIZE(ranges)];
+	uint64_t options;
+	long cores;
+	int error;
+
+	memset(cfg, 0, sizeof(*cfg));
+
+	/* a queue per host core, as the ls-addni script defaults to */
+	cores = sysconf(_SC_NPROCESSORS_ONLN);
+	values[0] = cores < 1 ? 1 : cores > 8 ? 8 : cores;
+	for (unsigned int i = 1; i < ARRAY_SIZE(values); i++)
+		values[i] = 0;
+
+	error = get_ls_option_values(ranges, ARRAY_SIZE(ranges), values);
+	if (error)
+		return error;
+
+	cfg->num_queues = (uint8_t)values[0];
+	cfg->num_tcs = (uint8_t)values[1];
+	cfg->mac_filter_entries = (uint8_t)values[2];
+	cfg->vlan_filter_entries = (uint8_t)values[3];
+	cfg->qos_entries = (uint8_t)values[4];
+	cfg->fs_entries = (uint16_t)values[5];
+
+	if (restool.cmd_option_mask & ONE_BIT_MASK(NI_ADD_OPT_OPTIONS)) {
+		restool.cmd_option_mask &= ~ONE_BIT_MASK(NI_ADD_OPT_OPTIONS);
+		error = parse_generic_create_options(
+				restool.cmd_option_args[NI_ADD_OPT_OPTIONS],
+				&options, ni_options_map,
+				ARRAY_SIZE(ni_options_map));
+		if (error)
+			return error;
+		cfg->options = (uint32_t)options;
+	}
+
+	return 0;
+}
+
+static int get_ni_add_cfg(const char *usage_msg, struct ni_add_cfg *cfg)
+{
+	int num_modes = 0;
+	int error;
+
+	memset(cfg, 0, sizeof(*cfg));
+
+	if (restool.obj_name != NULL) {
+		error = parse_ls_endpoint(restool.obj_name, &cfg->endpoint);
+		if (error)
+			return error;
+		cfg->link = true;
+		num_modes++;
+	}
+
+	if (restool.cmd_option_mask & ONE_BIT_MASK(NI_ADD_OPT_NO_LINK)) {
+		restool.cmd_option_mask &= ~ONE_BIT_MASK(NI_ADD_OPT_NO_LINK);
+		num_modes++;
+	}
+
+	if (restool.cmd_option_mask & ONE_BIT_MASK(NI_ADD_OPT_LOOPBACK)) {
+		restool.cmd_option_mask &= ~ONE_BIT_MASK(NI_ADD_OPT_LOOPBACK);
+		/* the peer is the new DPNI, its id is filled in later */
+		strcpy(cfg->endpoint.type, "dpni");
+		cfg->link = true;
+		cfg->loopback = true;
+		num_modes++;
+	}
+
+	if (num_modes != 1) {
+		ERROR_PRINTF("Exactly one of <endpoint>, --no-link and --loopback must be given\n");
+		puts(usage_msg);
+		return -EINVAL;
+	}
+
+	error = get_ls_container(NI_ADD_OPT_CONTAINER, &cfg->dprc_id);
+	if (error)
+		return error;
+
+	error = get_ls_label(NI_ADD_OPT_LABEL, &cfg->label);
+	if (error)
+		return error;
+
+	if (restool.cmd_option_mask & ONE_BIT_MASK(NI_ADD_OPT_MAC_ADDR)) {
+		restool.cmd_option_mask &= ~ONE_BIT_MASK(NI_ADD_OPT_MAC_ADDR);
+		error = parse_ni_mac_addr(
+				restool.cmd_option_args[NI_ADD_OPT_MAC_ADDR],
+				cfg->mac_addr);
+		if (error)
+			return error;
+		cfg->set_mac_addr = true;
+	}
+
+	return get_ni_dpni_cfg(&cfg->dpni_cfg);
+}
+
+/*
+ * Checks the container and the endpoint against one topology snapshot,
+ * so that nothing is created for an interface that cannot be linked
+ */
+static int check_ni_add_cfg(struct ni_add_cfg *cfg)
+{
+	struct topology topology;
+	int error;
+
+	memset(&topology, 0, sizeof(topology));
+	error = get_topology(restool.root_dprc_id, restool.root_dprc_handle,
+			     0, &topology);
+	if (error)
+		return error;
+
+	error = check_ls_container(&topology, cfg->dprc_id);
+	if (error)
+		goto out;
+
+	if (cfg->link && !cfg->loopback) {
+		error = check_ls_endpoints(&topology, &cfg->endpoint, 1);
+		if (error)
+			goto out;
+	}
+
+	cfg->num_dpios = NI_NUM_DPIOS -
+			 count_ls_objs(&topology, cfg->dprc_id, "dpio");
+	if (cfg->num_dpios < 0)
+		cfg->num_dpios = 0;
+out:
+	free_topology(&topology);
+	return error;
+}
+
+static int set_ni_mac_addr(uint32_t dpni_id, const uint8_t *mac_addr)
+{
+	uint16_t dpni_handle;
+	int error, error2;
+
+	error = dpni_open_v10(&restool.mc_io, 0, dpni_id, &dpni_handle);
+	if (error)
+		return error;
+
+	error = dpni_set_primary_mac_addr_v10(&restool.mc_io, 0, dpni_handle,
+					      mac_addr);
+	error2 = dpni_close_v10(&restool.mc_io, 0, dpni_handle);
+	if (error == 0)
+		error = error2;
+
+	return error;
+}
+
+/*
+ * Creates the DPNI and its dependencies, plugged in the container, and
+ * links the DPNI. Either all of it is done, or none of it is left.
+ */
+static int create_ni(struct ni_add_cfg *cfg, uint32_t *dpni_id)
+{
+	struct dpio_cfg_v10 dpio_cfg = {
+		.channel_mode = DPIO_LOCAL_CHANNEL,
+		.num_priorities = 8,
+	};
+	struct dpmcp_cfg dpmcp_cfg = {
+		.portal_id = DPMCP_GET_PORTAL_ID_FROM_POOL,
+	};
+	struct dpcon_cfg_v10 dpcon_cfg = { .num_priorities = 2 };
+	struct dpbp_cfg_v10 dpbp_cfg = { 0 };
+	struct dprc_endpoint endpoint;
+	struct ls_session session;
+	uint32_t obj_id;
+	int error;
+
+	error = open_ls_session(cfg->dprc_id, &session);
+	if (error)
+		return error;
+
+	for (int i = 0; i < cfg->num_dpios; i++) {
+		error = create_ls_obj(&session, "dpio", &dpio_cfg, true,
+				      &obj_id);
+		if (error)
+			goto undo;
+	}
+
+	error = create_ls_obj(&session, "dpbp", &dpbp_cfg, true, &obj_id);
+	if (error)
+		goto undo;
+
+	error = create_ls_obj(&session, "dpmcp", &dpmcp_cfg, true, &obj_id);
+	if (error)
+		goto undo;
+
+	for (int i = 0; i < NI_NUM_DPCONS; i++) {
+		error = create_ls_obj(&session, "dpcon", &dpcon_cfg, true,
+				      &obj_id);
+		if (error)
+			goto undo;
+	}
+
+	error = create_ls_obj(&session, "dpni", &cfg->dpni_cfg, false,
+			      dpni_id);
+	if (error)
+		goto undo;
+
+	if (cfg->set_mac_addr) {
+		error = set_ni_mac_addr(*dpni_id, cfg->mac_addr);
+		if (error) {
+			print_ls_mc_error("dpni", *dpni_id, "set MAC address",
+					  error);
+			goto undo;
+		}
+	}
+
+	error = label_ls_obj(&session, "dpni", *dpni_id, cfg->label);
+	if (error)
+		goto undo;
+
+	error = plug_ls_obj(&session, "dpni", *dpni_id);
+	if (error) {
+		print_ls_mc_error("dpni", *dpni_id, "plug", error);
+		goto undo;
+	}
+
+	if (cfg->link) {
+		memset(&endpoint, 0, sizeof(endpoint));
+		strcpy(endpoint.type, "dpni");
+		endpoint.id = *dpni_id;
+		if (cfg->loopback)
+			cfg->endpoint.id = *dpni_id;
+
+		error = connect_ls_link(&session, &endpoint, &cfg->endpoint);
+		if (error)
+			goto undo;
+	}
+
+	close_ls_session(&session);
+	return 0;
+
+undo:
+	undo_ls_session(&session);
+	close_ls_session(&session);
+	return error;
+}
+
+static int cmd_ni_add(void)
+{
+	static const char usage_msg[] =
+		"\n"
+		"Usage: restool ni add <endpoint> [OPTIONS]\n"
+		"       restool ni add --no-link [OPTIONS]\n"
+		"       restool ni add --loopback [OPTIONS]\n"
+		"\n"
+		"Creates a DPNI together with a DPBP, a DPMCP and 8 DPCONs, tops\n"
+		"the container up to 8 DPIOs, plugs them all and links the DPNI.\n"
+		"\n"
+		"<endpoint> is one of dpmac.X, dpni.X, dpsw.X.Y or dpdmux.X.Y,\n"
+		"optionally with its container path, e.g. dprc.1/dpmac.4.\n"
+		"--no-link\n"
+		"   Leaves the DPNI unlinked.\n"
+		"--loopback\n"
+		"   Links the DPNI to itself.\n"
+		"\n"
+		"OPTIONS:\n"
+		"--container=<container-name>\n"
+		"   Container of the new objects. Default is the root container.\n"
+		"--label=<label>\n"
+		"   Label of the DPNI, up to 15 characters.\n"
+		"--mac-addr=<addr>\n"
+		"   Primary MAC address, e.g. 00:00:05:00:00:05.\n"
+		"--options=<options-mask>\n"
+		"   Comma separated options of the DPNI: DPNI_OPT_TX_FRM_RELEASE,\n"
+		"   DPNI_OPT_NO_MAC_FILTER, DPNI_OPT_HAS_POLICING,\n"
+		"   DPNI_OPT_SHARED_CONGESTION, DPNI_OPT_HAS_KEY_MASKING,\n"
+		"   DPNI_OPT_NO_FS.\n"
+		"--num-queues=<number>\n"
+		"   Rx/Tx queues, 1-8. Default is the number of host cores.\n"
+		"--num-tcs=<number>\n"
+		"   Traffic classes, 1-8. Default is 1.\n"
+		"--mac-entries=<number>\n"
+		"   MAC filtering table entries, 1-80. Default is 80.\n"
+		"--vlan-entries=<number>\n"
+		"   VLAN filtering table entries, 1-16. Default is no VLAN filtering.\n"
+		"--qos-entries=<number>\n"
+		"   QoS table entries, 1-64. Default is 64.\n"
+		"--fs-entries=<number>\n"
+		"   Flow steering table entries, 1-1024. Default is 64.\n"
+		"\n"
+		"The container and the endpoint are checked before anything is\n"
+		"created. If a step fails, the objects already created are\n"
+		"destroyed. Once done, the container is rescanned and the name\n"
+		"of the network interface is printed when the kernel binds it.\n"
+		"\n"
+		"EXAMPLE:\n"
+		"Create a network interface linked to dpmac.4:\n"
+		"   $ restool ni add dpmac.4 --label=wan\n"
+		"\n";
+
+	char endpoint_name[OBJ_TYPE_MAX_LENGTH + 24];
+	char netdev[PATH_MAX];
+	char dpni_name[32];
+	struct ni_add_cfg cfg;
+	bool has_netdev = false;
+	uint32_t dpni_id;
+	int error;
+
+	if (restool.cmd_option_mask & ONE_BIT_MASK(NI_ADD_OPT_HELP)) {
+		puts(usage_msg);
+		restool.cmd_option_mask &= ~ONE_BIT_MASK(NI_ADD_OPT_HELP);
+		return 0;
+	}
+
+	error = get_ni_add_cfg(usage_msg, &cfg);
+	if (error)
+		return error;
+
+	error = check_ni_add_cfg(&cfg);
+	if (error)
+		return error;
+
+	error = create_ni(&cfg, &dpni_id);
+	if (error)
+		return error;
+
+	snprintf(dpni_name, sizeof(dpni_name), "dpni.%u", dpni_id);
+	error = rescan_ls_container(cfg.dprc_id);
+	if (error)
+		DEBUG_PRINTF("fsl-mc bus rescan failed (error %d)\n", error);
+	else if (cfg.dprc_id == restool.root_dprc_id)
+		has_netdev = wait_for_netdev(dpni_name, netdev,
+					     sizeof(netdev));
+
+	if (restool.script) {
+		printf("%s\n", dpni_name);
+		return 0;
+	}
+
+	if (cfg.link)
+		format_endpoint(&cfg.endpoint, endpoint_name,
+				sizeof(endpoint_name));
+	else
+		strcpy(endpoint_name, "none");
+
+	printf("Created interface: %s (object: %s, endpoint: %s)\n",
+	       has_netdev ? netdev : "none", dpni_name, endpoint_name);
+	return 0;
+}
+
+static int cmd_ni_list(void)
+{
+	static const char usage_msg[] =
+		"\n"
+		"Usage: restool ni list\n"
+		"\n"
+		"Lists the DPNIs of the root container and of all its child\n"
+		"containers, one per line with its container path, followed by\n"
+		"its network interface, endpoint and label when it has them.\n"
+		"\n";
+
+	if (restool.cmd_option_mask & ONE_BIT_MASK(LS_LIST_OPT_HELP)) {
+		puts(usage_msg);
+		restool.cmd_option_mask &= ~ONE_BIT_MASK(LS_LIST_OPT_HELP);
+		return 0;
+	}
+
+	return list_ls_objs("dpni");
+}
+
+static int cmd_mac_list(void)
+{
+	static const char usage_msg[] =
+		"\n"
+		"Usage: restool mac list\n"
+		"\n"
+		"Lists the DPMACs of the root container and of all its child\n"
+		"containers, one per line with its container path, followed by\n"
+		"its endpoint and label when it has them.\n"
+		"\n";
+
+	if (restool.cmd_option_mask & ONE_BIT_MASK(LS_LIST_OPT_HELP)) {
+		puts(usage_msg);
+		restool.cmd_option_mask &= ~ONE_BIT_MASK(LS_LIST_OPT_HELP);
+		return 0;
+	}
+
+	return list_ls_objs("dpmac");
+}
+
+/**
+ * Everything sw add needs to know before it creates anything
+ */
+struct sw_add_cfg {
+	struct dpsw_cfg_v10 dpsw_cfg;
+	uint32_t dprc_id;
+	const char *label;
+	/**
+	 * endpoints of interfaces 0 to num_endpoints - 1
+	 */
+	struct dprc_endpoint endpoints[LS_MAX_LINKS];
+	int num_endpoints;
+};
+
+static int get_sw_add_cfg(const char *usage_msg, struct sw_add_cfg *cfg)
+{
+	static const struct ls_option_range ranges[] = {
+		{ SW_ADD_OPT_NUM_IFS, "num-ifs", 1, UINT16_MAX },
+		{ SW_ADD_OPT_MAX_VLANS, "max-vlans", 1, UINT16_MAX },
+		{ SW_ADD_OPT_MAX_FDBS, "max-fdbs", 1, UINT8_MAX },
+		{ SW_ADD_OPT_MAX_FDB_ENTRIES, "max-fdb-entries", 1, UINT16_MAX },
+		{ SW_ADD_OPT_FDB_AGING_TIME, "fdb-aging-time", 1, UINT16_MAX },
+		{ SW_ADD_OPT_MAX_FDB_MC_GROUPS, "max-fdb-mc-groups", 1,
+		  UINT16_MAX },
+	};
+	/* the defaults of the ls-addsw script */
+	long values[ARRAY_SIZE(ranges)] = { 4, 16, 1, 1024, 300, 32 };
+	struct dpsw_cfg_v10 *dpsw_cfg = &cfg->dpsw_cfg;
+	int error;
+
+	memset(cfg, 0, sizeof(*cfg));
+
+	if (restool.obj_name != NULL) {
+		ERROR_PRINTF("Unexpected argument: \'%s\'\n\n",
+			     restool.obj_name);
+		puts(usage_msg);
+		return -EINVAL;
+	}
+
+	error = get_ls_container(SW_ADD_OPT_CONTAINER, &cfg->dprc_id);
+	if (error)
+		return error;
+
+	error = get_ls_label(SW_ADD_OPT_LABEL, &cfg->label);
+	if (error)
+		return error;
+
+	error = get_ls_option_values(ranges, ARRAY_SIZE(ranges), values);
+	if (error)
+		return error;
+
+	dpsw_cfg->num_ifs = (uint16_t)values[0];
+	dpsw_cfg->adv.max_vlans = (uint16_t)values[1];
+	dpsw_cfg->adv.max_fdbs = (uint8_t)values[2];
+	dpsw_cfg->adv.max_fdb_entries = (uint16_t)values[3];
+	dpsw_cfg->adv.fdb_aging_time = (uint16_t)values[4];
+	dpsw_cfg->adv.max_fdb_mc_groups = (uint16_t)values[5];
+
+	if (restool.cmd_option_mask & ONE_BIT_MASK(SW_ADD_OPT_OPTIONS)) {
+		restool.cmd_option_mask &= ~ONE_BIT_MASK(SW_ADD_OPT_OPTIONS);
+		error = parse_generic_create_options(
+				restool.cmd_option_args[SW_ADD_OPT_OPTIONS],
+				&dpsw_cfg->adv.options, sw_options_map,
+				ARRAY_SIZE(sw_options_map));
+		if (error)
+			return error;
+	}
+
+	if (restool.cmd_option_mask & ONE_BIT_MASK(SW_ADD_OPT_ENDPOINTS)) {
+		restool.cmd_option_mask &= ~ONE_BIT_MASK(SW_ADD_OPT_ENDPOINTS);
+		error = parse_ls_endpoint_list(
+				restool.cmd_option_args[SW_ADD_OPT_ENDPOINTS],
+				cfg->endpoints,
+				dpsw_cfg->num_ifs < LS_MAX_LINKS ?
+					dpsw_cfg->num_ifs : LS_MAX_LINKS,
+				&cfg->num_endpoints);
+		if (error)
+			return error;
+	}
+
+	return 0;
+}
+
+/*
+ * Creates the DPSW, a DPMCP and, unless the control interface is
+ * disabled, a DPBP, then links the interfaces. The DPSW is plugged last,
+ * once it is fully set up.
+ */
+static int create_sw(const struct sw_add_cfg *cfg, uint32_t *dpsw_id)
+{
+	struct dpmcp_cfg dpmcp_cfg = {
+		.portal_id = DPMCP_GET_PORTAL_ID_FROM_POOL,
+	};
+	struct dpbp_cfg_v10 dpbp_cfg = { 0 };
+	struct dprc_endpoint endpoint;
+	struct ls_session session;
+	uint32_t obj_id;
+	int error;
+
+	error = open_ls_session(cfg->dprc_id, &session);
+	if (error)
+		return error;
+
+	error = create_ls_obj(&session, "dpmcp", &dpmcp_cfg, true, &obj_id);
+	if (error)
+		goto undo;
+
+	if (!(cfg->dpsw_cfg.adv.options & DPSW_OPT_CTRL_IF_DIS)) {
+		error = create_ls_obj(&session, "dpbp", &dpbp_cfg, true,
+				      &obj_id);
+		if (error)
+			goto undo;
+	}
+
+	error = create_ls_obj(&session, "dpsw", &cfg->dpsw_cfg, false,
+			      dpsw_id);
+	if (error)
+		goto undo;
+
+	error = label_ls_obj(&session, "dpsw", *dpsw_id, cfg->label);
+	if (error)
+		goto undo;
+
+	memset(&endpoint, 0, sizeof(endpoint));
+	strcpy(endpoint.type, "dpsw");
+	endpoint.id = *dpsw_id;
+	for (int i = 0; i < cfg->num_endpoints; i++) {
+		endpoint.if_id = i;
+		error = connect_ls_link(&session, &endpoint,
+					&cfg->endpoints[i]);
+		if (error)
+			goto undo;
+	}
+
+	error = plug_ls_obj(&session, "dpsw", *dpsw_id);
+	if (error) {
+		print_ls_mc_error("dpsw", *dpsw_id, "plug", error);
+		goto undo;
+	}
+
+	close_ls_session(&session);
+	return 0;
+
+undo:
+	undo_ls_session(&session);
+	close_ls_session(&session);
+	return error;
+}
+
+static int cmd_sw_add(void)
+{
+	static const char usage_msg[] =
+		"\n"
+		"Usage: restool sw add [OPTIONS]\n"
+		"\n"
+		"Creates a DPSW together with a DPMCP and, unless the control\n"
+		"interface is disabled, a DPBP, links its interfaces and plugs it.\n"
+		"\n"
+		"OPTIONS:\n"
+		"--endpoints=<endpoint>[,<endpoint>...]\n"
+		"   Endpoints of interfaces 0, 1, ... of the switch: dpmac.X,\n"
+		"   dpni.X, dpsw.X.Y or dpdmux.X.Y, at most num-ifs of them.\n"
+		"--num-ifs=<number>\n"
+		"   Number of interfaces. Default is 4.\n"
+		"--options=<options-mask>\n"
+		"   Comma separated options of the DPSW: DPSW_OPT_FLOODING_DIS,\n"
+		"   DPSW_OPT_MULTICAST_DIS, DPSW_OPT_CTRL_IF_DIS,\n"
+		"   DPSW_OPT_FLOODING_METERING_DIS, DPSW_OPT_METERING_EN.\n"
+		"--max-vlans=<number>\n"
+		"   Maximum number of VLANs. Default is 16.\n"
+		"--max-fdbs=<number>\n"
+		"   Maximum number of FDBs. Default is 1.\n"
+		"--max-fdb-entries=<number>\n"
+		"   Number of FDB entries. Default is 1024.\n"
+		"--fdb-aging-time=<number>\n"
+		"   FDB aging time in seconds. Default is 300.\n"
+		"--max-fdb-mc-groups=<number>\n"
+		"   Multicast groups in each FDB. Default is 32.\n"
+		"--label=<label>\n"
+		"   Label of the DPSW, up to 15 characters.\n"
+		"--container=<container-name>\n"
+		"   Container of the new objects. Default is the root container.\n"
+		"\n"
+		"The container and all the endpoints are checked against one\n"
+		"snapshot of the topology before anything is created. If a step\n"
+		"fails, the links and objects already made are removed.\n"
+		"\n"
+		"EXAMPLE:\n"
+		"Create a 5 port switch with 4 ports linked:\n"
+		"   $ restool sw add --num-ifs=5 --endpoints=dpni.1,dpni.2,dpmac.1,dpmac.2\n"
+		"\n";
+
+	struct topology topology;
+	struct sw_add_cfg cfg;
+	uint32_t dpsw_id;
+	int error;
+
+	if (restool.cmd_option_mask & ONE_BIT_MASK(SW_ADD_OPT_HELP)) {
+		puts(usage_msg);
+		restool.cmd_option_mask &= ~ONE_BIT_MASK(SW_ADD_OPT_HELP);
+		return 0;
+	}
+
+	error = get_sw_add_cfg(usage_msg, &cfg);
+	if (error)
+		return error;
+
+	memset(&topology, 0, sizeof(topology));
+	error = get_topology(restool.root_dprc_id, restool.root_dprc_handle,
+			     0, &topology);
+	if (error == 0)
+		error = check_ls_container(&topology, cfg.dprc_id);
+	if (error == 0)
+		error = check_ls_endpoints(&topology, cfg.endpoints,
+					   cfg.num_endpoints);
+	free_topology(&topology);
+	if (error)
+		return error;
+
+	error = create_sw(&cfg, &dpsw_id);
+	if (error)
+		return error;
+
+	error = rescan_ls_container(cfg.dprc_id);
+	if (error)
+		DEBUG_PRINTF("fsl-mc bus rescan failed (error %d)\n", error);
+
+	if (restool.script) {
+		printf("dpsw.%u\n", dpsw_id);
+		return 0;
+	}
+
+	printf("Created ETHSW object dpsw.%u with %u ports\n", dpsw_id,
+	       (uint32_t)cfg.dpsw_cfg.num_ifs);
+	if (cfg.num_endpoints < cfg.dpsw_cfg.num_ifs)
+		printf("Do not forget to connect devices to interface(s).\n");
+
+	return 0;
+}
+
+/**
+ * Everything mux add needs to know before it creates anything
+ */
+struct mux_add_cfg {
+	struct dpdmux_cfg_v10 dpdmux_cfg;
+	uint32_t dprc_id;
+	const char *label;
+	/**
+	 * endpoints of interfaces 0, the uplink, to num_endpoints - 1
+	 */
+	struct dprc_endpoint endpoints[LS_MAX_LINKS];
+	int num_endpoints;
+};
+
+static int parse_mux_method(const char *method_str,
+			    enum dpdmux_method *method)
+{
+	for (unsigned int i = 0; i < ARRAY_SIZE(mux_methods); i++) {
+		if (strcmp(mux_methods[i].name, method_str) == 0) {
+			*method = mux_methods[i].method;
+			return 0;
+		}
+	}
+
+	ERROR_PRINTF("Invalid method: %s\n", method_str);
+	return -EINVAL;
+}
+
+static int get_mux_add_cfg(const char *usage_msg, struct mux_add_cfg *cfg)
+{
+	static const struct ls_option_range ranges[] = {
+		{ MUX_ADD_OPT_NUM_IFS, "num-ifs", 1, UINT16_MAX },
+		{ MUX_ADD_OPT_MAX_DMAT_ENTRIES, "max-dmat-entries", 1,
+		  UINT16_MAX },
+		{ MUX_ADD_OPT_MAX_MC_GROUPS, "max-mc-groups", 1, UINT16_MAX },
+	};
+	/* the defaults of the ls-addmux script */
+	long values[ARRAY_SIZE(ranges)] = { 0, 64, 32 };
+	struct dpdmux_cfg_v10 *dpdmux_cfg = &cfg->dpdmux_cfg;
+	int error;
+
+	memset(cfg, 0, sizeof(*cfg));
+
+	if (restool.obj_name == NULL) {
+		ERROR_PRINTF("<uplink> argument missing\n");
+		puts(usage_msg);
+		return -EINVAL;
+	}
+
+	error = parse_ls_endpoint(restool.obj_name, &cfg->endpoints[0]);
+	if (error)
+		return error;
+	cfg->num_endpoints = 1;
+
+	if (!(restool.cmd_option_mask & ONE_BIT_MASK(MUX_ADD_OPT_NUM_IFS))) {
+		ERROR_PRINTF("--num-ifs option missing\n");
+		puts(usage_msg);
+		return -EINVAL;
+	}
+
+	error = get_ls_container(MUX_ADD_OPT_CONTAINER, &cfg->dprc_id);
+	if (error)
+		return error;
+
+	error = get_ls_label(MUX_ADD_OPT_LABEL, &cfg->label);
+	if (error)
+		return error;
+
+	error = get_ls_option_values(ranges, ARRAY_SIZE(ranges), values);
+	if (error)
+		return error;
+
+	dpdmux_cfg->num_ifs = (uint16_t)values[0];
+	dpdmux_cfg->adv.max_dmat_entries = (uint16_t)values[1];
+	dpdmux_cfg->adv.max_mc_groups = (uint16_t)values[2];
+	dpdmux_cfg->manip = DPDMUX_MANIP_NONE;
+
+	dpdmux_cfg->method = DPDMUX_METHOD_MAC;
+	if (restool.cmd_option_mask & ONE_BIT_MASK(MUX_ADD_OPT_METHOD)) {
+		restool.cmd_option_mask &= ~ONE_BIT_MASK(MUX_ADD_OPT_METHOD);
+		error = parse_mux_method(
+				restool.cmd_option_args[MUX_ADD_OPT_METHOD],
+				&dpdmux_cfg->method);
+		if (error)
+			return error;
+	}
+
+	if (restool.cmd_option_mask & ONE_BIT_MASK(MUX_ADD_OPT_OPTIONS)) {
+		restool.cmd_option_mask &= ~ONE_BIT_MASK(MUX_ADD_OPT_OPTIONS);
+		error = parse_generic_create_options(
+				restool.cmd_option_args[MUX_ADD_OPT_OPTIONS],
+				&dpdmux_cfg->adv.options, mux_options_map,
+				ARRAY_SIZE(mux_options_map));
+		if (error)
+			return error;
+	}
+
+	/* a VEB unless a VEPA is asked for */
+	if (restool.cmd_option_mask & ONE_BIT_MASK(MUX_ADD_OPT_VEPA))
+		restool.cmd_option_mask &= ~ONE_BIT_MASK(MUX_ADD_OPT_VEPA);
+	else
+		dpdmux_cfg->adv.options |= DPDMUX_OPT_BRIDGE_EN;
+
+	if (restool.cmd_option_mask & ONE_BIT_MASK(MUX_ADD_OPT_DOWNLINKS)) {
+		restool.cmd_option_mask &=
+			~ONE_BIT_MASK(MUX_ADD_OPT_DOWNLINKS);
+		error = parse_ls_endpoint_list(
+				restool.cmd_option_args[MUX_ADD_OPT_DOWNLINKS],
+				cfg->endpoints,
+				dpdmux_cfg->num_ifs < LS_MAX_LINKS ?
+					dpdmux_cfg->num_ifs + 1 : LS_MAX_LINKS,
+				&cfg->num_endpoints);
+		if (error)
+			return error;
+	}
+
+	return 0;
+}
+
+/*
+ * Creates the DPDMUX and a DPMCP, then links the uplink and downlinks.
+ * The DPDMUX is plugged last, once it is fully set up.
+ */
+static int create_mux(const struct mux_add_cfg *cfg, uint32_t *dpdmux_id)
+{
+	struct dpmcp_cfg dpmcp_cfg = {
+		.portal_id = DPMCP_GET_PORTAL_ID_FROM_POOL,
+	};
+	struct dprc_endpoint endpoint;
+	struct ls_session session;
+	uint32_t obj_id;
+	int error;
+
+	error = open_ls_session(cfg->dprc_id, &session);
+	if (error)
+		return error;
+
+	error = create_ls_obj(&session, "dpmcp", &dpmcp_cfg, true, &obj_id);
+	if (error)
+		goto undo;
+
+	error = create_ls_obj(&session, "dpdmux", &cfg->dpdmux_cfg, false,
+			      dpdmux_id);
+	if (error)
+		goto undo;
+
+	error = label_ls_obj(&session, "dpdmux", *dpdmux_id, cfg->label);
+	if (error)
+		goto undo;
+
+	memset(&endpoint, 0, sizeof(endpoint));
+	strcpy(endpoint.type, "dpdmux");
+	endpoint.id = *dpdmux_id;
+	for (int i = 0; i < cfg->num_endpoints; i++) {
+		endpoint.if_id = i;
+		error = connect_ls_link(&session, &endpoint,
+					&cfg->endpoints[i]);
+		if (error)
+			goto undo;
+	}
+
+	error = plug_ls_obj(&session, "dpdmux", *dpdmux_id);
+	if (error) {
+		print_ls_mc_error("dpdmux", *dpdmux_id, "plug", error);
+		goto undo;
+	}
+
+	close_ls_session(&session);
+	return 0;
+
+undo:
+	undo_ls_session(&session);
+	close_ls_session(&session);
+	return error;
+}
+
+static int cmd_mux_add(void)
+{
+	static const char usage_msg[] =
+		"\n"
+		"Usage: restool mux add <uplink> --num-ifs=<number> [OPTIONS]\n"
+		"\n"
+		"Creates a DPDMUX together with a DPMCP, links its uplink and\n"
+		"downlinks and plugs it.\n"
+		"\n"
+		"<uplink> is the endpoint of interface 0: dpmac.X, dpni.X,\n"
+		"dpsw.X.Y or dpdmux.X.Y.\n"
+		"--num-ifs=<number>\n"
+		"   Number of downlinks, the uplink excluded.\n"
+		"\n"
+		"OPTIONS:\n"
+		"--downlinks=<endpoint>[,<endpoint>...]\n"
+		"   Endpoints of downlinks 1, 2, ..., at most num-ifs of them.\n"
+		"--vepa\n"
+		"   Configures the EVB as a VEPA. Default is VEB.\n"
+		"--options=<options-mask>\n"
+		"   Comma separated options of the DPDMUX:\n"
+		"   DPDMUX_OPT_CLS_MASK_SUPPORT.\n"
+		"--method=<dmat-method>\n"
+		"   Traffic steering method: DPDMUX_METHOD_NONE,\n"
+		"   DPDMUX_METHOD_C_VLAN_MAC, DPDMUX_METHOD_MAC,\n"
+		"   DPDMUX_METHOD_C_VLAN or DPDMUX_METHOD_CUSTOM.\n"
+		"   Default is DPDMUX_METHOD_MAC.\n"
+		"--max-dmat-entries=<number>\n"
+		"   Entries in the address table. Default is 64.\n"
+		"--max-mc-groups=<number>\n"
+		"   Multicast groups in the address table. Default is 32.\n"
+		"--label=<label>\n"
+		"   Label of the DPDMUX, up to 15 characters.\n"
+		"--container=<container-name>\n"
+		"   Container of the new objects. Default is the root container.\n"
+		"\n"
+		"The container and all the endpoints are checked against one\n"
+		"snapshot of the topology before anything is created. If a step\n"
+		"fails, the links and objects already made are removed.\n"
+		"\n"
+		"EXAMPLE:\n"
+		"Create an EVB with 4 downlinks, its uplink linked to dpmac.6:\n"
+		"   $ restool mux add dpmac.6 --num-ifs=4 --method=DPDMUX_METHOD_C_VLAN_MAC\n"
+		"\n";
+
+	char netdev[PATH_MAX];
+	char uplink_name[OBJ_TYPE_MAX_LENGTH + 24];
+	char dpdmux_name[32];
+	struct topology topology;
+	struct mux_add_cfg cfg;
+	bool has_netdev = false;
+	uint32_t dpdmux_id;
+	int error;
+
+	if (restool.cmd_option_mask & ONE_BIT_MASK(MUX_ADD_OPT_HELP)) {
+		puts(usage_msg);
+		restool.cmd_option_mask &= ~ONE_BIT_MASK(MUX_ADD_OPT_HELP);
+		return 0;
+	}
+
+	error = get_mux_add_cfg(usage_msg, &cfg);
+	if (error)
+		return error;
+
+	memset(&topology, 0, sizeof(topology));
+	error = get_topology(restool.root_dprc_id, restool.root_dprc_handle,
+			     0, &topology);
+	if (error == 0)
+		error = check_ls_container(&topology, cfg.dprc_id);
+	if (error == 0)
+		error = check_ls_endpoints(&topology, cfg.endpoints,
+					   cfg.num_endpoints);
+	free_topology(&topology);
+	if (error)
+		return error;
+
+	error = create_mux(&cfg, &dpdmux_id);
+	if (error)
+		return error;
+
+	snprintf(dpdmux_name, sizeof(dpdmux_name), "dpdmux.%u", dpdmux_id);
+	error = rescan_ls_container(cfg.dprc_id);
+	if (error)
+		DEBUG_PRINTF("fsl-mc bus rescan failed (error %d)\n", error);
+	else if (cfg.dprc_id == restool.root_dprc_id)
+		has_netdev = wait_for_netdev(dpdmux_name, netdev,
+					     sizeof(netdev));
+
+	if (restool.script) {
+		printf("%s\n", dpdmux_name);
+		return 0;
+	}
+
+	format_endpoint(&cfg.endpoints[0], uplink_name, sizeof(uplink_name));
+	printf("Created EVB: %s (object: %s, uplink: %s)\n",
+	       has_netdev ? netdev : "none", dpdmux_name, uplink_name);
+	if (cfg.num_endpoints <= cfg.dpdmux_cfg.num_ifs)
+		printf("Do not forget to connect devices to downlink(s).\n");
+
+	return 0;
+}
+
+/**
+ * ni command table
+ */
+struct object_command ni_commands[] = {
+	{ .cmd_name = "help",
+	  .options = NULL,
+	  .cmd_func = cmd_ni_help },
+
+	{ .cmd_name = "add",
+	  .options = ni_add_options,
+	  .cmd_func = cmd_ni_add },
+
+	{ .cmd_name = "list",
+	  .options = ls_list_options,
+	  .cmd_func = cmd_ni_list },
+
+	{ .cmd_name = NULL },
+};
+
+/**
+ * mac command table
+ */
+struct object_command mac_commands[] = {
+	{ .cmd_name = "help",
+	  .options = NULL,
+	  .cmd_func = cmd_mac_help },
+
+	{ .cmd_name = "list",
+	  .options = ls_list_options,
+	  .cmd_func = cmd_mac_list },
+
+	{ .cmd_name = NULL },
+};
+
+/**
+ * sw command table
+ */
+struct object_command sw_commands[] = {
+	{ .cmd_name = "help",
+	  .options = NULL,
+	  .cmd_func = cmd_sw_help },
+
+	{ .cmd_name = "add",
+	  .options = sw_add_options,
+	  .cmd_func = cmd_sw_add },
+
+	{ .cmd_name = NULL },
+};
+
+/**
+ * mux command table
+ */
+struct object_command mux_commands[] = {
+	{ .cmd_name = "help",
+	  .options = NULL,
+	  .cmd_func = cmd_mux_help },
+
+	{ .cmd_name = "add",
+	  .options = mux_add_options,
+	  .cmd_func = cmd_mux_add },
+
+	{ .cmd_name = NULL },
+};
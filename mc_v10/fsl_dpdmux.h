@@ -134,4 +134,71 @@ int dpdmux_get_api_version_v10(struct fsl_mc_io *mc_io,
 			       uint16_t *major_ver,
 			       uint16_t *minor_ver);
 
+/**
+ * struct dpdmux_l2_rule - Structure representing L2 rule
+ * @mac_addr: MAC address
+ * @vlan_id: VLAN ID
+ */
+struct dpdmux_l2_rule {
+	uint8_t mac_addr[6];
+	uint16_t vlan_id;
+};
+
+int dpdmux_if_add_l2_rule_v10(struct fsl_mc_io *mc_io,
+			      uint32_t cmd_flags,
+			      uint16_t token,
+			      uint16_t if_id,
+			      const struct dpdmux_l2_rule *rule);
+
+int dpdmux_if_remove_l2_rule_v10(struct fsl_mc_io *mc_io,
+				 uint32_t cmd_flags,
+				 uint16_t token,
+				 uint16_t if_id,
+				 const struct dpdmux_l2_rule *rule);
+
+int dpdmux_set_custom_key_v10(struct fsl_mc_io *mc_io,
+			      uint32_t cmd_flags,
+			      uint16_t token,
+			      uint64_t key_cfg_iova);
+
+/**
+ * struct dpdmux_rule_cfg - Custom classification rule.
+ *
+ * @key_iova: DMA address of buffer storing the look-up value
+ * @mask_iova: DMA address of the mask used for TCAM classification;
+ *		'0' for an exact match
+ * @key_size: size, in bytes, of the look-up value. This must match the size
+ *	of the look-up key defined using dpdmux_set_custom_key, otherwise the
+ *	entry will never be hit
+ */
+struct dpdmux_rule_cfg {
+	uint64_t key_iova;
+	uint64_t mask_iova;
+	uint8_t key_size;
+};
+
+/**
+ * struct dpdmux_cls_action - Action to execute for frames matching the
+ *	classification entry
+ *
+ * @dest_if: Interface to forward the frames to. Port numbering is similar to
+ *	the one used to connect interfaces:
+ *	- 0 is the uplink port,
+ *	- all others are downlink ports.
+ */
+struct dpdmux_cls_action {
+	uint16_t dest_if;
+};
+
+int dpdmux_add_custom_cls_entry_v10(struct fsl_mc_io *mc_io,
+				    uint32_t cmd_flags,
+				    uint16_t token,
+				    const struct dpdmux_rule_cfg *rule,
+				    const struct dpdmux_cls_action *action);
+
+int dpdmux_remove_custom_cls_entry_v10(struct fsl_mc_io *mc_io,
+				       uint32_t cmd_flags,
+				       uint16_t token,
+				       const struct dpdmux_rule_cfg *rule);
+
 #endif /* __FSL_DPDMUX_H */
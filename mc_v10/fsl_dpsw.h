@@ -152,4 +152,186 @@ int dpsw_get_api_version_v10(struct fsl_mc_io *mc_io,
 			     uint16_t *major_ver,
 			     uint16_t *minor_ver);
 
+/**
+ * Maximum number of DPSW interfaces
+ */
+#define DPSW_MAX_IF		64
+
+/**
+ * enum dpsw_fdb_entry_type - FDB Entry type - Static/Dynamic
+ * @DPSW_FDB_ENTRY_STATIC: Static entry
+ * @DPSW_FDB_ENTRY_DINAMIC: Dynamic entry
+ */
+enum dpsw_fdb_entry_type {
+	DPSW_FDB_ENTRY_STATIC = 0,
+	DPSW_FDB_ENTRY_DINAMIC = 1
+};
+
+/**
+ * struct dpsw_fdb_unicast_cfg - Unicast entry configuration
+ * @type: Select static or dynamic entry
+ * @mac_addr: MAC address
+ * @if_egress: Egress interface ID
+ */
+struct dpsw_fdb_unicast_cfg {
+	enum dpsw_fdb_entry_type type;
+	uint8_t mac_addr[6];
+	uint16_t if_egress;
+};
+
+int dpsw_fdb_add_unicast_v10(struct fsl_mc_io *mc_io,
+			     uint32_t cmd_flags,
+			     uint16_t token,
+			     uint16_t fdb_id,
+			     const struct dpsw_fdb_unicast_cfg *cfg);
+
+int dpsw_fdb_remove_unicast_v10(struct fsl_mc_io *mc_io,
+				uint32_t cmd_flags,
+				uint16_t token,
+				uint16_t fdb_id,
+				const struct dpsw_fdb_unicast_cfg *cfg);
+
+/**
+ * struct dpsw_fdb_multicast_cfg - Multi-cast entry configuration
+ * @type: Select static or dynamic entry
+ * @mac_addr: MAC address
+ * @num_ifs: Number of external and internal interfaces
+ * @if_id: Egress interface IDs
+ */
+struct dpsw_fdb_multicast_cfg {
+	enum dpsw_fdb_entry_type type;
+	uint8_t mac_addr[6];
+	uint16_t num_ifs;
+	uint16_t if_id[DPSW_MAX_IF];
+};
+
+int dpsw_fdb_add_multicast_v10(struct fsl_mc_io *mc_io,
+			       uint32_t cmd_flags,
+			       uint16_t token,
+			       uint16_t fdb_id,
+			       const struct dpsw_fdb_multicast_cfg *cfg);
+
+int dpsw_fdb_remove_multicast_v10(struct fsl_mc_io *mc_io,
+				  uint32_t cmd_flags,
+				  uint16_t token,
+				  uint16_t fdb_id,
+				  const struct dpsw_fdb_multicast_cfg *cfg);
+
+/**
+ * FDB dump entry type bits
+ */
+#define DPSW_FDB_ENTRY_TYPE_DYNAMIC	0x1
+#define DPSW_FDB_ENTRY_TYPE_UNICAST	0x2
+
+/**
+ * struct dpsw_fdb_dump_entry - FDB entry written by dpsw_fdb_dump_v10()
+ * @mac_addr: MAC address
+ * @type: DPSW_FDB_ENTRY_TYPE_* bits
+ * @if_info: Egress interface of a unicast entry
+ * @if_mask: Egress interfaces bitmap of a multicast entry
+ */
+#pragma pack(push, 1)
+struct dpsw_fdb_dump_entry {
+	uint8_t mac_addr[6];
+	uint8_t type;
+	uint8_t if_info;
+	uint8_t if_mask[8];
+};
+#pragma pack(pop)
+
+int dpsw_fdb_dump_v10(struct fsl_mc_io *mc_io,
+		      uint32_t cmd_flags,
+		      uint16_t token,
+		      uint16_t fdb_id,
+		      uint64_t iova_addr,
+		      uint32_t iova_size,
+		      uint16_t *num_entries);
+
+/**
+ * struct dpsw_vlan_cfg - VLAN Configuration
+ * @fdb_id: Forwarding Data Base
+ */
+struct dpsw_vlan_cfg {
+	uint16_t fdb_id;
+};
+
+int dpsw_vlan_add_v10(struct fsl_mc_io *mc_io,
+		      uint32_t cmd_flags,
+		      uint16_t token,
+		      uint16_t vlan_id,
+		      const struct dpsw_vlan_cfg *cfg);
+
+/**
+ * struct dpsw_vlan_if_cfg - Set of VLAN Interfaces
+ * @num_ifs: The number of interfaces that are assigned to the egress
+ *		list for this VLAN
+ * @if_id: The set of interfaces that are
+ *		assigned to the egress list for this VLAN
+ */
+struct dpsw_vlan_if_cfg {
+	uint16_t num_ifs;
+	uint16_t if_id[DPSW_MAX_IF];
+};
+
+int dpsw_vlan_add_if_v10(struct fsl_mc_io *mc_io,
+			 uint32_t cmd_flags,
+			 uint16_t token,
+			 uint16_t vlan_id,
+			 const struct dpsw_vlan_if_cfg *cfg);
+
+int dpsw_vlan_add_if_untagged_v10(struct fsl_mc_io *mc_io,
+				  uint32_t cmd_flags,
+				  uint16_t token,
+				  uint16_t vlan_id,
+				  const struct dpsw_vlan_if_cfg *cfg);
+
+int dpsw_vlan_remove_if_v10(struct fsl_mc_io *mc_io,
+			    uint32_t cmd_flags,
+			    uint16_t token,
+			    uint16_t vlan_id,
+			    const struct dpsw_vlan_if_cfg *cfg);
+
+int dpsw_vlan_remove_if_untagged_v10(struct fsl_mc_io *mc_io,
+				     uint32_t cmd_flags,
+				     uint16_t token,
+				     uint16_t vlan_id,
+				     const struct dpsw_vlan_if_cfg *cfg);
+
+int dpsw_vlan_remove_v10(struct fsl_mc_io *mc_io,
+			 uint32_t cmd_flags,
+			 uint16_t token,
+			 uint16_t vlan_id);
+
+/**
+ * struct dpsw_vlan_attr - VLAN attributes
+ * @fdb_id: Associated FDB ID
+ * @num_ifs: Number of interfaces
+ * @num_untagged_ifs: Number of untagged interfaces
+ * @num_flooding_ifs: Number of flooding interfaces
+ */
+struct dpsw_vlan_attr {
+	uint16_t fdb_id;
+	uint16_t num_ifs;
+	uint16_t num_untagged_ifs;
+	uint16_t num_flooding_ifs;
+};
+
+int dpsw_vlan_get_attributes_v10(struct fsl_mc_io *mc_io,
+				 uint32_t cmd_flags,
+				 uint16_t token,
+				 uint16_t vlan_id,
+				 struct dpsw_vlan_attr *attr);
+
+int dpsw_vlan_get_if_v10(struct fsl_mc_io *mc_io,
+			 uint32_t cmd_flags,
+			 uint16_t token,
+			 uint16_t vlan_id,
+			 struct dpsw_vlan_if_cfg *cfg);
+
+int dpsw_vlan_get_if_untagged_v10(struct fsl_mc_io *mc_io,
+				  uint32_t cmd_flags,
+				  uint16_t token,
+				  uint16_t vlan_id,
+				  struct dpsw_vlan_if_cfg *cfg);
+
 #endif /* __FSL_DPSW_H */
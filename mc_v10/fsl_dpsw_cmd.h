@@ -53,6 +53,22 @@
 #define DPSW_CMDID_GET_IRQ_MASK                 DPSW_CMD(0x015)
 #define DPSW_CMDID_GET_IRQ_STATUS               DPSW_CMD(0x016)
 
+#define DPSW_CMDID_VLAN_ADD                     DPSW_CMD(0x060)
+#define DPSW_CMDID_VLAN_ADD_IF                  DPSW_CMD(0x061)
+#define DPSW_CMDID_VLAN_ADD_IF_UNTAGGED         DPSW_CMD(0x062)
+#define DPSW_CMDID_VLAN_REMOVE_IF               DPSW_CMD(0x064)
+#define DPSW_CMDID_VLAN_REMOVE_IF_UNTAGGED      DPSW_CMD(0x065)
+#define DPSW_CMDID_VLAN_REMOVE                  DPSW_CMD(0x067)
+#define DPSW_CMDID_VLAN_GET_IF                  DPSW_CMD(0x068)
+#define DPSW_CMDID_VLAN_GET_IF_UNTAGGED         DPSW_CMD(0x06A)
+#define DPSW_CMDID_VLAN_GET_ATTRIBUTES          DPSW_CMD(0x06B)
+
+#define DPSW_CMDID_FDB_ADD_UNICAST              DPSW_CMD(0x084)
+#define DPSW_CMDID_FDB_REMOVE_UNICAST           DPSW_CMD(0x085)
+#define DPSW_CMDID_FDB_ADD_MULTICAST            DPSW_CMD(0x086)
+#define DPSW_CMDID_FDB_REMOVE_MULTICAST         DPSW_CMD(0x087)
+#define DPSW_CMDID_FDB_DUMP                     DPSW_CMD(0x08A)
+
 /* Macros for accessing command fields smaller than 1byte */
 #define DPSW_MASK(field)        \
 	GENMASK(DPSW_##field##_SHIFT + DPSW_##field##_SIZE - 1, \
@@ -138,6 +154,94 @@ struct dpsw_rsp_get_attr {
 	uint64_t options;
 };
 
+struct dpsw_cmd_vlan_add {
+	uint16_t fdb_id;
+	uint16_t vlan_id;
+};
+
+struct dpsw_cmd_vlan_manage_if {
+	/* cmd word 0 */
+	uint16_t pad0;
+	uint16_t vlan_id;
+	uint32_t pad1;
+	/* cmd word 1-4 */
+	uint64_t if_id[4];
+};
+
+struct dpsw_cmd_vlan_remove {
+	uint16_t pad;
+	uint16_t vlan_id;
+};
+
+struct dpsw_cmd_vlan_get_attr {
+	/* cmd word 0 */
+	uint64_t pad;
+	/* cmd word 1 */
+	uint16_t vlan_id;
+};
+
+struct dpsw_rsp_vlan_get_attr {
+	/* cmd word 0 */
+	uint64_t pad;
+	/* cmd word 1 */
+	uint16_t fdb_id;
+	uint16_t num_ifs;
+	uint16_t num_untagged_ifs;
+	uint16_t num_flooding_ifs;
+};
+
+struct dpsw_cmd_vlan_get_if {
+	uint16_t pad0;
+	uint16_t vlan_id;
+};
+
+struct dpsw_rsp_vlan_get_if {
+	/* cmd word 0 */
+	uint16_t pad0;
+	uint16_t num_ifs;
+	uint32_t pad1;
+	/* cmd word 1-4 */
+	uint64_t if_id[4];
+};
+
+#define DPSW_ENTRY_TYPE_SHIFT	0
+#define DPSW_ENTRY_TYPE_SIZE	4
+
+struct dpsw_cmd_fdb_unicast_op {
+	/* cmd word 0 */
+	uint16_t fdb_id;
+	uint8_t mac_addr[6];
+	/* cmd word 1 */
+	uint16_t if_egress;
+	/* only the first 4 bits from LSB */
+	uint8_t type;
+};
+
+struct dpsw_cmd_fdb_multicast_op {
+	/* cmd word 0 */
+	uint16_t fdb_id;
+	uint16_t num_ifs;
+	/* only the first 4 bits from LSB */
+	uint8_t type;
+	uint8_t pad[3];
+	/* cmd word 1 */
+	uint8_t mac_addr[6];
+	uint16_t pad2;
+	/* cmd word 2-5 */
+	uint64_t if_id[4];
+};
+
+struct dpsw_cmd_fdb_dump {
+	uint16_t fdb_id;
+	uint16_t pad0;
+	uint32_t pad1;
+	uint64_t iova_addr;
+	uint32_t iova_size;
+};
+
+struct dpsw_rsp_fdb_dump {
+	uint16_t num_entries;
+};
 
 struct dpsw_rsp_get_api_version {
 	uint16_t version_major;
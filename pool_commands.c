@@ -0,0 +1,789 @@
+/* Copyright 2026 NXP
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * * Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ * * Neither the name of the above-listed copyright holders nor the
+ * names of any contributors may be used to endorse or promote products
+ * derived from this software without specific prior written permission.
+ *
+ *
+ * ALTERNATIVELY, this software may be distributed under the terms of the
+ * GNU General Public License ("GPL") as published by the Free Software
+ * Foundation, either version 2 of that License or (at your option) any
+ * later version.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDERS OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <errno.h>
+#include <assert.h>
+#include <getopt.h>
+#include "restool.h"
+#include "utils.h"
+#include "mc_v9/fsl_dpio.h"
+#include "mc_v10/fsl_dpbp.h"
+#include "mc_v10/fsl_dpcon.h"
+#include "mc_v10/fsl_dpio.h"
+#include "mc_v10/fsl_dpmcp.h"
+#include "mc_v10/fsl_dpni.h"
+
+#define POOL_LABEL_PREFIX	"pool."
+#define POOL_MAX_OBJ_TYPES	5
+
+enum mc_cmd_status mc_status;
+
+/**
+ * Object pool profile: the objects making up one unit of the pool
+ */
+struct pool_profile {
+	const char *name;
+	const char *description;
+	uint8_t dpni_num_queues;
+	struct {
+		const char *type;
+		int count;
+	} objs[POOL_MAX_OBJ_TYPES];
+};
+
+static const struct pool_profile pool_profiles[] = {
+	{ .name = "net",
+	  .description = "DPNI with 8 queues, DPBP",
+	  .dpni_num_queues = 8,
+	  .objs = { { "dpni", 1 }, { "dpbp", 1 } } },
+
+	{ .name = "dpdk",
+	  .description = "DPNI with 8 queues, DPBP, DPIO, DPCON, DPMCP",
+	  .dpni_num_queues = 8,
+	  .objs = { { "dpni", 1 }, { "dpbp", 1 }, { "dpio", 1 },
+		    { "dpcon", 1 }, { "dpmcp", 1 } } },
+
+	{ .name = "io",
+	  .description = "DPIO, DPBP, DPCON",
+	  .objs = { { "dpio", 1 }, { "dpbp", 1 }, { "dpcon", 1 } } },
+};
+
+/**
+ * Objects of the staging container of a pool, grouped by profile entry
+ */
+struct pool_contents {
+	int *ids[POOL_MAX_OBJ_TYPES];
+	int num_ids[POOL_MAX_OBJ_TYPES];
+	int num_units;
+};
+
+/**
+ * pool fill command options
+ */
+enum pool_fill_options {
+	FILL_OPT_HELP = 0,
+	FILL_OPT_PROFILE,
+	FILL_OPT_COUNT,
+};
+
+static struct option pool_fill_options[] = {
+	[FILL_OPT_HELP] = {
+		.name = "help",
+	},
+
+	[FILL_OPT_PROFILE] = {
+		.name = "profile",
+		.has_arg = 1,
+	},
+
+	[FILL_OPT_COUNT] = {
+		.name = "count",
+		.has_arg = 1,
+	},
+
+	{ 0 },
+};
+
+C_ASSERT(ARRAY_SIZE(pool_fill_options) <= MAX_NUM_CMD_LINE_OPTIONS + 1);
+
+/**
+ * pool take command options
+ */
+enum pool_take_options {
+	TAKE_OPT_HELP = 0,
+	TAKE_OPT_PROFILE,
+	TAKE_OPT_INTO,
+	TAKE_OPT_COUNT,
+	TAKE_OPT_PLUGGED,
+};
+
+static struct option pool_take_options[] = {
+	[TAKE_OPT_HELP] = {
+		.name = "help",
+	},
+
+	[TAKE_OPT_PROFILE] = {
+		.name = "profile",
+		.has_arg = 1,
+	},
+
+	[TAKE_OPT_INTO] = {
+		.name = "into",
+		.has_arg = 1,
+	},
+
+	[TAKE_OPT_COUNT] = {
+		.name = "count",
+		.has_arg = 1,
+	},
+
+	[TAKE_OPT_PLUGGED] = {
+		.name = "plugged",
+		.has_arg = 1,
+	},
+
+	{ 0 },
+};
+
+C_ASSERT(ARRAY_SIZE(pool_take_options) <= MAX_NUM_CMD_LINE_OPTIONS + 1);
+
+/**
+ * pool list command options
+ */
+enum pool_list_options {
+	LIST_OPT_HELP = 0,
+};
+
+static struct option pool_list_options[] = {
+	[LIST_OPT_HELP] = {
+		.name = "help",
+	},
+
+	{ 0 },
+};
+
+C_ASSERT(ARRAY_SIZE(pool_list_options) <= MAX_NUM_CMD_LINE_OPTIONS + 1);
+
+static int cmd_pool_help(void)
+{
+	static const char help_msg[] =
+		"\n"
+		"Usage: restool pool <command> [--help] [ARGS...]\n"
+		"Where <command> can be:\n"
+		"   fill - pre-creates object sets of a profile in a staging container.\n"
+		"   take - moves object sets from a pool to a container.\n"
+		"   list - lists the pools and the number of object sets they hold.\n"
+		"\n"
+		"For command-specific help, use the --help option of each command.\n"
+		"\n";
+
+	printf(help_msg);
+	return 0;
+}
+
+static void print_pool_profiles(void)
+{
+	printf("Valid profiles are:\n");
+	for (unsigned int i = 0; i < ARRAY_SIZE(pool_profiles); i++)
+		printf("   %-6s - %s\n", pool_profiles[i].name,
+		       pool_profiles[i].description);
+}
+
+static const struct pool_profile *get_pool_profile(const char *name)
+{
+	for (unsigned int i = 0; i < ARRAY_SIZE(pool_profiles); i++) {
+		if (strcmp(pool_profiles[i].name, name) == 0)
+			return &pool_profiles[i];
+	}
+
+	ERROR_PRINTF("Invalid profile: '%s'\n", name);
+	print_pool_profiles();
+	return NULL;
+}
+
+/**
+ * Looks up the staging container of a pool among the children of the
+ * root container. Sets *found to false when there is none.
+ */
+static int find_pool_dprc(const struct pool_profile *profile,
+			  uint32_t *pool_dprc_id, bool *found)
+{
+	struct dprc_obj_desc obj_desc;
+	char label[MC_OBJ_LABEL_MAX_LENGTH + 1];
+	int num_child_devices;
+	int error;
+
+	*found = false;
+	snprintf(label, sizeof(label), POOL_LABEL_PREFIX "%s", profile->name);
+
+	error = dprc_get_obj_count(&restool.mc_io, 0,
+				   restool.root_dprc_handle,
+				   &num_child_devices);
+	if (error < 0)
+		goto out;
+
+	for (int i = 0; i < num_child_devices; i++) {
+		error = dprc_get_obj(&restool.mc_io, 0,
+				     restool.root_dprc_handle, i, &obj_desc);
+		if (error < 0)
+			goto out;
+
+		if (strcmp(obj_desc.type, "dprc") == 0 &&
+		    strcmp(obj_desc.label, label) == 0) {
+			*pool_dprc_id = obj_desc.id;
+			*found = true;
+			break;
+		}
+	}
+out:
+	if (error < 0) {
+		mc_status = flib_error_to_mc_status(error);
+		ERROR_PRINTF("MC error: %s (status %#x)\n",
+			     mc_status_to_string(mc_status), mc_status);
+	}
+
+	return error;
+}
+
+static int create_pool_dprc(const struct pool_profile *profile,
+			    uint32_t *pool_dprc_id)
+{
+	uint64_t mc_portal_offset;
+	struct dprc_cfg cfg;
+	int child_dprc_id;
+	int error;
+
+	memset(&cfg, 0, sizeof(cfg));
+	cfg.icid = DPRC_GET_ICID_FROM_POOL;
+	cfg.portal_id = DPRC_GET_PORTAL_ID_FROM_POOL;
+	cfg.options = DPRC_CFG_OPT_ALLOC_ALLOWED |
+		      DPRC_CFG_OPT_OBJ_CREATE_ALLOWED;
+	snprintf(cfg.label, sizeof(cfg.label), POOL_LABEL_PREFIX "%s",
+		 profile->name);
+
+	error = dprc_create_container(&restool.mc_io, 0,
+				      restool.root_dprc_handle, &cfg,
+				      &child_dprc_id, &mc_portal_offset);
+	if (error < 0) {
+		mc_status = flib_error_to_mc_status(error);
+		ERROR_PRINTF("MC error: %s (status %#x)\n",
+			     mc_status_to_string(mc_status), mc_status);
+		return error;
+	}
+
+	*pool_dprc_id = child_dprc_id;
+	print_new_obj("dprc", child_dprc_id, NULL);
+	return 0;
+}
+
+static void free_pool_contents(struct pool_contents *contents)
+{
+	for (int i = 0; i < POOL_MAX_OBJ_TYPES; i++)
+		free(contents->ids[i]);
+}
+
+/**
+ * Reads the objects of a staging container and counts the complete
+ * object sets it holds. Objects that are plugged are not counted.
+ */
+static int get_pool_contents(const struct pool_profile *profile,
+			     uint16_t pool_dprc_handle,
+			     struct pool_contents *contents)
+{
+	struct dprc_obj_desc obj_desc;
+	int num_child_devices;
+	int error;
+	int j;
+
+	memset(contents, 0, sizeof(*contents));
+	error = dprc_get_obj_count(&restool.mc_io, 0, pool_dprc_handle,
+				   &num_child_devices);
+	if (error < 0)
+		goto mc_error;
+
+	for (j = 0; j < POOL_MAX_OBJ_TYPES && profile->objs[j].type; j++) {
+		contents->ids[j] = calloc(num_child_devices + 1, sizeof(int));
+		if (contents->ids[j] == NULL) {
+			ERROR_PRINTF("Could not alloc memory for objects!\n");
+			free_pool_contents(contents);
+			return -ENOMEM;
+		}
+	}
+
+	for (int i = 0; i < num_child_devices; i++) {
+		error = dprc_get_obj(&restool.mc_io, 0, pool_dprc_handle, i,
+				     &obj_desc);
+		if (error < 0)
+			goto mc_error;
+
+		if (obj_desc.state & DPRC_OBJ_STATE_PLUGGED)
+			continue;
+
+		for (j = 0; j < POOL_MAX_OBJ_TYPES && profile->objs[j].type;
+		     j++) {
+			if (strcmp(obj_desc.type, profile->objs[j].type) == 0) {
+				contents->ids[j][contents->num_ids[j]++] =
+					obj_desc.id;
+				break;
+			}
+		}
+	}
+
+	contents->num_units = num_child_devices;
+	for (j = 0; j < POOL_MAX_OBJ_TYPES && profile->objs[j].type; j++) {
+		int num_units = contents->num_ids[j] / profile->objs[j].count;
+
+		if (num_units < contents->num_units)
+			contents->num_units = num_units;
+	}
+
+	return 0;
+
+mc_error:
+	mc_status = flib_error_to_mc_status(error);
+	ERROR_PRINTF("MC error: %s (status %#x)\n",
+		     mc_status_to_string(mc_status), mc_status);
+	free_pool_contents(contents);
+	return error;
+}
+
+static int create_pool_obj(const struct pool_profile *profile,
+			   const char *obj_type, uint16_t pool_dprc_handle,
+			   uint32_t *obj_id)
+{
+	if (strcmp(obj_type, "dpni") == 0) {
+		struct dpni_cfg_v10 cfg = { 0 };
+
+		cfg.num_queues = profile->dpni_num_queues;
+		return dpni_create_v10(&restool.mc_io, pool_dprc_handle, 0,
+				       &cfg, obj_id);
+	} else if (strcmp(obj_type, "dpbp") == 0) {
+		struct dpbp_cfg_v10 cfg = { 0 };
+
+		return dpbp_create_v10(&restool.mc_io, pool_dprc_handle, 0,
+				       &cfg, obj_id);
+	} else if (strcmp(obj_type, "dpio") == 0) {
+		struct dpio_cfg_v10 cfg = {
+			.channel_mode = DPIO_LOCAL_CHANNEL,
+			.num_priorities = 8,
+		};
+
+		return dpio_create_v10(&restool.mc_io, pool_dprc_handle, 0,
+				       &cfg, obj_id);
+	} else if (strcmp(obj_type, "dpcon") == 0) {
+		struct dpcon_cfg_v10 cfg = { .num_priorities = 1 };
+
+		return dpcon_create_v10(&restool.mc_io, pool_dprc_handle, 0,
+					&cfg, obj_id);
+	} else if (strcmp(obj_type, "dpmcp") == 0) {
+		struct dpmcp_cfg cfg = {
+			.portal_id = DPMCP_GET_PORTAL_ID_FROM_POOL,
+		};
+
+		return dpmcp_create_v10(&restool.mc_io, pool_dprc_handle, 0,
+					&cfg, obj_id);
+	}
+
+	assert(false);
+	return -EINVAL;
+}
+
+static const struct pool_profile *get_profile_option(int option,
+						     const char *usage_msg)
+{
+	if (!(restool.cmd_option_mask & ONE_BIT_MASK(option))) {
+		ERROR_PRINTF("--profile option missing\n");
+		puts(usage_msg);
+		return NULL;
+	}
+
+	restool.cmd_option_mask &= ~ONE_BIT_MASK(option);
+	assert(restool.cmd_option_args[option] != NULL);
+	return get_pool_profile(restool.cmd_option_args[option]);
+}
+
+static int cmd_pool_fill(void)
+{
+	static const char usage_msg[] =
+		"\n"
+		"Usage: restool pool fill --profile=<profile> [--count=<number>]\n"
+		"\n"
+		"OPTIONS:\n"
+		"--profile=<profile>\n"
+		"   Set of objects making up one unit of the pool: net, dpdk or io.\n"
+		"--count=<number>\n"
+		"   Number of object sets to create, 1 to 256. Default is 1.\n"
+		"\n"
+		"NOTES:\n"
+		" -The objects are created in a staging container labeled\n"
+		"  " POOL_LABEL_PREFIX "<profile>, which is created under the root\n"
+		"  container if it does not exist yet.\n"
+		" -Use 'restool pool take' to move object sets to a container.\n"
+		"\n"
+		"EXAMPLE:\n"
+		"Pre-create 16 network interface sets:\n"
+		"   $ restool pool fill --profile=net --count=16\n"
+		"\n";
+
+	const struct pool_profile *profile;
+	uint16_t pool_dprc_handle;
+	uint32_t pool_dprc_id;
+	int num_created = 0;
+	long count = 1;
+	bool found;
+	int error, error2;
+
+	if (restool.cmd_option_mask & ONE_BIT_MASK(FILL_OPT_HELP)) {
+		puts(usage_msg);
+		print_pool_profiles();
+		restool.cmd_option_mask &= ~ONE_BIT_MASK(FILL_OPT_HELP);
+		return 0;
+	}
+
+	if (restool.obj_name != NULL) {
+		ERROR_PRINTF("Unexpected argument: \'%s\'\n\n",
+			     restool.obj_name);
+		puts(usage_msg);
+		return -EINVAL;
+	}
+
+	profile = get_profile_option(FILL_OPT_PROFILE, usage_msg);
+	if (profile == NULL)
+		return -EINVAL;
+
+	if (restool.cmd_option_mask & ONE_BIT_MASK(FILL_OPT_COUNT)) {
+		restool.cmd_option_mask &= ~ONE_BIT_MASK(FILL_OPT_COUNT);
+		error = get_option_value(FILL_OPT_COUNT, &count,
+					 "Invalid count value\n", 1, 256);
+		if (error)
+			return error;
+	}
+
+	error = find_pool_dprc(profile, &pool_dprc_id, &found);
+	if (error < 0)
+		return error;
+
+	if (!found) {
+		error = create_pool_dprc(profile, &pool_dprc_id);
+		if (error < 0)
+			return error;
+	}
+
+	error = open_dprc(pool_dprc_id, &pool_dprc_handle);
+	if (error < 0)
+		return error;
+
+	for (; num_created < count; num_created++) {
+		for (int j = 0; j < POOL_MAX_OBJ_TYPES && profile->objs[j].type;
+		     j++) {
+			for (int k = 0; k < profile->objs[j].count; k++) {
+				uint32_t obj_id;
+
+				error = create_pool_obj(profile,
+							profile->objs[j].type,
+							pool_dprc_handle,
+							&obj_id);
+				if (error < 0)
+					goto mc_error;
+			}
+		}
+	}
+
+	goto out;
+
+mc_error:
+	mc_status = flib_error_to_mc_status(error);
+	ERROR_PRINTF("MC error: %s (status %#x)\n",
+		     mc_status_to_string(mc_status), mc_status);
+out:
+	printf("%d object set(s) added to pool %s (dprc.%u)\n",
+	       num_created, profile->name, pool_dprc_id);
+
+	error2 = dprc_close(&restool.mc_io, 0, pool_dprc_handle);
+	if (error2 < 0) {
+		mc_status = flib_error_to_mc_status(error2);
+		ERROR_PRINTF("MC error: %s (status %#x)\n",
+			     mc_status_to_string(mc_status), mc_status);
+		if (error == 0)
+			error = error2;
+	}
+
+	return error;
+}
+
+/**
+ * Moves one object from the staging container to the destination. The
+ * staging container and the destination are both children of the root
+ * container, so the object goes up to the root container first.
+ */
+static int take_pool_obj(uint32_t pool_dprc_id, uint32_t dest_dprc_id,
+			 const char *obj_type, int obj_id, bool plugged)
+{
+	struct dprc_res_req res_req;
+	int error;
+
+	memset(&res_req, 0, sizeof(res_req));
+	strcpy(res_req.type, obj_type);
+	res_req.num = 1;
+	res_req.options = DPRC_RES_REQ_OPT_EXPLICIT;
+	res_req.id_base_align = obj_id;
+
+	error = dprc_unassign(&restool.mc_io, 0, restool.root_dprc_handle,
+			      pool_dprc_id, &res_req);
+	if (error < 0)
+		return error;
+
+	if (plugged)
+		res_req.options |= DPRC_RES_REQ_OPT_PLUGGED;
+
+	if (dest_dprc_id == restool.root_dprc_id) {
+		if (!plugged)
+			return 0;
+
+		return dprc_assign(&restool.mc_io, 0,
+				   restool.root_dprc_handle,
+				   restool.root_dprc_id, &res_req);
+	}
+
+	return dprc_assign(&restool.mc_io, 0, restool.root_dprc_handle,
+			   dest_dprc_id, &res_req);
+}
+
+static int cmd_pool_take(void)
+{
+	static const char usage_msg[] =
+		"\n"
+		"Usage: restool pool take --profile=<profile> --into=<container>\n"
+		"                         [--count=<number>] [--plugged=<state>]\n"
+		"\n"
+		"OPTIONS:\n"
+		"--profile=<profile>\n"
+		"   Pool to take the object sets from.\n"
+		"--into=<container>\n"
+		"   Container receiving the objects.\n"
+		"--count=<number>\n"
+		"   Number of object sets to take, 1 to 256. Default is 1.\n"
+		"--plugged=<state>\n"
+		"   Plugged state of the moved objects, 0 or 1. Default is 1.\n"
+		"\n"
+		"NOTES:\n"
+		" -<container> must be the root container or one of its children.\n"
+		" -The names of the moved objects are printed one per line.\n"
+		"\n"
+		"EXAMPLE:\n"
+		"Give one network interface set to dprc.2:\n"
+		"   $ restool pool take --profile=net --into=dprc.2\n"
+		"\n";
+
+	const struct pool_profile *profile;
+	struct pool_contents contents;
+	uint32_t dest_parent_dprc_id;
+	uint16_t pool_dprc_handle;
+	uint32_t pool_dprc_id;
+	uint32_t dest_dprc_id;
+	bool plugged = true;
+	long count = 1;
+	long value;
+	bool found;
+	int error, error2;
+
+	if (restool.cmd_option_mask & ONE_BIT_MASK(TAKE_OPT_HELP)) {
+		puts(usage_msg);
+		restool.cmd_option_mask &= ~ONE_BIT_MASK(TAKE_OPT_HELP);
+		return 0;
+	}
+
+	if (restool.obj_name != NULL) {
+		ERROR_PRINTF("Unexpected argument: \'%s\'\n\n",
+			     restool.obj_name);
+		puts(usage_msg);
+		return -EINVAL;
+	}
+
+	profile = get_profile_option(TAKE_OPT_PROFILE, usage_msg);
+	if (profile == NULL)
+		return -EINVAL;
+
+	if (!(restool.cmd_option_mask & ONE_BIT_MASK(TAKE_OPT_INTO))) {
+		ERROR_PRINTF("--into option missing\n");
+		puts(usage_msg);
+		return -EINVAL;
+	}
+
+	restool.cmd_option_mask &= ~ONE_BIT_MASK(TAKE_OPT_INTO);
+	error = parse_object_name(restool.cmd_option_args[TAKE_OPT_INTO],
+				  "dprc", &dest_dprc_id);
+	if (error < 0)
+		return error;
+
+	if (dest_dprc_id != restool.root_dprc_id) {
+		error = get_parent_dprc_id(dest_dprc_id, "dprc",
+					   &dest_parent_dprc_id);
+		if (error < 0) {
+			ERROR_PRINTF("%s does not exist\n",
+				     restool.cmd_option_args[TAKE_OPT_INTO]);
+			return error;
+		}
+
+		if (dest_parent_dprc_id != restool.root_dprc_id) {
+			ERROR_PRINTF("%s is not a child of the root container\n",
+				     restool.cmd_option_args[TAKE_OPT_INTO]);
+			return -EINVAL;
+		}
+	}
+
+	if (restool.cmd_option_mask & ONE_BIT_MASK(TAKE_OPT_COUNT)) {
+		restool.cmd_option_mask &= ~ONE_BIT_MASK(TAKE_OPT_COUNT);
+		error = get_option_value(TAKE_OPT_COUNT, &count,
+					 "Invalid count value\n", 1, 256);
+		if (error)
+			return error;
+	}
+
+	if (restool.cmd_option_mask & ONE_BIT_MASK(TAKE_OPT_PLUGGED)) {
+		restool.cmd_option_mask &= ~ONE_BIT_MASK(TAKE_OPT_PLUGGED);
+		error = get_option_value(TAKE_OPT_PLUGGED, &value,
+					 "Invalid plugged value\n", 0, 1);
+		if (error)
+			return error;
+		plugged = value;
+	}
+
+	error = find_pool_dprc(profile, &pool_dprc_id, &found);
+	if (error < 0)
+		return error;
+
+	if (!found) {
+		ERROR_PRINTF("Pool %s does not exist, use 'restool pool fill'\n",
+			     profile->name);
+		return -ENOENT;
+	}
+
+	error = open_dprc(pool_dprc_id, &pool_dprc_handle);
+	if (error < 0)
+		return error;
+
+	error = get_pool_contents(profile, pool_dprc_handle, &contents);
+	error2 = dprc_close(&restool.mc_io, 0, pool_dprc_handle);
+	if (error == 0)
+		error = error2;
+	if (error < 0)
+		return error;
+
+	if (contents.num_units < count) {
+		ERROR_PRINTF("Pool %s holds %d object set(s), %ld requested\n",
+			     profile->name, contents.num_units, count);
+		error = -ENOSPC;
+		goto out;
+	}
+
+	for (int j = 0; j < POOL_MAX_OBJ_TYPES && profile->objs[j].type; j++) {
+		const char *obj_type = profile->objs[j].type;
+		int num_objs = profile->objs[j].count * count;
+
+		for (int k = 0; k < num_objs; k++) {
+			error = take_pool_obj(pool_dprc_id, dest_dprc_id,
+					      obj_type, contents.ids[j][k],
+					      plugged);
+			if (error < 0) {
+				mc_status = flib_error_to_mc_status(error);
+				ERROR_PRINTF("%s.%d: MC error: %s (status %#x)\n",
+					     obj_type, contents.ids[j][k],
+					     mc_status_to_string(mc_status),
+					     mc_status);
+				goto out;
+			}
+
+			printf("%s.%d\n", obj_type, contents.ids[j][k]);
+		}
+	}
+out:
+	free_pool_contents(&contents);
+	return error;
+}
+
+static int cmd_pool_list(void)
+{
+	static const char usage_msg[] =
+		"\n"
+		"Usage: restool pool list\n"
+		"\n"
+		"Lists the pools with their staging container and the number\n"
+		"of object sets they hold.\n"
+		"\n";
+
+	struct pool_contents contents;
+	uint16_t pool_dprc_handle;
+	uint32_t pool_dprc_id;
+	bool found;
+	int error, error2;
+
+	if (restool.cmd_option_mask & ONE_BIT_MASK(LIST_OPT_HELP)) {
+		puts(usage_msg);
+		restool.cmd_option_mask &= ~ONE_BIT_MASK(LIST_OPT_HELP);
+		return 0;
+	}
+
+	for (unsigned int i = 0; i < ARRAY_SIZE(pool_profiles); i++) {
+		const struct pool_profile *profile = &pool_profiles[i];
+
+		error = find_pool_dprc(profile, &pool_dprc_id, &found);
+		if (error < 0)
+			return error;
+		if (!found)
+			continue;
+
+		error = open_dprc(pool_dprc_id, &pool_dprc_handle);
+		if (error < 0)
+			return error;
+
+		error = get_pool_contents(profile, pool_dprc_handle,
+					  &contents);
+		error2 = dprc_close(&restool.mc_io, 0, pool_dprc_handle);
+		if (error == 0)
+			error = error2;
+		if (error < 0)
+			return error;
+
+		printf("%-6s dprc.%u %d\n", profile->name, pool_dprc_id,
+		       contents.num_units);
+		free_pool_contents(&contents);
+	}
+
+	return 0;
+}
+
+/**
+ * pool command table
+ */
+struct object_command pool_commands[] = {
+	{ .cmd_name = "help",
+	  .options = NULL,
+	  .cmd_func = cmd_pool_help },
+
+	{ .cmd_name = "fill",
+	  .options = pool_fill_options,
+	  .cmd_func = cmd_pool_fill },
+
+	{ .cmd_name = "take",
+	  .options = pool_take_options,
+	  .cmd_func = cmd_pool_take },
+
+	{ .cmd_name = "list",
+	  .options = pool_list_options,
+	  .cmd_func = cmd_pool_list },
+
+	{ .cmd_name = NULL },
+};
@@ -39,6 +39,9 @@
 #include <assert.h>
 #include <getopt.h>
 #include <sys/ioctl.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
 #include "restool.h"
 #include "utils.h"
 
@@ -159,6 +162,41 @@ static const struct obj_command_versions dpdmai_command_versions[] = {
 	{ .version = 0, .obj_commands = NULL },
 };
 
+static const struct obj_command_versions pool_command_versions[] = {
+	{ .version = 1, .obj_commands = pool_commands },
+	{ .version = 0, .obj_commands = NULL },
+};
+
+static const struct obj_command_versions snapshot_command_versions[] = {
+	{ .version = 1, .obj_commands = snapshot_commands },
+	{ .version = 0, .obj_commands = NULL },
+};
+
+static const struct obj_command_versions find_command_versions[] = {
+	{ .version = 1, .obj_commands = find_commands },
+	{ .version = 0, .obj_commands = NULL },
+};
+
+static const struct obj_command_versions ni_command_versions[] = {
+	{ .version = 1, .obj_commands = ni_commands },
+	{ .version = 0, .obj_commands = NULL },
+};
+
+static const struct obj_command_versions mac_command_versions[] = {
+	{ .version = 1, .obj_commands = mac_commands },
+	{ .version = 0, .obj_commands = NULL },
+};
+
+static const struct obj_command_versions sw_command_versions[] = {
+	{ .version = 1, .obj_commands = sw_commands },
+	{ .version = 0, .obj_commands = NULL },
+};
+
+static const struct obj_command_versions mux_command_versions[] = {
+	{ .version = 1, .obj_commands = mux_commands },
+	{ .version = 0, .obj_commands = NULL },
+};
+
 static const struct object_cmd_parser object_cmd_parsers[] = {
 	{ .obj_type = "dprc",   .obj_commands_versions = dprc_command_versions   },
 	{ .obj_type = "dpni",   .obj_commands_versions = dpni_command_versions   },
@@ -176,6 +214,13 @@ static const struct object_cmd_parser object_cmd_parsers[] = {
 	{ .obj_type = "dpdbg",  .obj_commands_versions = dpdbg_command_versions },
 	{ .obj_type = "dprtc",  .obj_commands_versions = dprtc_command_versions },
 	{ .obj_type = "dpdmai", .obj_commands_versions = dpdmai_command_versions },
+	{ .obj_type = "pool",   .obj_commands_versions = pool_command_versions   },
+	{ .obj_type = "snapshot", .obj_commands_versions = snapshot_command_versions },
+	{ .obj_type = "find",   .obj_commands_versions = find_command_versions   },
+	{ .obj_type = "ni",     .obj_commands_versions = ni_command_versions     },
+	{ .obj_type = "mac",    .obj_commands_versions = mac_command_versions    },
+	{ .obj_type = "sw",     .obj_commands_versions = sw_command_versions     },
+	{ .obj_type = "mux",    .obj_commands_versions = mux_command_versions    },
 };
 /**
  * Individual object structs to hold the mapping of the MC Version
@@ -265,6 +310,35 @@ struct version_table dprtc_version_table[] = {
 	{ .mc_major_version = 10, .object_version = 2 },
 	{ .mc_major_version = 0 }
 };
+struct version_table find_version_table[] = {
+	{ .mc_major_version = 9, .object_version = 1 },
+	{ .mc_major_version = 10, .object_version = 1 },
+	{ .mc_major_version = 0 }
+};
+struct version_table pool_version_table[] = {
+	{ .mc_major_version = 10, .object_version = 1 },
+	{ .mc_major_version = 0 }
+};
+struct version_table snapshot_version_table[] = {
+	{ .mc_major_version = 10, .object_version = 1 },
+	{ .mc_major_version = 0 }
+};
+struct version_table ni_version_table[] = {
+	{ .mc_major_version = 10, .object_version = 1 },
+	{ .mc_major_version = 0 }
+};
+struct version_table mac_version_table[] = {
+	{ .mc_major_version = 10, .object_version = 1 },
+	{ .mc_major_version = 0 }
+};
+struct version_table sw_version_table[] = {
+	{ .mc_major_version = 10, .object_version = 1 },
+	{ .mc_major_version = 0 }
+};
+struct version_table mux_version_table[] = {
+	{ .mc_major_version = 10, .object_version = 1 },
+	{ .mc_major_version = 0 }
+};
 
 /**
  * Lookup table used to map a specific MC Version to its corresponding
@@ -287,6 +361,13 @@ struct lut_entry version_lut[] = {
 	{ .object = "dpsw",   .versions_table = dpsw_version_table   },
 	{ .object = "dpdbg",  .versions_table = dpdbg_version_table  },
 	{ .object = "dprtc",  .versions_table = dprtc_version_table  },
+	{ .object = "pool",   .versions_table = pool_version_table   },
+	{ .object = "snapshot", .versions_table = snapshot_version_table },
+	{ .object = "find",   .versions_table = find_version_table   },
+	{ .object = "ni",     .versions_table = ni_version_table     },
+	{ .object = "mac",    .versions_table = mac_version_table    },
+	{ .object = "sw",     .versions_table = sw_version_table     },
+	{ .object = "mux",    .versions_table = mux_version_table    },
 };
 
 struct restool restool;
@@ -365,6 +446,7 @@ int find_target_obj_desc(uint32_t dprc_id, uint16_t dprc_handle,
 		DEBUG_PRINTF("This is root dprc.\n");
 		strcpy(target_obj_desc->type, "dprc");
 		target_obj_desc->id = 1;
+		*found = true;
 		return 0;
 	}
 
@@ -482,10 +564,11 @@ void print_obj_label(struct dprc_obj_desc *target_obj_desc)
 		printf("object label: %s\n", target_obj_desc->label);
 }
 
-int print_obj_verbose(struct dprc_obj_desc *target_obj_desc,
-			const struct flib_ops *ops)
+int print_obj_verbose(struct dprc_obj_desc *target_obj_desc)
 {
+	const struct flib_ops *ops;
 	uint16_t obj_handle;
+	int type_id;
 	uint32_t irq_mask;
 	uint32_t irq_status;
 	enum mc_cmd_status mc_status;
@@ -517,6 +600,14 @@ int print_obj_verbose(struct dprc_obj_desc *target_obj_desc,
 		return 0;
 	}
 
+	type_id = get_obj_type_id(target_obj_desc->type);
+	if (type_id < 0 || get_obj_type_desc(type_id)->ops == NULL) {
+		ERROR_PRINTF("no flib operations for %s objects\n",
+			     target_obj_desc->type);
+		return -EINVAL;
+	}
+	ops = get_obj_type_desc(type_id)->ops;
+
 	printf("number of mappable regions: %u\n",
 		target_obj_desc->region_count);
 	printf("number of interrupts: %u\n", target_obj_desc->irq_count);
@@ -609,6 +700,50 @@ bool in_use(const char *obj, const char *situation)
 	return false;
 }
 
+/**
+ * Unbinds an object from its driver through sysfs. Objects that are not
+ * bound to any driver are left untouched.
+ */
+int unbind_obj_driver(const char *obj)
+{
+	char unbind_path[PATH_MAX];
+	int error = 0;
+	FILE *fp;
+	int n;
+
+	n = snprintf(unbind_path, PATH_MAX,
+			"/sys/bus/fsl-mc/devices/%s/driver/unbind", obj);
+	if (n < 0 || n > PATH_MAX - 1) {
+		ERROR_PRINTF("unbind path copy error.\n");
+		return -EINVAL;
+	}
+
+	if (access(unbind_path, F_OK) != 0)
+		return 0;
+
+	fp = fopen(unbind_path, "w");
+	if (fp == NULL) {
+		error = -errno;
+		ERROR_PRINTF("Could not open %s: %s\n",
+			     unbind_path, strerror(errno));
+		return error;
+	}
+
+	if (fputs(obj, fp) == EOF)
+		error = -errno;
+
+	if (fclose(fp) == EOF && error == 0)
+		error = -errno;
+
+	if (error < 0) {
+		ERROR_PRINTF("Could not unbind %s: %s\n", obj, strerror(-error));
+		return error;
+	}
+
+	DEBUG_PRINTF("%s is unbound from its driver\n", obj);
+	return 0;
+}
+
 void print_new_obj(char *type, int id, const char *parent)
 {
 	if (restool.script) {
@@ -672,6 +807,250 @@ int get_parent_dprc_id(uint32_t obj_id, char *obj_type, uint32_t *parent_dprc_id
 	return 0;
 }
 
+static int topology_add(struct topology *topology,
+			const struct dprc_obj_desc *obj_desc,
+			uint32_t parent_dprc_id, int nesting_level)
+{
+	struct topology_obj *objs;
+	int max_objs;
+
+	if (topology->num_objs == topology->max_objs) {
+		max_objs = topology->max_objs ? topology->max_objs * 2 : 64;
+		objs = realloc(topology->objs, max_objs * sizeof(*objs));
+		if (!objs) {
+			ERROR_PRINTF("Could not alloc memory for topology!\n");
+			return -ENOMEM;
+		}
+		topology->objs = objs;
+		topology->max_objs = max_objs;
+	}
+
+	topology->objs[topology->num_objs].desc = *obj_desc;
+	topology->objs[topology->num_objs].parent_dprc_id = parent_dprc_id;
+	topology->objs[topology->num_objs].nesting_level = nesting_level;
+	topology->num_objs++;
+
+	return 0;
+}
+
+/**
+ * Collects all objects found under a given DPRC, recursively, in a single
+ * walk of the container hierarchy. The caller must release the snapshot
+ * with free_topology().
+ */
+int get_topology(uint32_t dprc_id, uint16_t dprc_handle,
+		 int nesting_level, struct topology *topology)
+{
+	int num_child_devices;
+	int error = 0;
+	enum mc_cmd_status mc_status;
+
+	assert(nesting_level <= MAX_DPRC_NESTING);
+
+	error = dprc_get_obj_count(&restool.mc_io, 0,
+				   dprc_handle,
+				   &num_child_devices);
+	if (error < 0) {
+		mc_status = flib_error_to_mc_status(error);
+		ERROR_PRINTF("MC error: %s (status %#x)\n",
+			     mc_status_to_string(mc_status), mc_status);
+		return error;
+	}
+
+	for (int i = 0; i < num_child_devices; i++) {
+		struct dprc_obj_desc obj_desc;
+		uint16_t child_dprc_handle;
+		int error2;
+
+		error = dprc_get_obj(&restool.mc_io, 0,
+				     dprc_handle,
+				     i,
+				     &obj_desc);
+		if (error < 0) {
+			DEBUG_PRINTF(
+				"dprc_get_object(%u) failed with error %d\n",
+				i, error);
+			return error;
+		}
+
+		error = topology_add(topology, &obj_desc, dprc_id,
+				     nesting_level);
+		if (error < 0)
+			return error;
+
+		if (strcmp(obj_desc.type, "dprc") != 0)
+			continue;
+
+		error = open_dprc(obj_desc.id, &child_dprc_handle);
+		if (error < 0)
+			return error;
+
+		error = get_topology(obj_desc.id, child_dprc_handle,
+				     nesting_level + 1, topology);
+
+		error2 = dprc_close(&restool.mc_io, 0, child_dprc_handle);
+		if (error2 < 0) {
+			mc_status = flib_error_to_mc_status(error2);
+			ERROR_PRINTF("MC error: %s (status %#x)\n",
+				     mc_status_to_string(mc_status), mc_status);
+			if (error == 0)
+				error = error2;
+		}
+
+		if (error < 0)
+			return error;
+	}
+
+	return 0;
+}
+
+struct topology_obj *topology_find(const struct topology *topology,
+				   const char *obj_type, int obj_id)
+{
+	for (int i = 0; i < topology->num_objs; i++) {
+		if (topology->objs[i].desc.id == obj_id &&
+		    strcmp(topology->objs[i].desc.type, obj_type) == 0)
+			return &topology->objs[i];
+	}
+
+	return NULL;
+}
+
+void free_topology(struct topology *topology)
+{
+	free(topology->objs);
+	topology->objs = NULL;
+	topology->num_objs = 0;
+	topology->max_objs = 0;
+}
+
+uint32_t hash_endpoint(const char *type, int id, int if_id)
+{
+	uint32_t hash = 2166136261u;
+
+	for (; *type != '\0'; type++) {
+		hash ^= (uint8_t)*type;
+		hash *= 16777619u;
+	}
+
+	hash ^= (uint32_t)id;
+	hash *= 16777619u;
+	hash ^= (uint32_t)if_id;
+	hash *= 16777619u;
+
+	return hash;
+}
+
+/**
+ * Connection cache entry: an endpoint and the endpoint it is linked to,
+ * state is -1 when the endpoint is not connected
+ */
+struct conn_cache_entry {
+	struct dprc_endpoint endpoint1;
+	struct dprc_endpoint endpoint2;
+	int state;
+	bool used;
+};
+
+static struct conn_cache_entry *conn_cache;
+static unsigned int conn_cache_size;
+static unsigned int conn_cache_count;
+
+static struct conn_cache_entry *conn_cache_slot(
+				const struct dprc_endpoint *endpoint)
+{
+	struct conn_cache_entry *entry;
+	unsigned int i;
+
+	i = hash_endpoint(endpoint->type, endpoint->id, endpoint->if_id) &
+	    (conn_cache_size - 1);
+	for (;;) {
+		entry = &conn_cache[i];
+		if (!entry->used ||
+		    (entry->endpoint1.id == endpoint->id &&
+		     entry->endpoint1.if_id == endpoint->if_id &&
+		     strcmp(entry->endpoint1.type, endpoint->type) == 0))
+			return entry;
+		i = (i + 1) & (conn_cache_size - 1);
+	}
+}
+
+static void conn_cache_add(const struct dprc_endpoint *endpoint1,
+			   const struct dprc_endpoint *endpoint2,
+			   int state)
+{
+	struct conn_cache_entry *old_cache = conn_cache;
+	unsigned int old_size = conn_cache_size;
+	struct conn_cache_entry *entry;
+
+	/* keep the table at most half full */
+	if ((conn_cache_count + 1) * 2 > conn_cache_size) {
+		unsigned int new_size = old_size ? old_size * 2 : 256;
+
+		conn_cache = calloc(new_size, sizeof(*conn_cache));
+		if (conn_cache == NULL) {
+			/* not caching only costs a later MC command */
+			conn_cache = old_cache;
+			return;
+		}
+
+		conn_cache_size = new_size;
+		for (unsigned int i = 0; i < old_size; i++) {
+			if (old_cache[i].used)
+				*conn_cache_slot(&old_cache[i].endpoint1) =
+					old_cache[i];
+		}
+		free(old_cache);
+	}
+
+	entry = conn_cache_slot(endpoint1);
+	if (!entry->used)
+		conn_cache_count++;
+	entry->endpoint1 = *endpoint1;
+	entry->endpoint2 = *endpoint2;
+	entry->state = state;
+	entry->used = true;
+}
+
+int get_connection(const struct dprc_endpoint *endpoint1,
+		   struct dprc_endpoint *endpoint2,
+		   int *state)
+{
+	struct conn_cache_entry *entry;
+	int error;
+
+	if (conn_cache_size != 0) {
+		entry = conn_cache_slot(endpoint1);
+		if (entry->used) {
+			*endpoint2 = entry->endpoint2;
+			*state = entry->state;
+			return 0;
+		}
+	}
+
+	error = dprc_get_connection(&restool.mc_io, 0,
+				    restool.root_dprc_handle,
+				    endpoint1, endpoint2, state);
+	if (error < 0)
+		return error;
+
+	conn_cache_add(endpoint1, endpoint2, *state);
+
+	/* the peer's query would return the same link, reversed */
+	if (*state != -1)
+		conn_cache_add(endpoint2, endpoint1, *state);
+
+	return 0;
+}
+
+void flush_connection_cache(void)
+{
+	free(conn_cache);
+	conn_cache = NULL;
+	conn_cache_size = 0;
+	conn_cache_count = 0;
+}
+
 static void print_usage(void)
 {
 	static const char usage_msg[] =
@@ -736,6 +1115,7 @@ static void print_usage_v9(void)
 		"SYNOPSIS\n"
 		"\n"
 		"  restool [<global-opts>] <object-type> <command> <object-name> [ARGS...]\n"
+		"  restool [<global-opts>] find [ARGS...]\n"
 		"\n"
 		"OPTIONS\n"
 		"\n"
@@ -747,7 +1127,8 @@ static void print_usage_v9(void)
 		"   --root=[dprc]    Specifies root container name\n"
 		"\n"
 		"  Valid <object-type> values: <dprc|dpni|dpio|dpsw|dpbp|dpci|dpcon|dpseci|dpdmux|\n"
-		"                               dpmcp|dpmac|dpdcei|dpaiop|dprtc|dpdmai>\n"
+		"                               dpmcp|dpmac|dpdcei|dpaiop|dprtc|dpdmai|\n"
+		"                               pool|snapshot|ni|mac|sw|mux>\n"
 		"\n"
 		"  Valid commands vary for each object type.\n"
 		"  Most objects support the following commands:\n"
@@ -837,6 +1218,163 @@ out:
 	return error;
 }
 
+/*
+ * Sorted by object type, in the order of enum obj_type_id
+ */
+static const struct obj_type_desc obj_types[] = {
+	[OBJ_TYPE_DPAIOP] = { "dpaiop", &dpaiop_ops },
+	[OBJ_TYPE_DPBP] = { "dpbp", &dpbp_ops },
+	[OBJ_TYPE_DPCI] = { "dpci", &dpci_ops },
+	[OBJ_TYPE_DPCON] = { "dpcon", &dpcon_ops },
+	[OBJ_TYPE_DPDBG] = { "dpdbg", NULL },
+	[OBJ_TYPE_DPDCEI] = { "dpdcei", &dpdcei_ops },
+	[OBJ_TYPE_DPDMAI] = { "dpdmai", &dpdmai_ops },
+	[OBJ_TYPE_DPDMUX] = { "dpdmux", &dpdmux_ops_v9 },
+	[OBJ_TYPE_DPIO] = { "dpio", &dpio_ops },
+	[OBJ_TYPE_DPMAC] = { "dpmac", &dpmac_ops },
+	[OBJ_TYPE_DPMCP] = { "dpmcp", &dpmcp_ops },
+	[OBJ_TYPE_DPNI] = { "dpni", &dpni_ops },
+	[OBJ_TYPE_DPRC] = { "dprc", &dprc_ops },
+	[OBJ_TYPE_DPRTC] = { "dprtc", &dprtc_ops },
+	[OBJ_TYPE_DPSECI] = { "dpseci", &dpseci_ops },
+	[OBJ_TYPE_DPSW] = { "dpsw", &dpsw_ops },
+};
+
+C_ASSERT(ARRAY_SIZE(obj_types) == NUM_OBJ_TYPES);
+
+int get_obj_type_id(const char *obj_type)
+{
+	int low = 0;
+	int high = NUM_OBJ_TYPES - 1;
+	int mid, diff;
+
+	while (low <= high) {
+		mid = (low + high) / 2;
+		diff = strcmp(obj_type, obj_types[mid].obj_type);
+		if (diff == 0)
+			return mid;
+		if (diff < 0)
+			high = mid - 1;
+		else
+			low = mid + 1;
+	}
+
+	return -EINVAL;
+}
+
+const struct obj_type_desc *get_obj_type_desc(enum obj_type_id type_id)
+{
+	assert(type_id < NUM_OBJ_TYPES);
+	return &obj_types[type_id];
+}
+
+int open_obj(enum obj_type_id type_id, uint32_t obj_id, uint16_t *obj_handle)
+{
+	const struct obj_type_desc *desc = get_obj_type_desc(type_id);
+	enum mc_cmd_status mc_status;
+	int error;
+
+	if (desc->ops == NULL)
+		return -ENOTSUP;
+
+	error = desc->ops->obj_open(&restool.mc_io, 0, obj_id, obj_handle);
+	if (error < 0) {
+		mc_status = flib_error_to_mc_status(error);
+		ERROR_PRINTF("MC error: %s (status %#x)\n",
+			mc_status_to_string(mc_status), mc_status);
+		return error;
+	}
+
+	if (*obj_handle == 0) {
+		DEBUG_PRINTF(
+			"%s_open() returned invalid handle (auth 0) for %s.%u\n",
+			desc->obj_type, desc->obj_type, obj_id);
+
+		(void)desc->ops->obj_close(&restool.mc_io, 0, *obj_handle);
+		return -ENOENT;
+	}
+
+	return 0;
+}
+
+int close_obj(enum obj_type_id type_id, uint16_t obj_handle)
+{
+	const struct obj_type_desc *desc = get_obj_type_desc(type_id);
+	enum mc_cmd_status mc_status;
+	int error;
+
+	error = desc->ops->obj_close(&restool.mc_io, 0, obj_handle);
+	if (error < 0) {
+		mc_status = flib_error_to_mc_status(error);
+		ERROR_PRINTF("MC error: %s (status %#x)\n",
+			mc_status_to_string(mc_status), mc_status);
+	}
+
+	return error;
+}
+
+/* /proc/self/pagemap entry: bit 63 is page present, bits 0-54 the PFN */
+#define PAGEMAP_PAGE_PRESENT	(1ULL << 63)
+#define PAGEMAP_PFN_MASK	((1ULL << 55) - 1)
+
+int alloc_dma_buf(size_t size, void **vaddr, uint64_t *iova)
+{
+	long page_size = sysconf(_SC_PAGESIZE);
+	uint64_t entry;
+	ssize_t count;
+	void *buf;
+	int fd, error;
+
+	/* one page is the most that is known to be physically contiguous */
+	if (size > (size_t)page_size)
+		return -EINVAL;
+
+	buf = mmap(NULL, page_size, PROT_READ | PROT_WRITE,
+		   MAP_PRIVATE | MAP_ANONYMOUS | MAP_LOCKED, -1, 0);
+	if (buf == MAP_FAILED) {
+		error = -errno;
+		ERROR_PRINTF("mmap() failed: %s\n", strerror(errno));
+		return error;
+	}
+	memset(buf, 0, page_size);
+
+	fd = open("/proc/self/pagemap", O_RDONLY);
+	if (fd < 0) {
+		error = -errno;
+		ERROR_PRINTF("open(/proc/self/pagemap) failed: %s\n",
+			     strerror(errno));
+		goto err_unmap;
+	}
+
+	count = pread(fd, &entry, sizeof(entry),
+		      ((uintptr_t)buf / page_size) * sizeof(entry));
+	error = count == sizeof(entry) ? 0 : -EIO;
+	close(fd);
+	if (error)
+		goto err_unmap;
+
+	/* the PFN reads as 0 without CAP_SYS_ADMIN */
+	if (!(entry & PAGEMAP_PAGE_PRESENT) ||
+	    (entry & PAGEMAP_PFN_MASK) == 0) {
+		ERROR_PRINTF("Could not find the physical address of the DMA buffer\n");
+		error = -EPERM;
+		goto err_unmap;
+	}
+
+	*vaddr = buf;
+	*iova = (entry & PAGEMAP_PFN_MASK) * page_size;
+	return 0;
+
+err_unmap:
+	munmap(buf, page_size);
+	return error;
+}
+
+void free_dma_buf(void *vaddr)
+{
+	munmap(vaddr, sysconf(_SC_PAGESIZE));
+}
+
 static int check_arg(char *optarg)
 {
 	int str_len = 0;
@@ -1470,6 +2008,19 @@ int main(int argc, char *argv[])
 		}
 
 		num_remaining_args = argc - next_argv_index;
+		obj_type = argv[next_argv_index];
+		if (strcmp(obj_type, "find") == 0) {
+			/*
+			 * find is not tied to an object type, the command
+			 * name doubles as the object type
+			 */
+			error = parse_obj_command(obj_type,
+						  obj_type,
+						  num_remaining_args,
+						  &argv[next_argv_index]);
+			goto out;
+		}
+
 		if (num_remaining_args < 2) {
 			ERROR_PRINTF("Incomplete command line\n");
 			print_try_help();
@@ -1477,7 +2028,6 @@ int main(int argc, char *argv[])
 			goto out;
 		}
 
-		obj_type = argv[next_argv_index];
 		cmd_name = argv[next_argv_index + 1];
 		error = parse_obj_command(obj_type,
 					  cmd_name,
@@ -1487,6 +2037,9 @@ int main(int argc, char *argv[])
 			goto out;
 	}
 
+	if (restool.rescan_done)
+		goto out;
+
 	DEBUG_PRINTF("calling sytem()\n");
 	error = system("echo 1 > /sys/bus/fsl-mc/rescan");
 	if (error == -1) {
@@ -1497,6 +2050,7 @@ int main(int argc, char *argv[])
 	}
 
 out:
+	flush_connection_cache();
 	if (root_dprc_opened) {
 		int error2;
 
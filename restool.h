@@ -275,6 +275,11 @@ struct restool {
 	 */
 	char specified_dev_file[USR_DEV_FILE_SIZE];
 
+	/**
+	 * set by commands that already rescanned the fsl-mc bus for the
+	 * objects they added
+	 */
+	bool rescan_done;
 };
 
 /**
@@ -326,6 +331,74 @@ struct flib_ops {
 	flib_obj_get_irq_status_t *obj_get_irq_status;
 };
 
+/**
+ * MC object types, index of the object type registry
+ */
+enum obj_type_id {
+	OBJ_TYPE_DPAIOP = 0,
+	OBJ_TYPE_DPBP,
+	OBJ_TYPE_DPCI,
+	OBJ_TYPE_DPCON,
+	OBJ_TYPE_DPDBG,
+	OBJ_TYPE_DPDCEI,
+	OBJ_TYPE_DPDMAI,
+	OBJ_TYPE_DPDMUX,
+	OBJ_TYPE_DPIO,
+	OBJ_TYPE_DPMAC,
+	OBJ_TYPE_DPMCP,
+	OBJ_TYPE_DPNI,
+	OBJ_TYPE_DPRC,
+	OBJ_TYPE_DPRTC,
+	OBJ_TYPE_DPSECI,
+	OBJ_TYPE_DPSW,
+	NUM_OBJ_TYPES
+};
+
+/**
+ * Object type registry entry
+ */
+struct obj_type_desc {
+	/**
+	 * object type, as reported by dprc_get_obj()
+	 */
+	const char *obj_type;
+
+	/**
+	 * flib operations of the type, NULL if its objects cannot be opened
+	 */
+	const struct flib_ops *ops;
+};
+
+/**
+ * MC object found while walking a container hierarchy
+ */
+struct topology_obj {
+	/**
+	 * object descriptor as returned by dprc_get_obj()
+	 */
+	struct dprc_obj_desc desc;
+
+	/**
+	 * id of the container the object belongs to
+	 */
+	uint32_t parent_dprc_id;
+
+	/**
+	 * nesting level of the parent container, relative to the walk start
+	 */
+	int nesting_level;
+};
+
+/**
+ * Flat snapshot of all objects found under a container. Objects are stored
+ * in walk order: a child container always precedes its own objects.
+ */
+struct topology {
+	struct topology_obj *objs;
+	int num_objs;
+	int max_objs;
+};
+
 /* functions used for parsing user command line argumments */
 int parse_object_name(const char *obj_name,
 		      char *expected_obj_type,
@@ -350,14 +423,37 @@ void print_unexpected_options_error(uint32_t option_mask,
 
 void print_obj_label(struct dprc_obj_desc *target_obj_desc);
 
-int print_obj_verbose(struct dprc_obj_desc *target_obj_desc,
-		      const struct flib_ops *ops);
+int print_obj_verbose(struct dprc_obj_desc *target_obj_desc);
 
 void print_new_obj(char *type, int id, const char *parent);
 
 /* functions used to handle generic object handling */
 int open_dprc(uint32_t dprc_id, uint16_t *dprc_handle);
 
+/*
+ * Object type registry: an object type is resolved to its index once,
+ * the per type operations are then reached by index. get_obj_type_id()
+ * returns -EINVAL for unknown types.
+ */
+int get_obj_type_id(const char *obj_type);
+
+const struct obj_type_desc *get_obj_type_desc(enum obj_type_id type_id);
+
+int open_obj(enum obj_type_id type_id, uint32_t obj_id,
+	     uint16_t *obj_handle);
+
+int close_obj(enum obj_type_id type_id, uint16_t obj_handle);
+
+/*
+ * Zeroed buffer of up to one page the MC can read from, for commands
+ * that take their parameters by I/O virtual address. The address handed
+ * to the MC is the physical one: this only works while the MC accesses
+ * memory without SMMU translation.
+ */
+int alloc_dma_buf(size_t size, void **vaddr, uint64_t *iova);
+
+void free_dma_buf(void *vaddr);
+
 int find_target_obj_desc(uint32_t dprc_id, uint16_t dprc_handle,
 			int nesting_level,
 			uint32_t target_id, char *target_type,
@@ -370,9 +466,32 @@ int check_resource_type(char *res_type);
 
 bool in_use(const char *obj, const char *situation);
 
+int unbind_obj_driver(const char *obj);
+
 int get_parent_dprc_id(uint32_t obj_id, char *obj_type,
 		       uint32_t *parent_dprc_id);
 
+int get_topology(uint32_t dprc_id, uint16_t dprc_handle,
+		 int nesting_level, struct topology *topology);
+
+struct topology_obj *topology_find(const struct topology *topology,
+				   const char *obj_type, int obj_id);
+
+void free_topology(struct topology *topology);
+
+uint32_t hash_endpoint(const char *type, int id, int if_id);
+
+/*
+ * Same as dprc_get_connection() on the root container, but the links
+ * are cached for the rest of the session, in both directions. Commands
+ * that change links must query the MC directly.
+ */
+int get_connection(const struct dprc_endpoint *endpoint1,
+		   struct dprc_endpoint *endpoint2,
+		   int *state);
+
+void flush_connection_cache(void);
+
 extern struct restool restool;
 
 /* command maps for all MC objects */
@@ -421,5 +540,29 @@ extern struct object_command dpsw_commands[];
 extern struct object_command dpsw_commands_v9[];
 extern struct object_command dpsw_commands_v10[];
 extern struct object_command dpdbg_commands[];
+extern struct object_command pool_commands[];
+extern struct object_command snapshot_commands[];
+extern struct object_command find_commands[];
+extern struct object_command ni_commands[];
+extern struct object_command mac_commands[];
+extern struct object_command sw_commands[];
+extern struct object_command mux_commands[];
+
+/* flib operations of all MC objects */
+extern const struct flib_ops dpaiop_ops;
+extern const struct flib_ops dpbp_ops;
+extern const struct flib_ops dpci_ops;
+extern const struct flib_ops dpcon_ops;
+extern const struct flib_ops dpdcei_ops;
+extern const struct flib_ops dpdmai_ops;
+extern const struct flib_ops dpdmux_ops_v9;
+extern const struct flib_ops dpio_ops;
+extern const struct flib_ops dpmac_ops;
+extern const struct flib_ops dpmcp_ops;
+extern const struct flib_ops dpni_ops;
+extern const struct flib_ops dprc_ops;
+extern const struct flib_ops dprtc_ops;
+extern const struct flib_ops dpseci_ops;
+extern const struct flib_ops dpsw_ops;
 
 #endif /* _RESTOOL_H_ */
@@ -0,0 +1,1115 @@
+/* Copyright 2026 NXP
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * * Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ * * Neither the name of the above-listed copyright holders nor the
+ * names of any contributors may be used to endorse or promote products
+ * derived from this software without specific prior written permission.
+ *
+ *
+ * ALTERNATIVELY, this software may be distributed under the terms of the
+ * GNU General Public License ("GPL") as published by the Free Software
+ * Foundation, either version 2 of that License or (at your option) any
+ * later version.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDERS OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <errno.h>
+#include <assert.h>
+#include <getopt.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "restool.h"
+#include "utils.h"
+#include "dprc_commands_clone.h"
+
+/*
+ * A snapshot file is a header followed by the object records, then the
+ * link records. All records have a fixed size and are stored in host byte
+ * order, so that a file can be mapped and used in place.
+ */
+#define SNAPSHOT_MAGIC		0x504e5352	/* "RSNP" */
+#define SNAPSHOT_VERSION	1
+
+/* the creation parameters of the object are valid */
+#define SNAPSHOT_OBJ_HAS_CFG	0x0001
+
+enum mc_cmd_status mc_status;
+
+struct snapshot_header {
+	uint32_t magic;
+	uint16_t version;
+	uint16_t header_size;
+	uint16_t obj_size;
+	uint16_t link_size;
+	uint32_t cfg_size;
+	uint32_t mc_fw_major;
+	uint32_t mc_fw_minor;
+	uint32_t dprc_id;
+	uint32_t num_objs;
+	uint32_t num_links;
+	uint32_t reserved;
+};
+
+C_ASSERT(sizeof(struct snapshot_header) == 40);
+
+/**
+ * Object of the saved container tree, in get_topology() walk order: a
+ * container is always stored before the objects it holds
+ */
+struct snapshot_obj {
+	char type[OBJ_TYPE_MAX_LENGTH + 8];
+	char label[MC_OBJ_LABEL_MAX_LENGTH + 1];
+	uint32_t id;
+	uint32_t parent_id;
+	uint32_t state;
+	uint16_t num_ifs;
+	uint16_t flags;
+	union obj_create_cfg cfg;
+};
+
+/**
+ * Link with at least one end in the saved container tree
+ */
+struct snapshot_link {
+	char type1[OBJ_TYPE_MAX_LENGTH + 8];
+	uint32_t id1;
+	uint32_t if_id1;
+	char type2[OBJ_TYPE_MAX_LENGTH + 8];
+	uint32_t id2;
+	uint32_t if_id2;
+};
+
+/**
+ * Snapshot in memory. A loaded snapshot points into the file mapping.
+ */
+struct snapshot {
+	struct snapshot_header hdr;
+	struct snapshot_obj *objs;
+	struct snapshot_link *links;
+	int max_links;
+	void *map;
+	size_t map_size;
+};
+
+/**
+ * snapshot save command options
+ */
+enum snapshot_save_options {
+	SAVE_OPT_HELP = 0,
+	SAVE_OPT_CONTAINER,
+};
+
+static struct option snapshot_save_options[] = {
+	[SAVE_OPT_HELP] = {
+		.name = "help",
+	},
+
+	[SAVE_OPT_CONTAINER] = {
+		.name = "container",
+		.has_arg = 1,
+	},
+
+	{ 0 },
+};
+
+C_ASSERT(ARRAY_SIZE(snapshot_save_options) <= MAX_NUM_CMD_LINE_OPTIONS + 1);
+
+/**
+ * snapshot restore command options
+ */
+enum snapshot_restore_options {
+	RESTORE_OPT_HELP = 0,
+	RESTORE_OPT_CONTAINER,
+};
+
+static struct option snapshot_restore_options[] = {
+	[RESTORE_OPT_HELP] = {
+		.name = "help",
+	},
+
+	[RESTORE_OPT_CONTAINER] = {
+		.name = "container",
+		.has_arg = 1,
+	},
+
+	{ 0 },
+};
+
+C_ASSERT(ARRAY_SIZE(snapshot_restore_options) <= MAX_NUM_CMD_LINE_OPTIONS + 1);
+
+/**
+ * snapshot diff command options
+ */
+enum snapshot_diff_options {
+	DIFF_OPT_HELP = 0,
+	DIFF_OPT_WITH,
+	DIFF_OPT_CONTAINER,
+};
+
+static struct option snapshot_diff_options[] = {
+	[DIFF_OPT_HELP] = {
+		.name = "help",
+	},
+
+	[DIFF_OPT_WITH] = {
+		.name = "with",
+		.has_arg = 1,
+	},
+
+	[DIFF_OPT_CONTAINER] = {
+		.name = "container",
+		.has_arg = 1,
+	},
+
+	{ 0 },
+};
+
+C_ASSERT(ARRAY_SIZE(snapshot_diff_options) <= MAX_NUM_CMD_LINE_OPTIONS + 1);
+
+static int cmd_snapshot_help(void)
+{
+	static const char help_msg[] =
+		"\n"
+		"Usage: restool snapshot <command> [--help] [ARGS...]\n"
+		"Where <command> can be:\n"
+		"   save    - saves a container tree to a binary snapshot file.\n"
+		"   restore - creates the contents of a snapshot file in a container.\n"
+		"   diff    - compares a snapshot file with the live system or\n"
+		"             with another snapshot file.\n"
+		"\n"
+		"For command-specific help, use the --help option of each command.\n"
+		"\n";
+
+	printf(help_msg);
+	return 0;
+}
+
+static void free_snapshot(struct snapshot *snap)
+{
+	if (snap->map != NULL) {
+		munmap(snap->map, snap->map_size);
+	} else {
+		free(snap->objs);
+		free(snap->links);
+	}
+
+	memset(snap, 0, sizeof(*snap));
+}
+
+static int find_snapshot_obj(const struct snapshot *snap, const char *type,
+			     uint32_t id)
+{
+	for (uint32_t i = 0; i < snap->hdr.num_objs; i++) {
+		if (snap->objs[i].id == id &&
+		    strcmp(snap->objs[i].type, type) == 0)
+			return i;
+	}
+
+	return -1;
+}
+
+static int read_snapshot_dprc_cfg(struct snapshot_obj *obj)
+{
+	struct dprc_attributes dprc_attr;
+	uint16_t dprc_handle;
+	int error, error2;
+
+	error = open_dprc(obj->id, &dprc_handle);
+	if (error < 0)
+		return error;
+
+	memset(&dprc_attr, 0, sizeof(dprc_attr));
+	error = dprc_get_attributes(&restool.mc_io, 0, dprc_handle,
+				    &dprc_attr);
+	error2 = dprc_close(&restool.mc_io, 0, dprc_handle);
+	if (error == 0)
+		error = error2;
+	if (error < 0) {
+		mc_status = flib_error_to_mc_status(error);
+		ERROR_PRINTF("dprc.%u: MC error: %s (status %#x)\n", obj->id,
+			     mc_status_to_string(mc_status), mc_status);
+		return error;
+	}
+
+	obj->cfg.dprc.options = dprc_attr.options;
+	return 0;
+}
+
+static int add_snapshot_link(struct snapshot *snap,
+			     const struct dprc_endpoint *endpoint1,
+			     const struct dprc_endpoint *endpoint2)
+{
+	struct snapshot_link *link;
+
+	/* a link inside the saved tree is seen from both of its ends */
+	for (uint32_t i = 0; i < snap->hdr.num_links; i++) {
+		link = &snap->links[i];
+		if (link->id1 == (uint32_t)endpoint2->id &&
+		    link->if_id1 == endpoint2->if_id &&
+		    strcmp(link->type1, endpoint2->type) == 0)
+			return 0;
+	}
+
+	if ((int)snap->hdr.num_links == snap->max_links) {
+		int max_links = snap->max_links ? snap->max_links * 2 : 16;
+
+		link = realloc(snap->links, max_links * sizeof(*link));
+		if (link == NULL) {
+			ERROR_PRINTF("Could not alloc memory!\n");
+			return -ENOMEM;
+		}
+
+		snap->links = link;
+		snap->max_links = max_links;
+	}
+
+	link = &snap->links[snap->hdr.num_links++];
+	memset(link, 0, sizeof(*link));
+	strcpy(link->type1, endpoint1->type);
+	link->id1 = endpoint1->id;
+	link->if_id1 = endpoint1->if_id;
+	strcpy(link->type2, endpoint2->type);
+	link->id2 = endpoint2->id;
+	link->if_id2 = endpoint2->if_id;
+	return 0;
+}
+
+static int read_snapshot_links(struct snapshot *snap)
+{
+	struct dprc_endpoint endpoint1;
+	struct dprc_endpoint endpoint2;
+	const struct snapshot_obj *obj;
+	int state;
+	int error;
+
+	for (uint32_t i = 0; i < snap->hdr.num_objs; i++) {
+		obj = &snap->objs[i];
+		for (uint16_t if_id = 0; if_id < obj->num_ifs; if_id++) {
+			memset(&endpoint1, 0, sizeof(endpoint1));
+			memset(&endpoint2, 0, sizeof(endpoint2));
+			strcpy(endpoint1.type, obj->type);
+			endpoint1.id = obj->id;
+			endpoint1.if_id = if_id;
+
+			error = dprc_get_connection(&restool.mc_io, 0,
+						    restool.root_dprc_handle,
+						    &endpoint1, &endpoint2,
+						    &state);
+			/*
+			 * like elsewhere, an endpoint that cannot be
+			 * queried is taken as not linked
+			 */
+			if (error < 0) {
+				DEBUG_PRINTF("%s.%u.%u: dprc_get_connection() failed with error %d\n",
+					     obj->type, obj->id, if_id, error);
+				continue;
+			}
+
+			if (state == -1)
+				continue;
+
+			error = add_snapshot_link(snap, &endpoint1,
+						  &endpoint2);
+			if (error < 0)
+				return error;
+		}
+	}
+
+	return 0;
+}
+
+/**
+ * Reads the container tree under dprc_id, with the creation parameters,
+ * labels, states and links of all its objects
+ */
+static int capture_snapshot(uint32_t dprc_id, struct snapshot *snap)
+{
+	struct topology topology = { 0 };
+	const struct dprc_obj_desc *desc;
+	struct snapshot_obj *obj;
+	uint16_t dprc_handle;
+	int error, error2;
+
+	memset(snap, 0, sizeof(*snap));
+	snap->hdr.magic = SNAPSHOT_MAGIC;
+	snap->hdr.version = SNAPSHOT_VERSION;
+	snap->hdr.header_size = sizeof(struct snapshot_header);
+	snap->hdr.obj_size = sizeof(struct snapshot_obj);
+	snap->hdr.link_size = sizeof(struct snapshot_link);
+	snap->hdr.cfg_size = sizeof(union obj_create_cfg);
+	snap->hdr.mc_fw_major = restool.mc_fw_version.major;
+	snap->hdr.mc_fw_minor = restool.mc_fw_version.minor;
+	snap->hdr.dprc_id = dprc_id;
+
+	if (dprc_id == restool.root_dprc_id) {
+		dprc_handle = restool.root_dprc_handle;
+	} else {
+		error = open_dprc(dprc_id, &dprc_handle);
+		if (error < 0)
+			return error;
+	}
+
+	error = get_topology(dprc_id, dprc_handle, 0, &topology);
+	if (dprc_id != restool.root_dprc_id) {
+		error2 = dprc_close(&restool.mc_io, 0, dprc_handle);
+		if (error2 < 0 && error == 0)
+			error = error2;
+	}
+	if (error < 0)
+		goto out;
+
+	snap->objs = calloc(topology.num_objs + 1, sizeof(*snap->objs));
+	if (snap->objs == NULL) {
+		ERROR_PRINTF("Could not alloc memory!\n");
+		error = -ENOMEM;
+		goto out;
+	}
+
+	for (int i = 0; i < topology.num_objs; i++) {
+		desc = &topology.objs[i].desc;
+		obj = &snap->objs[snap->hdr.num_objs++];
+		strcpy(obj->type, desc->type);
+		strcpy(obj->label, desc->label);
+		obj->id = desc->id;
+		obj->parent_id = topology.objs[i].parent_dprc_id;
+		obj->state = desc->state;
+
+		if (strcmp(desc->type, "dprc") == 0) {
+			error = read_snapshot_dprc_cfg(obj);
+			obj->flags |= SNAPSHOT_OBJ_HAS_CFG;
+		} else if (can_create_obj_v10(desc->type)) {
+			error = read_obj_create_cfg_v10(desc->type, desc->id,
+							&obj->cfg,
+							&obj->num_ifs);
+			obj->flags |= SNAPSHOT_OBJ_HAS_CFG;
+		} else if (strcmp(desc->type, "dpmac") == 0) {
+			obj->num_ifs = 1;
+		}
+		if (error < 0)
+			goto out;
+	}
+
+	error = read_snapshot_links(snap);
+out:
+	free_topology(&topology);
+	if (error < 0)
+		free_snapshot(snap);
+	return error;
+}
+
+static int write_snapshot(const char *file, const struct snapshot *snap)
+{
+	FILE *fp;
+	int error = 0;
+
+	fp = fopen(file, "w");
+	if (fp == NULL) {
+		ERROR_PRINTF("Could not open %s: %s\n", file, strerror(errno));
+		return -errno;
+	}
+
+	if (fwrite(&snap->hdr, sizeof(snap->hdr), 1, fp) != 1 ||
+	    fwrite(snap->objs, sizeof(*snap->objs), snap->hdr.num_objs, fp) !=
+	    snap->hdr.num_objs ||
+	    fwrite(snap->links, sizeof(*snap->links), snap->hdr.num_links,
+		   fp) != snap->hdr.num_links)
+		error = -EIO;
+
+	if (fclose(fp) != 0 && error == 0)
+		error = -errno;
+	if (error < 0)
+		ERROR_PRINTF("Could not write %s: %s\n", file, strerror(-error));
+
+	return error;
+}
+
+/**
+ * Object types must fit a struct dprc_endpoint, labels their field
+ */
+static bool check_snapshot_strings(const struct snapshot *snap)
+{
+	const struct snapshot_obj *obj;
+	const struct snapshot_link *link;
+
+	for (uint32_t i = 0; i < snap->hdr.num_objs; i++) {
+		obj = &snap->objs[i];
+		if (!memchr(obj->type, '\0', OBJ_TYPE_MAX_LENGTH + 1) ||
+		    !memchr(obj->label, '\0', sizeof(obj->label)))
+			return false;
+	}
+
+	for (uint32_t i = 0; i < snap->hdr.num_links; i++) {
+		link = &snap->links[i];
+		if (!memchr(link->type1, '\0', OBJ_TYPE_MAX_LENGTH + 1) ||
+		    !memchr(link->type2, '\0', OBJ_TYPE_MAX_LENGTH + 1))
+			return false;
+	}
+
+	return true;
+}
+
+/**
+ * Maps a snapshot file. The mapping is private, records can be changed
+ * in memory without touching the file.
+ */
+static int load_snapshot(const char *file, struct snapshot *snap)
+{
+	const struct snapshot_header *hdr;
+	struct stat st;
+	size_t size;
+	void *map;
+	int fd;
+
+	memset(snap, 0, sizeof(*snap));
+	fd = open(file, O_RDONLY);
+	if (fd < 0) {
+		ERROR_PRINTF("Could not open %s: %s\n", file, strerror(errno));
+		return -errno;
+	}
+
+	if (fstat(fd, &st) < 0 || (size_t)st.st_size < sizeof(*hdr)) {
+		ERROR_PRINTF("%s is not a restool snapshot\n", file);
+		close(fd);
+		return -EINVAL;
+	}
+
+	map = mmap(NULL, st.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd,
+		   0);
+	close(fd);
+	if (map == MAP_FAILED) {
+		ERROR_PRINTF("Could not map %s: %s\n", file, strerror(errno));
+		return -errno;
+	}
+
+	snap->map = map;
+	snap->map_size = st.st_size;
+	hdr = map;
+	if (hdr->magic != SNAPSHOT_MAGIC) {
+		ERROR_PRINTF("%s is not a restool snapshot\n", file);
+		goto invalid;
+	}
+
+	if (hdr->version != SNAPSHOT_VERSION ||
+	    hdr->header_size != sizeof(struct snapshot_header) ||
+	    hdr->obj_size != sizeof(struct snapshot_obj) ||
+	    hdr->link_size != sizeof(struct snapshot_link) ||
+	    hdr->cfg_size != sizeof(union obj_create_cfg)) {
+		ERROR_PRINTF("%s: unsupported snapshot format version %u\n",
+			     file, hdr->version);
+		goto invalid;
+	}
+
+	size = sizeof(*hdr) +
+	       (size_t)hdr->num_objs * sizeof(struct snapshot_obj) +
+	       (size_t)hdr->num_links * sizeof(struct snapshot_link);
+	if (size != snap->map_size) {
+		ERROR_PRINTF("%s: truncated or corrupted snapshot\n", file);
+		goto invalid;
+	}
+
+	snap->hdr = *hdr;
+	snap->objs = (struct snapshot_obj *)(hdr + 1);
+	snap->links = (struct snapshot_link *)(snap->objs + hdr->num_objs);
+	if (!check_snapshot_strings(snap)) {
+		ERROR_PRINTF("%s: truncated or corrupted snapshot\n", file);
+		goto invalid;
+	}
+
+	return 0;
+
+invalid:
+	free_snapshot(snap);
+	return -EINVAL;
+}
+
+/**
+ * Number of containers between the root container and dprc_id, capped
+ * at 2: objects can only be plugged in the root container and its
+ * children
+ */
+static int get_dprc_depth(uint32_t dprc_id, int *depth)
+{
+	struct dprc_obj_desc desc;
+	uint32_t parent_id;
+	bool found = false;
+	int error;
+
+	*depth = 0;
+	if (dprc_id == restool.root_dprc_id)
+		return 0;
+
+	memset(&desc, 0, sizeof(desc));
+	error = find_target_obj_desc(restool.root_dprc_id,
+				     restool.root_dprc_handle, 0, dprc_id,
+				     "dprc", &desc, &parent_id, &found);
+	if (error < 0)
+		return error;
+	if (!found) {
+		ERROR_PRINTF("dprc.%u does not exist\n", dprc_id);
+		return -ENOENT;
+	}
+
+	*depth = parent_id == restool.root_dprc_id ? 1 : 2;
+	return 0;
+}
+
+/**
+ * Plugs an object of the root container or of one of its children, by
+ * assigning it again with the plugged option
+ */
+static int plug_snapshot_obj(uint32_t dprc_id, const char *obj_type,
+			     uint32_t obj_id)
+{
+	struct dprc_res_req res_req;
+	int error;
+
+	memset(&res_req, 0, sizeof(res_req));
+	strcpy(res_req.type, obj_type);
+	res_req.num = 1;
+	res_req.options = DPRC_RES_REQ_OPT_EXPLICIT;
+	res_req.id_base_align = obj_id;
+
+	if (dprc_id != restool.root_dprc_id) {
+		error = dprc_unassign(&restool.mc_io, 0,
+				      restool.root_dprc_handle, dprc_id,
+				      &res_req);
+		if (error < 0)
+			return error;
+	}
+
+	res_req.options |= DPRC_RES_REQ_OPT_PLUGGED;
+	return dprc_assign(&restool.mc_io, 0, restool.root_dprc_handle,
+			   dprc_id, &res_req);
+}
+
+/**
+ * Per object state of a restore: new id, and for containers their depth
+ * and the handle they were opened with
+ */
+struct restore_obj {
+	uint32_t new_id;
+	uint16_t handle;
+	bool opened;
+	int depth;
+};
+
+static int restore_one(struct snapshot *snap, struct restore_obj *restore,
+		       uint32_t i, uint32_t dprc_id, uint16_t dprc_handle,
+		       int dprc_depth)
+{
+	struct snapshot_obj *obj = &snap->objs[i];
+	union obj_create_cfg cfg = obj->cfg;
+	uint64_t mc_portal_offset;
+	uint32_t parent_id = dprc_id;
+	uint16_t parent_handle = dprc_handle;
+	int depth = dprc_depth;
+	char parent_name[32];
+	int child_id;
+	int parent;
+	int error;
+
+	if (obj->parent_id != snap->hdr.dprc_id) {
+		parent = find_snapshot_obj(snap, "dprc", obj->parent_id);
+		if (parent < 0 || (uint32_t)parent >= i ||
+		    !restore[parent].opened) {
+			ERROR_PRINTF("%s.%u: container dprc.%u was not restored\n",
+				     obj->type, obj->id, obj->parent_id);
+			return -EINVAL;
+		}
+
+		parent_id = restore[parent].new_id;
+		parent_handle = restore[parent].handle;
+		depth = restore[parent].depth;
+	}
+
+	if (!(obj->flags & SNAPSHOT_OBJ_HAS_CFG)) {
+		/* DPMACs, DPAIOPs, ...: the live object with the same id */
+		restore[i].new_id = obj->id;
+		return 0;
+	}
+
+	if (strcmp(obj->type, "dprc") == 0) {
+		cfg.dprc.icid = DPRC_GET_ICID_FROM_POOL;
+		cfg.dprc.portal_id = DPRC_GET_PORTAL_ID_FROM_POOL;
+		strcpy(cfg.dprc.label, obj->label);
+		error = dprc_create_container(&restool.mc_io, 0, parent_handle,
+					      &cfg.dprc, &child_id,
+					      &mc_portal_offset);
+		restore[i].new_id = child_id;
+	} else {
+		error = create_obj_v10(parent_handle, obj->type, &cfg,
+				       &restore[i].new_id);
+	}
+	if (error < 0)
+		goto mc_error;
+
+	sprintf(parent_name, "dprc.%u", parent_id);
+	print_new_obj(obj->type, restore[i].new_id, parent_name);
+
+	if (strcmp(obj->type, "dprc") == 0) {
+		restore[i].depth = depth + 1;
+		error = open_dprc(restore[i].new_id, &restore[i].handle);
+		restore[i].opened = error == 0;
+		return error;
+	}
+
+	if (obj->label[0] != '\0') {
+		error = dprc_set_obj_label(&restool.mc_io, 0, parent_handle,
+					   obj->type, restore[i].new_id,
+					   obj->label);
+		if (error < 0)
+			goto mc_error;
+	}
+
+	if (!(obj->state & DPRC_OBJ_STATE_PLUGGED))
+		return 0;
+
+	if (depth > 1) {
+		printf("warning: %s.%u cannot be plugged in a nested container\n",
+		       obj->type, restore[i].new_id);
+		return 0;
+	}
+
+	error = plug_snapshot_obj(parent_id, obj->type, restore[i].new_id);
+	if (error == 0)
+		return 0;
+
+mc_error:
+	mc_status = flib_error_to_mc_status(error);
+	ERROR_PRINTF("%s.%u: MC error: %s (status %#x)\n",
+		     obj->type, obj->id,
+		     mc_status_to_string(mc_status), mc_status);
+	return error;
+}
+
+static void map_snapshot_endpoint(const struct snapshot *snap,
+				  const struct restore_obj *restore,
+				  const char *type, uint32_t id,
+				  uint32_t if_id,
+				  struct dprc_endpoint *endpoint)
+{
+	int index = find_snapshot_obj(snap, type, id);
+
+	memset(endpoint, 0, sizeof(*endpoint));
+	strcpy(endpoint->type, type);
+	endpoint->id = index >= 0 ? restore[index].new_id : id;
+	endpoint->if_id = if_id;
+}
+
+/**
+ * Creates the containers and objects of the snapshot in walk order, then
+ * connects them. Containers are opened once, and all requests go out in
+ * a single session.
+ */
+static int restore_snapshot(struct snapshot *snap, uint32_t dprc_id)
+{
+	struct dprc_connection_cfg connection_cfg = { 0 };
+	struct dprc_endpoint endpoint1;
+	struct dprc_endpoint endpoint2;
+	const struct snapshot_link *link;
+	struct restore_obj *restore;
+	uint16_t dprc_handle;
+	int dprc_depth;
+	int error, error2;
+
+	error = get_dprc_depth(dprc_id, &dprc_depth);
+	if (error < 0)
+		return error;
+
+	restore = calloc(snap->hdr.num_objs + 1, sizeof(*restore));
+	if (restore == NULL) {
+		ERROR_PRINTF("Could not alloc memory!\n");
+		return -ENOMEM;
+	}
+
+	if (dprc_id == restool.root_dprc_id) {
+		dprc_handle = restool.root_dprc_handle;
+	} else {
+		error = open_dprc(dprc_id, &dprc_handle);
+		if (error < 0)
+			goto out;
+	}
+
+	for (uint32_t i = 0; i < snap->hdr.num_objs && error == 0; i++)
+		error = restore_one(snap, restore, i, dprc_id, dprc_handle,
+				    dprc_depth);
+
+	for (uint32_t i = 0; i < snap->hdr.num_links && error == 0; i++) {
+		link = &snap->links[i];
+		map_snapshot_endpoint(snap, restore, link->type1, link->id1,
+				      link->if_id1, &endpoint1);
+		map_snapshot_endpoint(snap, restore, link->type2, link->id2,
+				      link->if_id2, &endpoint2);
+		error = dprc_connect(&restool.mc_io, 0,
+				     restool.root_dprc_handle,
+				     &endpoint1, &endpoint2, &connection_cfg);
+		if (error < 0) {
+			mc_status = flib_error_to_mc_status(error);
+			ERROR_PRINTF("%s.%d.%u: MC error: %s (status %#x)\n",
+				     endpoint1.type, endpoint1.id,
+				     endpoint1.if_id,
+				     mc_status_to_string(mc_status), mc_status);
+		}
+	}
+
+	if (error < 0)
+		ERROR_PRINTF("The snapshot was partially restored, the objects created are listed above\n");
+
+	for (uint32_t i = 0; i < snap->hdr.num_objs; i++) {
+		if (!restore[i].opened)
+			continue;
+
+		error2 = dprc_close(&restool.mc_io, 0, restore[i].handle);
+		if (error2 < 0 && error == 0)
+			error = error2;
+	}
+
+	if (dprc_id != restool.root_dprc_id) {
+		error2 = dprc_close(&restool.mc_io, 0, dprc_handle);
+		if (error2 < 0 && error == 0)
+			error = error2;
+	}
+out:
+	free(restore);
+	return error;
+}
+
+static bool same_link(const struct snapshot_link *link1,
+		      const struct snapshot_link *link2)
+{
+	if (link1->id1 == link2->id1 && link1->if_id1 == link2->if_id1 &&
+	    strcmp(link1->type1, link2->type1) == 0)
+		return link1->id2 == link2->id2 &&
+		       link1->if_id2 == link2->if_id2 &&
+		       strcmp(link1->type2, link2->type2) == 0;
+
+	return link1->id1 == link2->id2 && link1->if_id1 == link2->if_id2 &&
+	       strcmp(link1->type1, link2->type2) == 0 &&
+	       link1->id2 == link2->id1 && link1->if_id2 == link2->if_id1 &&
+	       strcmp(link1->type2, link2->type1) == 0;
+}
+
+static bool find_snapshot_link(const struct snapshot *snap,
+			       const struct snapshot_link *link)
+{
+	for (uint32_t i = 0; i < snap->hdr.num_links; i++) {
+		if (same_link(&snap->links[i], link))
+			return true;
+	}
+
+	return false;
+}
+
+/**
+ * Prints the objects and links that were removed (-), added (+) or
+ * changed (~) from snapshot old to snapshot new
+ */
+static int diff_snapshots(const struct snapshot *old,
+			  const struct snapshot *new)
+{
+	const struct snapshot_obj *obj1, *obj2;
+	const struct snapshot_link *link;
+	int num_diffs = 0;
+	int index;
+
+	for (uint32_t i = 0; i < old->hdr.num_objs; i++) {
+		obj1 = &old->objs[i];
+		index = find_snapshot_obj(new, obj1->type, obj1->id);
+		if (index < 0) {
+			printf("- %s.%u\n", obj1->type, obj1->id);
+			num_diffs++;
+			continue;
+		}
+
+		obj2 = &new->objs[index];
+		if (obj1->parent_id != obj2->parent_id) {
+			printf("~ %s.%u: container dprc.%u -> dprc.%u\n",
+			       obj1->type, obj1->id, obj1->parent_id,
+			       obj2->parent_id);
+			num_diffs++;
+		}
+		if (strcmp(obj1->label, obj2->label) != 0) {
+			printf("~ %s.%u: label \"%s\" -> \"%s\"\n",
+			       obj1->type, obj1->id, obj1->label, obj2->label);
+			num_diffs++;
+		}
+		if ((obj1->state ^ obj2->state) & DPRC_OBJ_STATE_PLUGGED) {
+			printf("~ %s.%u: %s\n", obj1->type, obj1->id,
+			       obj2->state & DPRC_OBJ_STATE_PLUGGED ?
+			       "plugged" : "unplugged");
+			num_diffs++;
+		}
+		if (obj1->flags != obj2->flags ||
+		    memcmp(&obj1->cfg, &obj2->cfg, sizeof(obj1->cfg)) != 0) {
+			printf("~ %s.%u: creation attributes changed\n",
+			       obj1->type, obj1->id);
+			num_diffs++;
+		}
+	}
+
+	for (uint32_t i = 0; i < new->hdr.num_objs; i++) {
+		obj2 = &new->objs[i];
+		if (find_snapshot_obj(old, obj2->type, obj2->id) < 0) {
+			printf("+ %s.%u\n", obj2->type, obj2->id);
+			num_diffs++;
+		}
+	}
+
+	for (uint32_t i = 0; i < old->hdr.num_links; i++) {
+		link = &old->links[i];
+		if (!find_snapshot_link(new, link)) {
+			printf("- %s.%u.%u <-> %s.%u.%u\n",
+			       link->type1, link->id1, link->if_id1,
+			       link->type2, link->id2, link->if_id2);
+			num_diffs++;
+		}
+	}
+
+	for (uint32_t i = 0; i < new->hdr.num_links; i++) {
+		link = &new->links[i];
+		if (!find_snapshot_link(old, link)) {
+			printf("+ %s.%u.%u <-> %s.%u.%u\n",
+			       link->type1, link->id1, link->if_id1,
+			       link->type2, link->id2, link->if_id2);
+			num_diffs++;
+		}
+	}
+
+	if (num_diffs == 0)
+		printf("no differences\n");
+
+	return 0;
+}
+
+static int get_container_option(int option, uint32_t *dprc_id)
+{
+	int error;
+
+	if (!(restool.cmd_option_mask & ONE_BIT_MASK(option)))
+		return 0;
+
+	restool.cmd_option_mask &= ~ONE_BIT_MASK(option);
+	error = parse_object_name(restool.cmd_option_args[option], "dprc",
+				  dprc_id);
+	if (error < 0)
+		return error;
+
+	if (!find_obj("dprc", *dprc_id))
+		return -EINVAL;
+
+	return 0;
+}
+
+static int cmd_snapshot_save(void)
+{
+	static const char usage_msg[] =
+		"\n"
+		"Usage: restool snapshot save <file> [--container=<container>]\n"
+		"\n"
+		"OPTIONS:\n"
+		"--container=<container>\n"
+		"   Container to save, with all its nested containers. Default\n"
+		"   is the root container.\n"
+		"\n"
+		"NOTES:\n"
+		" -The snapshot holds the containers and objects with their\n"
+		"  creation attributes, labels and plugged state, and the links\n"
+		"  of these objects.\n"
+		"\n"
+		"EXAMPLE:\n"
+		"   $ restool snapshot save dprc2.snap --container=dprc.2\n"
+		"\n";
+
+	uint32_t dprc_id = restool.root_dprc_id;
+	struct snapshot snap;
+	int error;
+
+	if (restool.cmd_option_mask & ONE_BIT_MASK(SAVE_OPT_HELP)) {
+		puts(usage_msg);
+		restool.cmd_option_mask &= ~ONE_BIT_MASK(SAVE_OPT_HELP);
+		return 0;
+	}
+
+	if (restool.obj_name == NULL) {
+		ERROR_PRINTF("<file> argument missing\n");
+		puts(usage_msg);
+		return -EINVAL;
+	}
+
+	error = get_container_option(SAVE_OPT_CONTAINER, &dprc_id);
+	if (error < 0)
+		return error;
+
+	error = capture_snapshot(dprc_id, &snap);
+	if (error < 0)
+		return error;
+
+	error = write_snapshot(restool.obj_name, &snap);
+	if (error == 0)
+		printf("dprc.%u saved to %s: %u objects, %u links\n", dprc_id,
+		       restool.obj_name, snap.hdr.num_objs,
+		       snap.hdr.num_links);
+
+	free_snapshot(&snap);
+	return error;
+}
+
+static int cmd_snapshot_restore(void)
+{
+	static const char usage_msg[] =
+		"\n"
+		"Usage: restool snapshot restore <file> [--container=<container>]\n"
+		"\n"
+		"OPTIONS:\n"
+		"--container=<container>\n"
+		"   Container standing for the saved container. Default is the\n"
+		"   root container.\n"
+		"\n"
+		"NOTES:\n"
+		" -The nested containers and the objects of the snapshot are\n"
+		"  created again with their labels, then connected. They get new\n"
+		"  ids, which are printed.\n"
+		" -DPMACs, DPAIOPs and other objects that cannot be created refer\n"
+		"  to the live object with the same id.\n"
+		" -Objects can only be plugged again in the root container and\n"
+		"  its children.\n"
+		"\n"
+		"EXAMPLE:\n"
+		"   $ restool snapshot restore dprc2.snap --container=dprc.3\n"
+		"\n";
+
+	uint32_t dprc_id = restool.root_dprc_id;
+	struct snapshot snap;
+	int error;
+
+	if (restool.cmd_option_mask & ONE_BIT_MASK(RESTORE_OPT_HELP)) {
+		puts(usage_msg);
+		restool.cmd_option_mask &= ~ONE_BIT_MASK(RESTORE_OPT_HELP);
+		return 0;
+	}
+
+	if (restool.obj_name == NULL) {
+		ERROR_PRINTF("<file> argument missing\n");
+		puts(usage_msg);
+		return -EINVAL;
+	}
+
+	error = get_container_option(RESTORE_OPT_CONTAINER, &dprc_id);
+	if (error < 0)
+		return error;
+
+	error = load_snapshot(restool.obj_name, &snap);
+	if (error < 0)
+		return error;
+
+	error = restore_snapshot(&snap, dprc_id);
+	free_snapshot(&snap);
+	return error;
+}
+
+static int cmd_snapshot_diff(void)
+{
+	static const char usage_msg[] =
+		"\n"
+		"Usage: restool snapshot diff <file> [--with=<file>]\n"
+		"                             [--container=<container>]\n"
+		"\n"
+		"OPTIONS:\n"
+		"--with=<file>\n"
+		"   Snapshot to compare <file> with. Default is the live system.\n"
+		"--container=<container>\n"
+		"   Live container to compare <file> with. Default is the\n"
+		"   container the snapshot was taken from.\n"
+		"\n"
+		"NOTES:\n"
+		" -Objects and links are matched by type and id, and printed as\n"
+		"  removed (-), added (+) or changed (~) since <file>.\n"
+		"\n"
+		"EXAMPLE:\n"
+		"   $ restool snapshot diff dprc2.snap\n"
+		"\n";
+
+	struct snapshot old, new;
+	uint32_t dprc_id;
+	int error;
+
+	if (restool.cmd_option_mask & ONE_BIT_MASK(DIFF_OPT_HELP)) {
+		puts(usage_msg);
+		restool.cmd_option_mask &= ~ONE_BIT_MASK(DIFF_OPT_HELP);
+		return 0;
+	}
+
+	if (restool.obj_name == NULL) {
+		ERROR_PRINTF("<file> argument missing\n");
+		puts(usage_msg);
+		return -EINVAL;
+	}
+
+	error = load_snapshot(restool.obj_name, &old);
+	if (error < 0)
+		return error;
+
+	dprc_id = old.hdr.dprc_id;
+	if (restool.cmd_option_mask & ONE_BIT_MASK(DIFF_OPT_WITH)) {
+		restool.cmd_option_mask &= ~ONE_BIT_MASK(DIFF_OPT_WITH);
+		error = load_snapshot(restool.cmd_option_args[DIFF_OPT_WITH],
+				      &new);
+	} else {
+		error = get_container_option(DIFF_OPT_CONTAINER, &dprc_id);
+		if (error == 0)
+			error = capture_snapshot(dprc_id, &new);
+	}
+
+	if (error == 0) {
+		error = diff_snapshots(&old, &new);
+		free_snapshot(&new);
+	}
+
+	free_snapshot(&old);
+	return error;
+}
+
+/**
+ * snapshot command table
+ */
+struct object_command snapshot_commands[] = {
+	{ .cmd_name = "help",
+	  .options = NULL,
+	  .cmd_func = cmd_snapshot_help },
+
+	{ .cmd_name = "save",
+	  .options = snapshot_save_options,
+	  .cmd_func = cmd_snapshot_save },
+
+	{ .cmd_name = "restore",
+	  .options = snapshot_restore_options,
+	  .cmd_func = cmd_snapshot_restore },
+
+	{ .cmd_name = "diff",
+	  .options = snapshot_diff_options,
+	  .cmd_func = cmd_snapshot_diff },
+
+	{ .cmd_name = NULL },
+};